@@ -28,6 +28,7 @@ GetOptions(
   'arch=s',
   'sym=s',
   'config=s',
+  'bench',
 );
 
 foreach my $opt (qw/arch config/) {
@@ -194,6 +195,131 @@ sub filter {
   return @filtered;
 }
 
+#
+# Benchmark table generation (--bench)
+#
+# Instead of the dispatch header, emit one wrapper per function variant that
+# calls it in a loop with synthesized arguments, plus a table of the wrappers
+# keyed by the cpu flag each variant needs. Arguments are chosen from their
+# type and name; functions taking anything else (structs, enums, tables of
+# pointers) are listed without a wrapper so the harness can report them.
+#
+my %bench_scalars = (
+  bd => "a->bd", bps => "a->bd",
+  x_step_q4 => 16, y_step_q4 => 16,
+  w => 16, h => 16, width => 16, height => 16, Width => 16, Height => 16,
+  block_width => 16, block_height => 16, rows => 16, cols => 16, n => 16,
+  size => 16, dest_width => 16, source_width => 80,
+  xoffset => 4, yoffset => 4, xofst => 4, yofst => 4,
+  tx_type => 1, skip_block => 0, count => 1, length => 256, bwl => 2,
+  flimit => 20, src_weight => 8, filter_weight => 2, strength => 6,
+  alpha => 64, y1 => 128, u1 => 128, v1 => 128, top_left => 128,
+  b_mode => 0, dc => 0, input => 8,
+  motion_magnitude => 0, increase_denoising => 0,
+);
+
+sub bench_arg {
+  my ($fn, $arg, $count) = @_;
+  my $array = ($arg =~ s/\s*\[\s*\d*\s*\]\s*$//);
+  my $name = ($arg =~ s/(?<=[\s*])(\w+)\s*$//) ? $1 : "";
+  my $depth = () = $arg =~ /\*/g;
+  $depth += $array;
+  (my $base = $arg) =~ s/\bconst\b|\*//g;
+  $base =~ s/^\s+|\s+$//g;
+  $base =~ s/\s+/ /g;
+  my $hbd = $fn =~ /highbd/;
+  my $pixel = $base =~ /^(uint8_t|unsigned char)$/;
+
+  if ($depth == 0) {
+    return undef if $base !~
+      /^(int|unsigned|unsigned int|intptr_t|ptrdiff_t|short|unsigned char)$/;
+    return "RTCD_BENCH_STRIDE" if $name =~ /stride|pitch|per_line|^[dsr]?p$/i;
+    return ($fn =~ /32x32/ ? 1024 : $fn =~ /8x8/ ? 64 : 256)
+      if $name eq "n_coeffs";
+    return ($fn =~ /temporal_filter/ ? 16 : 256) if $name eq "block_size";
+    return $bench_scalars{$name};
+  }
+  if ($depth == 1) {
+    if ($pixel) {
+      return "a->blimit" if $name =~ /^blimit/;
+      return "a->limit" if $name =~ /^(limit|flimits)/;
+      return "a->thresh" if $name =~ /^thresh/;
+    }
+    if ($base =~ /^(int16_t|short|tran_low_t)$/) {
+      return "a->scan" if $name =~ /^i?scan/;
+      return "a->$1" if $name =~ /^(zbin|round|quant|quant_shift|dequant)_ptr$/;
+      return "a->dequant" if $name =~ /^dqc?$/;
+      return "a->filter" if $name =~ /^filter_[xy]$/;
+      my $i = $count->{coeff}++;
+      return undef if $i >= 6;
+      return $base eq "tran_low_t" ? "a->coeff[$i]" : "a->coeff16[$i]";
+    }
+    if ($pixel || $base =~ /^(uint16_t|unsigned short)$/) {
+      my $i = $count->{pix}++;
+      return undef if $i >= 6;
+      return "a->pix16[$i]" if !$pixel;
+      return $hbd ? "CONVERT_TO_BYTEPTR(a->pix16[$i])" : "a->pix8[$i]";
+    }
+    return "a->chars" if $base eq "char";
+    return "($base *)a->out"
+      if $base =~ /^(int|unsigned|unsigned int|u?int(32|64)_t|unsigned long)$/;
+    return undef;
+  }
+  return ($hbd ? "a->refs16" : "a->refs") if $depth == 2 && $pixel;
+  return undef;
+}
+
+sub bench {
+  my $include_guard = uc($opts{sym})."_BENCH_H_";
+  my @table;
+  print <<EOF;
+#ifndef ${include_guard}
+#define ${include_guard}
+
+EOF
+  foreach my $fn (sort keys %ALL_FUNCS) {
+    my @val = @{$ALL_FUNCS{$fn}};
+    my $args = pop @val;
+    my %count = ();
+    my @call;
+    my $supported = 1;
+    foreach my $arg (split /,/, $args) {
+      next if $arg =~ /^\s*(void)?\s*$/;
+      my $expr = bench_arg($fn, $arg, \%count);
+      if (!defined $expr) {
+        $supported = 0;
+        last;
+      }
+      push @call, $expr;
+    }
+    if (!$supported) {
+      push @table, "  { \"$fn\", \"c\", 0, NULL },";
+      next;
+    }
+    foreach my $opt ("c", @ALL_ARCHS) {
+      my $ofn = eval "\$${fn}_${opt}";
+      next if !$ofn;
+      my $cond = $opt eq "c" ? "" : eval "\$have_${opt}";
+      $cond = "0" if !$cond;
+      $cond =~ s/^flags & //;
+      print "static void ${ofn}_bench(RtcdBenchArgs *a, int n) {\n";
+      print "  int i;\n";
+      print "  (void)a;\n" if !@call;
+      print "  for (i = 0; i < n; ++i) ${ofn}(" . join(", ", @call) . ");\n";
+      print "}\n\n";
+      push @table, "  { \"$fn\", \"$opt\", $cond, ${ofn}_bench },";
+    }
+  }
+  print "static const RtcdBenchKernel $opts{sym}_bench[] = {\n";
+  print "$_\n" foreach @table;
+  print <<EOF;
+  { NULL, NULL, 0, NULL }
+};
+
+#endif
+EOF
+}
+
 #
 # Helper functions for generating the arch specific RTCD files
 #
@@ -246,6 +372,7 @@ sub x86() {
     my $opt_uc = uc $opt;
     eval "\$have_${opt}=\"flags & HAS_${opt_uc}\"";
   }
+  return bench if $opts{bench};
 
   common_top;
   print <<EOF;
@@ -279,6 +406,7 @@ sub arm() {
     if ($opt eq 'neon_asm') { $opt_uc = 'NEON' }
     eval "\$have_${opt}=\"flags & HAS_${opt_uc}\"";
   }
+  return bench if $opts{bench};
 
   common_top;
   print <<EOF;
@@ -305,6 +433,7 @@ EOF
 
 sub mips() {
   determine_indirection("c", @ALL_ARCHS);
+  return bench if $opts{bench};
   common_top;
 
   print <<EOF;
@@ -336,6 +465,7 @@ EOF
 
 sub unoptimized() {
   determine_indirection "c";
+  return bench if $opts{bench};
   common_top;
   print <<EOF;
 #include "vpx_config.h"
@@ -423,3 +553,4 @@ Options:
   --require-EXT     Require support for EXT extensions
   --sym=SYMBOL      Unique symbol to use for RTCD initialization function
   --config=FILE     File with CONFIG_FOO=yes lines to parse
+  --bench           Generate a benchmark table instead of the header
@@ -29,6 +29,15 @@ $$(BUILD_PFX)$(1).h: $$(SRC_PATH_BARE)/$(2)
           $$(RTCD_OPTIONS) $$^ > $$@
 CLEAN-OBJS += $$(BUILD_PFX)$(1).h
 RTCD += $$(BUILD_PFX)$(1).h
+
+$$(BUILD_PFX)$(1)_bench.h: $$(SRC_PATH_BARE)/$(2)
+	@echo "    [CREATE] $$@"
+	$$(qexec)$$(SRC_PATH_BARE)/build/make/rtcd.pl --arch=$$(TGT_ISA) \
+          --sym=$(1) --bench \
+          --config=$$(CONFIG_DIR)$$(target)-$$(TOOLCHAIN).mk \
+          $$(RTCD_OPTIONS) $$^ > $$@
+CLEAN-OBJS += $$(BUILD_PFX)$(1)_bench.h
+RTCD_BENCH += $$(BUILD_PFX)$(1)_bench.h
 endef
 
 CODEC_SRCS-yes += CHANGELOG
@@ -348,6 +357,8 @@ libvpx_test_data_url=http://downloads.webmproject.org/test_data/libvpx/$(1)
 
 TEST_INTRA_PRED_SPEED_BIN=./test_intra_pred_speed$(EXE_SFX)
 TEST_INTRA_PRED_SPEED_SRCS=$(addprefix test/,$(call enabled,TEST_INTRA_PRED_SPEED_SRCS))
+TEST_RTCD_SPEED_BIN=./test_rtcd_speed$(EXE_SFX)
+TEST_RTCD_SPEED_SRCS=$(addprefix test/,$(call enabled,TEST_RTCD_SPEED_SRCS))
 
 libvpx_test_srcs.txt:
 	@echo "    [CREATE] $@"
@@ -473,6 +484,22 @@ $(eval $(call linkerxx_template,$(TEST_INTRA_PRED_SPEED_BIN), \
               -L. -lvpx -lgtest $(extralibs) -lm))
 endif  # TEST_INTRA_PRED_SPEED
 
+TEST_RTCD_SPEED_OBJS := $(sort $(call objs,$(TEST_RTCD_SPEED_SRCS)))
+ifneq ($(strip $(TEST_RTCD_SPEED_OBJS)),)
+OBJS-yes += $(TEST_RTCD_SPEED_OBJS)
+BINS-yes += $(TEST_RTCD_SPEED_BIN)
+ifeq ($(CONFIG_DEPENDENCY_TRACKING),yes)
+$(TEST_RTCD_SPEED_OBJS:.o=.d): $(RTCD_BENCH)
+else
+$(TEST_RTCD_SPEED_OBJS): $(RTCD_BENCH)
+endif
+
+$(TEST_RTCD_SPEED_BIN): lib$(CODEC_LIB)$(CODEC_LIB_SUF)
+$(eval $(call linkerxx_template,$(TEST_RTCD_SPEED_BIN), \
+              $(TEST_RTCD_SPEED_OBJS) \
+              -L. -lvpx $(extralibs) -lm))
+endif  # TEST_RTCD_SPEED
+
 endif  # CONFIG_UNIT_TESTS
 
 # Install test sources only if codec source is included
@@ -480,6 +507,7 @@ INSTALL-SRCS-$(CONFIG_CODEC_SRCS) += $(patsubst $(SRC_PATH_BARE)/%,%,\
     $(shell find $(SRC_PATH_BARE)/third_party/googletest -type f))
 INSTALL-SRCS-$(CONFIG_CODEC_SRCS) += $(LIBVPX_TEST_SRCS)
 INSTALL-SRCS-$(CONFIG_CODEC_SRCS) += $(TEST_INTRA_PRED_SPEED_SRCS)
+INSTALL-SRCS-$(CONFIG_CODEC_SRCS) += $(TEST_RTCD_SPEED_SRCS)
 
 define test_shard_template
 test:: test_shard.$(1)
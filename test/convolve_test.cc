@@ -1264,6 +1264,33 @@ void wrap_convolve8_avg_sse2_12(const uint8_t *src, ptrdiff_t src_stride,
 }
 #endif  // HAVE_SSE2 && ARCH_X86_64
 
+#if HAVE_AVX2 && ARCH_X86_64
+#define WRAP_AVX2(func, bd) \
+void wrap_##func##_avx2_##bd(const uint8_t *src, ptrdiff_t src_stride, \
+                             uint8_t *dst, ptrdiff_t dst_stride, \
+                             const int16_t *filter_x, int filter_x_stride, \
+                             const int16_t *filter_y, int filter_y_stride, \
+                             int w, int h) { \
+  vp9_highbd_##func##_avx2(src, src_stride, dst, dst_stride, filter_x, \
+                           filter_x_stride, filter_y, filter_y_stride, \
+                           w, h, bd); \
+}
+
+#define WRAP_AVX2_BD(bd) \
+WRAP_AVX2(convolve8_horiz, bd) \
+WRAP_AVX2(convolve8_avg_horiz, bd) \
+WRAP_AVX2(convolve8_vert, bd) \
+WRAP_AVX2(convolve8_avg_vert, bd) \
+WRAP_AVX2(convolve8, bd) \
+WRAP_AVX2(convolve8_avg, bd)
+
+WRAP_AVX2_BD(8)
+WRAP_AVX2_BD(10)
+WRAP_AVX2_BD(12)
+#undef WRAP_AVX2_BD
+#undef WRAP_AVX2
+#endif  // HAVE_AVX2 && ARCH_X86_64
+
 void wrap_convolve_copy_c_8(const uint8_t *src, ptrdiff_t src_stride,
                             uint8_t *dst, ptrdiff_t dst_stride,
                             const int16_t *filter_x,
@@ -1761,6 +1788,66 @@ INSTANTIATE_TEST_CASE_P(AVX2, ConvolveTest, ::testing::Values(
     make_tuple(64, 64, &convolve8_avx2)));
 #endif  // HAVE_AVX2 && HAVE_SSSE3
 
+#if HAVE_AVX2 && ARCH_X86_64 && CONFIG_VP9_HIGHBITDEPTH
+const ConvolveFunctions highbd_convolve8_avx2(
+    wrap_convolve_copy_c_8, wrap_convolve_avg_c_8,
+    wrap_convolve8_horiz_avx2_8, wrap_convolve8_avg_horiz_avx2_8,
+    wrap_convolve8_vert_avx2_8, wrap_convolve8_avg_vert_avx2_8,
+    wrap_convolve8_avx2_8, wrap_convolve8_avg_avx2_8, 8);
+INSTANTIATE_TEST_CASE_P(AVX2_8, ConvolveTest, ::testing::Values(
+    make_tuple(4, 4, &highbd_convolve8_avx2),
+    make_tuple(8, 4, &highbd_convolve8_avx2),
+    make_tuple(4, 8, &highbd_convolve8_avx2),
+    make_tuple(8, 8, &highbd_convolve8_avx2),
+    make_tuple(16, 8, &highbd_convolve8_avx2),
+    make_tuple(8, 16, &highbd_convolve8_avx2),
+    make_tuple(16, 16, &highbd_convolve8_avx2),
+    make_tuple(32, 16, &highbd_convolve8_avx2),
+    make_tuple(16, 32, &highbd_convolve8_avx2),
+    make_tuple(32, 32, &highbd_convolve8_avx2),
+    make_tuple(64, 32, &highbd_convolve8_avx2),
+    make_tuple(32, 64, &highbd_convolve8_avx2),
+    make_tuple(64, 64, &highbd_convolve8_avx2)));
+const ConvolveFunctions highbd_convolve10_avx2(
+    wrap_convolve_copy_c_10, wrap_convolve_avg_c_10,
+    wrap_convolve8_horiz_avx2_10, wrap_convolve8_avg_horiz_avx2_10,
+    wrap_convolve8_vert_avx2_10, wrap_convolve8_avg_vert_avx2_10,
+    wrap_convolve8_avx2_10, wrap_convolve8_avg_avx2_10, 10);
+INSTANTIATE_TEST_CASE_P(AVX2_10, ConvolveTest, ::testing::Values(
+    make_tuple(4, 4, &highbd_convolve10_avx2),
+    make_tuple(8, 4, &highbd_convolve10_avx2),
+    make_tuple(4, 8, &highbd_convolve10_avx2),
+    make_tuple(8, 8, &highbd_convolve10_avx2),
+    make_tuple(16, 8, &highbd_convolve10_avx2),
+    make_tuple(8, 16, &highbd_convolve10_avx2),
+    make_tuple(16, 16, &highbd_convolve10_avx2),
+    make_tuple(32, 16, &highbd_convolve10_avx2),
+    make_tuple(16, 32, &highbd_convolve10_avx2),
+    make_tuple(32, 32, &highbd_convolve10_avx2),
+    make_tuple(64, 32, &highbd_convolve10_avx2),
+    make_tuple(32, 64, &highbd_convolve10_avx2),
+    make_tuple(64, 64, &highbd_convolve10_avx2)));
+const ConvolveFunctions highbd_convolve12_avx2(
+    wrap_convolve_copy_c_12, wrap_convolve_avg_c_12,
+    wrap_convolve8_horiz_avx2_12, wrap_convolve8_avg_horiz_avx2_12,
+    wrap_convolve8_vert_avx2_12, wrap_convolve8_avg_vert_avx2_12,
+    wrap_convolve8_avx2_12, wrap_convolve8_avg_avx2_12, 12);
+INSTANTIATE_TEST_CASE_P(AVX2_12, ConvolveTest, ::testing::Values(
+    make_tuple(4, 4, &highbd_convolve12_avx2),
+    make_tuple(8, 4, &highbd_convolve12_avx2),
+    make_tuple(4, 8, &highbd_convolve12_avx2),
+    make_tuple(8, 8, &highbd_convolve12_avx2),
+    make_tuple(16, 8, &highbd_convolve12_avx2),
+    make_tuple(8, 16, &highbd_convolve12_avx2),
+    make_tuple(16, 16, &highbd_convolve12_avx2),
+    make_tuple(32, 16, &highbd_convolve12_avx2),
+    make_tuple(16, 32, &highbd_convolve12_avx2),
+    make_tuple(32, 32, &highbd_convolve12_avx2),
+    make_tuple(64, 32, &highbd_convolve12_avx2),
+    make_tuple(32, 64, &highbd_convolve12_avx2),
+    make_tuple(64, 64, &highbd_convolve12_avx2)));
+#endif  // HAVE_AVX2 && ARCH_X86_64 && CONFIG_VP9_HIGHBITDEPTH
+
 #if HAVE_NEON
 #if HAVE_NEON_ASM
 const ConvolveFunctions convolve8_neon(
@@ -884,6 +884,27 @@ INSTANTIATE_TEST_CASE_P(
                    VPX_BITS_8)));
 #endif  // HAVE_SSE2 && !CONFIG_VP9_HIGHBITDEPTH && !CONFIG_EMULATE_HARDWARE
 
+#if HAVE_AVX2 && !CONFIG_VP9_HIGHBITDEPTH && !CONFIG_EMULATE_HARDWARE
+INSTANTIATE_TEST_CASE_P(
+    AVX2, Trans16x16DCT,
+    ::testing::Values(
+        make_tuple(&vp9_fdct16x16_c,
+                   &vp9_idct16x16_256_add_avx2, 0, VPX_BITS_8),
+        make_tuple(&vp9_fdct16x16_avx2,
+                   &vp9_idct16x16_256_add_avx2, 0, VPX_BITS_8)));
+INSTANTIATE_TEST_CASE_P(
+    AVX2, Trans16x16HT,
+    ::testing::Values(
+        make_tuple(&vp9_fht16x16_avx2, &vp9_iht16x16_256_add_c, 0,
+                   VPX_BITS_8),
+        make_tuple(&vp9_fht16x16_avx2, &vp9_iht16x16_256_add_c, 1,
+                   VPX_BITS_8),
+        make_tuple(&vp9_fht16x16_avx2, &vp9_iht16x16_256_add_c, 2,
+                   VPX_BITS_8),
+        make_tuple(&vp9_fht16x16_avx2, &vp9_iht16x16_256_add_c, 3,
+                   VPX_BITS_8)));
+#endif  // HAVE_AVX2 && !CONFIG_VP9_HIGHBITDEPTH && !CONFIG_EMULATE_HARDWARE
+
 #if HAVE_SSE2 && CONFIG_VP9_HIGHBITDEPTH && !CONFIG_EMULATE_HARDWARE
 INSTANTIATE_TEST_CASE_P(
     SSE2, Trans16x16DCT,
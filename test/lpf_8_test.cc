@@ -107,6 +107,20 @@ void wrapper_vertical_16_dual_c(uint8_t *s, int p, const uint8_t *blimit,
 #endif  // CONFIG_VP9_HIGHBITDEPTH
 #endif  // HAVE_SSE2
 
+#if HAVE_AVX2 && !CONFIG_VP9_HIGHBITDEPTH
+void wrapper_vertical_16_avx2(uint8_t *s, int p, const uint8_t *blimit,
+                              const uint8_t *limit, const uint8_t *thresh,
+                              int count) {
+  vp9_lpf_vertical_16_avx2(s, p, blimit, limit, thresh);
+}
+
+void wrapper_vertical_16_dual_avx2(uint8_t *s, int p, const uint8_t *blimit,
+                                   const uint8_t *limit, const uint8_t *thresh,
+                                   int count) {
+  vp9_lpf_vertical_16_dual_avx2(s, p, blimit, limit, thresh);
+}
+#endif  // HAVE_AVX2 && !CONFIG_VP9_HIGHBITDEPTH
+
 #if HAVE_NEON_ASM
 #if CONFIG_VP9_HIGHBITDEPTH
 // No neon high bitdepth functions.
@@ -584,9 +598,34 @@ INSTANTIATE_TEST_CASE_P(
 INSTANTIATE_TEST_CASE_P(
     AVX2, Loop8Test6Param,
     ::testing::Values(
+        make_tuple(&vp9_lpf_horizontal_4_avx2, &vp9_lpf_horizontal_4_c, 8, 1),
+        make_tuple(&vp9_lpf_horizontal_4_avx2, &vp9_lpf_horizontal_4_c, 8, 2),
+        make_tuple(&vp9_lpf_horizontal_8_avx2, &vp9_lpf_horizontal_8_c, 8, 1),
+        make_tuple(&vp9_lpf_horizontal_8_avx2, &vp9_lpf_horizontal_8_c, 8, 2),
         make_tuple(&vp9_lpf_horizontal_16_avx2, &vp9_lpf_horizontal_16_c, 8, 1),
         make_tuple(&vp9_lpf_horizontal_16_avx2, &vp9_lpf_horizontal_16_c, 8,
-                   2)));
+                   2),
+        make_tuple(&vp9_lpf_vertical_4_avx2, &vp9_lpf_vertical_4_c, 8, 1),
+        make_tuple(&vp9_lpf_vertical_4_avx2, &vp9_lpf_vertical_4_c, 8, 2),
+        make_tuple(&vp9_lpf_vertical_8_avx2, &vp9_lpf_vertical_8_c, 8, 1),
+        make_tuple(&vp9_lpf_vertical_8_avx2, &vp9_lpf_vertical_8_c, 8, 2),
+        make_tuple(&wrapper_vertical_16_avx2, &wrapper_vertical_16_c, 8, 1),
+        make_tuple(&wrapper_vertical_16_dual_avx2,
+                   &wrapper_vertical_16_dual_c, 8, 1)));
+#endif
+
+#if HAVE_AVX2 && (!CONFIG_VP9_HIGHBITDEPTH)
+INSTANTIATE_TEST_CASE_P(
+    AVX2, Loop8Test9Param,
+    ::testing::Values(
+        make_tuple(&vp9_lpf_horizontal_4_dual_avx2,
+                   &vp9_lpf_horizontal_4_dual_c, 8),
+        make_tuple(&vp9_lpf_horizontal_8_dual_avx2,
+                   &vp9_lpf_horizontal_8_dual_c, 8),
+        make_tuple(&vp9_lpf_vertical_4_dual_avx2,
+                   &vp9_lpf_vertical_4_dual_c, 8),
+        make_tuple(&vp9_lpf_vertical_8_dual_avx2,
+                   &vp9_lpf_vertical_8_dual_c, 8)));
 #endif
 
 #if HAVE_SSE2
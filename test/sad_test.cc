@@ -17,6 +17,7 @@
 #include "./vpx_dsp_rtcd.h"
 #include "vpx_mem/vpx_mem.h"
 #include "vpx_ports/mem.h"
+#include "vpx_ports/vpx_timer.h"
 
 #include "test/acm_random.h"
 #include "test/clear_system_state.h"
@@ -46,6 +47,15 @@ typedef void (*SadMxNx4Func)(const uint8_t *src_ptr,
                              uint32_t *sad_array);
 typedef std::tr1::tuple<int, int, SadMxNx4Func, int> SadMxNx4Param;
 
+// x3 and x8 functions compare the source against the reference at 3 or 8
+// consecutive horizontal offsets; the last parameter is the offset count.
+typedef void (*SadMxNxKFunc)(const uint8_t *src_ptr,
+                             int src_stride,
+                             const uint8_t *ref_ptr,
+                             int ref_stride,
+                             uint32_t *sad_array);
+typedef std::tr1::tuple<int, int, SadMxNxKFunc, int> SadMxNxKParam;
+
 using libvpx_test::ACMRandom;
 
 namespace {
@@ -222,6 +232,18 @@ class SADTestBase : public ::testing::Test {
     }
   }
 
+  // Number of calls for the speed tests, so every block size covers about
+  // the same number of pixels.
+  int SpeedTestCount() const {
+    return 50000000 / (width_ * height_);
+  }
+
+  void PrintSpeed(const char *name, vpx_usec_timer *timer) const {
+    printf("%s %dx%d (%2dbit): %6d us\n", name, width_, height_,
+           bd_ == -1 ? 8 : bd_,
+           static_cast<int>(vpx_usec_timer_elapsed(timer)));
+  }
+
   int width_, height_, mask_, bd_;
   vpx_bit_depth_t bit_depth_;
   static uint8_t *source_data_;
@@ -317,6 +339,48 @@ class SADavgTest
   }
 };
 
+class SADxNTest
+    : public SADTestBase,
+      public ::testing::WithParamInterface<SadMxNxKParam> {
+ public:
+  SADxNTest() : SADTestBase(GET_PARAM(0), GET_PARAM(1), -1) {}
+
+ protected:
+  // The offsets read past the right edge of the block, so fill whole
+  // reference rows, plus one more for the last row's overhang.
+  int ReferenceRowsSize() const {
+    return (height_ + 1) * reference_stride_;
+  }
+
+  void FillReferenceRows() {
+    for (int i = 0; i < ReferenceRowsSize(); ++i)
+      reference_data_[i] = rnd_.Rand8();
+  }
+
+  unsigned int ReferenceSADAt(int offset) {
+    unsigned int sad = 0;
+    for (int h = 0; h < height_; ++h) {
+      for (int w = 0; w < width_; ++w) {
+        sad += abs(source_data_[h * source_stride_ + w] -
+                   reference_data_[h * reference_stride_ + w + offset]);
+      }
+    }
+    return sad;
+  }
+
+  void CheckSADs() {
+    uint32_t exp_sad[8];
+
+    ASM_REGISTER_STATE_CHECK(GET_PARAM(2)(source_data_, source_stride_,
+                                          reference_data_, reference_stride_,
+                                          exp_sad));
+    for (int offset = 0; offset < GET_PARAM(3); ++offset) {
+      EXPECT_EQ(ReferenceSADAt(offset), exp_sad[offset])
+          << "offset " << offset;
+    }
+  }
+};
+
 uint8_t *SADTestBase::source_data_ = NULL;
 uint8_t *SADTestBase::reference_data_ = NULL;
 uint8_t *SADTestBase::second_pred_ = NULL;
@@ -481,6 +545,97 @@ TEST_P(SADx4Test, SrcAlignedByWidth) {
   source_data_ = tmp_source_data;
 }
 
+TEST_P(SADTest, DISABLED_Speed) {
+  const int count = SpeedTestCount();
+  FillRandom(source_data_, source_stride_);
+  FillRandom(reference_data_, reference_stride_);
+  vpx_usec_timer timer;
+  vpx_usec_timer_start(&timer);
+  for (int i = 0; i < count; ++i) {
+    GET_PARAM(2)(source_data_, source_stride_, reference_data_,
+                 reference_stride_);
+  }
+  vpx_usec_timer_mark(&timer);
+  PrintSpeed("sad", &timer);
+}
+
+TEST_P(SADavgTest, DISABLED_Speed) {
+  const int count = SpeedTestCount();
+  FillRandom(source_data_, source_stride_);
+  FillRandom(reference_data_, reference_stride_);
+  FillRandom(second_pred_, width_);
+  vpx_usec_timer timer;
+  vpx_usec_timer_start(&timer);
+  for (int i = 0; i < count; ++i) {
+    GET_PARAM(2)(source_data_, source_stride_, reference_data_,
+                 reference_stride_, second_pred_);
+  }
+  vpx_usec_timer_mark(&timer);
+  PrintSpeed("sad_avg", &timer);
+}
+
+TEST_P(SADx4Test, DISABLED_Speed) {
+  const int count = SpeedTestCount();
+  const uint8_t *references[] = {GetReference(0), GetReference(1),
+                                 GetReference(2), GetReference(3)};
+  uint32_t results[4];
+  FillRandom(source_data_, source_stride_);
+  for (int block = 0; block < 4; ++block)
+    FillRandom(GetReference(block), reference_stride_);
+  vpx_usec_timer timer;
+  vpx_usec_timer_start(&timer);
+  for (int i = 0; i < count; ++i) {
+    GET_PARAM(2)(source_data_, source_stride_, references, reference_stride_,
+                 results);
+  }
+  vpx_usec_timer_mark(&timer);
+  PrintSpeed("sadx4d", &timer);
+}
+
+TEST_P(SADxNTest, MaxRef) {
+  FillConstant(source_data_, source_stride_, 0);
+  memset(reference_data_, mask_, ReferenceRowsSize());
+  CheckSADs();
+}
+
+TEST_P(SADxNTest, MaxSrc) {
+  FillConstant(source_data_, source_stride_, mask_);
+  memset(reference_data_, 0, ReferenceRowsSize());
+  CheckSADs();
+}
+
+TEST_P(SADxNTest, Random) {
+  for (int i = 0; i < 10; ++i) {
+    FillRandom(source_data_, source_stride_);
+    FillReferenceRows();
+    CheckSADs();
+  }
+}
+
+TEST_P(SADxNTest, UnalignedRef) {
+  uint8_t *const tmp_reference_data = reference_data_;
+  reference_data_ += 1;
+  FillRandom(source_data_, source_stride_);
+  FillReferenceRows();
+  CheckSADs();
+  reference_data_ = tmp_reference_data;
+}
+
+TEST_P(SADxNTest, DISABLED_Speed) {
+  const int count = SpeedTestCount();
+  uint32_t results[8];
+  FillRandom(source_data_, source_stride_);
+  FillReferenceRows();
+  vpx_usec_timer timer;
+  vpx_usec_timer_start(&timer);
+  for (int i = 0; i < count; ++i) {
+    GET_PARAM(2)(source_data_, source_stride_, reference_data_,
+                 reference_stride_, results);
+  }
+  vpx_usec_timer_mark(&timer);
+  PrintSpeed(GET_PARAM(3) == 3 ? "sadx3" : "sadx8", &timer);
+}
+
 using std::tr1::make_tuple;
 
 //------------------------------------------------------------------------------
@@ -743,6 +898,42 @@ const SadMxNx4Param x4d_c_tests[] = {
 };
 INSTANTIATE_TEST_CASE_P(C, SADx4Test, ::testing::ValuesIn(x4d_c_tests));
 
+const SadMxNxKFunc sad64x64x3_c = vpx_sad64x64x3_c;
+const SadMxNxKFunc sad32x32x3_c = vpx_sad32x32x3_c;
+const SadMxNxKFunc sad16x16x3_c = vpx_sad16x16x3_c;
+const SadMxNxKFunc sad16x8x3_c = vpx_sad16x8x3_c;
+const SadMxNxKFunc sad8x16x3_c = vpx_sad8x16x3_c;
+const SadMxNxKFunc sad8x8x3_c = vpx_sad8x8x3_c;
+const SadMxNxKFunc sad4x4x3_c = vpx_sad4x4x3_c;
+const SadMxNxKFunc sad64x64x8_c = vpx_sad64x64x8_c;
+const SadMxNxKFunc sad32x32x8_c = vpx_sad32x32x8_c;
+const SadMxNxKFunc sad16x16x8_c = vpx_sad16x16x8_c;
+const SadMxNxKFunc sad16x8x8_c = vpx_sad16x8x8_c;
+const SadMxNxKFunc sad8x16x8_c = vpx_sad8x16x8_c;
+const SadMxNxKFunc sad8x8x8_c = vpx_sad8x8x8_c;
+const SadMxNxKFunc sad8x4x8_c = vpx_sad8x4x8_c;
+const SadMxNxKFunc sad4x8x8_c = vpx_sad4x8x8_c;
+const SadMxNxKFunc sad4x4x8_c = vpx_sad4x4x8_c;
+const SadMxNxKParam xn_c_tests[] = {
+  make_tuple(64, 64, sad64x64x3_c, 3),
+  make_tuple(32, 32, sad32x32x3_c, 3),
+  make_tuple(16, 16, sad16x16x3_c, 3),
+  make_tuple(16, 8, sad16x8x3_c, 3),
+  make_tuple(8, 16, sad8x16x3_c, 3),
+  make_tuple(8, 8, sad8x8x3_c, 3),
+  make_tuple(4, 4, sad4x4x3_c, 3),
+  make_tuple(64, 64, sad64x64x8_c, 8),
+  make_tuple(32, 32, sad32x32x8_c, 8),
+  make_tuple(16, 16, sad16x16x8_c, 8),
+  make_tuple(16, 8, sad16x8x8_c, 8),
+  make_tuple(8, 16, sad8x16x8_c, 8),
+  make_tuple(8, 8, sad8x8x8_c, 8),
+  make_tuple(8, 4, sad8x4x8_c, 8),
+  make_tuple(4, 8, sad4x8x8_c, 8),
+  make_tuple(4, 4, sad4x4x8_c, 8),
+};
+INSTANTIATE_TEST_CASE_P(C, SADxNTest, ::testing::ValuesIn(xn_c_tests));
+
 //------------------------------------------------------------------------------
 // ARM functions
 #if HAVE_MEDIA
@@ -1065,15 +1256,47 @@ INSTANTIATE_TEST_CASE_P(SSE2, SADx4Test, ::testing::ValuesIn(x4d_sse2_tests));
 #endif  // HAVE_SSE2
 
 #if HAVE_SSE3
-// Only functions are x3, which do not have tests.
+const SadMxNxKFunc sad16x16x3_sse3 = vpx_sad16x16x3_sse3;
+const SadMxNxKFunc sad16x8x3_sse3 = vpx_sad16x8x3_sse3;
+const SadMxNxKFunc sad8x16x3_sse3 = vpx_sad8x16x3_sse3;
+const SadMxNxKFunc sad8x8x3_sse3 = vpx_sad8x8x3_sse3;
+const SadMxNxKFunc sad4x4x3_sse3 = vpx_sad4x4x3_sse3;
+const SadMxNxKParam xn_sse3_tests[] = {
+  make_tuple(16, 16, sad16x16x3_sse3, 3),
+  make_tuple(16, 8, sad16x8x3_sse3, 3),
+  make_tuple(8, 16, sad8x16x3_sse3, 3),
+  make_tuple(8, 8, sad8x8x3_sse3, 3),
+  make_tuple(4, 4, sad4x4x3_sse3, 3),
+};
+INSTANTIATE_TEST_CASE_P(SSE3, SADxNTest, ::testing::ValuesIn(xn_sse3_tests));
 #endif  // HAVE_SSE3
 
 #if HAVE_SSSE3
-// Only functions are x3, which do not have tests.
+const SadMxNxKFunc sad16x16x3_ssse3 = vpx_sad16x16x3_ssse3;
+const SadMxNxKFunc sad16x8x3_ssse3 = vpx_sad16x8x3_ssse3;
+const SadMxNxKParam xn_ssse3_tests[] = {
+  make_tuple(16, 16, sad16x16x3_ssse3, 3),
+  make_tuple(16, 8, sad16x8x3_ssse3, 3),
+};
+INSTANTIATE_TEST_CASE_P(SSSE3, SADxNTest,
+                        ::testing::ValuesIn(xn_ssse3_tests));
 #endif  // HAVE_SSSE3
 
 #if HAVE_SSE4_1
-// Only functions are x8, which do not have tests.
+const SadMxNxKFunc sad16x16x8_sse4_1 = vpx_sad16x16x8_sse4_1;
+const SadMxNxKFunc sad16x8x8_sse4_1 = vpx_sad16x8x8_sse4_1;
+const SadMxNxKFunc sad8x16x8_sse4_1 = vpx_sad8x16x8_sse4_1;
+const SadMxNxKFunc sad8x8x8_sse4_1 = vpx_sad8x8x8_sse4_1;
+const SadMxNxKFunc sad4x4x8_sse4_1 = vpx_sad4x4x8_sse4_1;
+const SadMxNxKParam xn_sse4_1_tests[] = {
+  make_tuple(16, 16, sad16x16x8_sse4_1, 8),
+  make_tuple(16, 8, sad16x8x8_sse4_1, 8),
+  make_tuple(8, 16, sad8x16x8_sse4_1, 8),
+  make_tuple(8, 8, sad8x8x8_sse4_1, 8),
+  make_tuple(4, 4, sad4x4x8_sse4_1, 8),
+};
+INSTANTIATE_TEST_CASE_P(SSE4_1, SADxNTest,
+                        ::testing::ValuesIn(xn_sse4_1_tests));
 #endif  // HAVE_SSE4_1
 
 #if HAVE_AVX2
@@ -1082,12 +1305,54 @@ const SadMxNFunc sad64x32_avx2 = vpx_sad64x32_avx2;
 const SadMxNFunc sad32x64_avx2 = vpx_sad32x64_avx2;
 const SadMxNFunc sad32x32_avx2 = vpx_sad32x32_avx2;
 const SadMxNFunc sad32x16_avx2 = vpx_sad32x16_avx2;
+const SadMxNFunc sad16x32_avx2 = vpx_sad16x32_avx2;
+const SadMxNFunc sad16x16_avx2 = vpx_sad16x16_avx2;
+const SadMxNFunc sad16x8_avx2 = vpx_sad16x8_avx2;
+#if CONFIG_VP9_HIGHBITDEPTH
+const SadMxNFunc highbd_sad64x64_avx2 = vpx_highbd_sad64x64_avx2;
+const SadMxNFunc highbd_sad64x32_avx2 = vpx_highbd_sad64x32_avx2;
+const SadMxNFunc highbd_sad32x64_avx2 = vpx_highbd_sad32x64_avx2;
+const SadMxNFunc highbd_sad32x32_avx2 = vpx_highbd_sad32x32_avx2;
+const SadMxNFunc highbd_sad32x16_avx2 = vpx_highbd_sad32x16_avx2;
+const SadMxNFunc highbd_sad16x32_avx2 = vpx_highbd_sad16x32_avx2;
+const SadMxNFunc highbd_sad16x16_avx2 = vpx_highbd_sad16x16_avx2;
+const SadMxNFunc highbd_sad16x8_avx2 = vpx_highbd_sad16x8_avx2;
+#endif  // CONFIG_VP9_HIGHBITDEPTH
 const SadMxNParam avx2_tests[] = {
   make_tuple(64, 64, sad64x64_avx2, -1),
   make_tuple(64, 32, sad64x32_avx2, -1),
   make_tuple(32, 64, sad32x64_avx2, -1),
   make_tuple(32, 32, sad32x32_avx2, -1),
   make_tuple(32, 16, sad32x16_avx2, -1),
+  make_tuple(16, 32, sad16x32_avx2, -1),
+  make_tuple(16, 16, sad16x16_avx2, -1),
+  make_tuple(16, 8, sad16x8_avx2, -1),
+#if CONFIG_VP9_HIGHBITDEPTH
+  make_tuple(64, 64, highbd_sad64x64_avx2, 8),
+  make_tuple(64, 32, highbd_sad64x32_avx2, 8),
+  make_tuple(32, 64, highbd_sad32x64_avx2, 8),
+  make_tuple(32, 32, highbd_sad32x32_avx2, 8),
+  make_tuple(32, 16, highbd_sad32x16_avx2, 8),
+  make_tuple(16, 32, highbd_sad16x32_avx2, 8),
+  make_tuple(16, 16, highbd_sad16x16_avx2, 8),
+  make_tuple(16, 8, highbd_sad16x8_avx2, 8),
+  make_tuple(64, 64, highbd_sad64x64_avx2, 10),
+  make_tuple(64, 32, highbd_sad64x32_avx2, 10),
+  make_tuple(32, 64, highbd_sad32x64_avx2, 10),
+  make_tuple(32, 32, highbd_sad32x32_avx2, 10),
+  make_tuple(32, 16, highbd_sad32x16_avx2, 10),
+  make_tuple(16, 32, highbd_sad16x32_avx2, 10),
+  make_tuple(16, 16, highbd_sad16x16_avx2, 10),
+  make_tuple(16, 8, highbd_sad16x8_avx2, 10),
+  make_tuple(64, 64, highbd_sad64x64_avx2, 12),
+  make_tuple(64, 32, highbd_sad64x32_avx2, 12),
+  make_tuple(32, 64, highbd_sad32x64_avx2, 12),
+  make_tuple(32, 32, highbd_sad32x32_avx2, 12),
+  make_tuple(32, 16, highbd_sad32x16_avx2, 12),
+  make_tuple(16, 32, highbd_sad16x32_avx2, 12),
+  make_tuple(16, 16, highbd_sad16x16_avx2, 12),
+  make_tuple(16, 8, highbd_sad16x8_avx2, 12),
+#endif  // CONFIG_VP9_HIGHBITDEPTH
 };
 INSTANTIATE_TEST_CASE_P(AVX2, SADTest, ::testing::ValuesIn(avx2_tests));
 
@@ -1096,22 +1361,124 @@ const SadMxNAvgFunc sad64x32_avg_avx2 = vpx_sad64x32_avg_avx2;
 const SadMxNAvgFunc sad32x64_avg_avx2 = vpx_sad32x64_avg_avx2;
 const SadMxNAvgFunc sad32x32_avg_avx2 = vpx_sad32x32_avg_avx2;
 const SadMxNAvgFunc sad32x16_avg_avx2 = vpx_sad32x16_avg_avx2;
+const SadMxNAvgFunc sad16x32_avg_avx2 = vpx_sad16x32_avg_avx2;
+const SadMxNAvgFunc sad16x16_avg_avx2 = vpx_sad16x16_avg_avx2;
+const SadMxNAvgFunc sad16x8_avg_avx2 = vpx_sad16x8_avg_avx2;
+#if CONFIG_VP9_HIGHBITDEPTH
+const SadMxNAvgFunc highbd_sad64x64_avg_avx2 = vpx_highbd_sad64x64_avg_avx2;
+const SadMxNAvgFunc highbd_sad64x32_avg_avx2 = vpx_highbd_sad64x32_avg_avx2;
+const SadMxNAvgFunc highbd_sad32x64_avg_avx2 = vpx_highbd_sad32x64_avg_avx2;
+const SadMxNAvgFunc highbd_sad32x32_avg_avx2 = vpx_highbd_sad32x32_avg_avx2;
+const SadMxNAvgFunc highbd_sad32x16_avg_avx2 = vpx_highbd_sad32x16_avg_avx2;
+const SadMxNAvgFunc highbd_sad16x32_avg_avx2 = vpx_highbd_sad16x32_avg_avx2;
+const SadMxNAvgFunc highbd_sad16x16_avg_avx2 = vpx_highbd_sad16x16_avg_avx2;
+const SadMxNAvgFunc highbd_sad16x8_avg_avx2 = vpx_highbd_sad16x8_avg_avx2;
+#endif  // CONFIG_VP9_HIGHBITDEPTH
 const SadMxNAvgParam avg_avx2_tests[] = {
   make_tuple(64, 64, sad64x64_avg_avx2, -1),
   make_tuple(64, 32, sad64x32_avg_avx2, -1),
   make_tuple(32, 64, sad32x64_avg_avx2, -1),
   make_tuple(32, 32, sad32x32_avg_avx2, -1),
   make_tuple(32, 16, sad32x16_avg_avx2, -1),
+  make_tuple(16, 32, sad16x32_avg_avx2, -1),
+  make_tuple(16, 16, sad16x16_avg_avx2, -1),
+  make_tuple(16, 8, sad16x8_avg_avx2, -1),
+#if CONFIG_VP9_HIGHBITDEPTH
+  make_tuple(64, 64, highbd_sad64x64_avg_avx2, 8),
+  make_tuple(64, 32, highbd_sad64x32_avg_avx2, 8),
+  make_tuple(32, 64, highbd_sad32x64_avg_avx2, 8),
+  make_tuple(32, 32, highbd_sad32x32_avg_avx2, 8),
+  make_tuple(32, 16, highbd_sad32x16_avg_avx2, 8),
+  make_tuple(16, 32, highbd_sad16x32_avg_avx2, 8),
+  make_tuple(16, 16, highbd_sad16x16_avg_avx2, 8),
+  make_tuple(16, 8, highbd_sad16x8_avg_avx2, 8),
+  make_tuple(64, 64, highbd_sad64x64_avg_avx2, 10),
+  make_tuple(64, 32, highbd_sad64x32_avg_avx2, 10),
+  make_tuple(32, 64, highbd_sad32x64_avg_avx2, 10),
+  make_tuple(32, 32, highbd_sad32x32_avg_avx2, 10),
+  make_tuple(32, 16, highbd_sad32x16_avg_avx2, 10),
+  make_tuple(16, 32, highbd_sad16x32_avg_avx2, 10),
+  make_tuple(16, 16, highbd_sad16x16_avg_avx2, 10),
+  make_tuple(16, 8, highbd_sad16x8_avg_avx2, 10),
+  make_tuple(64, 64, highbd_sad64x64_avg_avx2, 12),
+  make_tuple(64, 32, highbd_sad64x32_avg_avx2, 12),
+  make_tuple(32, 64, highbd_sad32x64_avg_avx2, 12),
+  make_tuple(32, 32, highbd_sad32x32_avg_avx2, 12),
+  make_tuple(32, 16, highbd_sad32x16_avg_avx2, 12),
+  make_tuple(16, 32, highbd_sad16x32_avg_avx2, 12),
+  make_tuple(16, 16, highbd_sad16x16_avg_avx2, 12),
+  make_tuple(16, 8, highbd_sad16x8_avg_avx2, 12),
+#endif  // CONFIG_VP9_HIGHBITDEPTH
 };
 INSTANTIATE_TEST_CASE_P(AVX2, SADavgTest, ::testing::ValuesIn(avg_avx2_tests));
 
 const SadMxNx4Func sad64x64x4d_avx2 = vpx_sad64x64x4d_avx2;
+const SadMxNx4Func sad64x32x4d_avx2 = vpx_sad64x32x4d_avx2;
+const SadMxNx4Func sad32x64x4d_avx2 = vpx_sad32x64x4d_avx2;
 const SadMxNx4Func sad32x32x4d_avx2 = vpx_sad32x32x4d_avx2;
+const SadMxNx4Func sad32x16x4d_avx2 = vpx_sad32x16x4d_avx2;
+const SadMxNx4Func sad16x32x4d_avx2 = vpx_sad16x32x4d_avx2;
+const SadMxNx4Func sad16x16x4d_avx2 = vpx_sad16x16x4d_avx2;
+const SadMxNx4Func sad16x8x4d_avx2 = vpx_sad16x8x4d_avx2;
+#if CONFIG_VP9_HIGHBITDEPTH
+const SadMxNx4Func highbd_sad64x64x4d_avx2 = vpx_highbd_sad64x64x4d_avx2;
+const SadMxNx4Func highbd_sad64x32x4d_avx2 = vpx_highbd_sad64x32x4d_avx2;
+const SadMxNx4Func highbd_sad32x64x4d_avx2 = vpx_highbd_sad32x64x4d_avx2;
+const SadMxNx4Func highbd_sad32x32x4d_avx2 = vpx_highbd_sad32x32x4d_avx2;
+const SadMxNx4Func highbd_sad32x16x4d_avx2 = vpx_highbd_sad32x16x4d_avx2;
+const SadMxNx4Func highbd_sad16x32x4d_avx2 = vpx_highbd_sad16x32x4d_avx2;
+const SadMxNx4Func highbd_sad16x16x4d_avx2 = vpx_highbd_sad16x16x4d_avx2;
+const SadMxNx4Func highbd_sad16x8x4d_avx2 = vpx_highbd_sad16x8x4d_avx2;
+#endif  // CONFIG_VP9_HIGHBITDEPTH
 const SadMxNx4Param x4d_avx2_tests[] = {
   make_tuple(64, 64, sad64x64x4d_avx2, -1),
+  make_tuple(64, 32, sad64x32x4d_avx2, -1),
+  make_tuple(32, 64, sad32x64x4d_avx2, -1),
   make_tuple(32, 32, sad32x32x4d_avx2, -1),
+  make_tuple(32, 16, sad32x16x4d_avx2, -1),
+  make_tuple(16, 32, sad16x32x4d_avx2, -1),
+  make_tuple(16, 16, sad16x16x4d_avx2, -1),
+  make_tuple(16, 8, sad16x8x4d_avx2, -1),
+#if CONFIG_VP9_HIGHBITDEPTH
+  make_tuple(64, 64, highbd_sad64x64x4d_avx2, 8),
+  make_tuple(64, 32, highbd_sad64x32x4d_avx2, 8),
+  make_tuple(32, 64, highbd_sad32x64x4d_avx2, 8),
+  make_tuple(32, 32, highbd_sad32x32x4d_avx2, 8),
+  make_tuple(32, 16, highbd_sad32x16x4d_avx2, 8),
+  make_tuple(16, 32, highbd_sad16x32x4d_avx2, 8),
+  make_tuple(16, 16, highbd_sad16x16x4d_avx2, 8),
+  make_tuple(16, 8, highbd_sad16x8x4d_avx2, 8),
+  make_tuple(64, 64, highbd_sad64x64x4d_avx2, 10),
+  make_tuple(64, 32, highbd_sad64x32x4d_avx2, 10),
+  make_tuple(32, 64, highbd_sad32x64x4d_avx2, 10),
+  make_tuple(32, 32, highbd_sad32x32x4d_avx2, 10),
+  make_tuple(32, 16, highbd_sad32x16x4d_avx2, 10),
+  make_tuple(16, 32, highbd_sad16x32x4d_avx2, 10),
+  make_tuple(16, 16, highbd_sad16x16x4d_avx2, 10),
+  make_tuple(16, 8, highbd_sad16x8x4d_avx2, 10),
+  make_tuple(64, 64, highbd_sad64x64x4d_avx2, 12),
+  make_tuple(64, 32, highbd_sad64x32x4d_avx2, 12),
+  make_tuple(32, 64, highbd_sad32x64x4d_avx2, 12),
+  make_tuple(32, 32, highbd_sad32x32x4d_avx2, 12),
+  make_tuple(32, 16, highbd_sad32x16x4d_avx2, 12),
+  make_tuple(16, 32, highbd_sad16x32x4d_avx2, 12),
+  make_tuple(16, 16, highbd_sad16x16x4d_avx2, 12),
+  make_tuple(16, 8, highbd_sad16x8x4d_avx2, 12),
+#endif  // CONFIG_VP9_HIGHBITDEPTH
 };
 INSTANTIATE_TEST_CASE_P(AVX2, SADx4Test, ::testing::ValuesIn(x4d_avx2_tests));
+
+const SadMxNxKFunc sad16x16x3_avx2 = vpx_sad16x16x3_avx2;
+const SadMxNxKFunc sad16x8x3_avx2 = vpx_sad16x8x3_avx2;
+const SadMxNxKFunc sad16x16x8_avx2 = vpx_sad16x16x8_avx2;
+const SadMxNxKFunc sad16x8x8_avx2 = vpx_sad16x8x8_avx2;
+const SadMxNxKParam xn_avx2_tests[] = {
+  make_tuple(16, 16, sad16x16x3_avx2, 3),
+  make_tuple(16, 8, sad16x8x3_avx2, 3),
+  make_tuple(16, 16, sad16x16x8_avx2, 8),
+  make_tuple(16, 8, sad16x8x8_avx2, 8),
+};
+INSTANTIATE_TEST_CASE_P(AVX2, SADxNTest, ::testing::ValuesIn(xn_avx2_tests));
 #endif  // HAVE_AVX2
 
 }  // namespace
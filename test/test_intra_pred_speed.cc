@@ -194,8 +194,9 @@ INTRA_PRED_TEST(SSE, TestIntraPred4, vp9_dc_predictor_4x4_sse,
 
 #if HAVE_SSSE3
 INTRA_PRED_TEST(SSSE3, TestIntraPred4, NULL, NULL, NULL, NULL, NULL,
-                vp9_h_predictor_4x4_ssse3, vp9_d45_predictor_4x4_ssse3, NULL,
-                NULL, vp9_d153_predictor_4x4_ssse3,
+                vp9_h_predictor_4x4_ssse3, vp9_d45_predictor_4x4_ssse3,
+                vp9_d135_predictor_4x4_ssse3, vp9_d117_predictor_4x4_ssse3,
+                vp9_d153_predictor_4x4_ssse3,
                 vp9_d207_predictor_4x4_ssse3, vp9_d63_predictor_4x4_ssse3, NULL)
 #endif  // HAVE_SSSE3
 
@@ -236,8 +237,9 @@ INTRA_PRED_TEST(SSE2, TestIntraPred8, NULL, NULL, NULL, NULL, NULL, NULL, NULL,
 
 #if HAVE_SSSE3
 INTRA_PRED_TEST(SSSE3, TestIntraPred8, NULL, NULL, NULL, NULL, NULL,
-                vp9_h_predictor_8x8_ssse3, vp9_d45_predictor_8x8_ssse3, NULL,
-                NULL, vp9_d153_predictor_8x8_ssse3,
+                vp9_h_predictor_8x8_ssse3, vp9_d45_predictor_8x8_ssse3,
+                vp9_d135_predictor_8x8_ssse3, vp9_d117_predictor_8x8_ssse3,
+                vp9_d153_predictor_8x8_ssse3,
                 vp9_d207_predictor_8x8_ssse3, vp9_d63_predictor_8x8_ssse3, NULL)
 #endif  // HAVE_SSSE3
 
@@ -279,7 +281,8 @@ INTRA_PRED_TEST(SSE2, TestIntraPred16, vp9_dc_predictor_16x16_sse2,
 #if HAVE_SSSE3
 INTRA_PRED_TEST(SSSE3, TestIntraPred16, NULL, NULL, NULL, NULL, NULL,
                 vp9_h_predictor_16x16_ssse3, vp9_d45_predictor_16x16_ssse3,
-                NULL, NULL, vp9_d153_predictor_16x16_ssse3,
+                vp9_d135_predictor_16x16_ssse3, vp9_d117_predictor_16x16_ssse3,
+                vp9_d153_predictor_16x16_ssse3,
                 vp9_d207_predictor_16x16_ssse3, vp9_d63_predictor_16x16_ssse3,
                 NULL)
 #endif  // HAVE_SSSE3
@@ -327,14 +330,261 @@ INTRA_PRED_TEST(SSE2, TestIntraPred32, vp9_dc_predictor_32x32_sse2,
 #if HAVE_SSSE3
 INTRA_PRED_TEST(SSSE3, TestIntraPred32, NULL, NULL, NULL, NULL, NULL,
                 vp9_h_predictor_32x32_ssse3, vp9_d45_predictor_32x32_ssse3,
-                NULL, NULL, NULL, vp9_d207_predictor_32x32_ssse3,
+                vp9_d135_predictor_32x32_ssse3, vp9_d117_predictor_32x32_ssse3,
+                vp9_d153_predictor_32x32_ssse3, vp9_d207_predictor_32x32_ssse3,
                 vp9_d63_predictor_32x32_ssse3, NULL)
 #endif  // HAVE_SSSE3
 
+#if HAVE_AVX2
+INTRA_PRED_TEST(AVX2, TestIntraPred32, NULL, NULL, NULL, NULL, NULL, NULL,
+                NULL, vp9_d135_predictor_32x32_avx2,
+                vp9_d117_predictor_32x32_avx2, vp9_d153_predictor_32x32_avx2,
+                NULL, NULL, NULL)
+#endif  // HAVE_AVX2
+
 #if HAVE_NEON
 INTRA_PRED_TEST(NEON, TestIntraPred32, NULL, NULL, NULL, NULL,
                 vp9_v_predictor_32x32_neon, vp9_h_predictor_32x32_neon, NULL,
                 NULL, NULL, NULL, NULL, NULL, vp9_tm_predictor_32x32_neon)
 #endif  // HAVE_NEON
 
+// -----------------------------------------------------------------------------
+// High bitdepth
+
+#if CONFIG_VP9_HIGHBITDEPTH
+namespace {
+
+typedef void (*VpxHighbdPredFunc)(uint16_t *dst, ptrdiff_t y_stride,
+                                  const uint16_t *above, const uint16_t *left,
+                                  int bd);
+
+void TestHighbdIntraPred(const char name[],
+                         VpxHighbdPredFunc const *pred_funcs,
+                         const char *const pred_func_names[], int num_funcs,
+                         const char *const signatures[], int block_size,
+                         int num_pixels_per_test) {
+  libvpx_test::ACMRandom rnd(libvpx_test::ACMRandom::DeterministicSeed());
+  const int kBitDepth = 10;
+  const int kMask = (1 << kBitDepth) - 1;
+  const int kBPS = 32;
+  const int kTotalPixels = 32 * kBPS;
+  DECLARE_ALIGNED(16, uint16_t, src[kTotalPixels]);
+  DECLARE_ALIGNED(16, uint16_t, ref_src[kTotalPixels]);
+  DECLARE_ALIGNED(16, uint16_t, left[kBPS]);
+  DECLARE_ALIGNED(16, uint16_t, above_mem[2 * kBPS + 16]);
+  uint16_t *const above = above_mem + 16;
+  for (int i = 0; i < kTotalPixels; ++i) ref_src[i] = rnd.Rand16() & kMask;
+  for (int i = 0; i < kBPS; ++i) left[i] = rnd.Rand16() & kMask;
+  for (int i = -1; i < kBPS; ++i) above[i] = rnd.Rand16() & kMask;
+  const int kNumTests = static_cast<int>(2.e10 / num_pixels_per_test);
+
+  ASSERT_LE(block_size, kBPS);
+  for (int i = block_size; i < 2 * kBPS; ++i) above[i] = above[block_size - 1];
+
+  for (int k = 0; k < num_funcs; ++k) {
+    if (pred_funcs[k] == NULL) continue;
+    memcpy(src, ref_src, sizeof(src));
+    vpx_usec_timer timer;
+    vpx_usec_timer_start(&timer);
+    for (int num_tests = 0; num_tests < kNumTests; ++num_tests) {
+      pred_funcs[k](src, kBPS, above, left, kBitDepth);
+    }
+    vpx_usec_timer_mark(&timer);
+    const int elapsed_time =
+        static_cast<int>(vpx_usec_timer_elapsed(&timer) / 1000);
+    libvpx_test::MD5 md5;
+    md5.Add(reinterpret_cast<const uint8_t *>(src), sizeof(src));
+    printf("Mode %s[%12s]: %5d ms     MD5: %s\n", name, pred_func_names[k],
+           elapsed_time, md5.Get());
+    EXPECT_STREQ(signatures[k], md5.Get());
+  }
+}
+
+void TestHighbdIntraPred4(VpxHighbdPredFunc const *pred_funcs) {
+  static const int kNumVp9IntraFuncs = 13;
+  static const char *const kSignatures[kNumVp9IntraFuncs] = {
+    "2d3fac831f351da1c76d40f0c5de4b62",
+    "1d7b8a2b43f57e78fefde1f9fbe39db6",
+    "e0878140c01edf8024343377344f987c",
+    "72011fe34d5bf1ff0f8a56e0f77a18f9",
+    "2a2bf14f67b66b91353fe22eb105c45f",
+    "bbcaef5665f386e0a8baab3aff2787c6",
+    "73685747ed4094c6abb0859feb21d5ca",
+    "48c16a5d6eff1de402138323dcd08c20",
+    "bc1c090dac0a0011421ffcc22beacbdd",
+    "7e33b373b3abbde247549d46ce184a16",
+    "06736bca5ae6ba5327f11b0959e61122",
+    "e52acbccff6ace1c756161c9bf5defdd",
+    "ac63b36020c3fc28bab4f953ed46ad91",
+  };
+  TestHighbdIntraPred("Highbd4", pred_funcs, kVp9IntraPredNames,
+                      kNumVp9IntraFuncs, kSignatures, 4,
+                      4 * 4 * kNumVp9IntraFuncs);
+}
+
+void TestHighbdIntraPred8(VpxHighbdPredFunc const *pred_funcs) {
+  static const int kNumVp9IntraFuncs = 13;
+  static const char *const kSignatures[kNumVp9IntraFuncs] = {
+    "d2b90319d6bbe5cadc7e4502db74dda3",
+    "0a8e2096de6f2095f72bf6602f7045ae",
+    "e11c7372fd8b3f88466308930d71e977",
+    "93436a73a212d42f06f1ee05dde302f7",
+    "265331d7c9541fd84be2134aa19ff7c8",
+    "a6eded2b58be52f02e40360aebf319b1",
+    "cebadefebd00427c6f9d9c7b946d95a7",
+    "7aee70069aa87a82319d486636ea1ff9",
+    "f27e370d14ecec1bedefa145a04a6ae2",
+    "e194d9abce04ed3fa1067517b30cd998",
+    "ccf665aa0a5fc88f388be6c5a058f6ab",
+    "47bafef089bac4d417923215f012d3ff",
+    "ba3f1317ecf25acafe825c7206369df0",
+  };
+  TestHighbdIntraPred("Highbd8", pred_funcs, kVp9IntraPredNames,
+                      kNumVp9IntraFuncs, kSignatures, 8,
+                      8 * 8 * kNumVp9IntraFuncs);
+}
+
+void TestHighbdIntraPred16(VpxHighbdPredFunc const *pred_funcs) {
+  static const int kNumVp9IntraFuncs = 13;
+  static const char *const kSignatures[kNumVp9IntraFuncs] = {
+    "1ea385324508938136f0d6f9c955a3ba",
+    "86d064389af1545bf2c602277bd8b830",
+    "87c89fa931d18f50347017a122d1127f",
+    "79102ce74c0c0d3ce5cb707ab07a2a61",
+    "ac5972000ff5417800d5eed30d024a5f",
+    "ca6808f8b1b9eccd264f276857d67881",
+    "7c72a13843703fca6f3cdfcc9668b987",
+    "45898933696da2f03dc1f5ead64c830e",
+    "6b93d86e1d1d27bed2cae3e5be26a065",
+    "eb35663e99cd8f563effd31e51cd1d0c",
+    "19faccbcaa98a660754f99f8c94bcfc1",
+    "952f0a5c8ffacfc7af24dd7153e5a665",
+    "6ab6fc73c9d1a403eb0d19742f194df1",
+  };
+  TestHighbdIntraPred("Highbd16", pred_funcs, kVp9IntraPredNames,
+                      kNumVp9IntraFuncs, kSignatures, 16,
+                      16 * 16 * kNumVp9IntraFuncs);
+}
+
+void TestHighbdIntraPred32(VpxHighbdPredFunc const *pred_funcs) {
+  static const int kNumVp9IntraFuncs = 13;
+  static const char *const kSignatures[kNumVp9IntraFuncs] = {
+    "6917f600ca27131b31496767237a1c59",
+    "8978a657b8526d6ef48750761ff85f1c",
+    "80dd44c586b19ff339d536421874b6d1",
+    "6cd1b84e01bb7cd74e30c89f41099dcd",
+    "46e580eee9f61abb252e9dec5c3fd771",
+    "03837ac55ede95caeb656bbe1d2260d6",
+    "f9a45473947dba45c96b416b2bffac6c",
+    "9d76598298b06955e1371dd808c7a7f0",
+    "b1dabd62b23912be6d007b3b6800802f",
+    "356d3bdaa9a4822dfe7a35ea10def829",
+    "7614d455c0a340b72dbe74c503a06c54",
+    "aa649070f8ba89cad58968fcde905d7c",
+    "296f5fe0fcd09bf9f7c442cf301a3a6a",
+  };
+  TestHighbdIntraPred("Highbd32", pred_funcs, kVp9IntraPredNames,
+                      kNumVp9IntraFuncs, kSignatures, 32,
+                      32 * 32 * kNumVp9IntraFuncs);
+}
+
+}  // namespace
+
+#define HIGHBD_INTRA_PRED_TEST(arch, test_func, dc, dc_left, dc_top, dc_128, \
+                               v, h, d45, d135, d117, d153, d207, d63, tm)   \
+  TEST(arch, test_func) {                                                    \
+    static const VpxHighbdPredFunc vp9_intra_pred[] = {                      \
+        dc,   dc_left, dc_top, dc_128, v,   h, d45,                          \
+        d135, d117,    d153,   d207,   d63, tm};                             \
+    test_func(vp9_intra_pred);                                               \
+  }
+
+HIGHBD_INTRA_PRED_TEST(C, TestHighbdIntraPred4, vp9_highbd_dc_predictor_4x4_c,
+                       vp9_highbd_dc_left_predictor_4x4_c,
+                       vp9_highbd_dc_top_predictor_4x4_c,
+                       vp9_highbd_dc_128_predictor_4x4_c,
+                       vp9_highbd_v_predictor_4x4_c,
+                       vp9_highbd_h_predictor_4x4_c,
+                       vp9_highbd_d45_predictor_4x4_c,
+                       vp9_highbd_d135_predictor_4x4_c,
+                       vp9_highbd_d117_predictor_4x4_c,
+                       vp9_highbd_d153_predictor_4x4_c,
+                       vp9_highbd_d207_predictor_4x4_c,
+                       vp9_highbd_d63_predictor_4x4_c,
+                       vp9_highbd_tm_predictor_4x4_c)
+
+#if HAVE_SSSE3
+HIGHBD_INTRA_PRED_TEST(SSSE3, TestHighbdIntraPred4, NULL, NULL, NULL, NULL,
+                       NULL, NULL, NULL, vp9_highbd_d135_predictor_4x4_ssse3,
+                       vp9_highbd_d117_predictor_4x4_ssse3,
+                       vp9_highbd_d153_predictor_4x4_ssse3, NULL, NULL, NULL)
+#endif  // HAVE_SSSE3
+
+HIGHBD_INTRA_PRED_TEST(C, TestHighbdIntraPred8, vp9_highbd_dc_predictor_8x8_c,
+                       vp9_highbd_dc_left_predictor_8x8_c,
+                       vp9_highbd_dc_top_predictor_8x8_c,
+                       vp9_highbd_dc_128_predictor_8x8_c,
+                       vp9_highbd_v_predictor_8x8_c,
+                       vp9_highbd_h_predictor_8x8_c,
+                       vp9_highbd_d45_predictor_8x8_c,
+                       vp9_highbd_d135_predictor_8x8_c,
+                       vp9_highbd_d117_predictor_8x8_c,
+                       vp9_highbd_d153_predictor_8x8_c,
+                       vp9_highbd_d207_predictor_8x8_c,
+                       vp9_highbd_d63_predictor_8x8_c,
+                       vp9_highbd_tm_predictor_8x8_c)
+
+#if HAVE_SSSE3
+HIGHBD_INTRA_PRED_TEST(SSSE3, TestHighbdIntraPred8, NULL, NULL, NULL, NULL,
+                       NULL, NULL, NULL, vp9_highbd_d135_predictor_8x8_ssse3,
+                       vp9_highbd_d117_predictor_8x8_ssse3,
+                       vp9_highbd_d153_predictor_8x8_ssse3, NULL, NULL, NULL)
+#endif  // HAVE_SSSE3
+
+HIGHBD_INTRA_PRED_TEST(C, TestHighbdIntraPred16,
+                       vp9_highbd_dc_predictor_16x16_c,
+                       vp9_highbd_dc_left_predictor_16x16_c,
+                       vp9_highbd_dc_top_predictor_16x16_c,
+                       vp9_highbd_dc_128_predictor_16x16_c,
+                       vp9_highbd_v_predictor_16x16_c,
+                       vp9_highbd_h_predictor_16x16_c,
+                       vp9_highbd_d45_predictor_16x16_c,
+                       vp9_highbd_d135_predictor_16x16_c,
+                       vp9_highbd_d117_predictor_16x16_c,
+                       vp9_highbd_d153_predictor_16x16_c,
+                       vp9_highbd_d207_predictor_16x16_c,
+                       vp9_highbd_d63_predictor_16x16_c,
+                       vp9_highbd_tm_predictor_16x16_c)
+
+#if HAVE_SSSE3
+HIGHBD_INTRA_PRED_TEST(SSSE3, TestHighbdIntraPred16, NULL, NULL, NULL, NULL,
+                       NULL, NULL, NULL, vp9_highbd_d135_predictor_16x16_ssse3,
+                       vp9_highbd_d117_predictor_16x16_ssse3,
+                       vp9_highbd_d153_predictor_16x16_ssse3, NULL, NULL, NULL)
+#endif  // HAVE_SSSE3
+
+HIGHBD_INTRA_PRED_TEST(C, TestHighbdIntraPred32,
+                       vp9_highbd_dc_predictor_32x32_c,
+                       vp9_highbd_dc_left_predictor_32x32_c,
+                       vp9_highbd_dc_top_predictor_32x32_c,
+                       vp9_highbd_dc_128_predictor_32x32_c,
+                       vp9_highbd_v_predictor_32x32_c,
+                       vp9_highbd_h_predictor_32x32_c,
+                       vp9_highbd_d45_predictor_32x32_c,
+                       vp9_highbd_d135_predictor_32x32_c,
+                       vp9_highbd_d117_predictor_32x32_c,
+                       vp9_highbd_d153_predictor_32x32_c,
+                       vp9_highbd_d207_predictor_32x32_c,
+                       vp9_highbd_d63_predictor_32x32_c,
+                       vp9_highbd_tm_predictor_32x32_c)
+
+#if HAVE_SSSE3
+HIGHBD_INTRA_PRED_TEST(SSSE3, TestHighbdIntraPred32, NULL, NULL, NULL, NULL,
+                       NULL, NULL, NULL, vp9_highbd_d135_predictor_32x32_ssse3,
+                       vp9_highbd_d117_predictor_32x32_ssse3,
+                       vp9_highbd_d153_predictor_32x32_ssse3, NULL, NULL, NULL)
+#endif  // HAVE_SSSE3
+
+#endif  // CONFIG_VP9_HIGHBITDEPTH
+
 #include "test/test_libvpx.cc"
@@ -0,0 +1,266 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+//  Time every RTCD function variant the cpu supports.
+//
+//  The call wrappers are generated from the rtcd definitions by
+//  'rtcd.pl --bench', which synthesizes each argument from its type and name
+//  (see build/make/rtcd.pl). Results are written to stdout as CSV:
+//
+//    kernel,isa,status,ns_per_call,speedup_vs_c
+//
+//  where status is "ok", "unavailable" (the cpu lacks the extension) or
+//  "unsupported" (the arguments could not be synthesized). An optional
+//  argument restricts the run to kernels whose name contains it. The
+//  VPX_SIMD_CAPS environment variable masks extensions as usual on x86.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "./vpx_config.h"
+#include "./vpx_dsp_rtcd.h"
+#include "./vpx_scale_rtcd.h"
+#if CONFIG_VP8
+#include "./vp8_rtcd.h"
+#endif
+#if CONFIG_VP9
+#include "./vp9_rtcd.h"
+#endif
+#include "vpx/vpx_integer.h"
+#include "vpx_mem/vpx_mem.h"
+#include "vpx_ports/mem.h"
+#include "vpx_ports/vpx_timer.h"
+#if ARCH_X86 || ARCH_X86_64
+#include "vpx_ports/x86.h"
+#elif ARCH_ARM
+#include "vpx_ports/arm.h"
+#endif
+
+namespace {
+
+#if !CONFIG_VP9
+// Only the vp9 functions take transform coefficients of this type.
+typedef int16_t tran_low_t;
+#endif
+
+// Pixel buffers hold 64x64 blocks with room for filter taps and edges on
+// every side; the block starts kBenchOffset pixels in.
+#define RTCD_BENCH_STRIDE 256
+const int kBenchRows = 160;
+const int kBenchOffset = 32 * RTCD_BENCH_STRIDE + 32;
+const int kBenchPixels = kBenchRows * RTCD_BENCH_STRIDE;
+const int kBenchCoeffs = 64 * RTCD_BENCH_STRIDE;
+const int kBenchBuffers = 6;
+const int kBenchBitDepth = 10;
+
+// Minimum duration of one timed run, and the number of runs to keep the
+// fastest of.
+const int64_t kMinRunUs = 2000;
+const int kRuns = 3;
+
+// An 8-tap kernel table aligned the way the convolve functions expect, so
+// the filter offset recovered from the pointer is valid. Only the half-pel
+// row is used with unscaled steps.
+DECLARE_ALIGNED(256, const int16_t, kBenchFilters[16][8]) = {
+  { 0, 0, 0, 128, 0, 0, 0, 0 }, { 0 }, { 0 }, { 0 }, { 0 }, { 0 }, { 0 }, { 0 },
+  { -1, 6, -19, 78, 78, -19, 6, -1 }, { 0 }, { 0 }, { 0 }, { 0 }, { 0 },
+  { 0 }, { 0 }
+};
+
+struct RtcdBenchArgs {
+  uint8_t *pix8[kBenchBuffers];
+  uint16_t *pix16[kBenchBuffers];
+  const uint8_t *refs[4];
+  const uint8_t *refs16[4];
+  int16_t *coeff16[kBenchBuffers];
+  tran_low_t *coeff[kBenchBuffers];
+  int16_t scan[1024];
+  int16_t zbin[16];
+  int16_t round[16];
+  int16_t quant[16];
+  int16_t quant_shift[16];
+  int16_t dequant[16];
+  const int16_t *filter;
+  DECLARE_ALIGNED(16, uint8_t, blimit[64]);
+  DECLARE_ALIGNED(16, uint8_t, limit[64]);
+  DECLARE_ALIGNED(16, uint8_t, thresh[64]);
+  char chars[4096];
+  int64_t out[1024];
+  int bd;
+};
+
+typedef void (*RtcdBenchFunc)(RtcdBenchArgs *args, int n);
+
+struct RtcdBenchKernel {
+  const char *name;
+  const char *isa;
+  int flags;
+  RtcdBenchFunc run;
+};
+
+#include "./vpx_dsp_rtcd_bench.h"
+#include "./vpx_scale_rtcd_bench.h"
+#if CONFIG_VP8
+#include "./vp8_rtcd_bench.h"
+#endif
+#if CONFIG_VP9
+#include "./vp9_rtcd_bench.h"
+#endif
+
+const RtcdBenchKernel *const kBenchTables[] = {
+  vpx_dsp_rtcd_bench,
+  vpx_scale_rtcd_bench,
+#if CONFIG_VP8
+  vp8_rtcd_bench,
+#endif
+#if CONFIG_VP9
+  vp9_rtcd_bench,
+#endif
+};
+
+int CpuFlags() {
+#if ARCH_X86 || ARCH_X86_64
+  return x86_simd_caps();
+#elif ARCH_ARM
+  return arm_cpu_caps();
+#else
+  return 0;
+#endif
+}
+
+// Fills every buffer with the same pseudo-random data, so each variant of a
+// kernel starts from identical inputs even if an earlier one wrote to them.
+void ResetArgs(RtcdBenchArgs *args) {
+  uint32_t seed = 0x12345678;
+  for (int b = 0; b < kBenchBuffers; ++b) {
+    uint8_t *const pix8 = args->pix8[b] - kBenchOffset;
+    uint16_t *const pix16 = args->pix16[b] - kBenchOffset;
+    for (int i = 0; i < kBenchPixels; ++i) {
+      seed = seed * 1103515245 + 12345;
+      pix8[i] = seed >> 24;
+      pix16[i] = (seed >> 16) & ((1 << kBenchBitDepth) - 1);
+    }
+    for (int i = 0; i < kBenchCoeffs; ++i) {
+      seed = seed * 1103515245 + 12345;
+      args->coeff16[b][i] = static_cast<int16_t>((seed >> 25) - 64);
+      args->coeff[b][i] = args->coeff16[b][i];
+    }
+  }
+  memset(args->chars, 0, sizeof(args->chars));
+  memset(args->out, 0, sizeof(args->out));
+}
+
+void InitArgs(RtcdBenchArgs *args) {
+  for (int b = 0; b < kBenchBuffers; ++b) {
+    args->pix8[b] = static_cast<uint8_t *>(vpx_memalign(32, kBenchPixels)) +
+                    kBenchOffset;
+    args->pix16[b] = static_cast<uint16_t *>(vpx_memalign(
+                         32, kBenchPixels * sizeof(uint16_t))) + kBenchOffset;
+    args->coeff16[b] = static_cast<int16_t *>(
+        vpx_memalign(32, kBenchCoeffs * sizeof(int16_t)));
+    args->coeff[b] = static_cast<tran_low_t *>(
+        vpx_memalign(32, kBenchCoeffs * sizeof(tran_low_t)));
+  }
+  for (int i = 0; i < 4; ++i) {
+    args->refs[i] = args->pix8[i + 1];
+#if CONFIG_VP9_HIGHBITDEPTH
+    args->refs16[i] = CONVERT_TO_BYTEPTR(args->pix16[i + 1]);
+#endif
+  }
+  for (int i = 0; i < 1024; ++i)
+    args->scan[i] = i;
+  // Quantizer for a q index in the middle of the range: DC in element 0 and
+  // AC in the rest.
+  for (int i = 0; i < 16; ++i) {
+    const int q = i ? 48 : 40;
+    args->zbin[i] = q * 7 / 10;
+    args->round[i] = q / 2;
+    args->quant[i] = (1 << 16) / q;
+    args->quant_shift[i] = 1 << 14;
+    args->dequant[i] = q;
+  }
+  args->filter = kBenchFilters[8];
+  memset(args->blimit, 40, sizeof(args->blimit));
+  memset(args->limit, 10, sizeof(args->limit));
+  memset(args->thresh, 4, sizeof(args->thresh));
+  args->bd = kBenchBitDepth;
+  ResetArgs(args);
+}
+
+void FreeArgs(RtcdBenchArgs *args) {
+  for (int b = 0; b < kBenchBuffers; ++b) {
+    vpx_free(args->pix8[b] - kBenchOffset);
+    vpx_free(args->pix16[b] - kBenchOffset);
+    vpx_free(args->coeff16[b]);
+    vpx_free(args->coeff[b]);
+  }
+}
+
+int64_t TimeRun(const RtcdBenchKernel &kernel, RtcdBenchArgs *args, int n) {
+  vpx_usec_timer timer;
+  ResetArgs(args);
+  vpx_usec_timer_start(&timer);
+  kernel.run(args, n);
+  vpx_usec_timer_mark(&timer);
+  return vpx_usec_timer_elapsed(&timer);
+}
+
+// Returns the time per call in nanoseconds.
+double TimeKernel(const RtcdBenchKernel &kernel, RtcdBenchArgs *args) {
+  int n = 1;
+  int64_t elapsed;
+  while ((elapsed = TimeRun(kernel, args, n)) < kMinRunUs && n < (1 << 28))
+    n *= 2;
+  for (int run = 1; run < kRuns; ++run) {
+    const int64_t t = TimeRun(kernel, args, n);
+    if (t < elapsed) elapsed = t;
+  }
+  return 1000.0 * elapsed / n;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  const char *const filter = argc > 1 ? argv[1] : NULL;
+  const int flags = CpuFlags();
+  RtcdBenchArgs args;
+
+  vpx_dsp_rtcd();
+  vpx_scale_rtcd();
+#if CONFIG_VP8
+  vp8_rtcd();
+#endif
+#if CONFIG_VP9
+  vp9_rtcd();
+#endif
+  InitArgs(&args);
+
+  printf("kernel,isa,status,ns_per_call,speedup_vs_c\n");
+  for (size_t t = 0; t < sizeof(kBenchTables) / sizeof(kBenchTables[0]); ++t) {
+    double c_ns = 0;
+    for (const RtcdBenchKernel *k = kBenchTables[t]; k->name != NULL; ++k) {
+      if (filter != NULL && strstr(k->name, filter) == NULL) continue;
+      if (k->run == NULL) {
+        printf("%s,%s,unsupported,,\n", k->name, k->isa);
+      } else if ((k->flags & flags) != k->flags) {
+        printf("%s,%s,unavailable,,\n", k->name, k->isa);
+      } else {
+        const double ns = TimeKernel(*k, &args);
+        // The table lists the C variant of each function first.
+        if (!strcmp(k->isa, "c")) c_ns = ns;
+        printf("%s,%s,ok,%.2f,%.2f\n", k->name, k->isa, ns, c_ns / ns);
+      }
+      fflush(stdout);
+    }
+  }
+
+  FreeArgs(&args);
+  return EXIT_SUCCESS;
+}
@@ -27,6 +27,7 @@ class TileIndependenceTest : public ::libvpx_test::EncoderTest,
       : EncoderTest(GET_PARAM(0)),
         md5_fw_order_(),
         md5_inv_order_(),
+        md5_pipelined_lpf_(),
         n_tiles_(GET_PARAM(1)) {
     init_flags_ = VPX_CODEC_USE_PSNR;
     vpx_codec_dec_cfg_t cfg = vpx_codec_dec_cfg_t();
@@ -36,11 +37,15 @@ class TileIndependenceTest : public ::libvpx_test::EncoderTest,
     fw_dec_ = codec_->CreateDecoder(cfg, 0);
     inv_dec_ = codec_->CreateDecoder(cfg, 0);
     inv_dec_->Control(VP9_INVERT_TILE_DECODE_ORDER, 1);
+    cfg.threads = 4;
+    pipelined_lpf_dec_ = codec_->CreateDecoder(cfg, 0);
+    pipelined_lpf_dec_->Control(VP9D_SET_PIPELINED_LOOP_FILTER, 1);
   }
 
   virtual ~TileIndependenceTest() {
     delete fw_dec_;
     delete inv_dec_;
+    delete pipelined_lpf_dec_;
   }
 
   virtual void SetUp() {
@@ -70,10 +75,11 @@ class TileIndependenceTest : public ::libvpx_test::EncoderTest,
   virtual void FramePktHook(const vpx_codec_cx_pkt_t *pkt) {
     UpdateMD5(fw_dec_, pkt, &md5_fw_order_);
     UpdateMD5(inv_dec_, pkt, &md5_inv_order_);
+    UpdateMD5(pipelined_lpf_dec_, pkt, &md5_pipelined_lpf_);
   }
 
-  ::libvpx_test::MD5 md5_fw_order_, md5_inv_order_;
-  ::libvpx_test::Decoder *fw_dec_, *inv_dec_;
+  ::libvpx_test::MD5 md5_fw_order_, md5_inv_order_, md5_pipelined_lpf_;
+  ::libvpx_test::Decoder *fw_dec_, *inv_dec_, *pipelined_lpf_dec_;
 
  private:
   int n_tiles_;
@@ -82,6 +88,8 @@ class TileIndependenceTest : public ::libvpx_test::EncoderTest,
 // run an encode with 2 or 4 tiles, and do the decode both in normal and
 // inverted tile ordering. Ensure that the MD5 of the output in both cases
 // is identical. If so, tiles are considered independent and the test passes.
+// A multi-threaded decode that loopfilters rows while the tiles are still being
+// decoded must match as well.
 TEST_P(TileIndependenceTest, MD5Match) {
   const vpx_rational timebase = { 33333333, 1000000000 };
   cfg_.g_timebase = timebase;
@@ -100,6 +108,7 @@ TEST_P(TileIndependenceTest, MD5Match) {
   // output if it fails. Not sure if it's helpful since it's really just
   // a MD5...
   ASSERT_STREQ(md5_fw_str, md5_inv_str);
+  ASSERT_STREQ(md5_fw_str, md5_pipelined_lpf_.Get());
 }
 
 VP9_INSTANTIATE_TEST_CASE(TileIndependenceTest, ::testing::Range(0, 2, 1));
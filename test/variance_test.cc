@@ -8,6 +8,7 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <cstdio>
 #include <cstdlib>
 #include <new>
 
@@ -21,6 +22,7 @@
 #include "vpx/vpx_integer.h"
 #include "vpx_mem/vpx_mem.h"
 #include "vpx_ports/mem.h"
+#include "vpx_ports/vpx_timer.h"
 #if CONFIG_VP9_ENCODER
 # include "./vp9_rtcd.h"
 # include "vp9/encoder/vp9_variance.h"
@@ -34,6 +36,9 @@ typedef unsigned int (*VarianceMxNFunc)(const uint8_t *a, int a_stride,
                                         unsigned int *sse);
 typedef unsigned int (*Get4x4SseFunc)(const uint8_t *a, int a_stride,
                                       const uint8_t *b, int b_stride);
+typedef int64_t (*FrameSseFunc)(const uint8_t *a, int a_stride,
+                                const uint8_t *b, int b_stride,
+                                int width, int height);
 
 
 using ::std::tr1::get;
@@ -245,6 +250,7 @@ class VarianceTest
   void RefTest();
   void RefStrideTest();
   void OneQuarterTest();
+  void SpeedTest();
 
   ACMRandom rnd_;
   uint8_t *src_;
@@ -370,6 +376,31 @@ void VarianceTest<VarianceFunctionType>::OneQuarterTest() {
   EXPECT_EQ(expected, var);
 }
 
+template<typename VarianceFunctionType>
+void VarianceTest<VarianceFunctionType>::SpeedTest() {
+  const int kCountSpeedTestBlock = 50000000 / block_size_;
+  for (int j = 0; j < block_size_; j++) {
+    if (!use_high_bit_depth_) {
+      src_[j] = rnd_.Rand8();
+      ref_[j] = rnd_.Rand8();
+#if CONFIG_VP9_HIGHBITDEPTH
+    } else {
+      CONVERT_TO_SHORTPTR(src_)[j] = rnd_.Rand16() & mask_;
+      CONVERT_TO_SHORTPTR(ref_)[j] = rnd_.Rand16() & mask_;
+#endif  // CONFIG_VP9_HIGHBITDEPTH
+    }
+  }
+  unsigned int sse;
+  vpx_usec_timer timer;
+  vpx_usec_timer_start(&timer);
+  for (int i = 0; i < kCountSpeedTestBlock; ++i)
+    variance_(src_, width_, ref_, width_, &sse);
+  vpx_usec_timer_mark(&timer);
+  const int elapsed_time = static_cast<int>(vpx_usec_timer_elapsed(&timer));
+  printf("Variance %dx%d (%dbit): %d us\n", width_, height_, bit_depth_,
+         elapsed_time);
+}
+
 template<typename MseFunctionType>
 class MseTest
     : public ::testing::TestWithParam<tuple<int, int, MseFunctionType> > {
@@ -464,6 +495,100 @@ void MseTest<MseFunctionType>::MaxTest_sse() {
   EXPECT_EQ(expected, var);
 }
 
+// Sum of squared errors of a plane of any size, as used for the frame PSNR.
+// The bit depth is 0 for the low bit depth functions.
+class FrameSseTest
+    : public ::testing::TestWithParam<tuple<FrameSseFunc, int> > {
+ public:
+  virtual void SetUp() {
+    sse_ = get<0>(GetParam());
+    use_high_bit_depth_ = get<1>(GetParam()) != 0;
+    bit_depth_ = use_high_bit_depth_ ? get<1>(GetParam()) : 8;
+    mask_ = (1 << bit_depth_) - 1;
+    rnd_.Reset(ACMRandom::DeterministicSeed());
+    a_ = new uint16_t[kBufferSize];
+    b_ = new uint16_t[kBufferSize];
+    a8_ = new uint8_t[kBufferSize];
+    b8_ = new uint8_t[kBufferSize];
+  }
+
+  virtual void TearDown() {
+    delete[] a_;
+    delete[] b_;
+    delete[] a8_;
+    delete[] b8_;
+    libvpx_test::ClearSystemState();
+  }
+
+ protected:
+  static const int kMaxWidth = 1920;
+  static const int kMaxHeight = 64;
+  static const int kBufferSize = (kMaxWidth + 32) * kMaxHeight;
+
+  void CheckSse(int width, int height, int a_stride, int b_stride) {
+    int64_t expected = 0;
+    for (int y = 0; y < height; ++y) {
+      for (int x = 0; x < width; ++x) {
+        const int diff = a_[y * a_stride + x] - b_[y * b_stride + x];
+        expected += static_cast<int64_t>(diff) * diff;
+      }
+    }
+    int64_t sse = -1;
+    if (!use_high_bit_depth_) {
+      for (int i = 0; i < kBufferSize; ++i) {
+        a8_[i] = static_cast<uint8_t>(a_[i]);
+        b8_[i] = static_cast<uint8_t>(b_[i]);
+      }
+      ASM_REGISTER_STATE_CHECK(
+          sse = sse_(a8_, a_stride, b8_, b_stride, width, height));
+#if CONFIG_VP9_HIGHBITDEPTH
+    } else {
+      ASM_REGISTER_STATE_CHECK(
+          sse = sse_(CONVERT_TO_BYTEPTR(a_), a_stride,
+                     CONVERT_TO_BYTEPTR(b_), b_stride, width, height));
+#endif  // CONFIG_VP9_HIGHBITDEPTH
+    }
+    EXPECT_EQ(expected, sse) << width << "x" << height;
+  }
+
+  void RefTest() {
+    for (int i = 0; i < 200; ++i) {
+      const int width = 1 + rnd_(i < 100 ? 80 : kMaxWidth);
+      const int height = 1 + rnd_(kMaxHeight);
+      const int a_stride = width + rnd_(32);
+      const int b_stride = width + rnd_(32);
+      for (int j = 0; j < kBufferSize; ++j) {
+        a_[j] = rnd_.Rand16() & mask_;
+        b_[j] = rnd_.Rand16() & mask_;
+      }
+      CheckSse(width, height, a_stride, b_stride);
+    }
+  }
+
+  void MaxTest() {
+    for (int j = 0; j < kBufferSize; ++j) {
+      a_[j] = mask_;
+      b_[j] = 0;
+    }
+    CheckSse(kMaxWidth, kMaxHeight, kMaxWidth, kMaxWidth);
+    CheckSse(kMaxWidth - 15, kMaxHeight - 1, kMaxWidth, kMaxWidth);
+    CheckSse(17, 3, kMaxWidth, kMaxWidth);
+  }
+
+  FrameSseFunc sse_;
+  bool use_high_bit_depth_;
+  int bit_depth_;
+  int mask_;
+  ACMRandom rnd_;
+  uint16_t *a_;
+  uint16_t *b_;
+  uint8_t *a8_;
+  uint8_t *b8_;
+};
+
+TEST_P(FrameSseTest, Ref) { RefTest(); }
+TEST_P(FrameSseTest, Max) { MaxTest(); }
+
 unsigned int subpel_avg_variance_ref(const uint8_t *ref,
                                      const uint8_t *src,
                                      const uint8_t *second_pred,
@@ -713,6 +838,7 @@ TEST_P(VpxVarianceTest, Zero) { ZeroTest(); }
 TEST_P(VpxVarianceTest, Ref) { RefTest(); }
 TEST_P(VpxVarianceTest, RefStride) { RefStrideTest(); }
 TEST_P(VpxVarianceTest, OneQuarter) { OneQuarterTest(); }
+TEST_P(VpxVarianceTest, DISABLED_Speed) { SpeedTest(); }
 TEST_P(SumOfSquaresTest, Const) { ConstTest(); }
 TEST_P(SumOfSquaresTest, Ref) { RefTest(); }
 
@@ -733,6 +859,19 @@ INSTANTIATE_TEST_CASE_P(C, VpxMseTest,
                                           make_tuple(3, 4, mse8x16_c),
                                           make_tuple(3, 3, mse8x8_c)));
 
+const FrameSseFunc frame_sse_c = vpx_sse_c;
+#if CONFIG_VP9_HIGHBITDEPTH
+const FrameSseFunc highbd_frame_sse_c = vpx_highbd_sse_c;
+INSTANTIATE_TEST_CASE_P(C, FrameSseTest,
+                        ::testing::Values(make_tuple(frame_sse_c, 0),
+                                          make_tuple(highbd_frame_sse_c, 8),
+                                          make_tuple(highbd_frame_sse_c, 10),
+                                          make_tuple(highbd_frame_sse_c, 12)));
+#else
+INSTANTIATE_TEST_CASE_P(C, FrameSseTest,
+                        ::testing::Values(make_tuple(frame_sse_c, 0)));
+#endif  // CONFIG_VP9_HIGHBITDEPTH
+
 const VarianceMxNFunc variance64x64_c = vpx_variance64x64_c;
 const VarianceMxNFunc variance64x32_c = vpx_variance64x32_c;
 const VarianceMxNFunc variance32x64_c = vpx_variance32x64_c;
@@ -773,6 +912,7 @@ TEST_P(VpxHBDVarianceTest, Zero) { ZeroTest(); }
 TEST_P(VpxHBDVarianceTest, Ref) { RefTest(); }
 TEST_P(VpxHBDVarianceTest, RefStride) { RefStrideTest(); }
 TEST_P(VpxHBDVarianceTest, OneQuarter) { OneQuarterTest(); }
+TEST_P(VpxHBDVarianceTest, DISABLED_Speed) { SpeedTest(); }
 
 /* TODO(debargha): This test does not support the highbd version
 const VarianceMxNFunc highbd_12_mse16x16_c = vpx_highbd_12_mse16x16_c;
@@ -926,6 +1066,20 @@ INSTANTIATE_TEST_CASE_P(SSE2, VpxMseTest,
                                           make_tuple(3, 4, mse8x16_sse2),
                                           make_tuple(3, 3, mse8x8_sse2)));
 
+const FrameSseFunc frame_sse_sse2 = vpx_sse_sse2;
+#if CONFIG_VP9_HIGHBITDEPTH
+const FrameSseFunc highbd_frame_sse_sse2 = vpx_highbd_sse_sse2;
+INSTANTIATE_TEST_CASE_P(
+    SSE2, FrameSseTest,
+    ::testing::Values(make_tuple(frame_sse_sse2, 0),
+                      make_tuple(highbd_frame_sse_sse2, 8),
+                      make_tuple(highbd_frame_sse_sse2, 10),
+                      make_tuple(highbd_frame_sse_sse2, 12)));
+#else
+INSTANTIATE_TEST_CASE_P(SSE2, FrameSseTest,
+                        ::testing::Values(make_tuple(frame_sse_sse2, 0)));
+#endif  // CONFIG_VP9_HIGHBITDEPTH
+
 const VarianceMxNFunc variance64x64_sse2 = vpx_variance64x64_sse2;
 const VarianceMxNFunc variance64x32_sse2 = vpx_variance64x32_sse2;
 const VarianceMxNFunc variance32x64_sse2 = vpx_variance32x64_sse2;
@@ -1811,21 +1965,43 @@ INSTANTIATE_TEST_CASE_P(
 
 #if HAVE_AVX2
 const VarianceMxNFunc mse16x16_avx2 = vpx_mse16x16_avx2;
+const VarianceMxNFunc mse16x8_avx2 = vpx_mse16x8_avx2;
 INSTANTIATE_TEST_CASE_P(AVX2, VpxMseTest,
-                        ::testing::Values(make_tuple(4, 4, mse16x16_avx2)));
+                        ::testing::Values(make_tuple(4, 4, mse16x16_avx2),
+                                          make_tuple(4, 3, mse16x8_avx2)));
+
+const FrameSseFunc frame_sse_avx2 = vpx_sse_avx2;
+#if CONFIG_VP9_HIGHBITDEPTH
+const FrameSseFunc highbd_frame_sse_avx2 = vpx_highbd_sse_avx2;
+INSTANTIATE_TEST_CASE_P(
+    AVX2, FrameSseTest,
+    ::testing::Values(make_tuple(frame_sse_avx2, 0),
+                      make_tuple(highbd_frame_sse_avx2, 8),
+                      make_tuple(highbd_frame_sse_avx2, 10),
+                      make_tuple(highbd_frame_sse_avx2, 12)));
+#else
+INSTANTIATE_TEST_CASE_P(AVX2, FrameSseTest,
+                        ::testing::Values(make_tuple(frame_sse_avx2, 0)));
+#endif  // CONFIG_VP9_HIGHBITDEPTH
 
 const VarianceMxNFunc variance64x64_avx2 = vpx_variance64x64_avx2;
 const VarianceMxNFunc variance64x32_avx2 = vpx_variance64x32_avx2;
+const VarianceMxNFunc variance32x64_avx2 = vpx_variance32x64_avx2;
 const VarianceMxNFunc variance32x32_avx2 = vpx_variance32x32_avx2;
 const VarianceMxNFunc variance32x16_avx2 = vpx_variance32x16_avx2;
+const VarianceMxNFunc variance16x32_avx2 = vpx_variance16x32_avx2;
 const VarianceMxNFunc variance16x16_avx2 = vpx_variance16x16_avx2;
+const VarianceMxNFunc variance16x8_avx2 = vpx_variance16x8_avx2;
 INSTANTIATE_TEST_CASE_P(
     AVX2, VpxVarianceTest,
     ::testing::Values(make_tuple(6, 6, variance64x64_avx2, 0),
                       make_tuple(6, 5, variance64x32_avx2, 0),
+                      make_tuple(5, 6, variance32x64_avx2, 0),
                       make_tuple(5, 5, variance32x32_avx2, 0),
                       make_tuple(5, 4, variance32x16_avx2, 0),
-                      make_tuple(4, 4, variance16x16_avx2, 0)));
+                      make_tuple(4, 5, variance16x32_avx2, 0),
+                      make_tuple(4, 4, variance16x16_avx2, 0),
+                      make_tuple(4, 3, variance16x8_avx2, 0)));
 
 #if CONFIG_VP9_ENCODER
 const vp9_subpixvariance_fn_t subpel_variance32x32_avx2 =
@@ -1845,6 +2021,159 @@ INSTANTIATE_TEST_CASE_P(
     AVX2, VP9SubpelAvgVarianceTest,
     ::testing::Values(make_tuple(5, 5, subpel_avg_variance32x32_avx2, 0),
                       make_tuple(6, 6, subpel_avg_variance64x64_avx2, 0)));
+
+#if CONFIG_VP9_HIGHBITDEPTH
+const vp9_subpixvariance_fn_t highbd_subpel_variance16x8_avx2 =
+    vp9_highbd_sub_pixel_variance16x8_avx2;
+const vp9_subpixvariance_fn_t highbd_subpel_variance16x16_avx2 =
+    vp9_highbd_sub_pixel_variance16x16_avx2;
+const vp9_subpixvariance_fn_t highbd_subpel_variance16x32_avx2 =
+    vp9_highbd_sub_pixel_variance16x32_avx2;
+const vp9_subpixvariance_fn_t highbd_subpel_variance32x16_avx2 =
+    vp9_highbd_sub_pixel_variance32x16_avx2;
+const vp9_subpixvariance_fn_t highbd_subpel_variance32x32_avx2 =
+    vp9_highbd_sub_pixel_variance32x32_avx2;
+const vp9_subpixvariance_fn_t highbd_subpel_variance32x64_avx2 =
+    vp9_highbd_sub_pixel_variance32x64_avx2;
+const vp9_subpixvariance_fn_t highbd_subpel_variance64x32_avx2 =
+    vp9_highbd_sub_pixel_variance64x32_avx2;
+const vp9_subpixvariance_fn_t highbd_subpel_variance64x64_avx2 =
+    vp9_highbd_sub_pixel_variance64x64_avx2;
+const vp9_subpixvariance_fn_t highbd_10_subpel_variance16x8_avx2 =
+    vp9_highbd_10_sub_pixel_variance16x8_avx2;
+const vp9_subpixvariance_fn_t highbd_10_subpel_variance16x16_avx2 =
+    vp9_highbd_10_sub_pixel_variance16x16_avx2;
+const vp9_subpixvariance_fn_t highbd_10_subpel_variance16x32_avx2 =
+    vp9_highbd_10_sub_pixel_variance16x32_avx2;
+const vp9_subpixvariance_fn_t highbd_10_subpel_variance32x16_avx2 =
+    vp9_highbd_10_sub_pixel_variance32x16_avx2;
+const vp9_subpixvariance_fn_t highbd_10_subpel_variance32x32_avx2 =
+    vp9_highbd_10_sub_pixel_variance32x32_avx2;
+const vp9_subpixvariance_fn_t highbd_10_subpel_variance32x64_avx2 =
+    vp9_highbd_10_sub_pixel_variance32x64_avx2;
+const vp9_subpixvariance_fn_t highbd_10_subpel_variance64x32_avx2 =
+    vp9_highbd_10_sub_pixel_variance64x32_avx2;
+const vp9_subpixvariance_fn_t highbd_10_subpel_variance64x64_avx2 =
+    vp9_highbd_10_sub_pixel_variance64x64_avx2;
+const vp9_subpixvariance_fn_t highbd_12_subpel_variance16x8_avx2 =
+    vp9_highbd_12_sub_pixel_variance16x8_avx2;
+const vp9_subpixvariance_fn_t highbd_12_subpel_variance16x16_avx2 =
+    vp9_highbd_12_sub_pixel_variance16x16_avx2;
+const vp9_subpixvariance_fn_t highbd_12_subpel_variance16x32_avx2 =
+    vp9_highbd_12_sub_pixel_variance16x32_avx2;
+const vp9_subpixvariance_fn_t highbd_12_subpel_variance32x16_avx2 =
+    vp9_highbd_12_sub_pixel_variance32x16_avx2;
+const vp9_subpixvariance_fn_t highbd_12_subpel_variance32x32_avx2 =
+    vp9_highbd_12_sub_pixel_variance32x32_avx2;
+const vp9_subpixvariance_fn_t highbd_12_subpel_variance32x64_avx2 =
+    vp9_highbd_12_sub_pixel_variance32x64_avx2;
+const vp9_subpixvariance_fn_t highbd_12_subpel_variance64x32_avx2 =
+    vp9_highbd_12_sub_pixel_variance64x32_avx2;
+const vp9_subpixvariance_fn_t highbd_12_subpel_variance64x64_avx2 =
+    vp9_highbd_12_sub_pixel_variance64x64_avx2;
+INSTANTIATE_TEST_CASE_P(
+    AVX2, VP9SubpelVarianceHighTest,
+    ::testing::Values(
+        make_tuple(4, 3, highbd_subpel_variance16x8_avx2, 8),
+        make_tuple(4, 4, highbd_subpel_variance16x16_avx2, 8),
+        make_tuple(4, 5, highbd_subpel_variance16x32_avx2, 8),
+        make_tuple(5, 4, highbd_subpel_variance32x16_avx2, 8),
+        make_tuple(5, 5, highbd_subpel_variance32x32_avx2, 8),
+        make_tuple(5, 6, highbd_subpel_variance32x64_avx2, 8),
+        make_tuple(6, 5, highbd_subpel_variance64x32_avx2, 8),
+        make_tuple(6, 6, highbd_subpel_variance64x64_avx2, 8),
+        make_tuple(4, 3, highbd_10_subpel_variance16x8_avx2, 10),
+        make_tuple(4, 4, highbd_10_subpel_variance16x16_avx2, 10),
+        make_tuple(4, 5, highbd_10_subpel_variance16x32_avx2, 10),
+        make_tuple(5, 4, highbd_10_subpel_variance32x16_avx2, 10),
+        make_tuple(5, 5, highbd_10_subpel_variance32x32_avx2, 10),
+        make_tuple(5, 6, highbd_10_subpel_variance32x64_avx2, 10),
+        make_tuple(6, 5, highbd_10_subpel_variance64x32_avx2, 10),
+        make_tuple(6, 6, highbd_10_subpel_variance64x64_avx2, 10),
+        make_tuple(4, 3, highbd_12_subpel_variance16x8_avx2, 12),
+        make_tuple(4, 4, highbd_12_subpel_variance16x16_avx2, 12),
+        make_tuple(4, 5, highbd_12_subpel_variance16x32_avx2, 12),
+        make_tuple(5, 4, highbd_12_subpel_variance32x16_avx2, 12),
+        make_tuple(5, 5, highbd_12_subpel_variance32x32_avx2, 12),
+        make_tuple(5, 6, highbd_12_subpel_variance32x64_avx2, 12),
+        make_tuple(6, 5, highbd_12_subpel_variance64x32_avx2, 12),
+        make_tuple(6, 6, highbd_12_subpel_variance64x64_avx2, 12)));
+const vp9_subp_avg_variance_fn_t highbd_subpel_avg_variance16x8_avx2 =
+    vp9_highbd_sub_pixel_avg_variance16x8_avx2;
+const vp9_subp_avg_variance_fn_t highbd_subpel_avg_variance16x16_avx2 =
+    vp9_highbd_sub_pixel_avg_variance16x16_avx2;
+const vp9_subp_avg_variance_fn_t highbd_subpel_avg_variance16x32_avx2 =
+    vp9_highbd_sub_pixel_avg_variance16x32_avx2;
+const vp9_subp_avg_variance_fn_t highbd_subpel_avg_variance32x16_avx2 =
+    vp9_highbd_sub_pixel_avg_variance32x16_avx2;
+const vp9_subp_avg_variance_fn_t highbd_subpel_avg_variance32x32_avx2 =
+    vp9_highbd_sub_pixel_avg_variance32x32_avx2;
+const vp9_subp_avg_variance_fn_t highbd_subpel_avg_variance32x64_avx2 =
+    vp9_highbd_sub_pixel_avg_variance32x64_avx2;
+const vp9_subp_avg_variance_fn_t highbd_subpel_avg_variance64x32_avx2 =
+    vp9_highbd_sub_pixel_avg_variance64x32_avx2;
+const vp9_subp_avg_variance_fn_t highbd_subpel_avg_variance64x64_avx2 =
+    vp9_highbd_sub_pixel_avg_variance64x64_avx2;
+const vp9_subp_avg_variance_fn_t highbd_10_subpel_avg_variance16x8_avx2 =
+    vp9_highbd_10_sub_pixel_avg_variance16x8_avx2;
+const vp9_subp_avg_variance_fn_t highbd_10_subpel_avg_variance16x16_avx2 =
+    vp9_highbd_10_sub_pixel_avg_variance16x16_avx2;
+const vp9_subp_avg_variance_fn_t highbd_10_subpel_avg_variance16x32_avx2 =
+    vp9_highbd_10_sub_pixel_avg_variance16x32_avx2;
+const vp9_subp_avg_variance_fn_t highbd_10_subpel_avg_variance32x16_avx2 =
+    vp9_highbd_10_sub_pixel_avg_variance32x16_avx2;
+const vp9_subp_avg_variance_fn_t highbd_10_subpel_avg_variance32x32_avx2 =
+    vp9_highbd_10_sub_pixel_avg_variance32x32_avx2;
+const vp9_subp_avg_variance_fn_t highbd_10_subpel_avg_variance32x64_avx2 =
+    vp9_highbd_10_sub_pixel_avg_variance32x64_avx2;
+const vp9_subp_avg_variance_fn_t highbd_10_subpel_avg_variance64x32_avx2 =
+    vp9_highbd_10_sub_pixel_avg_variance64x32_avx2;
+const vp9_subp_avg_variance_fn_t highbd_10_subpel_avg_variance64x64_avx2 =
+    vp9_highbd_10_sub_pixel_avg_variance64x64_avx2;
+const vp9_subp_avg_variance_fn_t highbd_12_subpel_avg_variance16x8_avx2 =
+    vp9_highbd_12_sub_pixel_avg_variance16x8_avx2;
+const vp9_subp_avg_variance_fn_t highbd_12_subpel_avg_variance16x16_avx2 =
+    vp9_highbd_12_sub_pixel_avg_variance16x16_avx2;
+const vp9_subp_avg_variance_fn_t highbd_12_subpel_avg_variance16x32_avx2 =
+    vp9_highbd_12_sub_pixel_avg_variance16x32_avx2;
+const vp9_subp_avg_variance_fn_t highbd_12_subpel_avg_variance32x16_avx2 =
+    vp9_highbd_12_sub_pixel_avg_variance32x16_avx2;
+const vp9_subp_avg_variance_fn_t highbd_12_subpel_avg_variance32x32_avx2 =
+    vp9_highbd_12_sub_pixel_avg_variance32x32_avx2;
+const vp9_subp_avg_variance_fn_t highbd_12_subpel_avg_variance32x64_avx2 =
+    vp9_highbd_12_sub_pixel_avg_variance32x64_avx2;
+const vp9_subp_avg_variance_fn_t highbd_12_subpel_avg_variance64x32_avx2 =
+    vp9_highbd_12_sub_pixel_avg_variance64x32_avx2;
+const vp9_subp_avg_variance_fn_t highbd_12_subpel_avg_variance64x64_avx2 =
+    vp9_highbd_12_sub_pixel_avg_variance64x64_avx2;
+INSTANTIATE_TEST_CASE_P(
+    AVX2, VP9SubpelAvgVarianceHighTest,
+    ::testing::Values(
+        make_tuple(4, 3, highbd_subpel_avg_variance16x8_avx2, 8),
+        make_tuple(4, 4, highbd_subpel_avg_variance16x16_avx2, 8),
+        make_tuple(4, 5, highbd_subpel_avg_variance16x32_avx2, 8),
+        make_tuple(5, 4, highbd_subpel_avg_variance32x16_avx2, 8),
+        make_tuple(5, 5, highbd_subpel_avg_variance32x32_avx2, 8),
+        make_tuple(5, 6, highbd_subpel_avg_variance32x64_avx2, 8),
+        make_tuple(6, 5, highbd_subpel_avg_variance64x32_avx2, 8),
+        make_tuple(6, 6, highbd_subpel_avg_variance64x64_avx2, 8),
+        make_tuple(4, 3, highbd_10_subpel_avg_variance16x8_avx2, 10),
+        make_tuple(4, 4, highbd_10_subpel_avg_variance16x16_avx2, 10),
+        make_tuple(4, 5, highbd_10_subpel_avg_variance16x32_avx2, 10),
+        make_tuple(5, 4, highbd_10_subpel_avg_variance32x16_avx2, 10),
+        make_tuple(5, 5, highbd_10_subpel_avg_variance32x32_avx2, 10),
+        make_tuple(5, 6, highbd_10_subpel_avg_variance32x64_avx2, 10),
+        make_tuple(6, 5, highbd_10_subpel_avg_variance64x32_avx2, 10),
+        make_tuple(6, 6, highbd_10_subpel_avg_variance64x64_avx2, 10),
+        make_tuple(4, 3, highbd_12_subpel_avg_variance16x8_avx2, 12),
+        make_tuple(4, 4, highbd_12_subpel_avg_variance16x16_avx2, 12),
+        make_tuple(4, 5, highbd_12_subpel_avg_variance16x32_avx2, 12),
+        make_tuple(5, 4, highbd_12_subpel_avg_variance32x16_avx2, 12),
+        make_tuple(5, 5, highbd_12_subpel_avg_variance32x32_avx2, 12),
+        make_tuple(5, 6, highbd_12_subpel_avg_variance32x64_avx2, 12),
+        make_tuple(6, 5, highbd_12_subpel_avg_variance64x32_avx2, 12),
+        make_tuple(6, 6, highbd_12_subpel_avg_variance64x64_avx2, 12)));
+#endif  // CONFIG_VP9_HIGHBITDEPTH
 #endif  // CONFIG_VP9_ENCODER
 #endif  // HAVE_AVX2
 
@@ -87,3 +87,44 @@ TEST(VP9, TestBitIO) {
     }
   }
 }
+
+TEST(VP9, TestBoundedBitIO) {
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  const int kBitsToTest = 1000;
+  const int kBufferSize = 1000;
+  uint8_t probas[kBitsToTest];
+  int bits[kBitsToTest];
+
+  for (int i = 0; i < kBitsToTest; ++i) {
+    probas[i] = rnd.Rand8();
+    bits[i] = rnd(2);
+  }
+
+  vp9_writer bw;
+  uint8_t bw_buffer[kBufferSize];
+  vp9_start_encode(&bw, bw_buffer);
+  for (int i = 0; i < kBitsToTest; ++i)
+    vp9_write(&bw, bits[i], static_cast<int>(probas[i]));
+  vp9_stop_encode(&bw);
+  const unsigned int coded_size = bw.pos;
+  GTEST_ASSERT_EQ(bw.error, 0);
+
+  for (unsigned int size = coded_size - 8; size <= coded_size; ++size) {
+    vp9_writer bounded;
+    uint8_t bounded_buffer[kBufferSize];
+    memset(bounded_buffer, 0xa5, sizeof(bounded_buffer));
+    vp9_start_bounded_encode(&bounded, bounded_buffer, size);
+    for (int i = 0; i < kBitsToTest; ++i)
+      vp9_write(&bounded, bits[i], static_cast<int>(probas[i]));
+    vp9_stop_encode(&bounded);
+
+    // The output is exact when it fits, and nothing is written past the
+    // end of the buffer when it does not.
+    GTEST_ASSERT_EQ(bounded.error, size < coded_size) << "size: " << size;
+    GTEST_ASSERT_LE(bounded.pos, size);
+    for (unsigned int i = size; i < sizeof(bounded_buffer); ++i)
+      GTEST_ASSERT_EQ(bounded_buffer[i], 0xa5) << "size: " << size;
+    if (!bounded.error)
+      GTEST_ASSERT_EQ(memcmp(bounded_buffer, bw_buffer, coded_size), 0);
+  }
+}
@@ -20,14 +20,16 @@
 namespace {
 class VP9EncoderThreadTest
     : public ::libvpx_test::EncoderTest,
-      public ::libvpx_test::CodecTestWith2Params<libvpx_test::TestMode, int> {
+      public ::libvpx_test::CodecTestWith3Params<libvpx_test::TestMode, int,
+                                                 int> {
  protected:
   VP9EncoderThreadTest()
       : EncoderTest(GET_PARAM(0)),
         encoder_initialized_(false),
         tiles_(2),
         encoding_mode_(GET_PARAM(1)),
-        set_cpu_used_(GET_PARAM(2)) {
+        set_cpu_used_(GET_PARAM(2)),
+        row_mt_(GET_PARAM(3)) {
     init_flags_ = VPX_CODEC_USE_PSNR;
     vpx_codec_dec_cfg_t cfg = vpx_codec_dec_cfg_t();
     cfg.w = 1280;
@@ -68,6 +70,7 @@ class VP9EncoderThreadTest
       // Encode 4 column tiles.
       encoder->Control(VP9E_SET_TILE_COLUMNS, tiles_);
       encoder->Control(VP8E_SET_CPUUSED, set_cpu_used_);
+      encoder->Control(VP9E_SET_ROW_MT, row_mt_);
       if (encoding_mode_ != ::libvpx_test::kRealTime) {
         encoder->Control(VP8E_SET_ENABLEAUTOALTREF, 1);
         encoder->Control(VP8E_SET_ARNR_MAXFRAMES, 7);
@@ -101,6 +104,7 @@ class VP9EncoderThreadTest
   int tiles_;
   ::libvpx_test::TestMode encoding_mode_;
   int set_cpu_used_;
+  int row_mt_;
   ::libvpx_test::Decoder *decoder_;
   std::vector<std::string> md5_;
 };
@@ -133,5 +137,5 @@ VP9_INSTANTIATE_TEST_CASE(
     VP9EncoderThreadTest,
     ::testing::Values(::libvpx_test::kTwoPassGood, ::libvpx_test::kOnePassGood,
                       ::libvpx_test::kRealTime),
-    ::testing::Range(1, 9));
+    ::testing::Range(1, 9), ::testing::Range(0, 2));
 }  // namespace
@@ -0,0 +1,120 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "third_party/googletest/src/include/gtest/gtest.h"
+
+#include "./vpx_config.h"
+#include "vp9/common/vp9_frame_buffers.h"
+#include "vpx/vp8dx.h"
+#include "vpx/vpx_decoder.h"
+
+namespace {
+
+class VP9FrameBuffersTest : public ::testing::Test {
+ protected:
+  virtual void SetUp() {
+    memset(&list_, 0, sizeof(list_));
+    ASSERT_EQ(0, vp9_alloc_internal_frame_buffers(&list_));
+  }
+
+  virtual void TearDown() { vp9_free_internal_frame_buffers(&list_); }
+
+  vpx_codec_frame_buffer_t Get(size_t min_size) {
+    vpx_codec_frame_buffer_t fb = vpx_codec_frame_buffer_t();
+    EXPECT_EQ(0, vp9_get_frame_buffer(&list_, min_size, &fb));
+    EXPECT_TRUE(fb.data != NULL);
+    EXPECT_GE(fb.size, min_size);
+    return fb;
+  }
+
+  void Release(vpx_codec_frame_buffer_t *fb) {
+    EXPECT_EQ(0, vp9_release_frame_buffer(&list_, fb));
+  }
+
+  InternalFrameBufferList list_;
+};
+
+TEST_F(VP9FrameBuffersTest, ReusesLargerBufferForSmallerFrame) {
+  vpx_codec_frame_buffer_t large = Get(100000);
+  Release(&large);
+  vpx_codec_frame_buffer_t small = Get(1000);
+  EXPECT_EQ(large.data, small.data);
+  EXPECT_EQ(large.size, small.size);
+  Release(&small);
+}
+
+TEST_F(VP9FrameBuffersTest, PicksSmallestBufferThatFits) {
+  vpx_codec_frame_buffer_t fbs[3] = { Get(10000), Get(40000), Get(20000) };
+  for (int i = 0; i < 3; ++i) Release(&fbs[i]);
+
+  vpx_codec_frame_buffer_t fb = Get(15000);
+  EXPECT_EQ(fbs[2].data, fb.data);
+  vpx_codec_frame_buffer_t fb2 = Get(15000);
+  EXPECT_EQ(fbs[1].data, fb2.data);
+  Release(&fb);
+  Release(&fb2);
+}
+
+TEST_F(VP9FrameBuffersTest, RoundsUpToSizeClass) {
+  // 1000 is rounded up to a multiple of 512 / 8.
+  vpx_codec_frame_buffer_t fb = Get(1000);
+  EXPECT_EQ(1024u, fb.size);
+  Release(&fb);
+
+  // A slightly larger frame fits in the same buffer.
+  vpx_codec_frame_buffer_t fb2 = Get(1020);
+  EXPECT_EQ(fb.data, fb2.data);
+  Release(&fb2);
+}
+
+TEST_F(VP9FrameBuffersTest, AllocatesSizeHint) {
+  list_.size_hint = 100000;
+  vpx_codec_frame_buffer_t fb = Get(1000);
+  EXPECT_GE(fb.size, 100000u);
+  Release(&fb);
+
+  vpx_codec_frame_buffer_t fb2 = Get(90000);
+  EXPECT_EQ(fb.data, fb2.data);
+  Release(&fb2);
+}
+
+TEST_F(VP9FrameBuffersTest, FailsWhenAllInUse) {
+  vpx_codec_frame_buffer_t fbs[VP9_MAXIMUM_REF_BUFFERS +
+                               VPX_MAXIMUM_WORK_BUFFERS];
+  const int num_fbs = static_cast<int>(sizeof(fbs) / sizeof(fbs[0]));
+  for (int i = 0; i < num_fbs; ++i) fbs[i] = Get(1000);
+
+  vpx_codec_frame_buffer_t fb = vpx_codec_frame_buffer_t();
+  EXPECT_EQ(-1, vp9_get_frame_buffer(&list_, 1000, &fb));
+
+  // The released buffer is grown for a larger frame.
+  Release(&fbs[0]);
+  fb = Get(2000);
+  Release(&fb);
+  for (int i = 1; i < num_fbs; ++i) Release(&fbs[i]);
+}
+
+TEST(VP9FrameSizeHintTest, ValidatesHint) {
+  vpx_codec_ctx_t dec;
+  ASSERT_EQ(VPX_CODEC_OK,
+            vpx_codec_dec_init(&dec, &vpx_codec_vp9_dx_algo, NULL, 0));
+  int frame_size[2] = { 1920, 1080 };
+  EXPECT_EQ(VPX_CODEC_OK,
+            vpx_codec_control(&dec, VP9D_SET_FRAME_SIZE_HINT, frame_size));
+  frame_size[0] = frame_size[1] = 0;
+  EXPECT_EQ(VPX_CODEC_OK,
+            vpx_codec_control(&dec, VP9D_SET_FRAME_SIZE_HINT, frame_size));
+  frame_size[0] = -1;
+  EXPECT_EQ(VPX_CODEC_INVALID_PARAM,
+            vpx_codec_control(&dec, VP9D_SET_FRAME_SIZE_HINT, frame_size));
+  EXPECT_EQ(VPX_CODEC_OK, vpx_codec_destroy(&dec));
+}
+
+}  // namespace
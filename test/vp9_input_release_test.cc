@@ -0,0 +1,146 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "third_party/googletest/src/include/gtest/gtest.h"
+
+#include "test/i420_video_source.h"
+#include "vpx/vp8cx.h"
+#include "vpx/vpx_encoder.h"
+
+namespace {
+
+const int kWidth = 352;
+const int kHeight = 288;
+const int kFrames = 12;
+
+void ReleaseInput(void *cb_priv, void *img_priv) {
+  std::vector<int> *const released = static_cast<std::vector<int> *>(cb_priv);
+  released->push_back(static_cast<int>(reinterpret_cast<intptr_t>(img_priv)));
+}
+
+// Returns a copy of src in an image with the border the encoder needs to
+// hold it without copying.
+vpx_image_t *CreateBorderedImage(const vpx_image_t *src) {
+  const int border = VP9_INPUT_BORDER_IN_PIXELS;
+  vpx_image_t *const img = vpx_img_alloc(NULL, src->fmt, src->d_w + 2 * border,
+                                         src->d_h + 2 * border, 32);
+  EXPECT_TRUE(img != NULL);
+  EXPECT_EQ(0, vpx_img_set_rect(img, border, border, src->d_w, src->d_h));
+  for (int plane = 0; plane < 3; ++plane) {
+    const int w = plane ? (src->d_w + 1) >> 1 : src->d_w;
+    const int h = plane ? (src->d_h + 1) >> 1 : src->d_h;
+    for (int r = 0; r < h; ++r)
+      memcpy(img->planes[plane] + r * img->stride[plane],
+             src->planes[plane] + r * src->stride[plane], w);
+  }
+  return img;
+}
+
+class VP9InputReleaseTest : public ::testing::TestWithParam<int> {
+ protected:
+  // Encodes the clip and returns the compressed data. If hold is set the
+  // release callback is installed, and if bordered is set the frames are
+  // submitted in images the encoder can hold.
+  std::string Encode(bool hold, bool bordered) {
+    vpx_codec_ctx_t enc;
+    vpx_codec_enc_cfg_t cfg;
+    std::vector<vpx_image_t *> images;
+    std::string data;
+
+    EXPECT_EQ(VPX_CODEC_OK,
+              vpx_codec_enc_config_default(&vpx_codec_vp9_cx_algo, &cfg, 0));
+    cfg.g_w = kWidth;
+    cfg.g_h = kHeight;
+    cfg.g_threads = GetParam();
+    cfg.g_lag_in_frames = 8;
+    cfg.rc_target_bitrate = 400;
+    EXPECT_EQ(VPX_CODEC_OK,
+              vpx_codec_enc_init(&enc, &vpx_codec_vp9_cx_algo, &cfg, 0));
+    EXPECT_EQ(VPX_CODEC_OK, vpx_codec_control(&enc, VP8E_SET_CPUUSED, 4));
+    if (hold) {
+      vpx_release_input_cb_t cb;
+      cb.release = ReleaseInput;
+      cb.cb_priv = &released_;
+      EXPECT_EQ(VPX_CODEC_OK,
+                vpx_codec_control(&enc, VP9E_SET_INPUT_RELEASE_CB, &cb));
+    }
+
+    libvpx_test::I420VideoSource video("hantro_collage_w352h288.yuv",
+                                       kWidth, kHeight, 30, 1, 0, kFrames);
+    video.Begin();
+    for (int i = 0; i <= kFrames; ++i) {
+      vpx_image_t *img = NULL;
+      if (i < kFrames) {
+        img = video.img();
+        if (bordered) {
+          img = CreateBorderedImage(img);
+          images.push_back(img);
+        }
+        img->user_priv = reinterpret_cast<void *>(static_cast<intptr_t>(i));
+        video.Next();
+      }
+      EXPECT_EQ(VPX_CODEC_OK, vpx_codec_encode(&enc, img, i, 1, 0,
+                                               VPX_DL_GOOD_QUALITY));
+      // Copied images are released before vpx_codec_encode() returns, held
+      // ones stay in the lookahead.
+      if (hold && !bordered)
+        EXPECT_EQ(std::min(i + 1, kFrames), static_cast<int>(released_.size()));
+      if (hold && bordered && i == 0)
+        EXPECT_TRUE(released_.empty());
+
+      vpx_codec_iter_t iter = NULL;
+      const vpx_codec_cx_pkt_t *pkt;
+      while ((pkt = vpx_codec_get_cx_data(&enc, &iter)) != NULL) {
+        if (pkt->kind == VPX_CODEC_CX_FRAME_PKT)
+          data.append(static_cast<const char *>(pkt->data.frame.buf),
+                      pkt->data.frame.sz);
+      }
+    }
+    EXPECT_EQ(VPX_CODEC_OK, vpx_codec_destroy(&enc));
+
+    for (size_t i = 0; i < images.size(); ++i)
+      vpx_img_free(images[i]);
+    return data;
+  }
+
+  void ExpectAllReleasedOnce() {
+    std::sort(released_.begin(), released_.end());
+    ASSERT_EQ(kFrames, static_cast<int>(released_.size()));
+    for (int i = 0; i < kFrames; ++i)
+      EXPECT_EQ(i, released_[i]);
+  }
+
+  std::vector<int> released_;
+};
+
+TEST_P(VP9InputReleaseTest, HeldImagesMatchCopies) {
+  const std::string copied = Encode(false, true);
+  EXPECT_TRUE(released_.empty());
+  const std::string held = Encode(true, true);
+  ExpectAllReleasedOnce();
+  EXPECT_TRUE(copied == held);
+}
+
+TEST_P(VP9InputReleaseTest, UnborderedImagesAreReleasedRightAway) {
+  const std::string copied = Encode(false, false);
+  const std::string released = Encode(true, false);
+  ExpectAllReleasedOnce();
+  EXPECT_TRUE(copied == released);
+}
+
+INSTANTIATE_TEST_CASE_P(VP9, VP9InputReleaseTest, ::testing::Values(1, 4));
+
+}  // namespace
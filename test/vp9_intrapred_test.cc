@@ -127,6 +127,60 @@ TEST_P(VP9IntraPredTest, IntraPredTests) {
   RunTest(left_col, above_data, dst, ref_dst);
 }
 
+typedef void (*lowbd_intra_pred_fn_t)(uint8_t *dst, ptrdiff_t stride,
+                                      const uint8_t *above,
+                                      const uint8_t *left);
+typedef std::tr1::tuple<lowbd_intra_pred_fn_t, lowbd_intra_pred_fn_t, int>
+    lowbd_intra_pred_params_t;
+class VP9LowbdIntraPredTest
+    : public ::testing::TestWithParam<lowbd_intra_pred_params_t> {
+ public:
+  virtual ~VP9LowbdIntraPredTest() { libvpx_test::ClearSystemState(); }
+
+ protected:
+  virtual void SetUp() {
+    pred_fn_    = GET_PARAM(0);
+    ref_fn_     = GET_PARAM(1);
+    block_size_ = GET_PARAM(2);
+    stride_     = block_size_ * 3;
+  }
+
+  lowbd_intra_pred_fn_t pred_fn_;
+  lowbd_intra_pred_fn_t ref_fn_;
+  int block_size_;
+  ptrdiff_t stride_;
+};
+
+TEST_P(VP9LowbdIntraPredTest, IntraPredTests) {
+  // max block size is 32
+  DECLARE_ALIGNED(16, uint8_t, left_col[2*32]);
+  DECLARE_ALIGNED(16, uint8_t, above_data[2*32+32]);
+  DECLARE_ALIGNED(16, uint8_t, dst[3 * 32 * 32]);
+  DECLARE_ALIGNED(16, uint8_t, ref_dst[3 * 32 * 32]);
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  uint8_t *const above_row = above_data + 16;
+  int error_count = 0;
+  for (int i = 0; i < count_test_block; ++i) {
+    // Fill edges with random data, try first with saturated values.
+    for (int x = -1; x <= block_size_*2; x++)
+      above_row[x] = i == 0 ? 255 : rnd.Rand8();
+    for (int y = 0; y < block_size_; y++)
+      left_col[y] = i == 0 ? 255 : rnd.Rand8();
+    ref_fn_(ref_dst, stride_, above_row, left_col);
+    ASM_REGISTER_STATE_CHECK(pred_fn_(dst, stride_, above_row, left_col));
+    for (int y = 0; y < block_size_; y++) {
+      for (int x = 0; x < block_size_; x++) {
+        error_count += ref_dst[x + y * stride_] != dst[x + y * stride_];
+        if (error_count == 1) {
+          ASSERT_EQ(ref_dst[x + y * stride_], dst[x + y * stride_])
+              << " Failed on Test Case Number "<< i;
+        }
+      }
+    }
+  }
+  ASSERT_EQ(0, error_count);
+}
+
 using std::tr1::make_tuple;
 
 #if HAVE_SSE2
@@ -295,4 +349,139 @@ INSTANTIATE_TEST_CASE_P(SSE2_TO_C_12, VP9IntraPredTest,
 #endif
 #endif  // CONFIG_VP9_HIGHBITDEPTH
 #endif  // HAVE_SSE2
+
+#if HAVE_SSSE3
+#if CONFIG_VP9_HIGHBITDEPTH
+INSTANTIATE_TEST_CASE_P(SSSE3_TO_C_8, VP9IntraPredTest,
+                        ::testing::Values(
+                            make_tuple(&vp9_highbd_d117_predictor_4x4_ssse3,
+                                       &vp9_highbd_d117_predictor_4x4_c, 4, 8),
+                            make_tuple(&vp9_highbd_d117_predictor_8x8_ssse3,
+                                       &vp9_highbd_d117_predictor_8x8_c, 8, 8),
+                            make_tuple(&vp9_highbd_d117_predictor_16x16_ssse3,
+                                       &vp9_highbd_d117_predictor_16x16_c, 16,
+                                       8),
+                            make_tuple(&vp9_highbd_d117_predictor_32x32_ssse3,
+                                       &vp9_highbd_d117_predictor_32x32_c, 32,
+                                       8),
+                            make_tuple(&vp9_highbd_d135_predictor_4x4_ssse3,
+                                       &vp9_highbd_d135_predictor_4x4_c, 4, 8),
+                            make_tuple(&vp9_highbd_d135_predictor_8x8_ssse3,
+                                       &vp9_highbd_d135_predictor_8x8_c, 8, 8),
+                            make_tuple(&vp9_highbd_d135_predictor_16x16_ssse3,
+                                       &vp9_highbd_d135_predictor_16x16_c, 16,
+                                       8),
+                            make_tuple(&vp9_highbd_d135_predictor_32x32_ssse3,
+                                       &vp9_highbd_d135_predictor_32x32_c, 32,
+                                       8),
+                            make_tuple(&vp9_highbd_d153_predictor_4x4_ssse3,
+                                       &vp9_highbd_d153_predictor_4x4_c, 4, 8),
+                            make_tuple(&vp9_highbd_d153_predictor_8x8_ssse3,
+                                       &vp9_highbd_d153_predictor_8x8_c, 8, 8),
+                            make_tuple(&vp9_highbd_d153_predictor_16x16_ssse3,
+                                       &vp9_highbd_d153_predictor_16x16_c, 16,
+                                       8),
+                            make_tuple(&vp9_highbd_d153_predictor_32x32_ssse3,
+                                       &vp9_highbd_d153_predictor_32x32_c, 32,
+                                       8)));
+
+INSTANTIATE_TEST_CASE_P(SSSE3_TO_C_10, VP9IntraPredTest,
+                        ::testing::Values(
+                            make_tuple(&vp9_highbd_d117_predictor_4x4_ssse3,
+                                       &vp9_highbd_d117_predictor_4x4_c, 4, 10),
+                            make_tuple(&vp9_highbd_d117_predictor_8x8_ssse3,
+                                       &vp9_highbd_d117_predictor_8x8_c, 8, 10),
+                            make_tuple(&vp9_highbd_d117_predictor_16x16_ssse3,
+                                       &vp9_highbd_d117_predictor_16x16_c, 16,
+                                       10),
+                            make_tuple(&vp9_highbd_d117_predictor_32x32_ssse3,
+                                       &vp9_highbd_d117_predictor_32x32_c, 32,
+                                       10),
+                            make_tuple(&vp9_highbd_d135_predictor_4x4_ssse3,
+                                       &vp9_highbd_d135_predictor_4x4_c, 4, 10),
+                            make_tuple(&vp9_highbd_d135_predictor_8x8_ssse3,
+                                       &vp9_highbd_d135_predictor_8x8_c, 8, 10),
+                            make_tuple(&vp9_highbd_d135_predictor_16x16_ssse3,
+                                       &vp9_highbd_d135_predictor_16x16_c, 16,
+                                       10),
+                            make_tuple(&vp9_highbd_d135_predictor_32x32_ssse3,
+                                       &vp9_highbd_d135_predictor_32x32_c, 32,
+                                       10),
+                            make_tuple(&vp9_highbd_d153_predictor_4x4_ssse3,
+                                       &vp9_highbd_d153_predictor_4x4_c, 4, 10),
+                            make_tuple(&vp9_highbd_d153_predictor_8x8_ssse3,
+                                       &vp9_highbd_d153_predictor_8x8_c, 8, 10),
+                            make_tuple(&vp9_highbd_d153_predictor_16x16_ssse3,
+                                       &vp9_highbd_d153_predictor_16x16_c, 16,
+                                       10),
+                            make_tuple(&vp9_highbd_d153_predictor_32x32_ssse3,
+                                       &vp9_highbd_d153_predictor_32x32_c, 32,
+                                       10)));
+
+INSTANTIATE_TEST_CASE_P(SSSE3_TO_C_12, VP9IntraPredTest,
+                        ::testing::Values(
+                            make_tuple(&vp9_highbd_d117_predictor_4x4_ssse3,
+                                       &vp9_highbd_d117_predictor_4x4_c, 4, 12),
+                            make_tuple(&vp9_highbd_d117_predictor_8x8_ssse3,
+                                       &vp9_highbd_d117_predictor_8x8_c, 8, 12),
+                            make_tuple(&vp9_highbd_d117_predictor_16x16_ssse3,
+                                       &vp9_highbd_d117_predictor_16x16_c, 16,
+                                       12),
+                            make_tuple(&vp9_highbd_d117_predictor_32x32_ssse3,
+                                       &vp9_highbd_d117_predictor_32x32_c, 32,
+                                       12),
+                            make_tuple(&vp9_highbd_d135_predictor_4x4_ssse3,
+                                       &vp9_highbd_d135_predictor_4x4_c, 4, 12),
+                            make_tuple(&vp9_highbd_d135_predictor_8x8_ssse3,
+                                       &vp9_highbd_d135_predictor_8x8_c, 8, 12),
+                            make_tuple(&vp9_highbd_d135_predictor_16x16_ssse3,
+                                       &vp9_highbd_d135_predictor_16x16_c, 16,
+                                       12),
+                            make_tuple(&vp9_highbd_d135_predictor_32x32_ssse3,
+                                       &vp9_highbd_d135_predictor_32x32_c, 32,
+                                       12),
+                            make_tuple(&vp9_highbd_d153_predictor_4x4_ssse3,
+                                       &vp9_highbd_d153_predictor_4x4_c, 4, 12),
+                            make_tuple(&vp9_highbd_d153_predictor_8x8_ssse3,
+                                       &vp9_highbd_d153_predictor_8x8_c, 8, 12),
+                            make_tuple(&vp9_highbd_d153_predictor_16x16_ssse3,
+                                       &vp9_highbd_d153_predictor_16x16_c, 16,
+                                       12),
+                            make_tuple(&vp9_highbd_d153_predictor_32x32_ssse3,
+                                       &vp9_highbd_d153_predictor_32x32_c, 32,
+                                       12)));
+#endif  // CONFIG_VP9_HIGHBITDEPTH
+
+INSTANTIATE_TEST_CASE_P(SSSE3_TO_C, VP9LowbdIntraPredTest,
+                        ::testing::Values(
+                            make_tuple(&vp9_d117_predictor_4x4_ssse3,
+                                       &vp9_d117_predictor_4x4_c, 4),
+                            make_tuple(&vp9_d117_predictor_8x8_ssse3,
+                                       &vp9_d117_predictor_8x8_c, 8),
+                            make_tuple(&vp9_d117_predictor_16x16_ssse3,
+                                       &vp9_d117_predictor_16x16_c, 16),
+                            make_tuple(&vp9_d117_predictor_32x32_ssse3,
+                                       &vp9_d117_predictor_32x32_c, 32),
+                            make_tuple(&vp9_d135_predictor_4x4_ssse3,
+                                       &vp9_d135_predictor_4x4_c, 4),
+                            make_tuple(&vp9_d135_predictor_8x8_ssse3,
+                                       &vp9_d135_predictor_8x8_c, 8),
+                            make_tuple(&vp9_d135_predictor_16x16_ssse3,
+                                       &vp9_d135_predictor_16x16_c, 16),
+                            make_tuple(&vp9_d135_predictor_32x32_ssse3,
+                                       &vp9_d135_predictor_32x32_c, 32),
+                            make_tuple(&vp9_d153_predictor_32x32_ssse3,
+                                       &vp9_d153_predictor_32x32_c, 32)));
+#endif  // HAVE_SSSE3
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_CASE_P(AVX2_TO_C, VP9LowbdIntraPredTest,
+                        ::testing::Values(
+                            make_tuple(&vp9_d117_predictor_32x32_avx2,
+                                       &vp9_d117_predictor_32x32_c, 32),
+                            make_tuple(&vp9_d135_predictor_32x32_avx2,
+                                       &vp9_d135_predictor_32x32_c, 32),
+                            make_tuple(&vp9_d153_predictor_32x32_avx2,
+                                       &vp9_d153_predictor_32x32_c, 32)));
+#endif  // HAVE_AVX2
 }  // namespace
@@ -0,0 +1,205 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "third_party/googletest/src/include/gtest/gtest.h"
+
+#include "test/acm_random.h"
+#include "test/clear_system_state.h"
+#include "test/register_state_check.h"
+#include "test/util.h"
+#include "./vpx_config.h"
+#include "./vp9_rtcd.h"
+#include "./vpx_dsp_rtcd.h"
+#include "vp9/common/vp9_blockd.h"
+#include "vp9/common/vp9_entropymv.h"
+#include "vp9/encoder/vp9_block.h"
+#include "vp9/encoder/vp9_mcomp.h"
+#include "vpx/vpx_integer.h"
+#include "vpx_ports/mem.h"
+#include "vpx_ports/vpx_timer.h"
+
+using libvpx_test::ACMRandom;
+
+namespace {
+
+const int kBlockSize = 16;
+// The block is searched over MVs within kRange pixels in each direction.
+const int kRange = 80;
+const int kStride = 2 * kRange + kBlockSize + 16;
+const int kRefRows = 2 * kRange + kBlockSize;
+const int kNumIterations = 1000;
+
+// (test function, reference function)
+typedef std::tr1::tuple<vp9_diamond_search_fn_t, vp9_diamond_search_fn_t>
+    MotionSearchParam;
+
+class MotionSearchTest : public ::testing::TestWithParam<MotionSearchParam> {
+ public:
+  virtual ~MotionSearchTest() {}
+
+  virtual void SetUp() {
+    search_ = GET_PARAM(0);
+    ref_search_ = GET_PARAM(1);
+    rnd_.Reset(ACMRandom::DeterministicSeed());
+    x_ = new MACROBLOCK;
+    memset(x_, 0, sizeof(*x_));
+    x_->plane[0].src.buf = src_;
+    x_->plane[0].src.stride = kStride;
+    x_->e_mbd.plane[0].pre[0].buf = ref_ + kRange * kStride + kRange;
+    x_->e_mbd.plane[0].pre[0].stride = kStride;
+    x_->nmvsadcost[0] = &mvsadcost_[0][MV_MAX];
+    x_->nmvsadcost[1] = &mvsadcost_[1][MV_MAX];
+    memset(&fn_ptr_, 0, sizeof(fn_ptr_));
+    fn_ptr_.sdf = vpx_sad16x16;
+    fn_ptr_.sdx4df = vpx_sad16x16x4d;
+  }
+
+  virtual void TearDown() {
+    delete x_;
+    libvpx_test::ClearSystemState();
+  }
+
+ protected:
+  // Flat content and a zero cost weight produce many equal totals, which
+  // checks that ties are resolved like the reference.
+  void FillRandom(bool flat) {
+    const int mask = flat ? 3 : 255;
+    for (int i = 0; i < kBlockSize * kStride; ++i)
+      src_[i] = rnd_.Rand8() & mask;
+    for (int i = 0; i < kRefRows * kStride; ++i)
+      ref_[i] = rnd_.Rand8() & mask;
+    for (int i = 0; i < MV_VALS; ++i) {
+      mvsadcost_[0][i] = rnd_(1024);
+      mvsadcost_[1][i] = rnd_(1024);
+    }
+    for (int i = 0; i < MV_JOINTS; ++i)
+      x_->nmvjointsadcost[i] = rnd_(512);
+    x_->mv_row_min = -kRange + rnd_(kRange / 2);
+    x_->mv_row_max = kRange - rnd_(kRange / 2);
+    x_->mv_col_min = -kRange + rnd_(kRange / 2);
+    x_->mv_col_max = kRange - rnd_(kRange / 2);
+  }
+
+  // Returns a full pel MV that may lie outside the search range.
+  MV RandomMv() {
+    const MV mv = { static_cast<int16_t>(rnd_(2 * kRange + 1) - kRange),
+                    static_cast<int16_t>(rnd_(2 * kRange + 1) - kRange) };
+    return mv;
+  }
+
+  void CheckSearch(const search_site_config *cfg, int search_param,
+                   int sad_per_bit) {
+    const MV start_mv = RandomMv();
+    const MV center_mv = { static_cast<int16_t>(RandomMv().row * 8),
+                           static_cast<int16_t>(RandomMv().col * 8) };
+    MV ref_mv = start_mv, ref_best_mv;
+    MV mv = start_mv, best_mv;
+    int ref_num00, num00;
+    int ref_sad, sad;
+
+    ref_sad = ref_search_(x_, cfg, &ref_mv, &ref_best_mv, search_param,
+                          sad_per_bit, &ref_num00, &fn_ptr_, &center_mv);
+    ASM_REGISTER_STATE_CHECK(
+        sad = search_(x_, cfg, &mv, &best_mv, search_param, sad_per_bit,
+                      &num00, &fn_ptr_, &center_mv));
+    EXPECT_EQ(ref_sad, sad);
+    EXPECT_EQ(ref_mv.row, mv.row);
+    EXPECT_EQ(ref_mv.col, mv.col);
+    EXPECT_EQ(ref_best_mv.row, best_mv.row)
+        << "search_param " << search_param << " start " << start_mv.row
+        << "," << start_mv.col;
+    EXPECT_EQ(ref_best_mv.col, best_mv.col)
+        << "search_param " << search_param << " start " << start_mv.row
+        << "," << start_mv.col;
+    EXPECT_EQ(ref_num00, num00);
+  }
+
+  void CheckSearches(const search_site_config *cfg) {
+    for (int i = 0; i < kNumIterations; ++i) {
+      FillRandom(i & 1);
+      CheckSearch(cfg, i % MAX_MVSEARCH_STEPS, (i & 2) ? rnd_(128) : 0);
+      if (HasFailure()) return;
+    }
+  }
+
+  void RunSpeedTest(const search_site_config *cfg) {
+    const int kCountSpeedTestBlock = 20000;
+    vp9_diamond_search_fn_t funcs[2] = { ref_search_, search_ };
+    const char *const names[2] = { "reference", "test" };
+
+    FillRandom(false);
+    // Keep the full range search short enough to repeat.
+    x_->mv_row_min = x_->mv_col_min = -16;
+    x_->mv_row_max = x_->mv_col_max = 16;
+    for (int f = 0; f < 2; ++f) {
+      vpx_usec_timer timer;
+      vpx_usec_timer_start(&timer);
+      for (int i = 0; i < kCountSpeedTestBlock; ++i) {
+        MV mv = { 0, 0 }, best_mv;
+        const MV center_mv = { 0, 0 };
+        int num00;
+        funcs[f](x_, cfg, &mv, &best_mv, 0, 64, &num00, &fn_ptr_, &center_mv);
+      }
+      vpx_usec_timer_mark(&timer);
+      printf("Motion search (%s, %d per step): %d us\n", names[f],
+             cfg->searches_per_step,
+             static_cast<int>(vpx_usec_timer_elapsed(&timer)));
+    }
+  }
+
+  vp9_diamond_search_fn_t search_;
+  vp9_diamond_search_fn_t ref_search_;
+  ACMRandom rnd_;
+  MACROBLOCK *x_;
+  vp9_variance_fn_ptr_t fn_ptr_;
+  int mvsadcost_[2][MV_VALS];
+  uint8_t src_[kBlockSize * kStride];
+  uint8_t ref_[kRefRows * kStride];
+};
+
+TEST_P(MotionSearchTest, FourPointDiamond) {
+  search_site_config cfg;
+  vp9_init_dsmotion_compensation(&cfg, kStride);
+  CheckSearches(&cfg);
+}
+
+TEST_P(MotionSearchTest, EightPointDiamond) {
+  search_site_config cfg;
+  vp9_init3smotion_compensation(&cfg, kStride);
+  CheckSearches(&cfg);
+}
+
+TEST_P(MotionSearchTest, DISABLED_Speed) {
+  search_site_config cfg;
+  vp9_init_dsmotion_compensation(&cfg, kStride);
+  RunSpeedTest(&cfg);
+  vp9_init3smotion_compensation(&cfg, kStride);
+  RunSpeedTest(&cfg);
+}
+
+using std::tr1::make_tuple;
+
+INSTANTIATE_TEST_CASE_P(
+    C, MotionSearchTest,
+    ::testing::Values(
+        make_tuple(&vp9_diamond_search_sad_c, &vp9_diamond_search_sad_c),
+        make_tuple(&vp9_full_range_search_c, &vp9_full_range_search_c)));
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_CASE_P(
+    AVX2, MotionSearchTest,
+    ::testing::Values(
+        make_tuple(&vp9_diamond_search_sad_avx2, &vp9_diamond_search_sad_c),
+        make_tuple(&vp9_full_range_search_avx2, &vp9_full_range_search_c)));
+#endif  // HAVE_AVX2
+}  // namespace
@@ -0,0 +1,200 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "third_party/googletest/src/include/gtest/gtest.h"
+#include "test/codec_factory.h"
+#include "test/encode_test_driver.h"
+#include "test/i420_video_source.h"
+#include "test/md5_helper.h"
+#include "test/util.h"
+#include "vp9/encoder/vp9_firstpass.h"
+
+namespace {
+const int kFrames = 20;
+// The whole clip, long enough for the chunks to make up for each other's
+// rate control misses.
+const int kQualityFrames = 60;
+
+class VP9ParallelChunksTest
+    : public ::libvpx_test::EncoderTest,
+      public ::libvpx_test::CodecTestWith2Params<int, int> {
+ protected:
+  VP9ParallelChunksTest()
+      : EncoderTest(GET_PARAM(0)),
+        encoder_initialized_(false),
+        parallel_chunks_(GET_PARAM(1)),
+        kf_max_dist_(GET_PARAM(2)) {
+    vpx_codec_dec_cfg_t cfg = vpx_codec_dec_cfg_t();
+    cfg.w = 352;
+    cfg.h = 288;
+    decoder_ = codec_->CreateDecoder(cfg, 0);
+
+    md5_.clear();
+  }
+  virtual ~VP9ParallelChunksTest() {
+    delete decoder_;
+  }
+
+  virtual void SetUp() {
+    InitializeConfig();
+    SetMode(::libvpx_test::kTwoPassGood);
+
+    cfg_.g_lag_in_frames = 10;
+    cfg_.rc_end_usage = VPX_VBR;
+    cfg_.rc_target_bitrate = 500;
+    cfg_.kf_max_dist = kf_max_dist_;
+  }
+
+  virtual void BeginPassHook(unsigned int /*pass*/) {
+    encoder_initialized_ = false;
+    key_frame_pts_.clear();
+    total_bytes_ = 0;
+    psnr_sum_ = 0.0;
+    psnr_count_ = 0;
+  }
+
+  virtual void PreEncodeFrameHook(::libvpx_test::VideoSource * /*video*/,
+                                  ::libvpx_test::Encoder *encoder) {
+    if (!encoder_initialized_) {
+      encoder->Control(VP8E_SET_CPUUSED, 4);
+      encoder->Control(VP9E_SET_TILE_COLUMNS, 1);
+      encoder->Control(VP9E_SET_PARALLEL_CHUNKS, parallel_chunks_);
+      encoder_initialized_ = true;
+    }
+  }
+
+  virtual void FramePktHook(const vpx_codec_cx_pkt_t *pkt) {
+    if (pkt->data.frame.flags & VPX_FRAME_IS_KEY)
+      key_frame_pts_.push_back(pkt->data.frame.pts);
+    total_bytes_ += pkt->data.frame.sz;
+
+    const vpx_codec_err_t res = decoder_->DecodeFrame(
+        reinterpret_cast<uint8_t*>(pkt->data.frame.buf), pkt->data.frame.sz);
+    if (res != VPX_CODEC_OK) {
+      abort_ = true;
+      ASSERT_EQ(VPX_CODEC_OK, res);
+    }
+    ::libvpx_test::DxDataIterator dec_iter = decoder_->GetDxData();
+    const vpx_image_t *img;
+
+    while ((img = dec_iter.Next()) != NULL) {
+      ::libvpx_test::MD5 md5_res;
+      md5_res.Add(img);
+      md5_.push_back(md5_res.Get());
+    }
+  }
+
+  virtual void PSNRPktHook(const vpx_codec_cx_pkt_t *pkt) {
+    psnr_sum_ += pkt->data.psnr.psnr[0];
+    ++psnr_count_;
+  }
+
+  // The first frame of each chunk, as the encoder places them from the
+  // first pass stats.
+  std::vector<int> ChunkStarts() {
+    const vpx_fixed_buf_t stats = stats_.buf();
+    const int num_frames =
+        static_cast<int>(stats.sz / sizeof(FIRSTPASS_STATS)) - 1;
+    const int max_frames = std::max(
+        1, std::min(kf_max_dist_,
+                    (num_frames + parallel_chunks_ - 1) / parallel_chunks_));
+    std::vector<int> chunk_start(num_frames);
+    const int num_chunks = vp9_twopass_split_chunks(
+        static_cast<const FIRSTPASS_STATS *>(stats.buf), num_frames,
+        max_frames, &chunk_start[0]);
+    chunk_start.resize(num_chunks);
+    return chunk_start;
+  }
+
+  bool encoder_initialized_;
+  int parallel_chunks_;
+  int kf_max_dist_;
+  ::libvpx_test::Decoder *decoder_;
+  std::vector<std::string> md5_;
+  std::vector<vpx_codec_pts_t> key_frame_pts_;
+  size_t total_bytes_;
+  double psnr_sum_;
+  int psnr_count_;
+};
+
+TEST_P(VP9ParallelChunksTest, ThreadCountInvariant) {
+  std::vector<std::string> single_thr_md5, multi_thr_md5;
+
+  ::libvpx_test::I420VideoSource video("hantro_collage_w352h288.yuv", 352, 288,
+                                       30, 1, 0, kFrames);
+
+  // Every input frame must come out, and the chunk layout must not depend on
+  // the number of threads the application allows.
+  cfg_.g_threads = 1;
+  ASSERT_NO_FATAL_FAILURE(RunLoop(&video));
+  single_thr_md5 = md5_;
+  md5_.clear();
+  ASSERT_EQ(kFrames, static_cast<int>(single_thr_md5.size()));
+
+  cfg_.g_threads = 4;
+  ASSERT_NO_FATAL_FAILURE(RunLoop(&video));
+  multi_thr_md5 = md5_;
+  md5_.clear();
+
+  ASSERT_EQ(single_thr_md5, multi_thr_md5);
+}
+
+TEST_P(VP9ParallelChunksTest, ChunksStartWithKeyFrames) {
+  if (parallel_chunks_ < 2)
+    return;
+
+  ::libvpx_test::I420VideoSource video("hantro_collage_w352h288.yuv", 352, 288,
+                                       30, 1, 0, kFrames);
+  ASSERT_NO_FATAL_FAILURE(RunLoop(&video));
+
+  const std::vector<int> chunk_start = ChunkStarts();
+  ASSERT_LE(2u, chunk_start.size());
+  for (size_t i = 0; i < chunk_start.size(); ++i) {
+    EXPECT_NE(key_frame_pts_.end(),
+              std::find(key_frame_pts_.begin(), key_frame_pts_.end(),
+                        chunk_start[i]))
+        << "Chunk " << i << " does not start with a key frame";
+  }
+}
+
+TEST_P(VP9ParallelChunksTest, MatchesSingleEncoder) {
+  ::libvpx_test::I420VideoSource video("hantro_collage_w352h288.yuv", 352, 288,
+                                       30, 1, 0, kQualityFrames);
+  set_init_flags(VPX_CODEC_USE_PSNR);
+
+  const int parallel_chunks = parallel_chunks_;
+  parallel_chunks_ = 0;
+  ASSERT_NO_FATAL_FAILURE(RunLoop(&video));
+  const size_t single_bytes = total_bytes_;
+  const double single_psnr = psnr_sum_ / psnr_count_;
+  md5_.clear();
+
+  parallel_chunks_ = parallel_chunks;
+  ASSERT_NO_FATAL_FAILURE(RunLoop(&video));
+  const double chunks_psnr = psnr_sum_ / psnr_count_;
+
+  // Every shown frame has its PSNR packet, the chunks share the bit budget
+  // of the whole clip, or spend about what a single encoder does when key
+  // frames alone exceed it, and the extra key frames cost little quality.
+  const double budget_bytes =
+      cfg_.rc_target_bitrate * 1000.0 / 8 * kQualityFrames / 30;
+  EXPECT_EQ(kQualityFrames, psnr_count_);
+  EXPECT_LE(total_bytes_, 1.1 * std::max(budget_bytes,
+                                         static_cast<double>(single_bytes)));
+  EXPECT_GT(chunks_psnr, single_psnr - 1.5);
+}
+
+VP9_INSTANTIATE_TEST_CASE(VP9ParallelChunksTest,
+                          ::testing::Values(0, 2, 4),
+                          ::testing::Values(6, 9999));
+}  // namespace
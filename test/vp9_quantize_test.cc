@@ -21,6 +21,7 @@
 #include "./vpx_config.h"
 #include "./vp9_rtcd.h"
 #include "vp9/common/vp9_entropy.h"
+#include "vp9/common/vp9_quant_common.h"
 #include "vp9/common/vp9_scan.h"
 #include "vpx/vpx_codec.h"
 #include "vpx/vpx_integer.h"
@@ -348,4 +349,118 @@ INSTANTIATE_TEST_CASE_P(
                    &vp9_highbd_quantize_b_32x32_c, VPX_BITS_12)));
 #endif  // HAVE_SSE2
 #endif  // CONFIG_VP9_HIGHBITDEPTH
+
+#if !CONFIG_VP9_HIGHBITDEPTH
+const int number_of_iterations = 1000;
+
+typedef void (*QuantizeFunc)(const tran_low_t *coeff, intptr_t count,
+                             int skip_block, const int16_t *zbin,
+                             const int16_t *round, const int16_t *quant,
+                             const int16_t *quant_shift,
+                             tran_low_t *qcoeff, tran_low_t *dqcoeff,
+                             const int16_t *dequant,
+                             uint16_t *eob, const int16_t *scan,
+                             const int16_t *iscan);
+typedef std::tr1::tuple<QuantizeFunc, QuantizeFunc> QuantizeParam;
+
+class VP9QuantizeLowbdTest : public ::testing::TestWithParam<QuantizeParam> {
+ public:
+  virtual ~VP9QuantizeLowbdTest() {}
+  virtual void SetUp() {
+    quantize_op_ = GET_PARAM(0);
+    ref_quantize_op_ = GET_PARAM(1);
+  }
+
+  virtual void TearDown() { libvpx_test::ClearSystemState(); }
+
+ protected:
+  QuantizeFunc quantize_op_;
+  QuantizeFunc ref_quantize_op_;
+};
+
+TEST_P(VP9QuantizeLowbdTest, OperationCheck) {
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  DECLARE_ALIGNED(16, tran_low_t, coeff_ptr[256]);
+  DECLARE_ALIGNED(16, int16_t, zbin_ptr[2]);
+  DECLARE_ALIGNED(16, int16_t, round_ptr[2]);
+  DECLARE_ALIGNED(16, int16_t, quant_ptr[2]);
+  DECLARE_ALIGNED(16, int16_t, quant_shift_ptr[2]);
+  DECLARE_ALIGNED(16, tran_low_t, qcoeff_ptr[256]);
+  DECLARE_ALIGNED(16, tran_low_t, dqcoeff_ptr[256]);
+  DECLARE_ALIGNED(16, tran_low_t, ref_qcoeff_ptr[256]);
+  DECLARE_ALIGNED(16, tran_low_t, ref_dqcoeff_ptr[256]);
+  DECLARE_ALIGNED(16, int16_t, dequant_ptr[2]);
+  DECLARE_ALIGNED(16, uint16_t, eob_ptr[1]);
+  DECLARE_ALIGNED(16, uint16_t, ref_eob_ptr[1]);
+  int err_count_total = 0;
+  int first_failure = -1;
+  for (int i = 0; i < number_of_iterations; ++i) {
+    const int skip_block = i == 0;
+    const TX_SIZE sz = (TX_SIZE)(i % 3);  // TX_4X4, TX_8X8 TX_16X16
+    const TX_TYPE tx_type = (TX_TYPE)((i >> 2) % 3);
+    const scan_order *scan_order = &vp9_scan_orders[sz][tx_type];
+    const int count = (4 << sz) * (4 << sz);  // 16, 64, 256
+    int err_count = 0;
+    *eob_ptr = rnd.Rand16();
+    *ref_eob_ptr = *eob_ptr;
+    // Coefficients cover the whole 16-bit range, including both extremes.
+    // Every other block is mostly small values, like real residuals.
+    for (int j = 0; j < count; j++) {
+      if ((i & 1) && rnd(8))
+        coeff_ptr[j] = rnd(41) - 20;
+      else
+        coeff_ptr[j] = static_cast<int16_t>(rnd.Rand16());
+    }
+    coeff_ptr[rnd(count)] = -32768;
+    coeff_ptr[rnd(count)] = 32767;
+    // The parameters are derived the way vp9_init_quantizer() does.
+    const int q = rnd(QINDEX_RANGE);
+    const int qzbin_factor =
+        q == 0 ? 64 : (vp9_dc_quant(q, 0, VPX_BITS_8) < 148 ? 84 : 80);
+    const int qrounding_factor = q == 0 ? 64 : 48;
+    for (int j = 0; j < 2; j++) {
+      const int d = j == 0 ? vp9_dc_quant(q, 0, VPX_BITS_8)
+                           : vp9_ac_quant(q, 0, VPX_BITS_8);
+      int l = 0;
+      while ((d >> (l + 1)) > 0) ++l;
+      zbin_ptr[j] = (qzbin_factor * d + 64) >> 7;
+      round_ptr[j] = (qrounding_factor * d) >> 7;
+      quant_ptr[j] = static_cast<int16_t>(1 + (1 << (16 + l)) / d - (1 << 16));
+      quant_shift_ptr[j] = 1 << (16 - l);
+      dequant_ptr[j] = d;
+    }
+    ref_quantize_op_(coeff_ptr, count, skip_block, zbin_ptr, round_ptr,
+                     quant_ptr, quant_shift_ptr, ref_qcoeff_ptr,
+                     ref_dqcoeff_ptr, dequant_ptr,
+                     ref_eob_ptr, scan_order->scan, scan_order->iscan);
+    ASM_REGISTER_STATE_CHECK(quantize_op_(coeff_ptr, count, skip_block,
+                                          zbin_ptr, round_ptr, quant_ptr,
+                                          quant_shift_ptr, qcoeff_ptr,
+                                          dqcoeff_ptr, dequant_ptr, eob_ptr,
+                                          scan_order->scan, scan_order->iscan));
+    for (int j = 0; j < count; ++j) {
+      err_count += (ref_qcoeff_ptr[j]  != qcoeff_ptr[j]) |
+          (ref_dqcoeff_ptr[j] != dqcoeff_ptr[j]);
+    }
+    err_count += (*ref_eob_ptr != *eob_ptr);
+    if (err_count && !err_count_total) {
+      first_failure = i;
+    }
+    err_count_total += err_count;
+  }
+  EXPECT_EQ(0, err_count_total)
+      << "Error: Quantization Test, C output doesn't match SIMD output. "
+      << "First failed at test case " << first_failure;
+}
+
+using std::tr1::make_tuple;
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_CASE_P(
+    AVX2, VP9QuantizeLowbdTest,
+    ::testing::Values(
+        make_tuple(&vp9_quantize_b_avx2, &vp9_quantize_b_c),
+        make_tuple(&vp9_quantize_fp_avx2, &vp9_quantize_fp_c)));
+#endif  // HAVE_AVX2
+#endif  // !CONFIG_VP9_HIGHBITDEPTH
 }  // namespace
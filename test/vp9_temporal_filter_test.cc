@@ -0,0 +1,225 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "third_party/googletest/src/include/gtest/gtest.h"
+
+#include "test/acm_random.h"
+#include "test/clear_system_state.h"
+#include "test/register_state_check.h"
+#include "test/util.h"
+#include "./vpx_config.h"
+#include "./vp9_rtcd.h"
+#include "vpx/vpx_integer.h"
+#include "vpx_ports/mem.h"
+#include "vpx_ports/vpx_timer.h"
+
+using libvpx_test::ACMRandom;
+
+namespace {
+
+const int kMaxBlockSize = 16;
+const int kStride = 2 * kMaxBlockSize;
+const int kNumIterations = 1000;
+
+typedef void (*TemporalFilterApplyFunc)(uint8_t *frame1, unsigned int stride,
+                                        uint8_t *frame2,
+                                        unsigned int block_width,
+                                        unsigned int block_height,
+                                        int strength, int filter_weight,
+                                        unsigned int *accumulator,
+                                        uint16_t *count);
+
+// (test function, reference function, bit depth)
+typedef std::tr1::tuple<TemporalFilterApplyFunc, TemporalFilterApplyFunc, int>
+    TemporalFilterParam;
+
+class TemporalFilterTest
+    : public ::testing::TestWithParam<TemporalFilterParam> {
+ public:
+  virtual ~TemporalFilterTest() {}
+
+  virtual void SetUp() {
+    apply_ = GET_PARAM(0);
+    ref_apply_ = GET_PARAM(1);
+    bit_depth_ = GET_PARAM(2);
+    mask_ = (1 << bit_depth_) - 1;
+    rnd_.Reset(ACMRandom::DeterministicSeed());
+  }
+
+  virtual void TearDown() { libvpx_test::ClearSystemState(); }
+
+ protected:
+  uint8_t *Frame1() {
+#if CONFIG_VP9_HIGHBITDEPTH
+    if (bit_depth_ > 8) return CONVERT_TO_BYTEPTR(frame1_16_);
+#endif
+    return frame1_;
+  }
+
+  uint8_t *Frame2() {
+#if CONFIG_VP9_HIGHBITDEPTH
+    if (bit_depth_ > 8) return CONVERT_TO_BYTEPTR(frame2_16_);
+#endif
+    return frame2_;
+  }
+
+  void SetPixel(bool source, int i, int value) {
+#if CONFIG_VP9_HIGHBITDEPTH
+    if (bit_depth_ > 8) {
+      (source ? frame1_16_ : frame2_16_)[i] = value;
+      return;
+    }
+#endif
+    (source ? frame1_ : frame2_)[i] = value;
+  }
+
+  // Pixels far apart give the largest differences, and pixels close
+  // together the ones that are not clamped by the weighting.
+  void FillRandom() {
+    const int mode = rnd_(3);
+    for (int i = 0; i < kMaxBlockSize * kStride; ++i) {
+      const int a = rnd_.Rand16() & mask_;
+      int b;
+      if (mode == 0)
+        b = rnd_.Rand16() & mask_;
+      else if (mode == 1)
+        b = (a + (rnd_(33) - 16)) & mask_;
+      else
+        b = (rnd_.Rand8() & 1) ? mask_ : 0;
+      SetPixel(true, i, mode == 2 ? mask_ - b : a);
+      SetPixel(false, i, b);
+    }
+    for (int i = 0; i < kMaxBlockSize * kMaxBlockSize; ++i) {
+      accumulator_[i] = rnd_.Rand16() * 16;
+      count_[i] = rnd_.Rand16();
+    }
+  }
+
+  void CheckApply(int width, int height, int strength, int filter_weight) {
+    unsigned int ref_accumulator[kMaxBlockSize * kMaxBlockSize];
+    uint16_t ref_count[kMaxBlockSize * kMaxBlockSize];
+
+    memcpy(ref_accumulator, accumulator_, sizeof(ref_accumulator));
+    memcpy(ref_count, count_, sizeof(ref_count));
+    ref_apply_(Frame1(), kStride, Frame2(), width, height, strength,
+               filter_weight, ref_accumulator, ref_count);
+    ASM_REGISTER_STATE_CHECK(apply_(Frame1(), kStride, Frame2(), width,
+                                    height, strength, filter_weight,
+                                    accumulator_, count_));
+    for (int i = 0; i < width * height; ++i) {
+      EXPECT_EQ(ref_accumulator[i], accumulator_[i])
+          << width << "x" << height << " strength " << strength
+          << " weight " << filter_weight << " at " << i;
+      EXPECT_EQ(ref_count[i], count_[i])
+          << width << "x" << height << " strength " << strength
+          << " weight " << filter_weight << " at " << i;
+      if (HasFailure()) return;
+    }
+  }
+
+  TemporalFilterApplyFunc apply_;
+  TemporalFilterApplyFunc ref_apply_;
+  int bit_depth_;
+  int mask_;
+  ACMRandom rnd_;
+  uint8_t frame1_[kMaxBlockSize * kStride];
+  uint8_t frame2_[kMaxBlockSize * kStride];
+#if CONFIG_VP9_HIGHBITDEPTH
+  uint16_t frame1_16_[kMaxBlockSize * kStride];
+  uint16_t frame2_16_[kMaxBlockSize * kStride];
+#endif
+  unsigned int accumulator_[kMaxBlockSize * kMaxBlockSize];
+  uint16_t count_[kMaxBlockSize * kMaxBlockSize];
+};
+
+TEST_P(TemporalFilterTest, CompareToReference) {
+  // The luma block and the chroma blocks of the subsampling modes.
+  const int sizes[][2] = { { 16, 16 }, { 8, 8 }, { 8, 16 }, { 16, 8 } };
+  // The encoder raises the strength by 2 per bit above 8.
+  const int max_strength = 6 + 2 * (bit_depth_ - 8);
+
+  for (int i = 0; i < kNumIterations; ++i) {
+    const int *const size = sizes[i % 4];
+    FillRandom();
+    CheckApply(size[0], size[1], rnd_(max_strength + 1), rnd_(3));
+    if (HasFailure()) return;
+  }
+}
+
+TEST_P(TemporalFilterTest, DISABLED_Speed) {
+  const int kCountSpeedTestBlock = 1000000;
+  TemporalFilterApplyFunc funcs[2] = { ref_apply_, apply_ };
+  const char *const names[2] = { "reference", "test" };
+  const int strength = 6 + 2 * (bit_depth_ - 8);
+
+  FillRandom();
+  for (int f = 0; f < 2; ++f) {
+    vpx_usec_timer timer;
+    vpx_usec_timer_start(&timer);
+    for (int i = 0; i < kCountSpeedTestBlock; ++i)
+      funcs[f](Frame1(), kStride, Frame2(), 16, 16, strength, 2,
+               accumulator_, count_);
+    vpx_usec_timer_mark(&timer);
+    printf("Temporal filter 16x16 (%s, %d bit): %d us\n", names[f],
+           bit_depth_, static_cast<int>(vpx_usec_timer_elapsed(&timer)));
+  }
+}
+
+using std::tr1::make_tuple;
+
+INSTANTIATE_TEST_CASE_P(
+    C, TemporalFilterTest,
+    ::testing::Values(make_tuple(&vp9_temporal_filter_apply_c,
+                                 &vp9_temporal_filter_apply_c, 8)));
+
+#if HAVE_SSE2
+INSTANTIATE_TEST_CASE_P(
+    SSE2, TemporalFilterTest,
+    ::testing::Values(make_tuple(&vp9_temporal_filter_apply_sse2,
+                                 &vp9_temporal_filter_apply_c, 8)));
+#endif  // HAVE_SSE2
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_CASE_P(
+    AVX2, TemporalFilterTest,
+    ::testing::Values(make_tuple(&vp9_temporal_filter_apply_avx2,
+                                 &vp9_temporal_filter_apply_c, 8)));
+#endif  // HAVE_AVX2
+
+#if CONFIG_VP9_HIGHBITDEPTH
+INSTANTIATE_TEST_CASE_P(
+    C_HIGH, TemporalFilterTest,
+    ::testing::Values(make_tuple(&vp9_highbd_temporal_filter_apply_c,
+                                 &vp9_highbd_temporal_filter_apply_c, 10),
+                      make_tuple(&vp9_highbd_temporal_filter_apply_c,
+                                 &vp9_highbd_temporal_filter_apply_c, 12)));
+
+#if HAVE_SSE4_1
+INSTANTIATE_TEST_CASE_P(
+    SSE4_1_HIGH, TemporalFilterTest,
+    ::testing::Values(make_tuple(&vp9_highbd_temporal_filter_apply_sse4_1,
+                                 &vp9_highbd_temporal_filter_apply_c, 10),
+                      make_tuple(&vp9_highbd_temporal_filter_apply_sse4_1,
+                                 &vp9_highbd_temporal_filter_apply_c, 12)));
+#endif  // HAVE_SSE4_1
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_CASE_P(
+    AVX2_HIGH, TemporalFilterTest,
+    ::testing::Values(make_tuple(&vp9_highbd_temporal_filter_apply_avx2,
+                                 &vp9_highbd_temporal_filter_apply_c, 10),
+                      make_tuple(&vp9_highbd_temporal_filter_apply_avx2,
+                                 &vp9_highbd_temporal_filter_apply_c, 12)));
+#endif  // HAVE_AVX2
+#endif  // CONFIG_VP9_HIGHBITDEPTH
+}  // namespace
@@ -38,42 +38,73 @@ void vp9_free_internal_frame_buffers(InternalFrameBufferList *list) {
   list->int_fb = NULL;
 }
 
+// Rounds |size| up to a multiple of an eighth of the largest power of two
+// not above it, so that a buffer holds frames a little larger than the one
+// it was allocated for, at the cost of at most an eighth more memory.
+static size_t get_size_class(size_t size) {
+  size_t step = 1;
+  size_t rounded;
+  while ((step << 4) <= size)
+    step <<= 1;
+  rounded = (size + step - 1) & ~(step - 1);
+  return rounded < size ? size : rounded;
+}
+
 int vp9_get_frame_buffer(void *cb_priv, size_t min_size,
                          vpx_codec_frame_buffer_t *fb) {
   int i;
+  int best = -1;
+  int smallest = -1;
+  InternalFrameBuffer *int_fb;
   InternalFrameBufferList *const int_fb_list =
       (InternalFrameBufferList *)cb_priv;
   if (int_fb_list == NULL)
     return -1;
 
-  // Find a free frame buffer.
+  // Find the smallest free frame buffer that is large enough, and the
+  // smallest free one to reallocate if none is.
   for (i = 0; i < int_fb_list->num_internal_frame_buffers; ++i) {
-    if (!int_fb_list->int_fb[i].in_use)
-      break;
+    const InternalFrameBuffer *const buf = &int_fb_list->int_fb[i];
+    if (buf->in_use)
+      continue;
+    if (buf->size >= min_size &&
+        (best < 0 || buf->size < int_fb_list->int_fb[best].size))
+      best = i;
+    if (smallest < 0 || buf->size < int_fb_list->int_fb[smallest].size)
+      smallest = i;
   }
 
-  if (i == int_fb_list->num_internal_frame_buffers)
+  if (smallest < 0)
     return -1;
 
-  if (int_fb_list->int_fb[i].size < min_size) {
-    int_fb_list->int_fb[i].data =
-        (uint8_t *)vpx_realloc(int_fb_list->int_fb[i].data, min_size);
-    if (!int_fb_list->int_fb[i].data)
+  if (best < 0) {
+    const size_t alloc_size = get_size_class(
+        min_size > int_fb_list->size_hint ? min_size : int_fb_list->size_hint);
+    int_fb = &int_fb_list->int_fb[smallest];
+
+    // The contents need not be kept, so free first rather than realloc and
+    // copy them.
+    vpx_free(int_fb->data);
+    int_fb->size = 0;
+    int_fb->data = (uint8_t *)vpx_malloc(alloc_size);
+    if (!int_fb->data)
       return -1;
 
     // This memset is needed for fixing valgrind error from C loop filter
     // due to access uninitialized memory in frame border. It could be
     // removed if border is totally removed.
-    memset(int_fb_list->int_fb[i].data, 0, min_size);
-    int_fb_list->int_fb[i].size = min_size;
+    memset(int_fb->data, 0, alloc_size);
+    int_fb->size = alloc_size;
+  } else {
+    int_fb = &int_fb_list->int_fb[best];
   }
 
-  fb->data = int_fb_list->int_fb[i].data;
-  fb->size = int_fb_list->int_fb[i].size;
-  int_fb_list->int_fb[i].in_use = 1;
+  fb->data = int_fb->data;
+  fb->size = int_fb->size;
+  int_fb->in_use = 1;
 
   // Set the frame buffer's private data to point at the internal frame buffer.
-  fb->priv = &int_fb_list->int_fb[i];
+  fb->priv = int_fb;
   return 0;
 }
 
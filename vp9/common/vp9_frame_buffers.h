@@ -27,6 +27,10 @@ typedef struct InternalFrameBuffer {
 typedef struct InternalFrameBufferList {
   int num_internal_frame_buffers;
   InternalFrameBuffer *int_fb;
+  // Smallest size in bytes to allocate a frame buffer with, so that frames
+  // up to the size the application expects do not grow the buffers. 0 when
+  // there is no hint.
+  size_t size_hint;
 } InternalFrameBufferList;
 
 // Initializes |list|. Returns 0 on success.
@@ -39,6 +43,10 @@ void vp9_free_internal_frame_buffers(InternalFrameBufferList *list);
 // Callback private data, which points to an InternalFrameBufferList.
 // |min_size| is the minimum size in bytes needed to decode the next frame.
 // |fb| pointer to the frame buffer.
+// Returns the smallest free buffer that holds |min_size|, so that buffers
+// allocated for larger frames serve the smaller ones after a resolution
+// change. Otherwise the smallest free buffer is reallocated, rounded up to a
+// size class of an eighth of a power of two, or to the size hint.
 int vp9_get_frame_buffer(void *cb_priv, size_t min_size,
                          vpx_codec_frame_buffer_t *fb);
 
@@ -15,24 +15,6 @@
 #include "vp9/common/vp9_reconinter.h"
 #include "vp9/common/vp9_loopfilter.h"
 
-#if CONFIG_MULTITHREAD
-static INLINE void mutex_lock(pthread_mutex_t *const mutex) {
-  const int kMaxTryLocks = 4000;
-  int locked = 0;
-  int i;
-
-  for (i = 0; i < kMaxTryLocks; ++i) {
-    if (!pthread_mutex_trylock(mutex)) {
-      locked = 1;
-      break;
-    }
-  }
-
-  if (!locked)
-    pthread_mutex_lock(mutex);
-}
-#endif  // CONFIG_MULTITHREAD
-
 static INLINE void sync_read(VP9LfSync *const lf_sync, int r, int c) {
 #if CONFIG_MULTITHREAD
   const int nsync = lf_sync->sync_range;
@@ -85,6 +67,60 @@ static INLINE void sync_write(VP9LfSync *const lf_sync, int r, int c,
 #endif  // CONFIG_MULTITHREAD
 }
 
+static INLINE enum lf_path get_lf_path(
+    const struct macroblockd_plane planes[MAX_MB_PLANE], int y_only) {
+  if (y_only)
+    return LF_PATH_444;
+  else if (planes[1].subsampling_y == 1 && planes[1].subsampling_x == 1)
+    return LF_PATH_420;
+  else if (planes[1].subsampling_y == 0 && planes[1].subsampling_x == 0)
+    return LF_PATH_444;
+  else
+    return LF_PATH_SLOW;
+}
+
+static INLINE void filter_sb_row(const YV12_BUFFER_CONFIG *const frame_buffer,
+                                 VP9_COMMON *const cm,
+                                 struct macroblockd_plane planes[MAX_MB_PLANE],
+                                 int mi_row, int num_planes, enum lf_path path,
+                                 VP9LfSync *const lf_sync) {
+  const int sb_cols = mi_cols_aligned_to_sb(cm->mi_cols) >> MI_BLOCK_SIZE_LOG2;
+  MODE_INFO **const mi = cm->mi_grid_visible + mi_row * cm->mi_stride;
+  int mi_col;
+
+  for (mi_col = 0; mi_col < cm->mi_cols; mi_col += MI_BLOCK_SIZE) {
+    const int r = mi_row >> MI_BLOCK_SIZE_LOG2;
+    const int c = mi_col >> MI_BLOCK_SIZE_LOG2;
+    LOOP_FILTER_MASK lfm;
+    int plane;
+
+    sync_read(lf_sync, r, c);
+
+    vp9_setup_dst_planes(planes, frame_buffer, mi_row, mi_col);
+
+    // TODO(JBB): Make setup_mask work for non 420.
+    vp9_setup_mask(cm, mi_row, mi_col, mi + mi_col, cm->mi_stride, &lfm);
+
+    vp9_filter_block_plane_ss00(cm, &planes[0], mi_row, &lfm);
+    for (plane = 1; plane < num_planes; ++plane) {
+      switch (path) {
+        case LF_PATH_420:
+          vp9_filter_block_plane_ss11(cm, &planes[plane], mi_row, &lfm);
+          break;
+        case LF_PATH_444:
+          vp9_filter_block_plane_ss00(cm, &planes[plane], mi_row, &lfm);
+          break;
+        case LF_PATH_SLOW:
+          vp9_filter_block_plane_non420(cm, &planes[plane], mi + mi_col,
+                                        mi_row, mi_col);
+          break;
+      }
+    }
+
+    sync_write(lf_sync, r, c, sb_cols);
+  }
+}
+
 // Implement row loopfiltering for each thread.
 static INLINE
 void thread_loop_filter_rows(const YV12_BUFFER_CONFIG *const frame_buffer,
@@ -93,57 +129,23 @@ void thread_loop_filter_rows(const YV12_BUFFER_CONFIG *const frame_buffer,
                              int start, int stop, int y_only,
                              VP9LfSync *const lf_sync) {
   const int num_planes = y_only ? 1 : MAX_MB_PLANE;
-  const int sb_cols = mi_cols_aligned_to_sb(cm->mi_cols) >> MI_BLOCK_SIZE_LOG2;
-  int mi_row, mi_col;
-  enum lf_path path;
-  if (y_only)
-    path = LF_PATH_444;
-  else if (planes[1].subsampling_y == 1 && planes[1].subsampling_x == 1)
-    path = LF_PATH_420;
-  else if (planes[1].subsampling_y == 0 && planes[1].subsampling_x == 0)
-    path = LF_PATH_444;
-  else
-    path = LF_PATH_SLOW;
+  const enum lf_path path = get_lf_path(planes, y_only);
+  int mi_row;
 
   for (mi_row = start; mi_row < stop;
        mi_row += lf_sync->num_workers * MI_BLOCK_SIZE) {
-    MODE_INFO **const mi = cm->mi_grid_visible + mi_row * cm->mi_stride;
-
-    for (mi_col = 0; mi_col < cm->mi_cols; mi_col += MI_BLOCK_SIZE) {
-      const int r = mi_row >> MI_BLOCK_SIZE_LOG2;
-      const int c = mi_col >> MI_BLOCK_SIZE_LOG2;
-      LOOP_FILTER_MASK lfm;
-      int plane;
-
-      sync_read(lf_sync, r, c);
-
-      vp9_setup_dst_planes(planes, frame_buffer, mi_row, mi_col);
-
-      // TODO(JBB): Make setup_mask work for non 420.
-      vp9_setup_mask(cm, mi_row, mi_col, mi + mi_col, cm->mi_stride,
-                     &lfm);
-
-      vp9_filter_block_plane_ss00(cm, &planes[0], mi_row, &lfm);
-      for (plane = 1; plane < num_planes; ++plane) {
-        switch (path) {
-          case LF_PATH_420:
-            vp9_filter_block_plane_ss11(cm, &planes[plane], mi_row, &lfm);
-            break;
-          case LF_PATH_444:
-            vp9_filter_block_plane_ss00(cm, &planes[plane], mi_row, &lfm);
-            break;
-          case LF_PATH_SLOW:
-            vp9_filter_block_plane_non420(cm, &planes[plane], mi + mi_col,
-                                          mi_row, mi_col);
-            break;
-        }
-      }
-
-      sync_write(lf_sync, r, c, sb_cols);
-    }
+    filter_sb_row(frame_buffer, cm, planes, mi_row, num_planes, path, lf_sync);
   }
 }
 
+void vp9_loop_filter_sb_row(const YV12_BUFFER_CONFIG *frame_buffer,
+                            VP9_COMMON *cm,
+                            struct macroblockd_plane planes[MAX_MB_PLANE],
+                            int mi_row, int y_only, VP9LfSync *lf_sync) {
+  filter_sb_row(frame_buffer, cm, planes, mi_row, y_only ? 1 : MAX_MB_PLANE,
+                get_lf_path(planes, y_only), lf_sync);
+}
+
 // Row-based multi-threaded loopfilter hook
 static int loop_filter_row_worker(VP9LfSync *const lf_sync,
                                   LFWorkerData *const lf_data) {
@@ -162,10 +164,7 @@ static void loop_filter_rows_mt(YV12_BUFFER_CONFIG *frame,
   const VP9WorkerInterface *const winterface = vp9_get_worker_interface();
   // Number of superblock rows and cols
   const int sb_rows = mi_cols_aligned_to_sb(cm->mi_rows) >> MI_BLOCK_SIZE_LOG2;
-  // Decoder may allocate more threads than number of tiles based on user's
-  // input.
-  const int tile_cols = 1 << cm->log2_tile_cols;
-  const int num_workers = MIN(nworkers, tile_cols);
+  const int num_workers = nworkers;
   int i;
 
   if (!lf_sync->sync_range || sb_rows != lf_sync->rows ||
@@ -178,13 +177,6 @@ static void loop_filter_rows_mt(YV12_BUFFER_CONFIG *frame,
   memset(lf_sync->cur_sb_col, -1, sizeof(*lf_sync->cur_sb_col) * sb_rows);
 
   // Set up loopfilter thread data.
-  // The decoder is capping num_workers because it has been observed that using
-  // more threads on the loopfilter than there are cores will hurt performance
-  // on Android. This is because the system will only schedule the tile decode
-  // workers on cores equal to the number of tile columns. Then if the decoder
-  // tries to use more threads for the loopfilter, it will hurt performance
-  // because of contention. If the multithreading code changes in the future
-  // then the number of workers used by the loopfilter should be revisited.
   for (i = 0; i < num_workers; ++i) {
     VP9Worker *const worker = &workers[i];
     LFWorkerData *const lf_data = &lf_sync->lfdata[i];
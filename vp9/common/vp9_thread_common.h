@@ -17,6 +17,26 @@
 struct VP9Common;
 struct FRAME_COUNTS;
 
+#if CONFIG_MULTITHREAD
+// Spins on the mutex for a while before blocking, since the row sync locks
+// are only held briefly.
+static INLINE void mutex_lock(pthread_mutex_t *const mutex) {
+  const int kMaxTryLocks = 4000;
+  int locked = 0;
+  int i;
+
+  for (i = 0; i < kMaxTryLocks; ++i) {
+    if (!pthread_mutex_trylock(mutex)) {
+      locked = 1;
+      break;
+    }
+  }
+
+  if (!locked)
+    pthread_mutex_lock(mutex);
+}
+#endif  // CONFIG_MULTITHREAD
+
 // Loopfilter row synchronization
 typedef struct VP9LfSyncData {
 #if CONFIG_MULTITHREAD
@@ -51,6 +71,14 @@ void vp9_loop_filter_frame_mt(YV12_BUFFER_CONFIG *frame,
                               VP9Worker *workers, int num_workers,
                               VP9LfSync *lf_sync);
 
+// Loopfilter the superblock row starting at mi_row. The row waits on the
+// progress of the row above through lf_sync, so rows may be handed out to
+// threads in any pool as long as they are started in order.
+void vp9_loop_filter_sb_row(const YV12_BUFFER_CONFIG *frame_buffer,
+                            struct VP9Common *cm,
+                            struct macroblockd_plane planes[MAX_MB_PLANE],
+                            int mi_row, int y_only, VP9LfSync *lf_sync);
+
 void vp9_accumulate_frame_counts(struct VP9Common *cm,
                                  struct FRAME_COUNTS *counts, int is_dec);
 
@@ -0,0 +1,451 @@
+/*
+ *  Copyright (c) 2015 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "./vp9_rtcd.h"
+
+#include <tmmintrin.h>
+
+#include "vpx_ports/mem.h"
+
+// High bitdepth versions of the d117, d135 and d153 predictors in
+// vp9_intrapred_intrin_ssse3.c. Each row is the row above it shifted right by
+// one or two pixels, with pixels of the filtered left column shifted in from
+// the top of a reversed column vector.
+
+DECLARE_ALIGNED(16, static const uint8_t, reverse_words[16]) = {
+  14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1
+};
+
+// Gather the even or the odd words, reversed, into the upper half.
+DECLARE_ALIGNED(16, static const uint8_t, reverse_even_words[16]) = {
+  0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+  12, 13, 8, 9, 4, 5, 0, 1
+};
+
+DECLARE_ALIGNED(16, static const uint8_t, reverse_odd_words[16]) = {
+  0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+  14, 15, 10, 11, 6, 7, 2, 3
+};
+
+// ROUND_POWER_OF_TWO(a + 2 * b + c, 2).
+static INLINE __m128i avg3_epu16(const __m128i a, const __m128i b,
+                                 const __m128i c) {
+  const __m128i odd = _mm_and_si128(_mm_xor_si128(a, c), _mm_set1_epi16(1));
+  const __m128i avg = _mm_sub_epi16(_mm_avg_epu16(a, c), odd);
+  return _mm_avg_epu16(avg, b);
+}
+
+// Shifts x up by one pixel and puts v in the lowest one.
+static INLINE __m128i shift_in_word(const __m128i x, int v) {
+  return _mm_or_si128(_mm_slli_si128(x, 2), _mm_cvtsi32_si128(v));
+}
+
+// out[r] = AVG3(left[r - 2], left[r - 1], left[r]) for the first 8 pixels of
+// the left column, with above[-1] and above[0] standing in for left[-1] and
+// left[-2].
+static INLINE __m128i filter_left(const __m128i l, const uint16_t *above) {
+  const __m128i lm1 = shift_in_word(l, above[-1]);
+  const __m128i lm2 = shift_in_word(lm1, above[0]);
+  return avg3_epu16(lm2, lm1, l);
+}
+
+// The same for the 8 pixels from left[0], which must not be the first.
+static INLINE __m128i filter_left_at(const uint16_t *left) {
+  return avg3_epu16(_mm_loadu_si128((const __m128i *)(left - 2)),
+                    _mm_loadu_si128((const __m128i *)(left - 1)),
+                    _mm_loadu_si128((const __m128i *)left));
+}
+
+// The 2-tap average of left[r - 1] and left[r], left[-1] being above[-1].
+static INLINE __m128i average_left(const __m128i l, const uint16_t *above) {
+  return _mm_avg_epu16(shift_in_word(l, above[-1]), l);
+}
+
+static INLINE __m128i average_left_at(const uint16_t *left) {
+  return _mm_avg_epu16(_mm_loadu_si128((const __m128i *)(left - 1)),
+                       _mm_loadu_si128((const __m128i *)left));
+}
+
+// out[c] = AVG3(above[c - 1], above[c], above[c + 1]) for 8 pixels from c.
+static INLINE __m128i filter_above(const uint16_t *above) {
+  return avg3_epu16(_mm_loadu_si128((const __m128i *)(above - 1)),
+                    _mm_loadu_si128((const __m128i *)above),
+                    _mm_loadu_si128((const __m128i *)(above + 1)));
+}
+
+static INLINE __m128i average_above(const uint16_t *above) {
+  return _mm_avg_epu16(_mm_loadu_si128((const __m128i *)(above - 1)),
+                       _mm_loadu_si128((const __m128i *)above));
+}
+
+// Combines the column vectors of two consecutive sets of 8 pixels.
+static INLINE __m128i gather_col(const __m128i lo, const __m128i hi,
+                                 const __m128i mask) {
+  return _mm_or_si128(_mm_shuffle_epi8(lo, mask),
+                      _mm_srli_si128(_mm_shuffle_epi8(hi, mask), 8));
+}
+
+void vp9_highbd_d135_predictor_4x4_ssse3(uint16_t *dst, ptrdiff_t stride,
+                                         const uint16_t *above,
+                                         const uint16_t *left, int bd) {
+  const __m128i a = _mm_loadu_si128((const __m128i *)(above - 1));
+  const __m128i l = _mm_loadl_epi64((const __m128i *)left);
+  const __m128i col = _mm_shuffle_epi8(filter_left(l, above),
+                                       _mm_load_si128((const __m128i *)
+                                                      reverse_words));
+  const __m128i row = avg3_epu16(a, _mm_srli_si128(a, 2),
+                                 _mm_srli_si128(a, 4));
+  (void)bd;
+
+  _mm_storel_epi64((__m128i *)dst, _mm_alignr_epi8(row, col, 14));
+  _mm_storel_epi64((__m128i *)(dst + stride), _mm_alignr_epi8(row, col, 12));
+  _mm_storel_epi64((__m128i *)(dst + 2 * stride),
+                   _mm_alignr_epi8(row, col, 10));
+  _mm_storel_epi64((__m128i *)(dst + 3 * stride),
+                   _mm_alignr_epi8(row, col, 8));
+}
+
+void vp9_highbd_d135_predictor_8x8_ssse3(uint16_t *dst, ptrdiff_t stride,
+                                         const uint16_t *above,
+                                         const uint16_t *left, int bd) {
+  const __m128i l = _mm_loadu_si128((const __m128i *)left);
+  __m128i col = _mm_shuffle_epi8(filter_left(l, above),
+                                 _mm_load_si128((const __m128i *)
+                                                reverse_words));
+  __m128i row = filter_above(above);
+  int r;
+  (void)bd;
+
+  for (r = 0; r < 8; ++r) {
+    row = _mm_alignr_epi8(row, col, 14);
+    col = _mm_slli_si128(col, 2);
+    _mm_storeu_si128((__m128i *)dst, row);
+    dst += stride;
+  }
+}
+
+void vp9_highbd_d135_predictor_16x16_ssse3(uint16_t *dst, ptrdiff_t stride,
+                                           const uint16_t *above,
+                                           const uint16_t *left, int bd) {
+  const __m128i rev = _mm_load_si128((const __m128i *)reverse_words);
+  const __m128i l = _mm_loadu_si128((const __m128i *)left);
+  const __m128i cols[2] = {
+    _mm_shuffle_epi8(filter_left(l, above), rev),
+    _mm_shuffle_epi8(filter_left_at(left + 8), rev)
+  };
+  __m128i row0 = filter_above(above);
+  __m128i row1 = filter_above(above + 8);
+  int i, r;
+  (void)bd;
+
+  for (i = 0; i < 2; ++i) {
+    __m128i col = cols[i];
+    for (r = 0; r < 8; ++r) {
+      row1 = _mm_alignr_epi8(row1, row0, 14);
+      row0 = _mm_alignr_epi8(row0, col, 14);
+      col = _mm_slli_si128(col, 2);
+      _mm_storeu_si128((__m128i *)dst, row0);
+      _mm_storeu_si128((__m128i *)(dst + 8), row1);
+      dst += stride;
+    }
+  }
+}
+
+void vp9_highbd_d135_predictor_32x32_ssse3(uint16_t *dst, ptrdiff_t stride,
+                                           const uint16_t *above,
+                                           const uint16_t *left, int bd) {
+  const __m128i rev = _mm_load_si128((const __m128i *)reverse_words);
+  const __m128i l = _mm_loadu_si128((const __m128i *)left);
+  const __m128i cols[4] = {
+    _mm_shuffle_epi8(filter_left(l, above), rev),
+    _mm_shuffle_epi8(filter_left_at(left + 8), rev),
+    _mm_shuffle_epi8(filter_left_at(left + 16), rev),
+    _mm_shuffle_epi8(filter_left_at(left + 24), rev)
+  };
+  __m128i row0 = filter_above(above);
+  __m128i row1 = filter_above(above + 8);
+  __m128i row2 = filter_above(above + 16);
+  __m128i row3 = filter_above(above + 24);
+  int i, r;
+  (void)bd;
+
+  for (i = 0; i < 4; ++i) {
+    __m128i col = cols[i];
+    for (r = 0; r < 8; ++r) {
+      row3 = _mm_alignr_epi8(row3, row2, 14);
+      row2 = _mm_alignr_epi8(row2, row1, 14);
+      row1 = _mm_alignr_epi8(row1, row0, 14);
+      row0 = _mm_alignr_epi8(row0, col, 14);
+      col = _mm_slli_si128(col, 2);
+      _mm_storeu_si128((__m128i *)dst, row0);
+      _mm_storeu_si128((__m128i *)(dst + 8), row1);
+      _mm_storeu_si128((__m128i *)(dst + 16), row2);
+      _mm_storeu_si128((__m128i *)(dst + 24), row3);
+      dst += stride;
+    }
+  }
+}
+
+// d117's even rows start from the 2-tap average of the above row and its odd
+// rows from d135's first row. Each set of rows takes every other pixel of the
+// filtered left column.
+
+void vp9_highbd_d117_predictor_4x4_ssse3(uint16_t *dst, ptrdiff_t stride,
+                                         const uint16_t *above,
+                                         const uint16_t *left, int bd) {
+  const __m128i a = _mm_loadu_si128((const __m128i *)(above - 1));
+  const __m128i l = _mm_loadl_epi64((const __m128i *)left);
+  const __m128i d = filter_left(l, above);
+  __m128i col_even = _mm_shuffle_epi8(
+      d, _mm_load_si128((const __m128i *)reverse_odd_words));
+  __m128i col_odd = _mm_shuffle_epi8(
+      d, _mm_load_si128((const __m128i *)reverse_even_words));
+  __m128i even = _mm_avg_epu16(a, _mm_srli_si128(a, 2));
+  __m128i odd = avg3_epu16(a, _mm_srli_si128(a, 2), _mm_srli_si128(a, 4));
+  int r;
+  (void)bd;
+
+  for (r = 0; r < 4; r += 2) {
+    odd = _mm_alignr_epi8(odd, col_odd, 14);
+    col_odd = _mm_slli_si128(col_odd, 2);
+    _mm_storel_epi64((__m128i *)dst, even);
+    _mm_storel_epi64((__m128i *)(dst + stride), odd);
+    even = _mm_alignr_epi8(even, col_even, 14);
+    col_even = _mm_slli_si128(col_even, 2);
+    dst += 2 * stride;
+  }
+}
+
+void vp9_highbd_d117_predictor_8x8_ssse3(uint16_t *dst, ptrdiff_t stride,
+                                         const uint16_t *above,
+                                         const uint16_t *left, int bd) {
+  const __m128i l = _mm_loadu_si128((const __m128i *)left);
+  const __m128i d = filter_left(l, above);
+  __m128i col_even = _mm_shuffle_epi8(
+      d, _mm_load_si128((const __m128i *)reverse_odd_words));
+  __m128i col_odd = _mm_shuffle_epi8(
+      d, _mm_load_si128((const __m128i *)reverse_even_words));
+  __m128i even = average_above(above);
+  __m128i odd = filter_above(above);
+  int r;
+  (void)bd;
+
+  for (r = 0; r < 8; r += 2) {
+    odd = _mm_alignr_epi8(odd, col_odd, 14);
+    col_odd = _mm_slli_si128(col_odd, 2);
+    _mm_storeu_si128((__m128i *)dst, even);
+    _mm_storeu_si128((__m128i *)(dst + stride), odd);
+    even = _mm_alignr_epi8(even, col_even, 14);
+    col_even = _mm_slli_si128(col_even, 2);
+    dst += 2 * stride;
+  }
+}
+
+void vp9_highbd_d117_predictor_16x16_ssse3(uint16_t *dst, ptrdiff_t stride,
+                                           const uint16_t *above,
+                                           const uint16_t *left, int bd) {
+  const __m128i l = _mm_loadu_si128((const __m128i *)left);
+  const __m128i d0 = filter_left(l, above);
+  const __m128i d1 = filter_left_at(left + 8);
+  __m128i col_even = gather_col(d0, d1, _mm_load_si128(
+      (const __m128i *)reverse_odd_words));
+  __m128i col_odd = gather_col(d0, d1, _mm_load_si128(
+      (const __m128i *)reverse_even_words));
+  __m128i even0 = average_above(above);
+  __m128i even1 = average_above(above + 8);
+  __m128i odd0 = filter_above(above);
+  __m128i odd1 = filter_above(above + 8);
+  int r;
+  (void)bd;
+
+  for (r = 0; r < 16; r += 2) {
+    odd1 = _mm_alignr_epi8(odd1, odd0, 14);
+    odd0 = _mm_alignr_epi8(odd0, col_odd, 14);
+    col_odd = _mm_slli_si128(col_odd, 2);
+    _mm_storeu_si128((__m128i *)dst, even0);
+    _mm_storeu_si128((__m128i *)(dst + 8), even1);
+    _mm_storeu_si128((__m128i *)(dst + stride), odd0);
+    _mm_storeu_si128((__m128i *)(dst + stride + 8), odd1);
+    even1 = _mm_alignr_epi8(even1, even0, 14);
+    even0 = _mm_alignr_epi8(even0, col_even, 14);
+    col_even = _mm_slli_si128(col_even, 2);
+    dst += 2 * stride;
+  }
+}
+
+void vp9_highbd_d117_predictor_32x32_ssse3(uint16_t *dst, ptrdiff_t stride,
+                                           const uint16_t *above,
+                                           const uint16_t *left, int bd) {
+  const __m128i even_mask = _mm_load_si128(
+      (const __m128i *)reverse_even_words);
+  const __m128i odd_mask = _mm_load_si128((const __m128i *)reverse_odd_words);
+  const __m128i l = _mm_loadu_si128((const __m128i *)left);
+  const __m128i d0 = filter_left(l, above);
+  const __m128i d1 = filter_left_at(left + 8);
+  const __m128i d2 = filter_left_at(left + 16);
+  const __m128i d3 = filter_left_at(left + 24);
+  __m128i col_even = gather_col(d0, d1, odd_mask);
+  __m128i col_odd = gather_col(d0, d1, even_mask);
+  __m128i even0 = average_above(above);
+  __m128i even1 = average_above(above + 8);
+  __m128i even2 = average_above(above + 16);
+  __m128i even3 = average_above(above + 24);
+  __m128i odd0 = filter_above(above);
+  __m128i odd1 = filter_above(above + 8);
+  __m128i odd2 = filter_above(above + 16);
+  __m128i odd3 = filter_above(above + 24);
+  int r;
+  (void)bd;
+
+  for (r = 0; r < 32; r += 2) {
+    if (r == 16) {
+      col_even = gather_col(d2, d3, odd_mask);
+      col_odd = gather_col(d2, d3, even_mask);
+    }
+    odd3 = _mm_alignr_epi8(odd3, odd2, 14);
+    odd2 = _mm_alignr_epi8(odd2, odd1, 14);
+    odd1 = _mm_alignr_epi8(odd1, odd0, 14);
+    odd0 = _mm_alignr_epi8(odd0, col_odd, 14);
+    col_odd = _mm_slli_si128(col_odd, 2);
+    _mm_storeu_si128((__m128i *)dst, even0);
+    _mm_storeu_si128((__m128i *)(dst + 8), even1);
+    _mm_storeu_si128((__m128i *)(dst + 16), even2);
+    _mm_storeu_si128((__m128i *)(dst + 24), even3);
+    _mm_storeu_si128((__m128i *)(dst + stride), odd0);
+    _mm_storeu_si128((__m128i *)(dst + stride + 8), odd1);
+    _mm_storeu_si128((__m128i *)(dst + stride + 16), odd2);
+    _mm_storeu_si128((__m128i *)(dst + stride + 24), odd3);
+    even3 = _mm_alignr_epi8(even3, even2, 14);
+    even2 = _mm_alignr_epi8(even2, even1, 14);
+    even1 = _mm_alignr_epi8(even1, even0, 14);
+    even0 = _mm_alignr_epi8(even0, col_even, 14);
+    col_even = _mm_slli_si128(col_even, 2);
+    dst += 2 * stride;
+  }
+}
+
+// d153 shifts in two pixels per row: the 2-tap average of the left column
+// and the filtered left column, interleaved into the column vectors.
+
+void vp9_highbd_d153_predictor_4x4_ssse3(uint16_t *dst, ptrdiff_t stride,
+                                         const uint16_t *above,
+                                         const uint16_t *left, int bd) {
+  const __m128i rev = _mm_load_si128((const __m128i *)reverse_words);
+  const __m128i a = _mm_loadu_si128((const __m128i *)(above - 1));
+  const __m128i l = _mm_loadl_epi64((const __m128i *)left);
+  const __m128i c = _mm_shuffle_epi8(average_left(l, above), rev);
+  const __m128i d = _mm_shuffle_epi8(filter_left(l, above), rev);
+  __m128i col = _mm_unpackhi_epi16(c, d);
+  __m128i row = avg3_epu16(a, _mm_srli_si128(a, 2), _mm_srli_si128(a, 4));
+  int r;
+  (void)bd;
+
+  for (r = 0; r < 4; ++r) {
+    row = _mm_alignr_epi8(row, col, 12);
+    col = _mm_slli_si128(col, 4);
+    _mm_storel_epi64((__m128i *)dst, row);
+    dst += stride;
+  }
+}
+
+void vp9_highbd_d153_predictor_8x8_ssse3(uint16_t *dst, ptrdiff_t stride,
+                                         const uint16_t *above,
+                                         const uint16_t *left, int bd) {
+  const __m128i rev = _mm_load_si128((const __m128i *)reverse_words);
+  const __m128i l = _mm_loadu_si128((const __m128i *)left);
+  const __m128i c = _mm_shuffle_epi8(average_left(l, above), rev);
+  const __m128i d = _mm_shuffle_epi8(filter_left(l, above), rev);
+  const __m128i cols[2] = {
+    _mm_unpackhi_epi16(c, d), _mm_unpacklo_epi16(c, d)
+  };
+  __m128i row = filter_above(above);
+  int i, r;
+  (void)bd;
+
+  for (i = 0; i < 2; ++i) {
+    __m128i col = cols[i];
+    for (r = 0; r < 4; ++r) {
+      row = _mm_alignr_epi8(row, col, 12);
+      col = _mm_slli_si128(col, 4);
+      _mm_storeu_si128((__m128i *)dst, row);
+      dst += stride;
+    }
+  }
+}
+
+void vp9_highbd_d153_predictor_16x16_ssse3(uint16_t *dst, ptrdiff_t stride,
+                                           const uint16_t *above,
+                                           const uint16_t *left, int bd) {
+  const __m128i rev = _mm_load_si128((const __m128i *)reverse_words);
+  const __m128i l = _mm_loadu_si128((const __m128i *)left);
+  const __m128i c0 = _mm_shuffle_epi8(average_left(l, above), rev);
+  const __m128i d0 = _mm_shuffle_epi8(filter_left(l, above), rev);
+  const __m128i c1 = _mm_shuffle_epi8(average_left_at(left + 8), rev);
+  const __m128i d1 = _mm_shuffle_epi8(filter_left_at(left + 8), rev);
+  const __m128i cols[4] = {
+    _mm_unpackhi_epi16(c0, d0), _mm_unpacklo_epi16(c0, d0),
+    _mm_unpackhi_epi16(c1, d1), _mm_unpacklo_epi16(c1, d1)
+  };
+  __m128i row0 = filter_above(above);
+  __m128i row1 = filter_above(above + 8);
+  int i, r;
+  (void)bd;
+
+  for (i = 0; i < 4; ++i) {
+    __m128i col = cols[i];
+    for (r = 0; r < 4; ++r) {
+      row1 = _mm_alignr_epi8(row1, row0, 12);
+      row0 = _mm_alignr_epi8(row0, col, 12);
+      col = _mm_slli_si128(col, 4);
+      _mm_storeu_si128((__m128i *)dst, row0);
+      _mm_storeu_si128((__m128i *)(dst + 8), row1);
+      dst += stride;
+    }
+  }
+}
+
+void vp9_highbd_d153_predictor_32x32_ssse3(uint16_t *dst, ptrdiff_t stride,
+                                           const uint16_t *above,
+                                           const uint16_t *left, int bd) {
+  const __m128i rev = _mm_load_si128((const __m128i *)reverse_words);
+  const __m128i l = _mm_loadu_si128((const __m128i *)left);
+  __m128i cols[8];
+  __m128i row0 = filter_above(above);
+  __m128i row1 = filter_above(above + 8);
+  __m128i row2 = filter_above(above + 16);
+  __m128i row3 = filter_above(above + 24);
+  int i, r;
+  (void)bd;
+
+  for (i = 0; i < 4; ++i) {
+    const __m128i c = _mm_shuffle_epi8(
+        i ? average_left_at(left + 8 * i) : average_left(l, above), rev);
+    const __m128i d = _mm_shuffle_epi8(
+        i ? filter_left_at(left + 8 * i) : filter_left(l, above), rev);
+    cols[2 * i] = _mm_unpackhi_epi16(c, d);
+    cols[2 * i + 1] = _mm_unpacklo_epi16(c, d);
+  }
+
+  for (i = 0; i < 8; ++i) {
+    __m128i col = cols[i];
+    for (r = 0; r < 4; ++r) {
+      row3 = _mm_alignr_epi8(row3, row2, 12);
+      row2 = _mm_alignr_epi8(row2, row1, 12);
+      row1 = _mm_alignr_epi8(row1, row0, 12);
+      row0 = _mm_alignr_epi8(row0, col, 12);
+      col = _mm_slli_si128(col, 4);
+      _mm_storeu_si128((__m128i *)dst, row0);
+      _mm_storeu_si128((__m128i *)(dst + 8), row1);
+      _mm_storeu_si128((__m128i *)(dst + 16), row2);
+      _mm_storeu_si128((__m128i *)(dst + 24), row3);
+      dst += stride;
+    }
+  }
+}
@@ -0,0 +1,351 @@
+/*
+ *  Copyright (c) 2015 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Due to a header conflict between math.h and intrinsics includes with ceil()
+// in certain configurations under vs9 this include needs to precede
+// immintrin.h.
+#include "./vp9_rtcd.h"
+
+#include <immintrin.h>
+
+#include "vp9/common/vp9_filter.h"
+#include "vp9/common/x86/convolve.h"
+#include "vpx_ports/mem.h"
+
+#if ARCH_X86_64
+typedef struct {
+  __m256i f01, f23, f45, f67;
+} HighbdFilter8;
+
+static INLINE HighbdFilter8 load_filter8(const int16_t *filter) {
+  HighbdFilter8 f;
+  f.f01 = _mm256_set1_epi32((uint16_t)filter[0] | (filter[1] << 16));
+  f.f23 = _mm256_set1_epi32((uint16_t)filter[2] | (filter[3] << 16));
+  f.f45 = _mm256_set1_epi32((uint16_t)filter[4] | (filter[5] << 16));
+  f.f67 = _mm256_set1_epi32((uint16_t)filter[6] | (filter[7] << 16));
+  return f;
+}
+
+// Apply the 8 taps to 16 pixels, s[k] holding the pixels under tap k. Pixels
+// are at most 12 bits, so the products and their sum fit in 32 bits.
+static INLINE __m256i filter8_16(const HighbdFilter8 *f, __m256i s0,
+                                 __m256i s1, __m256i s2, __m256i s3,
+                                 __m256i s4, __m256i s5, __m256i s6,
+                                 __m256i s7, __m256i max) {
+  const __m256i rounding = _mm256_set1_epi32(1 << (FILTER_BITS - 1));
+  __m256i lo = _mm256_madd_epi16(_mm256_unpacklo_epi16(s0, s1), f->f01);
+  __m256i hi = _mm256_madd_epi16(_mm256_unpackhi_epi16(s0, s1), f->f01);
+  lo = _mm256_add_epi32(lo,
+      _mm256_madd_epi16(_mm256_unpacklo_epi16(s2, s3), f->f23));
+  hi = _mm256_add_epi32(hi,
+      _mm256_madd_epi16(_mm256_unpackhi_epi16(s2, s3), f->f23));
+  lo = _mm256_add_epi32(lo,
+      _mm256_madd_epi16(_mm256_unpacklo_epi16(s4, s5), f->f45));
+  hi = _mm256_add_epi32(hi,
+      _mm256_madd_epi16(_mm256_unpackhi_epi16(s4, s5), f->f45));
+  lo = _mm256_add_epi32(lo,
+      _mm256_madd_epi16(_mm256_unpacklo_epi16(s6, s7), f->f67));
+  hi = _mm256_add_epi32(hi,
+      _mm256_madd_epi16(_mm256_unpackhi_epi16(s6, s7), f->f67));
+  lo = _mm256_srai_epi32(_mm256_add_epi32(lo, rounding), FILTER_BITS);
+  hi = _mm256_srai_epi32(_mm256_add_epi32(hi, rounding), FILTER_BITS);
+  // The unpacks and the pack work within 128-bit lanes, so the pixel order is
+  // restored here.
+  return _mm256_min_epu16(_mm256_packus_epi32(lo, hi), max);
+}
+
+static INLINE __m256i loadu_128(const uint16_t *p) {
+  return _mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)p));
+}
+
+static INLINE __m256i loadu2_128(const uint16_t *p0, const uint16_t *p1) {
+  return _mm256_inserti128_si256(loadu_128(p0),
+                                 _mm_loadu_si128((const __m128i *)p1), 1);
+}
+
+static INLINE void store_16(uint16_t *dst, __m256i res, int avg) {
+  if (avg)
+    res = _mm256_avg_epu16(res,
+                           _mm256_loadu_si256((const __m256i *)dst));
+  _mm256_storeu_si256((__m256i *)dst, res);
+}
+
+static INLINE void store_8(uint16_t *dst, __m256i res, int avg) {
+  __m128i r = _mm256_castsi256_si128(res);
+  if (avg)
+    r = _mm_avg_epu16(r, _mm_loadu_si128((const __m128i *)dst));
+  _mm_storeu_si128((__m128i *)dst, r);
+}
+
+static INLINE void store2_8(uint16_t *dst0, uint16_t *dst1, __m256i res,
+                            int avg) {
+  __m128i r0 = _mm256_castsi256_si128(res);
+  __m128i r1 = _mm256_extracti128_si256(res, 1);
+  if (avg) {
+    r0 = _mm_avg_epu16(r0, _mm_loadu_si128((const __m128i *)dst0));
+    r1 = _mm_avg_epu16(r1, _mm_loadu_si128((const __m128i *)dst1));
+  }
+  _mm_storeu_si128((__m128i *)dst0, r0);
+  _mm_storeu_si128((__m128i *)dst1, r1);
+}
+
+static INLINE void highbd_filter_block1d16_h8(const uint16_t *src_ptr,
+                                              ptrdiff_t src_pitch,
+                                              uint16_t *output_ptr,
+                                              ptrdiff_t out_pitch,
+                                              unsigned int output_height,
+                                              const int16_t *filter, int bd,
+                                              int avg) {
+  const HighbdFilter8 f = load_filter8(filter);
+  const __m256i max = _mm256_set1_epi16((1 << bd) - 1);
+  unsigned int i;
+  src_ptr -= 3;
+  for (i = 0; i < output_height; ++i) {
+    const __m256i res = filter8_16(&f,
+        _mm256_loadu_si256((const __m256i *)(src_ptr + 0)),
+        _mm256_loadu_si256((const __m256i *)(src_ptr + 1)),
+        _mm256_loadu_si256((const __m256i *)(src_ptr + 2)),
+        _mm256_loadu_si256((const __m256i *)(src_ptr + 3)),
+        _mm256_loadu_si256((const __m256i *)(src_ptr + 4)),
+        _mm256_loadu_si256((const __m256i *)(src_ptr + 5)),
+        _mm256_loadu_si256((const __m256i *)(src_ptr + 6)),
+        _mm256_loadu_si256((const __m256i *)(src_ptr + 7)), max);
+    store_16(output_ptr, res, avg);
+    src_ptr += src_pitch;
+    output_ptr += out_pitch;
+  }
+}
+
+// 8 pixels wide: two rows are filtered at once, one in each 128-bit lane.
+static INLINE void highbd_filter_block1d8_h8(const uint16_t *src_ptr,
+                                             ptrdiff_t src_pitch,
+                                             uint16_t *output_ptr,
+                                             ptrdiff_t out_pitch,
+                                             unsigned int output_height,
+                                             const int16_t *filter, int bd,
+                                             int avg) {
+  const HighbdFilter8 f = load_filter8(filter);
+  const __m256i max = _mm256_set1_epi16((1 << bd) - 1);
+  unsigned int i;
+  src_ptr -= 3;
+  for (i = 0; i + 1 < output_height; i += 2) {
+    const uint16_t *s0 = src_ptr;
+    const uint16_t *s1 = src_ptr + src_pitch;
+    const __m256i res = filter8_16(&f,
+        loadu2_128(s0 + 0, s1 + 0), loadu2_128(s0 + 1, s1 + 1),
+        loadu2_128(s0 + 2, s1 + 2), loadu2_128(s0 + 3, s1 + 3),
+        loadu2_128(s0 + 4, s1 + 4), loadu2_128(s0 + 5, s1 + 5),
+        loadu2_128(s0 + 6, s1 + 6), loadu2_128(s0 + 7, s1 + 7), max);
+    store2_8(output_ptr, output_ptr + out_pitch, res, avg);
+    src_ptr += 2 * src_pitch;
+    output_ptr += 2 * out_pitch;
+  }
+  if (i < output_height) {
+    // The last row of an odd height only uses the low lane.
+    const uint16_t *s0 = src_ptr;
+    const __m256i res = filter8_16(&f,
+        loadu_128(s0 + 0), loadu_128(s0 + 1), loadu_128(s0 + 2),
+        loadu_128(s0 + 3), loadu_128(s0 + 4), loadu_128(s0 + 5),
+        loadu_128(s0 + 6), loadu_128(s0 + 7), max);
+    store_8(output_ptr, res, avg);
+  }
+}
+
+static INLINE void highbd_filter_block1d16_v8(const uint16_t *src_ptr,
+                                              ptrdiff_t src_pitch,
+                                              uint16_t *output_ptr,
+                                              ptrdiff_t out_pitch,
+                                              unsigned int output_height,
+                                              const int16_t *filter, int bd,
+                                              int avg) {
+  const HighbdFilter8 f = load_filter8(filter);
+  const __m256i max = _mm256_set1_epi16((1 << bd) - 1);
+  __m256i s0 = _mm256_loadu_si256((const __m256i *)(src_ptr + 0 * src_pitch));
+  __m256i s1 = _mm256_loadu_si256((const __m256i *)(src_ptr + 1 * src_pitch));
+  __m256i s2 = _mm256_loadu_si256((const __m256i *)(src_ptr + 2 * src_pitch));
+  __m256i s3 = _mm256_loadu_si256((const __m256i *)(src_ptr + 3 * src_pitch));
+  __m256i s4 = _mm256_loadu_si256((const __m256i *)(src_ptr + 4 * src_pitch));
+  __m256i s5 = _mm256_loadu_si256((const __m256i *)(src_ptr + 5 * src_pitch));
+  __m256i s6 = _mm256_loadu_si256((const __m256i *)(src_ptr + 6 * src_pitch));
+  unsigned int i;
+  src_ptr += 7 * src_pitch;
+  for (i = 0; i < output_height; ++i) {
+    const __m256i s7 = _mm256_loadu_si256((const __m256i *)src_ptr);
+    store_16(output_ptr, filter8_16(&f, s0, s1, s2, s3, s4, s5, s6, s7, max),
+             avg);
+    s0 = s1;
+    s1 = s2;
+    s2 = s3;
+    s3 = s4;
+    s4 = s5;
+    s5 = s6;
+    s6 = s7;
+    src_ptr += src_pitch;
+    output_ptr += out_pitch;
+  }
+}
+
+// 8 pixels wide: output rows i and i + 1 share the lanes of each register,
+// row k of the window holding source rows i + k and i + k + 1.
+static INLINE void highbd_filter_block1d8_v8(const uint16_t *src_ptr,
+                                             ptrdiff_t src_pitch,
+                                             uint16_t *output_ptr,
+                                             ptrdiff_t out_pitch,
+                                             unsigned int output_height,
+                                             const int16_t *filter, int bd,
+                                             int avg) {
+  const HighbdFilter8 f = load_filter8(filter);
+  const __m256i max = _mm256_set1_epi16((1 << bd) - 1);
+  const uint16_t *s = src_ptr;
+  __m256i s0 = loadu2_128(s + 0 * src_pitch, s + 1 * src_pitch);
+  __m256i s1 = loadu2_128(s + 1 * src_pitch, s + 2 * src_pitch);
+  __m256i s2 = loadu2_128(s + 2 * src_pitch, s + 3 * src_pitch);
+  __m256i s3 = loadu2_128(s + 3 * src_pitch, s + 4 * src_pitch);
+  __m256i s4 = loadu2_128(s + 4 * src_pitch, s + 5 * src_pitch);
+  __m256i s5 = loadu2_128(s + 5 * src_pitch, s + 6 * src_pitch);
+  unsigned int i;
+  s += 6 * src_pitch;
+  for (i = 0; i + 1 < output_height; i += 2) {
+    const __m256i s6 = loadu2_128(s, s + src_pitch);
+    const __m256i s7 = loadu2_128(s + src_pitch, s + 2 * src_pitch);
+    store2_8(output_ptr, output_ptr + out_pitch,
+             filter8_16(&f, s0, s1, s2, s3, s4, s5, s6, s7, max), avg);
+    s0 = s2;
+    s1 = s3;
+    s2 = s4;
+    s3 = s5;
+    s4 = s6;
+    s5 = s7;
+    s += 2 * src_pitch;
+    output_ptr += 2 * out_pitch;
+  }
+  if (i < output_height) {
+    const __m256i s6 = loadu_128(s);
+    const __m256i s7 = loadu_128(s + src_pitch);
+    store_8(output_ptr, filter8_16(&f, s0, s1, s2, s3, s4, s5, s6, s7, max),
+            avg);
+  }
+}
+
+#define HIGHBD_FILTER_BLOCK1D(width, dir, avg_name, avg) \
+static void vp9_highbd_filter_block1d##width##_##dir##8_##avg_name##avx2( \
+    const uint16_t *src_ptr, const ptrdiff_t src_pitch, uint16_t *output_ptr, \
+    ptrdiff_t out_pitch, unsigned int output_height, const int16_t *filter, \
+    int bd) { \
+  highbd_filter_block1d##width##_##dir##8(src_ptr, src_pitch, output_ptr, \
+                                          out_pitch, output_height, filter, \
+                                          bd, avg); \
+}
+
+HIGHBD_FILTER_BLOCK1D(16, h, , 0)
+HIGHBD_FILTER_BLOCK1D(16, v, , 0)
+HIGHBD_FILTER_BLOCK1D(8, h, , 0)
+HIGHBD_FILTER_BLOCK1D(8, v, , 0)
+HIGHBD_FILTER_BLOCK1D(16, h, avg_, 1)
+HIGHBD_FILTER_BLOCK1D(16, v, avg_, 1)
+HIGHBD_FILTER_BLOCK1D(8, h, avg_, 1)
+HIGHBD_FILTER_BLOCK1D(8, v, avg_, 1)
+
+highbd_filter8_1dfunction vp9_highbd_filter_block1d4_v8_sse2;
+highbd_filter8_1dfunction vp9_highbd_filter_block1d4_h8_sse2;
+highbd_filter8_1dfunction vp9_highbd_filter_block1d4_v8_avg_sse2;
+highbd_filter8_1dfunction vp9_highbd_filter_block1d4_h8_avg_sse2;
+highbd_filter8_1dfunction vp9_highbd_filter_block1d16_v2_sse2;
+highbd_filter8_1dfunction vp9_highbd_filter_block1d16_h2_sse2;
+highbd_filter8_1dfunction vp9_highbd_filter_block1d8_v2_sse2;
+highbd_filter8_1dfunction vp9_highbd_filter_block1d8_h2_sse2;
+highbd_filter8_1dfunction vp9_highbd_filter_block1d4_v2_sse2;
+highbd_filter8_1dfunction vp9_highbd_filter_block1d4_h2_sse2;
+highbd_filter8_1dfunction vp9_highbd_filter_block1d16_v2_avg_sse2;
+highbd_filter8_1dfunction vp9_highbd_filter_block1d16_h2_avg_sse2;
+highbd_filter8_1dfunction vp9_highbd_filter_block1d8_v2_avg_sse2;
+highbd_filter8_1dfunction vp9_highbd_filter_block1d8_h2_avg_sse2;
+highbd_filter8_1dfunction vp9_highbd_filter_block1d4_v2_avg_sse2;
+highbd_filter8_1dfunction vp9_highbd_filter_block1d4_h2_avg_sse2;
+#define vp9_highbd_filter_block1d4_v8_avx2 vp9_highbd_filter_block1d4_v8_sse2
+#define vp9_highbd_filter_block1d4_h8_avx2 vp9_highbd_filter_block1d4_h8_sse2
+#define vp9_highbd_filter_block1d4_v8_avg_avx2 \
+    vp9_highbd_filter_block1d4_v8_avg_sse2
+#define vp9_highbd_filter_block1d4_h8_avg_avx2 \
+    vp9_highbd_filter_block1d4_h8_avg_sse2
+#define vp9_highbd_filter_block1d16_v2_avx2 vp9_highbd_filter_block1d16_v2_sse2
+#define vp9_highbd_filter_block1d16_h2_avx2 vp9_highbd_filter_block1d16_h2_sse2
+#define vp9_highbd_filter_block1d8_v2_avx2 vp9_highbd_filter_block1d8_v2_sse2
+#define vp9_highbd_filter_block1d8_h2_avx2 vp9_highbd_filter_block1d8_h2_sse2
+#define vp9_highbd_filter_block1d4_v2_avx2 vp9_highbd_filter_block1d4_v2_sse2
+#define vp9_highbd_filter_block1d4_h2_avx2 vp9_highbd_filter_block1d4_h2_sse2
+#define vp9_highbd_filter_block1d16_v2_avg_avx2 \
+    vp9_highbd_filter_block1d16_v2_avg_sse2
+#define vp9_highbd_filter_block1d16_h2_avg_avx2 \
+    vp9_highbd_filter_block1d16_h2_avg_sse2
+#define vp9_highbd_filter_block1d8_v2_avg_avx2 \
+    vp9_highbd_filter_block1d8_v2_avg_sse2
+#define vp9_highbd_filter_block1d8_h2_avg_avx2 \
+    vp9_highbd_filter_block1d8_h2_avg_sse2
+#define vp9_highbd_filter_block1d4_v2_avg_avx2 \
+    vp9_highbd_filter_block1d4_v2_avg_sse2
+#define vp9_highbd_filter_block1d4_h2_avg_avx2 \
+    vp9_highbd_filter_block1d4_h2_avg_sse2
+
+// void vp9_highbd_convolve8_horiz_avx2(const uint8_t *src,
+//                                      ptrdiff_t src_stride,
+//                                      uint8_t *dst,
+//                                      ptrdiff_t dst_stride,
+//                                      const int16_t *filter_x,
+//                                      int x_step_q4,
+//                                      const int16_t *filter_y,
+//                                      int y_step_q4,
+//                                      int w, int h, int bd);
+// void vp9_highbd_convolve8_vert_avx2(const uint8_t *src,
+//                                     ptrdiff_t src_stride,
+//                                     uint8_t *dst,
+//                                     ptrdiff_t dst_stride,
+//                                     const int16_t *filter_x,
+//                                     int x_step_q4,
+//                                     const int16_t *filter_y,
+//                                     int y_step_q4,
+//                                     int w, int h, int bd);
+// void vp9_highbd_convolve8_avg_horiz_avx2(const uint8_t *src,
+//                                          ptrdiff_t src_stride,
+//                                          uint8_t *dst,
+//                                          ptrdiff_t dst_stride,
+//                                          const int16_t *filter_x,
+//                                          int x_step_q4,
+//                                          const int16_t *filter_y,
+//                                          int y_step_q4,
+//                                          int w, int h, int bd);
+// void vp9_highbd_convolve8_avg_vert_avx2(const uint8_t *src,
+//                                         ptrdiff_t src_stride,
+//                                         uint8_t *dst,
+//                                         ptrdiff_t dst_stride,
+//                                         const int16_t *filter_x,
+//                                         int x_step_q4,
+//                                         const int16_t *filter_y,
+//                                         int y_step_q4,
+//                                         int w, int h, int bd);
+HIGH_FUN_CONV_1D(horiz, x_step_q4, filter_x, h, src, , avx2);
+HIGH_FUN_CONV_1D(vert, y_step_q4, filter_y, v, src - src_stride * 3, , avx2);
+HIGH_FUN_CONV_1D(avg_horiz, x_step_q4, filter_x, h, src, avg_, avx2);
+HIGH_FUN_CONV_1D(avg_vert, y_step_q4, filter_y, v, src - src_stride * 3, avg_,
+                 avx2);
+
+// void vp9_highbd_convolve8_avx2(const uint8_t *src, ptrdiff_t src_stride,
+//                                uint8_t *dst, ptrdiff_t dst_stride,
+//                                const int16_t *filter_x, int x_step_q4,
+//                                const int16_t *filter_y, int y_step_q4,
+//                                int w, int h, int bd);
+// void vp9_highbd_convolve8_avg_avx2(const uint8_t *src, ptrdiff_t src_stride,
+//                                    uint8_t *dst, ptrdiff_t dst_stride,
+//                                    const int16_t *filter_x, int x_step_q4,
+//                                    const int16_t *filter_y, int y_step_q4,
+//                                    int w, int h, int bd);
+HIGH_FUN_CONV_2D(, avx2);
+HIGH_FUN_CONV_2D(avg_ , avx2);
+#endif  // ARCH_X86_64
@@ -0,0 +1,507 @@
+/*
+ *  Copyright (c) 2015 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>  // AVX2
+#include <string.h>
+
+#include "./vp9_rtcd.h"
+#include "vp9/common/vp9_idct.h"  // for cospi constants
+#include "vpx_ports/mem.h"
+
+// The 1-D transforms below work on 16 columns at a time: in[k] holds input k
+// of the 16 transforms, one per 16-bit lane. The arithmetic follows the C
+// idct16() and idct32() step by step so the results are bit-exact.
+
+#define pair256_set_epi16(a, b) \
+  _mm256_set_epi16((int16_t)(b), (int16_t)(a), (int16_t)(b), (int16_t)(a), \
+                   (int16_t)(b), (int16_t)(a), (int16_t)(b), (int16_t)(a), \
+                   (int16_t)(b), (int16_t)(a), (int16_t)(b), (int16_t)(a), \
+                   (int16_t)(b), (int16_t)(a), (int16_t)(b), (int16_t)(a))
+
+static INLINE __m256i dct_round_shift_pack(__m256i lo, __m256i hi) {
+  const __m256i rounding = _mm256_set1_epi32(DCT_CONST_ROUNDING);
+  lo = _mm256_srai_epi32(_mm256_add_epi32(lo, rounding), DCT_CONST_BITS);
+  hi = _mm256_srai_epi32(_mm256_add_epi32(hi, rounding), DCT_CONST_BITS);
+  return _mm256_packs_epi32(lo, hi);
+}
+
+// out0 = round(a * k0[0] + b * k0[1]), out1 = round(a * k1[0] + b * k1[1]),
+// with the constant pairs interleaved as built by pair256_set_epi16().
+static INLINE void multiply_add(__m256i a, __m256i b, __m256i k0, __m256i k1,
+                                __m256i *out0, __m256i *out1) {
+  const __m256i lo = _mm256_unpacklo_epi16(a, b);
+  const __m256i hi = _mm256_unpackhi_epi16(a, b);
+  *out0 = dct_round_shift_pack(_mm256_madd_epi16(lo, k0),
+                               _mm256_madd_epi16(hi, k0));
+  *out1 = dct_round_shift_pack(_mm256_madd_epi16(lo, k1),
+                               _mm256_madd_epi16(hi, k1));
+}
+
+// out0 = round(a * c0 - b * c1), out1 = round(a * c1 + b * c0).
+static INLINE void butterfly(__m256i a, __m256i b, int c0, int c1,
+                             __m256i *out0, __m256i *out1) {
+  multiply_add(a, b, pair256_set_epi16(c0, -c1), pair256_set_epi16(c1, c0),
+               out0, out1);
+}
+
+// out0 = round((b - a) * cospi_16_64), out1 = round((a + b) * cospi_16_64).
+static INLINE void butterfly_cospi16(__m256i a, __m256i b,
+                                     __m256i *out0, __m256i *out1) {
+  multiply_add(a, b, pair256_set_epi16(-cospi_16_64, cospi_16_64),
+               pair256_set_epi16(cospi_16_64, cospi_16_64), out0, out1);
+}
+
+// Transpose the 8x8 blocks held in each 128-bit lane of in[0..7].
+static INLINE void transpose_8x8_lanes(const __m256i *in, __m256i *out) {
+  const __m256i a0 = _mm256_unpacklo_epi16(in[0], in[1]);
+  const __m256i a1 = _mm256_unpackhi_epi16(in[0], in[1]);
+  const __m256i a2 = _mm256_unpacklo_epi16(in[2], in[3]);
+  const __m256i a3 = _mm256_unpackhi_epi16(in[2], in[3]);
+  const __m256i a4 = _mm256_unpacklo_epi16(in[4], in[5]);
+  const __m256i a5 = _mm256_unpackhi_epi16(in[4], in[5]);
+  const __m256i a6 = _mm256_unpacklo_epi16(in[6], in[7]);
+  const __m256i a7 = _mm256_unpackhi_epi16(in[6], in[7]);
+
+  const __m256i b0 = _mm256_unpacklo_epi32(a0, a2);
+  const __m256i b1 = _mm256_unpackhi_epi32(a0, a2);
+  const __m256i b2 = _mm256_unpacklo_epi32(a1, a3);
+  const __m256i b3 = _mm256_unpackhi_epi32(a1, a3);
+  const __m256i b4 = _mm256_unpacklo_epi32(a4, a6);
+  const __m256i b5 = _mm256_unpackhi_epi32(a4, a6);
+  const __m256i b6 = _mm256_unpacklo_epi32(a5, a7);
+  const __m256i b7 = _mm256_unpackhi_epi32(a5, a7);
+
+  out[0] = _mm256_unpacklo_epi64(b0, b4);
+  out[1] = _mm256_unpackhi_epi64(b0, b4);
+  out[2] = _mm256_unpacklo_epi64(b1, b5);
+  out[3] = _mm256_unpackhi_epi64(b1, b5);
+  out[4] = _mm256_unpacklo_epi64(b2, b6);
+  out[5] = _mm256_unpackhi_epi64(b2, b6);
+  out[6] = _mm256_unpacklo_epi64(b3, b7);
+  out[7] = _mm256_unpackhi_epi64(b3, b7);
+}
+
+// Transpose a 16x16 block of 16-bit values, one row per register.
+static INLINE void transpose_16x16(__m256i *in) {
+  __m256i left[8], right[8];
+  int i;
+
+  // Gather the left and right 8x8 halves of rows i and i + 8 so that each
+  // 128-bit lane holds one 8x8 block.
+  for (i = 0; i < 8; ++i) {
+    left[i] = _mm256_permute2x128_si256(in[i], in[i + 8], 0x20);
+    right[i] = _mm256_permute2x128_si256(in[i], in[i + 8], 0x31);
+  }
+  transpose_8x8_lanes(left, in);
+  transpose_8x8_lanes(right, in + 8);
+}
+
+static void idct16_avx2(__m256i *in) {
+  __m256i step1[16], step2[16];
+
+  // stage 2
+  butterfly(in[1], in[15], cospi_30_64, cospi_2_64, &step2[8], &step2[15]);
+  butterfly(in[9], in[7], cospi_14_64, cospi_18_64, &step2[9], &step2[14]);
+  butterfly(in[5], in[11], cospi_22_64, cospi_10_64, &step2[10], &step2[13]);
+  butterfly(in[13], in[3], cospi_6_64, cospi_26_64, &step2[11], &step2[12]);
+
+  // stage 3
+  butterfly(in[2], in[14], cospi_28_64, cospi_4_64, &step1[4], &step1[7]);
+  butterfly(in[10], in[6], cospi_12_64, cospi_20_64, &step1[5], &step1[6]);
+  step1[8] = _mm256_add_epi16(step2[8], step2[9]);
+  step1[9] = _mm256_sub_epi16(step2[8], step2[9]);
+  step1[10] = _mm256_sub_epi16(step2[11], step2[10]);
+  step1[11] = _mm256_add_epi16(step2[10], step2[11]);
+  step1[12] = _mm256_add_epi16(step2[12], step2[13]);
+  step1[13] = _mm256_sub_epi16(step2[12], step2[13]);
+  step1[14] = _mm256_sub_epi16(step2[15], step2[14]);
+  step1[15] = _mm256_add_epi16(step2[14], step2[15]);
+
+  // stage 4
+  multiply_add(in[0], in[8], pair256_set_epi16(cospi_16_64, cospi_16_64),
+               pair256_set_epi16(cospi_16_64, -cospi_16_64),
+               &step2[0], &step2[1]);
+  butterfly(in[4], in[12], cospi_24_64, cospi_8_64, &step2[2], &step2[3]);
+  step2[4] = _mm256_add_epi16(step1[4], step1[5]);
+  step2[5] = _mm256_sub_epi16(step1[4], step1[5]);
+  step2[6] = _mm256_sub_epi16(step1[7], step1[6]);
+  step2[7] = _mm256_add_epi16(step1[6], step1[7]);
+  step2[8] = step1[8];
+  step2[15] = step1[15];
+  multiply_add(step1[9], step1[14], pair256_set_epi16(-cospi_8_64, cospi_24_64),
+               pair256_set_epi16(cospi_24_64, cospi_8_64),
+               &step2[9], &step2[14]);
+  multiply_add(step1[10], step1[13],
+               pair256_set_epi16(-cospi_24_64, -cospi_8_64),
+               pair256_set_epi16(-cospi_8_64, cospi_24_64),
+               &step2[10], &step2[13]);
+  step2[11] = step1[11];
+  step2[12] = step1[12];
+
+  // stage 5
+  step1[0] = _mm256_add_epi16(step2[0], step2[3]);
+  step1[1] = _mm256_add_epi16(step2[1], step2[2]);
+  step1[2] = _mm256_sub_epi16(step2[1], step2[2]);
+  step1[3] = _mm256_sub_epi16(step2[0], step2[3]);
+  step1[4] = step2[4];
+  butterfly_cospi16(step2[5], step2[6], &step1[5], &step1[6]);
+  step1[7] = step2[7];
+  step1[8] = _mm256_add_epi16(step2[8], step2[11]);
+  step1[9] = _mm256_add_epi16(step2[9], step2[10]);
+  step1[10] = _mm256_sub_epi16(step2[9], step2[10]);
+  step1[11] = _mm256_sub_epi16(step2[8], step2[11]);
+  step1[12] = _mm256_sub_epi16(step2[15], step2[12]);
+  step1[13] = _mm256_sub_epi16(step2[14], step2[13]);
+  step1[14] = _mm256_add_epi16(step2[13], step2[14]);
+  step1[15] = _mm256_add_epi16(step2[12], step2[15]);
+
+  // stage 6
+  step2[0] = _mm256_add_epi16(step1[0], step1[7]);
+  step2[1] = _mm256_add_epi16(step1[1], step1[6]);
+  step2[2] = _mm256_add_epi16(step1[2], step1[5]);
+  step2[3] = _mm256_add_epi16(step1[3], step1[4]);
+  step2[4] = _mm256_sub_epi16(step1[3], step1[4]);
+  step2[5] = _mm256_sub_epi16(step1[2], step1[5]);
+  step2[6] = _mm256_sub_epi16(step1[1], step1[6]);
+  step2[7] = _mm256_sub_epi16(step1[0], step1[7]);
+  step2[8] = step1[8];
+  step2[9] = step1[9];
+  butterfly_cospi16(step1[10], step1[13], &step2[10], &step2[13]);
+  butterfly_cospi16(step1[11], step1[12], &step2[11], &step2[12]);
+  step2[14] = step1[14];
+  step2[15] = step1[15];
+
+  // stage 7
+  in[0] = _mm256_add_epi16(step2[0], step2[15]);
+  in[1] = _mm256_add_epi16(step2[1], step2[14]);
+  in[2] = _mm256_add_epi16(step2[2], step2[13]);
+  in[3] = _mm256_add_epi16(step2[3], step2[12]);
+  in[4] = _mm256_add_epi16(step2[4], step2[11]);
+  in[5] = _mm256_add_epi16(step2[5], step2[10]);
+  in[6] = _mm256_add_epi16(step2[6], step2[9]);
+  in[7] = _mm256_add_epi16(step2[7], step2[8]);
+  in[8] = _mm256_sub_epi16(step2[7], step2[8]);
+  in[9] = _mm256_sub_epi16(step2[6], step2[9]);
+  in[10] = _mm256_sub_epi16(step2[5], step2[10]);
+  in[11] = _mm256_sub_epi16(step2[4], step2[11]);
+  in[12] = _mm256_sub_epi16(step2[3], step2[12]);
+  in[13] = _mm256_sub_epi16(step2[2], step2[13]);
+  in[14] = _mm256_sub_epi16(step2[1], step2[14]);
+  in[15] = _mm256_sub_epi16(step2[0], step2[15]);
+}
+
+// The even inputs of idct32() go through the same steps as idct16(), so only
+// the odd half is computed here.
+static void idct32_avx2(__m256i *in) {
+  __m256i even[16], step1[32], step2[32];
+  int i;
+
+  for (i = 0; i < 16; ++i)
+    even[i] = in[2 * i];
+  idct16_avx2(even);
+
+  // stage 1
+  butterfly(in[1], in[31], cospi_31_64, cospi_1_64, &step1[16], &step1[31]);
+  butterfly(in[17], in[15], cospi_15_64, cospi_17_64, &step1[17], &step1[30]);
+  butterfly(in[9], in[23], cospi_23_64, cospi_9_64, &step1[18], &step1[29]);
+  butterfly(in[25], in[7], cospi_7_64, cospi_25_64, &step1[19], &step1[28]);
+  butterfly(in[5], in[27], cospi_27_64, cospi_5_64, &step1[20], &step1[27]);
+  butterfly(in[21], in[11], cospi_11_64, cospi_21_64, &step1[21], &step1[26]);
+  butterfly(in[13], in[19], cospi_19_64, cospi_13_64, &step1[22], &step1[25]);
+  butterfly(in[29], in[3], cospi_3_64, cospi_29_64, &step1[23], &step1[24]);
+
+  // stage 2
+  step2[16] = _mm256_add_epi16(step1[16], step1[17]);
+  step2[17] = _mm256_sub_epi16(step1[16], step1[17]);
+  step2[18] = _mm256_sub_epi16(step1[19], step1[18]);
+  step2[19] = _mm256_add_epi16(step1[18], step1[19]);
+  step2[20] = _mm256_add_epi16(step1[20], step1[21]);
+  step2[21] = _mm256_sub_epi16(step1[20], step1[21]);
+  step2[22] = _mm256_sub_epi16(step1[23], step1[22]);
+  step2[23] = _mm256_add_epi16(step1[22], step1[23]);
+  step2[24] = _mm256_add_epi16(step1[24], step1[25]);
+  step2[25] = _mm256_sub_epi16(step1[24], step1[25]);
+  step2[26] = _mm256_sub_epi16(step1[27], step1[26]);
+  step2[27] = _mm256_add_epi16(step1[26], step1[27]);
+  step2[28] = _mm256_add_epi16(step1[28], step1[29]);
+  step2[29] = _mm256_sub_epi16(step1[28], step1[29]);
+  step2[30] = _mm256_sub_epi16(step1[31], step1[30]);
+  step2[31] = _mm256_add_epi16(step1[30], step1[31]);
+
+  // stage 3
+  step1[16] = step2[16];
+  step1[31] = step2[31];
+  multiply_add(step2[17], step2[30], pair256_set_epi16(-cospi_4_64, cospi_28_64),
+               pair256_set_epi16(cospi_28_64, cospi_4_64),
+               &step1[17], &step1[30]);
+  multiply_add(step2[18], step2[29],
+               pair256_set_epi16(-cospi_28_64, -cospi_4_64),
+               pair256_set_epi16(-cospi_4_64, cospi_28_64),
+               &step1[18], &step1[29]);
+  step1[19] = step2[19];
+  step1[20] = step2[20];
+  multiply_add(step2[21], step2[26],
+               pair256_set_epi16(-cospi_20_64, cospi_12_64),
+               pair256_set_epi16(cospi_12_64, cospi_20_64),
+               &step1[21], &step1[26]);
+  multiply_add(step2[22], step2[25],
+               pair256_set_epi16(-cospi_12_64, -cospi_20_64),
+               pair256_set_epi16(-cospi_20_64, cospi_12_64),
+               &step1[22], &step1[25]);
+  step1[23] = step2[23];
+  step1[24] = step2[24];
+  step1[27] = step2[27];
+  step1[28] = step2[28];
+
+  // stage 4
+  step2[16] = _mm256_add_epi16(step1[16], step1[19]);
+  step2[17] = _mm256_add_epi16(step1[17], step1[18]);
+  step2[18] = _mm256_sub_epi16(step1[17], step1[18]);
+  step2[19] = _mm256_sub_epi16(step1[16], step1[19]);
+  step2[20] = _mm256_sub_epi16(step1[23], step1[20]);
+  step2[21] = _mm256_sub_epi16(step1[22], step1[21]);
+  step2[22] = _mm256_add_epi16(step1[21], step1[22]);
+  step2[23] = _mm256_add_epi16(step1[20], step1[23]);
+  step2[24] = _mm256_add_epi16(step1[24], step1[27]);
+  step2[25] = _mm256_add_epi16(step1[25], step1[26]);
+  step2[26] = _mm256_sub_epi16(step1[25], step1[26]);
+  step2[27] = _mm256_sub_epi16(step1[24], step1[27]);
+  step2[28] = _mm256_sub_epi16(step1[31], step1[28]);
+  step2[29] = _mm256_sub_epi16(step1[30], step1[29]);
+  step2[30] = _mm256_add_epi16(step1[29], step1[30]);
+  step2[31] = _mm256_add_epi16(step1[28], step1[31]);
+
+  // stage 5
+  step1[16] = step2[16];
+  step1[17] = step2[17];
+  multiply_add(step2[18], step2[29], pair256_set_epi16(-cospi_8_64, cospi_24_64),
+               pair256_set_epi16(cospi_24_64, cospi_8_64),
+               &step1[18], &step1[29]);
+  multiply_add(step2[19], step2[28], pair256_set_epi16(-cospi_8_64, cospi_24_64),
+               pair256_set_epi16(cospi_24_64, cospi_8_64),
+               &step1[19], &step1[28]);
+  multiply_add(step2[20], step2[27],
+               pair256_set_epi16(-cospi_24_64, -cospi_8_64),
+               pair256_set_epi16(-cospi_8_64, cospi_24_64),
+               &step1[20], &step1[27]);
+  multiply_add(step2[21], step2[26],
+               pair256_set_epi16(-cospi_24_64, -cospi_8_64),
+               pair256_set_epi16(-cospi_8_64, cospi_24_64),
+               &step1[21], &step1[26]);
+  step1[22] = step2[22];
+  step1[23] = step2[23];
+  step1[24] = step2[24];
+  step1[25] = step2[25];
+  step1[30] = step2[30];
+  step1[31] = step2[31];
+
+  // stage 6
+  step2[16] = _mm256_add_epi16(step1[16], step1[23]);
+  step2[17] = _mm256_add_epi16(step1[17], step1[22]);
+  step2[18] = _mm256_add_epi16(step1[18], step1[21]);
+  step2[19] = _mm256_add_epi16(step1[19], step1[20]);
+  step2[20] = _mm256_sub_epi16(step1[19], step1[20]);
+  step2[21] = _mm256_sub_epi16(step1[18], step1[21]);
+  step2[22] = _mm256_sub_epi16(step1[17], step1[22]);
+  step2[23] = _mm256_sub_epi16(step1[16], step1[23]);
+  step2[24] = _mm256_sub_epi16(step1[31], step1[24]);
+  step2[25] = _mm256_sub_epi16(step1[30], step1[25]);
+  step2[26] = _mm256_sub_epi16(step1[29], step1[26]);
+  step2[27] = _mm256_sub_epi16(step1[28], step1[27]);
+  step2[28] = _mm256_add_epi16(step1[27], step1[28]);
+  step2[29] = _mm256_add_epi16(step1[26], step1[29]);
+  step2[30] = _mm256_add_epi16(step1[25], step1[30]);
+  step2[31] = _mm256_add_epi16(step1[24], step1[31]);
+
+  // stage 7
+  step1[16] = step2[16];
+  step1[17] = step2[17];
+  step1[18] = step2[18];
+  step1[19] = step2[19];
+  butterfly_cospi16(step2[20], step2[27], &step1[20], &step1[27]);
+  butterfly_cospi16(step2[21], step2[26], &step1[21], &step1[26]);
+  butterfly_cospi16(step2[22], step2[25], &step1[22], &step1[25]);
+  butterfly_cospi16(step2[23], step2[24], &step1[23], &step1[24]);
+  step1[28] = step2[28];
+  step1[29] = step2[29];
+  step1[30] = step2[30];
+  step1[31] = step2[31];
+
+  // final stage
+  for (i = 0; i < 16; ++i) {
+    in[i] = _mm256_add_epi16(even[i], step1[31 - i]);
+    in[31 - i] = _mm256_sub_epi16(even[i], step1[31 - i]);
+  }
+}
+
+// Add ROUND_POWER_OF_TWO(in, 6) to 16 destination pixels. mulhrs by 1 << 9
+// computes the rounded shift without overflowing 16 bits.
+static INLINE void recon_and_store_16(uint8_t *dest, __m256i in) {
+  const __m256i d = _mm256_cvtepu8_epi16(_mm_loadu_si128((__m128i *)dest));
+  in = _mm256_mulhrs_epi16(in, _mm256_set1_epi16(1 << 9));
+  in = _mm256_add_epi16(in, d);
+  _mm_storeu_si128((__m128i *)dest,
+                   _mm_packus_epi16(_mm256_castsi256_si128(in),
+                                    _mm256_extracti128_si256(in, 1)));
+}
+
+static INLINE void load_buffer_16x16(const int16_t *input, int stride,
+                                     int rows, __m256i *in) {
+  int i;
+  for (i = 0; i < rows; ++i)
+    in[i] = _mm256_loadu_si256((const __m256i *)(input + i * stride));
+  for (; i < 16; ++i)
+    in[i] = _mm256_setzero_si256();
+}
+
+static void idct16x16_add(const int16_t *input, uint8_t *dest, int stride,
+                          int rows) {
+  __m256i in[16];
+  int i;
+
+  load_buffer_16x16(input, 16, rows, in);
+  transpose_16x16(in);
+  idct16_avx2(in);
+  transpose_16x16(in);
+  idct16_avx2(in);
+
+  for (i = 0; i < 16; ++i)
+    recon_and_store_16(dest + i * stride, in[i]);
+}
+
+void vp9_idct16x16_256_add_avx2(const int16_t *input, uint8_t *dest,
+                                int stride) {
+  idct16x16_add(input, dest, stride, 16);
+}
+
+void vp9_idct16x16_10_add_avx2(const int16_t *input, uint8_t *dest,
+                               int stride) {
+  // Only the upper-left 4x4 coefficients are non-zero.
+  idct16x16_add(input, dest, stride, 4);
+}
+
+// Add dc to a block of 'size' x 'size' pixels, 'size' being 16 or 32.
+static INLINE void add_dc(uint8_t *dest, int stride, int size, int16_t dc) {
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i dc16 = _mm256_set1_epi16(dc);
+  int i;
+
+  if (size == 16) {
+    for (i = 0; i < 16; i += 2) {
+      const __m256i d = _mm256_inserti128_si256(
+          _mm256_castsi128_si256(_mm_loadu_si128((__m128i *)dest)),
+          _mm_loadu_si128((__m128i *)(dest + stride)), 1);
+      const __m256i lo = _mm256_add_epi16(_mm256_unpacklo_epi8(d, zero), dc16);
+      const __m256i hi = _mm256_add_epi16(_mm256_unpackhi_epi8(d, zero), dc16);
+      const __m256i res = _mm256_packus_epi16(lo, hi);
+      _mm_storeu_si128((__m128i *)dest, _mm256_castsi256_si128(res));
+      _mm_storeu_si128((__m128i *)(dest + stride),
+                       _mm256_extracti128_si256(res, 1));
+      dest += 2 * stride;
+    }
+  } else {
+    for (i = 0; i < size; ++i) {
+      const __m256i d = _mm256_loadu_si256((__m256i *)dest);
+      const __m256i lo = _mm256_add_epi16(_mm256_unpacklo_epi8(d, zero), dc16);
+      const __m256i hi = _mm256_add_epi16(_mm256_unpackhi_epi8(d, zero), dc16);
+      _mm256_storeu_si256((__m256i *)dest, _mm256_packus_epi16(lo, hi));
+      dest += stride;
+    }
+  }
+}
+
+static INLINE int16_t get_dc(const int16_t *input) {
+  int16_t out = WRAPLOW(dct_const_round_shift(input[0] * cospi_16_64), 8);
+  out = WRAPLOW(dct_const_round_shift(out * cospi_16_64), 8);
+  return ROUND_POWER_OF_TWO(out, 6);
+}
+
+void vp9_idct16x16_1_add_avx2(const int16_t *input, uint8_t *dest,
+                              int stride) {
+  add_dc(dest, stride, 16, get_dc(input));
+}
+
+// Row transform of 'rows' rows starting at row 'row' of the 32x32 input,
+// written to out as 32 rows of 32 values. Only the first 'cols' input
+// columns are read, the rest are taken to be zero.
+static void idct32_rows(const int16_t *input, int16_t *out, int row, int rows,
+                        int cols) {
+  __m256i in[32];
+  int i;
+
+  load_buffer_16x16(input + row * 32, 32, rows, in);
+  load_buffer_16x16(input + row * 32 + 16, 32, cols > 16 ? rows : 0, in + 16);
+  transpose_16x16(in);
+  transpose_16x16(in + 16);
+  idct32_avx2(in);
+  transpose_16x16(in);
+  transpose_16x16(in + 16);
+
+  for (i = 0; i < 16; ++i) {
+    _mm256_storeu_si256((__m256i *)(out + (row + i) * 32), in[i]);
+    _mm256_storeu_si256((__m256i *)(out + (row + i) * 32 + 16), in[16 + i]);
+  }
+}
+
+static void idct32_cols(const int16_t *out, uint8_t *dest, int stride) {
+  __m256i in[32];
+  int i, col;
+
+  for (col = 0; col < 32; col += 16) {
+    for (i = 0; i < 32; ++i)
+      in[i] = _mm256_loadu_si256((const __m256i *)(out + i * 32 + col));
+    idct32_avx2(in);
+    for (i = 0; i < 32; ++i)
+      recon_and_store_16(dest + i * stride + col, in[i]);
+  }
+}
+
+static INLINE int is_zero_16x32(const int16_t *input) {
+  __m256i acc = _mm256_setzero_si256();
+  int i;
+  for (i = 0; i < 32; ++i) {
+    acc = _mm256_or_si256(acc,
+                          _mm256_loadu_si256((const __m256i *)(input + 16 * i)));
+  }
+  return _mm256_testz_si256(acc, acc);
+}
+
+void vp9_idct32x32_1024_add_avx2(const int16_t *input, uint8_t *dest,
+                                 int stride) {
+  DECLARE_ALIGNED(32, int16_t, out[32 * 32]);
+  int row;
+
+  // Rows. Groups of 16 rows with no non-zero coefficients transform to zero.
+  for (row = 0; row < 32; row += 16) {
+    if (is_zero_16x32(input + row * 32)) {
+      memset(out + row * 32, 0, 16 * 32 * sizeof(out[0]));
+    } else {
+      idct32_rows(input, out, row, 16, 32);
+    }
+  }
+
+  idct32_cols(out, dest, stride);
+}
+
+void vp9_idct32x32_34_add_avx2(const int16_t *input, uint8_t *dest,
+                               int stride) {
+  DECLARE_ALIGNED(32, int16_t, out[32 * 32]);
+
+  // Only the upper-left 8x8 coefficients are non-zero.
+  idct32_rows(input, out, 0, 8, 16);
+  memset(out + 16 * 32, 0, 16 * 32 * sizeof(out[0]));
+
+  idct32_cols(out, dest, stride);
+}
+
+void vp9_idct32x32_1_add_avx2(const int16_t *input, uint8_t *dest,
+                              int stride) {
+  add_dc(dest, stride, 32, get_dc(input));
+}
@@ -0,0 +1,205 @@
+/*
+ *  Copyright (c) 2015 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>
+
+#include "./vp9_rtcd.h"
+#include "vpx_ports/mem.h"
+
+// Every row of the d117, d135 and d153 predictors is a 32 pixel window into a
+// line made of the filtered left column, reversed, followed by the filtered
+// above row. The line is kept in registers and each row is extracted from it
+// with one _mm256_alignr_epi8(), so the rows do not depend on each other.
+
+DECLARE_ALIGNED(16, static const uint8_t, reverse_bytes[16]) = {
+  15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0
+};
+
+DECLARE_ALIGNED(16, static const uint8_t, reverse_even_bytes[16]) = {
+  0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+  14, 12, 10, 8, 6, 4, 2, 0
+};
+
+DECLARE_ALIGNED(16, static const uint8_t, reverse_odd_bytes[16]) = {
+  0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+  15, 13, 11, 9, 7, 5, 3, 1
+};
+
+static INLINE __m128i avg3_epu8(const __m128i a, const __m128i b,
+                                const __m128i c) {
+  const __m128i odd = _mm_and_si128(_mm_xor_si128(a, c), _mm_set1_epi8(1));
+  const __m128i avg = _mm_subs_epu8(_mm_avg_epu8(a, c), odd);
+  return _mm_avg_epu8(avg, b);
+}
+
+static INLINE __m256i avg3_epu8_avx2(const __m256i a, const __m256i b,
+                                     const __m256i c) {
+  const __m256i odd = _mm256_and_si256(_mm256_xor_si256(a, c),
+                                       _mm256_set1_epi8(1));
+  const __m256i avg = _mm256_subs_epu8(_mm256_avg_epu8(a, c), odd);
+  return _mm256_avg_epu8(avg, b);
+}
+
+static INLINE __m128i shift_in_byte(const __m128i x, int v) {
+  return _mm_or_si128(_mm_slli_si128(x, 1), _mm_cvtsi32_si128(v));
+}
+
+// out[r] = AVG3(left[r - 2], left[r - 1], left[r]) for r < 16, with above[-1]
+// and above[0] standing in for left[-1] and left[-2].
+static INLINE __m128i filter_left_lo(const uint8_t *above,
+                                     const uint8_t *left) {
+  const __m128i l = _mm_loadu_si128((const __m128i *)left);
+  const __m128i lm1 = shift_in_byte(l, above[-1]);
+  const __m128i lm2 = shift_in_byte(lm1, above[0]);
+  return avg3_epu8(lm2, lm1, l);
+}
+
+static INLINE __m128i filter_left_hi(const uint8_t *left) {
+  return avg3_epu8(_mm_loadu_si128((const __m128i *)(left + 14)),
+                   _mm_loadu_si128((const __m128i *)(left + 15)),
+                   _mm_loadu_si128((const __m128i *)(left + 16)));
+}
+
+// out[c] = AVG3(above[c - 1], above[c], above[c + 1]) for c < 32.
+static INLINE __m256i filter_above(const uint8_t *above) {
+  return avg3_epu8_avx2(_mm256_loadu_si256((const __m256i *)(above - 1)),
+                        _mm256_loadu_si256((const __m256i *)above),
+                        _mm256_loadu_si256((const __m256i *)(above + 1)));
+}
+
+static INLINE __m128i gather_col(const __m128i lo, const __m128i hi,
+                                 const __m128i mask) {
+  return _mm_or_si128(_mm_shuffle_epi8(lo, mask),
+                      _mm_srli_si128(_mm_shuffle_epi8(hi, mask), 8));
+}
+
+// Stores the window of pixels n to n + 31 of the 64 pixel line [lo hi] as row
+// r, for 0 <= n < 16. x must hold the middle of the line: lo's upper half
+// followed by hi's lower half.
+#define WINDOW_LO(r, lo, x, n)                                           \
+  _mm256_storeu_si256((__m256i *)(dst + (r) * stride),                  \
+                      _mm256_alignr_epi8(x, lo, n))
+
+// As WINDOW_LO() for the window of pixels 16 + n to 47 + n.
+#define WINDOW_HI(r, x, hi, n)                                           \
+  _mm256_storeu_si256((__m256i *)(dst + (r) * stride),                  \
+                      _mm256_alignr_epi8(hi, x, n))
+
+static INLINE __m256i line_middle(const __m256i lo, const __m256i hi) {
+  return _mm256_permute2x128_si256(lo, hi, 0x21);
+}
+
+static INLINE __m256i combine(const __m128i lo, const __m128i hi) {
+  return _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+}
+
+void vp9_d135_predictor_32x32_avx2(uint8_t *dst, ptrdiff_t stride,
+                                   const uint8_t *above, const uint8_t *left) {
+  const __m128i rev = _mm_load_si128((const __m128i *)reverse_bytes);
+  const __m256i lo = combine(_mm_shuffle_epi8(filter_left_hi(left), rev),
+                             _mm_shuffle_epi8(filter_left_lo(above, left),
+                                              rev));
+  const __m256i hi = filter_above(above);
+  const __m256i x = line_middle(lo, hi);
+
+  // Row r starts at pixel 31 - r of the line.
+  WINDOW_HI(0, x, hi, 15);  WINDOW_HI(1, x, hi, 14);
+  WINDOW_HI(2, x, hi, 13);  WINDOW_HI(3, x, hi, 12);
+  WINDOW_HI(4, x, hi, 11);  WINDOW_HI(5, x, hi, 10);
+  WINDOW_HI(6, x, hi, 9);   WINDOW_HI(7, x, hi, 8);
+  WINDOW_HI(8, x, hi, 7);   WINDOW_HI(9, x, hi, 6);
+  WINDOW_HI(10, x, hi, 5);  WINDOW_HI(11, x, hi, 4);
+  WINDOW_HI(12, x, hi, 3);  WINDOW_HI(13, x, hi, 2);
+  WINDOW_HI(14, x, hi, 1);  WINDOW_HI(15, x, hi, 0);
+  WINDOW_LO(16, lo, x, 15); WINDOW_LO(17, lo, x, 14);
+  WINDOW_LO(18, lo, x, 13); WINDOW_LO(19, lo, x, 12);
+  WINDOW_LO(20, lo, x, 11); WINDOW_LO(21, lo, x, 10);
+  WINDOW_LO(22, lo, x, 9);  WINDOW_LO(23, lo, x, 8);
+  WINDOW_LO(24, lo, x, 7);  WINDOW_LO(25, lo, x, 6);
+  WINDOW_LO(26, lo, x, 5);  WINDOW_LO(27, lo, x, 4);
+  WINDOW_LO(28, lo, x, 3);  WINDOW_LO(29, lo, x, 2);
+  WINDOW_LO(30, lo, x, 1);  WINDOW_LO(31, lo, x, 0);
+}
+
+// The even and odd rows of d117 are windows into two lines, each with half
+// of the filtered left column: 16 pixels of it followed by the above row
+// average (even rows) or the filtered above row (odd rows). Only the upper
+// half of the left part of the lines is needed, so x holds it directly.
+void vp9_d117_predictor_32x32_avx2(uint8_t *dst, ptrdiff_t stride,
+                                   const uint8_t *above, const uint8_t *left) {
+  const __m128i d_lo = filter_left_lo(above, left);
+  const __m128i d_hi = filter_left_hi(left);
+  const __m256i even = _mm256_avg_epu8(
+      _mm256_loadu_si256((const __m256i *)(above - 1)),
+      _mm256_loadu_si256((const __m256i *)above));
+  const __m256i odd = filter_above(above);
+  const __m256i x_even = combine(gather_col(d_lo, d_hi, _mm_load_si128(
+      (const __m128i *)reverse_odd_bytes)), _mm256_castsi256_si128(even));
+  const __m256i x_odd = combine(gather_col(d_lo, d_hi, _mm_load_si128(
+      (const __m128i *)reverse_even_bytes)), _mm256_castsi256_si128(odd));
+
+  _mm256_storeu_si256((__m256i *)dst, even);
+  WINDOW_HI(1, x_odd, odd, 15);   WINDOW_HI(2, x_even, even, 15);
+  WINDOW_HI(3, x_odd, odd, 14);   WINDOW_HI(4, x_even, even, 14);
+  WINDOW_HI(5, x_odd, odd, 13);   WINDOW_HI(6, x_even, even, 13);
+  WINDOW_HI(7, x_odd, odd, 12);   WINDOW_HI(8, x_even, even, 12);
+  WINDOW_HI(9, x_odd, odd, 11);   WINDOW_HI(10, x_even, even, 11);
+  WINDOW_HI(11, x_odd, odd, 10);  WINDOW_HI(12, x_even, even, 10);
+  WINDOW_HI(13, x_odd, odd, 9);   WINDOW_HI(14, x_even, even, 9);
+  WINDOW_HI(15, x_odd, odd, 8);   WINDOW_HI(16, x_even, even, 8);
+  WINDOW_HI(17, x_odd, odd, 7);   WINDOW_HI(18, x_even, even, 7);
+  WINDOW_HI(19, x_odd, odd, 6);   WINDOW_HI(20, x_even, even, 6);
+  WINDOW_HI(21, x_odd, odd, 5);   WINDOW_HI(22, x_even, even, 5);
+  WINDOW_HI(23, x_odd, odd, 4);   WINDOW_HI(24, x_even, even, 4);
+  WINDOW_HI(25, x_odd, odd, 3);   WINDOW_HI(26, x_even, even, 3);
+  WINDOW_HI(27, x_odd, odd, 2);   WINDOW_HI(28, x_even, even, 2);
+  WINDOW_HI(29, x_odd, odd, 1);   WINDOW_HI(30, x_even, even, 1);
+  WINDOW_HI(31, x_odd, odd, 0);
+}
+
+// d153 shifts in two pixels per row, so its line interleaves the 2-tap
+// average of the left column with the filtered left column and is 96 pixels
+// long: row r starts at pixel 62 - 2 * r.
+void vp9_d153_predictor_32x32_avx2(uint8_t *dst, ptrdiff_t stride,
+                                   const uint8_t *above, const uint8_t *left) {
+  const __m128i rev = _mm_load_si128((const __m128i *)reverse_bytes);
+  const __m128i l0 = _mm_loadu_si128((const __m128i *)left);
+  const __m128i l1 = _mm_loadu_si128((const __m128i *)(left + 16));
+  const __m128i c0 = _mm_shuffle_epi8(
+      _mm_avg_epu8(shift_in_byte(l0, above[-1]), l0), rev);
+  const __m128i c1 = _mm_shuffle_epi8(
+      _mm_avg_epu8(_mm_loadu_si128((const __m128i *)(left + 15)), l1), rev);
+  const __m128i d0 = _mm_shuffle_epi8(filter_left_lo(above, left), rev);
+  const __m128i d1 = _mm_shuffle_epi8(filter_left_hi(left), rev);
+  const __m256i line0 = combine(_mm_unpacklo_epi8(c1, d1),
+                                _mm_unpackhi_epi8(c1, d1));
+  const __m256i line1 = combine(_mm_unpacklo_epi8(c0, d0),
+                                _mm_unpackhi_epi8(c0, d0));
+  const __m256i line2 = filter_above(above);
+  const __m256i x01 = line_middle(line0, line1);
+  const __m256i x12 = line_middle(line1, line2);
+
+  WINDOW_HI(0, x12, line2, 14);   WINDOW_HI(1, x12, line2, 12);
+  WINDOW_HI(2, x12, line2, 10);   WINDOW_HI(3, x12, line2, 8);
+  WINDOW_HI(4, x12, line2, 6);    WINDOW_HI(5, x12, line2, 4);
+  WINDOW_HI(6, x12, line2, 2);    WINDOW_HI(7, x12, line2, 0);
+  WINDOW_LO(8, line1, x12, 14);   WINDOW_LO(9, line1, x12, 12);
+  WINDOW_LO(10, line1, x12, 10);  WINDOW_LO(11, line1, x12, 8);
+  WINDOW_LO(12, line1, x12, 6);   WINDOW_LO(13, line1, x12, 4);
+  WINDOW_LO(14, line1, x12, 2);   WINDOW_LO(15, line1, x12, 0);
+  WINDOW_HI(16, x01, line1, 14);  WINDOW_HI(17, x01, line1, 12);
+  WINDOW_HI(18, x01, line1, 10);  WINDOW_HI(19, x01, line1, 8);
+  WINDOW_HI(20, x01, line1, 6);   WINDOW_HI(21, x01, line1, 4);
+  WINDOW_HI(22, x01, line1, 2);   WINDOW_HI(23, x01, line1, 0);
+  WINDOW_LO(24, line0, x01, 14);  WINDOW_LO(25, line0, x01, 12);
+  WINDOW_LO(26, line0, x01, 10);  WINDOW_LO(27, line0, x01, 8);
+  WINDOW_LO(28, line0, x01, 6);   WINDOW_LO(29, line0, x01, 4);
+  WINDOW_LO(30, line0, x01, 2);   WINDOW_LO(31, line0, x01, 0);
+}
@@ -0,0 +1,307 @@
+/*
+ *  Copyright (c) 2015 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "./vp9_rtcd.h"
+
+#include <tmmintrin.h>
+
+#include "vpx_ports/mem.h"
+
+// The d117, d135 and d153 predictors copy every row from the row above it,
+// shifted right by one or two pixels, with new pixels from the filtered left
+// column shifted in at the start of the row. The rows are built that way in
+// registers: _mm_alignr_epi8() shifts the row and takes the new pixels from
+// the top bytes of a column vector, which holds the column in reverse order.
+
+DECLARE_ALIGNED(16, static const uint8_t, reverse_bytes[16]) = {
+  15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0
+};
+
+// Gather the even or the odd bytes, reversed, into the upper half.
+DECLARE_ALIGNED(16, static const uint8_t, reverse_even_bytes[16]) = {
+  0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+  14, 12, 10, 8, 6, 4, 2, 0
+};
+
+DECLARE_ALIGNED(16, static const uint8_t, reverse_odd_bytes[16]) = {
+  0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+  15, 13, 11, 9, 7, 5, 3, 1
+};
+
+// ROUND_POWER_OF_TWO(a + 2 * b + c, 2) without leaving 8 bits.
+static INLINE __m128i avg3_epu8(const __m128i a, const __m128i b,
+                                const __m128i c) {
+  const __m128i odd = _mm_and_si128(_mm_xor_si128(a, c), _mm_set1_epi8(1));
+  const __m128i avg = _mm_subs_epu8(_mm_avg_epu8(a, c), odd);
+  return _mm_avg_epu8(avg, b);
+}
+
+// Shifts x up by one byte and puts v in the lowest byte.
+static INLINE __m128i shift_in_byte(const __m128i x, int v) {
+  return _mm_or_si128(_mm_slli_si128(x, 1), _mm_cvtsi32_si128(v));
+}
+
+// Filters up to 16 left pixels, treating above[-1] and above[0] as left[-1]
+// and left[-2]: out[r] = AVG3(left[r - 2], left[r - 1], left[r]). out[0] is
+// the top-left pixel of d135 and d117's second row; out[r] for r > 0 is the
+// pixel d135 and d153 put at row r of their first (d153: second) column.
+static INLINE __m128i filter_left(const __m128i l, const uint8_t *above) {
+  const __m128i lm1 = shift_in_byte(l, above[-1]);
+  const __m128i lm2 = shift_in_byte(lm1, above[0]);
+  return avg3_epu8(lm2, lm1, l);
+}
+
+// Pixels 16 to 31 of the filtered left column.
+static INLINE __m128i filter_left_hi(const uint8_t *left) {
+  return avg3_epu8(_mm_loadu_si128((const __m128i *)(left + 14)),
+                   _mm_loadu_si128((const __m128i *)(left + 15)),
+                   _mm_loadu_si128((const __m128i *)(left + 16)));
+}
+
+// out[c] = AVG3(above[c - 1], above[c], above[c + 1]) for 16 pixels from c.
+static INLINE __m128i filter_above(const uint8_t *above) {
+  return avg3_epu8(_mm_loadu_si128((const __m128i *)(above - 1)),
+                   _mm_loadu_si128((const __m128i *)above),
+                   _mm_loadu_si128((const __m128i *)(above + 1)));
+}
+
+// filter_above() for blocks of 8 pixels or less, which must not read past
+// above[2 * bs - 1]. a holds above[-1] and the pixels after it.
+static INLINE __m128i filter_above_small(const __m128i a) {
+  return avg3_epu8(a, _mm_srli_si128(a, 1), _mm_srli_si128(a, 2));
+}
+
+// Combines the column vectors of the two halves of a 32 pixel column.
+static INLINE __m128i gather_col(const __m128i lo, const __m128i hi,
+                                 const __m128i mask) {
+  return _mm_or_si128(_mm_shuffle_epi8(lo, mask),
+                      _mm_srli_si128(_mm_shuffle_epi8(hi, mask), 8));
+}
+
+void vp9_d135_predictor_4x4_ssse3(uint8_t *dst, ptrdiff_t stride,
+                                  const uint8_t *above, const uint8_t *left) {
+  const __m128i a = _mm_loadl_epi64((const __m128i *)(above - 1));
+  const __m128i l = _mm_cvtsi32_si128(*(const int *)left);
+  const __m128i col = _mm_shuffle_epi8(filter_left(l, above),
+                                       _mm_load_si128((const __m128i *)
+                                                      reverse_bytes));
+  const __m128i row = filter_above_small(a);
+
+  *(int *)dst = _mm_cvtsi128_si32(_mm_alignr_epi8(row, col, 15));
+  *(int *)(dst + stride) = _mm_cvtsi128_si32(_mm_alignr_epi8(row, col, 14));
+  *(int *)(dst + 2 * stride) =
+      _mm_cvtsi128_si32(_mm_alignr_epi8(row, col, 13));
+  *(int *)(dst + 3 * stride) =
+      _mm_cvtsi128_si32(_mm_alignr_epi8(row, col, 12));
+}
+
+void vp9_d135_predictor_8x8_ssse3(uint8_t *dst, ptrdiff_t stride,
+                                  const uint8_t *above, const uint8_t *left) {
+  const __m128i a = _mm_loadu_si128((const __m128i *)(above - 1));
+  const __m128i l = _mm_loadl_epi64((const __m128i *)left);
+  __m128i col = _mm_shuffle_epi8(filter_left(l, above),
+                                 _mm_load_si128((const __m128i *)
+                                                reverse_bytes));
+  __m128i row = filter_above_small(a);
+  int r;
+
+  for (r = 0; r < 8; ++r) {
+    row = _mm_alignr_epi8(row, col, 15);
+    col = _mm_slli_si128(col, 1);
+    _mm_storel_epi64((__m128i *)dst, row);
+    dst += stride;
+  }
+}
+
+void vp9_d135_predictor_16x16_ssse3(uint8_t *dst, ptrdiff_t stride,
+                                    const uint8_t *above,
+                                    const uint8_t *left) {
+  const __m128i l = _mm_loadu_si128((const __m128i *)left);
+  __m128i col = _mm_shuffle_epi8(filter_left(l, above),
+                                 _mm_load_si128((const __m128i *)
+                                                reverse_bytes));
+  __m128i row = filter_above(above);
+  int r;
+
+  for (r = 0; r < 16; ++r) {
+    row = _mm_alignr_epi8(row, col, 15);
+    col = _mm_slli_si128(col, 1);
+    _mm_storeu_si128((__m128i *)dst, row);
+    dst += stride;
+  }
+}
+
+void vp9_d135_predictor_32x32_ssse3(uint8_t *dst, ptrdiff_t stride,
+                                    const uint8_t *above,
+                                    const uint8_t *left) {
+  const __m128i rev = _mm_load_si128((const __m128i *)reverse_bytes);
+  const __m128i l = _mm_loadu_si128((const __m128i *)left);
+  const __m128i col_hi = _mm_shuffle_epi8(filter_left_hi(left), rev);
+  __m128i col = _mm_shuffle_epi8(filter_left(l, above), rev);
+  __m128i row0 = filter_above(above);
+  __m128i row1 = filter_above(above + 16);
+  int r;
+
+  for (r = 0; r < 32; ++r) {
+    if (r == 16) col = col_hi;
+    row1 = _mm_alignr_epi8(row1, row0, 15);
+    row0 = _mm_alignr_epi8(row0, col, 15);
+    col = _mm_slli_si128(col, 1);
+    _mm_storeu_si128((__m128i *)dst, row0);
+    _mm_storeu_si128((__m128i *)(dst + 16), row1);
+    dst += stride;
+  }
+}
+
+// d117 alternates between two sets of rows: the even rows start from the
+// 2-tap average of the above row and the odd rows from d135's first row. Each
+// set takes every other pixel of the filtered left column.
+
+void vp9_d117_predictor_4x4_ssse3(uint8_t *dst, ptrdiff_t stride,
+                                  const uint8_t *above, const uint8_t *left) {
+  const __m128i a = _mm_loadl_epi64((const __m128i *)(above - 1));
+  const __m128i l = _mm_cvtsi32_si128(*(const int *)left);
+  const __m128i d = filter_left(l, above);
+  __m128i col_even = _mm_shuffle_epi8(
+      d, _mm_load_si128((const __m128i *)reverse_odd_bytes));
+  __m128i col_odd = _mm_shuffle_epi8(
+      d, _mm_load_si128((const __m128i *)reverse_even_bytes));
+  __m128i even = _mm_avg_epu8(a, _mm_srli_si128(a, 1));
+  __m128i odd = filter_above_small(a);
+  int r;
+
+  for (r = 0; r < 4; r += 2) {
+    odd = _mm_alignr_epi8(odd, col_odd, 15);
+    col_odd = _mm_slli_si128(col_odd, 1);
+    *(int *)dst = _mm_cvtsi128_si32(even);
+    *(int *)(dst + stride) = _mm_cvtsi128_si32(odd);
+    even = _mm_alignr_epi8(even, col_even, 15);
+    col_even = _mm_slli_si128(col_even, 1);
+    dst += 2 * stride;
+  }
+}
+
+void vp9_d117_predictor_8x8_ssse3(uint8_t *dst, ptrdiff_t stride,
+                                  const uint8_t *above, const uint8_t *left) {
+  const __m128i a = _mm_loadu_si128((const __m128i *)(above - 1));
+  const __m128i l = _mm_loadl_epi64((const __m128i *)left);
+  const __m128i d = filter_left(l, above);
+  __m128i col_even = _mm_shuffle_epi8(
+      d, _mm_load_si128((const __m128i *)reverse_odd_bytes));
+  __m128i col_odd = _mm_shuffle_epi8(
+      d, _mm_load_si128((const __m128i *)reverse_even_bytes));
+  __m128i even = _mm_avg_epu8(a, _mm_srli_si128(a, 1));
+  __m128i odd = filter_above_small(a);
+  int r;
+
+  for (r = 0; r < 8; r += 2) {
+    odd = _mm_alignr_epi8(odd, col_odd, 15);
+    col_odd = _mm_slli_si128(col_odd, 1);
+    _mm_storel_epi64((__m128i *)dst, even);
+    _mm_storel_epi64((__m128i *)(dst + stride), odd);
+    even = _mm_alignr_epi8(even, col_even, 15);
+    col_even = _mm_slli_si128(col_even, 1);
+    dst += 2 * stride;
+  }
+}
+
+void vp9_d117_predictor_16x16_ssse3(uint8_t *dst, ptrdiff_t stride,
+                                    const uint8_t *above,
+                                    const uint8_t *left) {
+  const __m128i l = _mm_loadu_si128((const __m128i *)left);
+  const __m128i d = filter_left(l, above);
+  __m128i col_even = _mm_shuffle_epi8(
+      d, _mm_load_si128((const __m128i *)reverse_odd_bytes));
+  __m128i col_odd = _mm_shuffle_epi8(
+      d, _mm_load_si128((const __m128i *)reverse_even_bytes));
+  __m128i even = _mm_avg_epu8(_mm_loadu_si128((const __m128i *)(above - 1)),
+                              _mm_loadu_si128((const __m128i *)above));
+  __m128i odd = filter_above(above);
+  int r;
+
+  for (r = 0; r < 16; r += 2) {
+    odd = _mm_alignr_epi8(odd, col_odd, 15);
+    col_odd = _mm_slli_si128(col_odd, 1);
+    _mm_storeu_si128((__m128i *)dst, even);
+    _mm_storeu_si128((__m128i *)(dst + stride), odd);
+    even = _mm_alignr_epi8(even, col_even, 15);
+    col_even = _mm_slli_si128(col_even, 1);
+    dst += 2 * stride;
+  }
+}
+
+void vp9_d117_predictor_32x32_ssse3(uint8_t *dst, ptrdiff_t stride,
+                                    const uint8_t *above,
+                                    const uint8_t *left) {
+  const __m128i l = _mm_loadu_si128((const __m128i *)left);
+  const __m128i d_lo = filter_left(l, above);
+  const __m128i d_hi = filter_left_hi(left);
+  __m128i col_even = gather_col(d_lo, d_hi, _mm_load_si128(
+      (const __m128i *)reverse_odd_bytes));
+  __m128i col_odd = gather_col(d_lo, d_hi, _mm_load_si128(
+      (const __m128i *)reverse_even_bytes));
+  __m128i even0 = _mm_avg_epu8(_mm_loadu_si128((const __m128i *)(above - 1)),
+                               _mm_loadu_si128((const __m128i *)above));
+  __m128i even1 = _mm_avg_epu8(_mm_loadu_si128((const __m128i *)(above + 15)),
+                               _mm_loadu_si128((const __m128i *)(above + 16)));
+  __m128i odd0 = filter_above(above);
+  __m128i odd1 = filter_above(above + 16);
+  int r;
+
+  for (r = 0; r < 32; r += 2) {
+    odd1 = _mm_alignr_epi8(odd1, odd0, 15);
+    odd0 = _mm_alignr_epi8(odd0, col_odd, 15);
+    col_odd = _mm_slli_si128(col_odd, 1);
+    _mm_storeu_si128((__m128i *)dst, even0);
+    _mm_storeu_si128((__m128i *)(dst + 16), even1);
+    _mm_storeu_si128((__m128i *)(dst + stride), odd0);
+    _mm_storeu_si128((__m128i *)(dst + stride + 16), odd1);
+    even1 = _mm_alignr_epi8(even1, even0, 15);
+    even0 = _mm_alignr_epi8(even0, col_even, 15);
+    col_even = _mm_slli_si128(col_even, 1);
+    dst += 2 * stride;
+  }
+}
+
+// d153 shifts in two pixels per row: the 2-tap average of the left column
+// and the filtered left column. The smaller sizes are in
+// vp9_intrapred_ssse3.asm.
+void vp9_d153_predictor_32x32_ssse3(uint8_t *dst, ptrdiff_t stride,
+                                    const uint8_t *above,
+                                    const uint8_t *left) {
+  const __m128i rev = _mm_load_si128((const __m128i *)reverse_bytes);
+  const __m128i l0 = _mm_loadu_si128((const __m128i *)left);
+  const __m128i l1 = _mm_loadu_si128((const __m128i *)(left + 16));
+  const __m128i lm1 = shift_in_byte(l0, above[-1]);
+  const __m128i c0 = _mm_shuffle_epi8(_mm_avg_epu8(lm1, l0), rev);
+  const __m128i c1 = _mm_shuffle_epi8(
+      _mm_avg_epu8(_mm_loadu_si128((const __m128i *)(left + 15)), l1), rev);
+  const __m128i d0 = _mm_shuffle_epi8(filter_left(l0, above), rev);
+  const __m128i d1 = _mm_shuffle_epi8(filter_left_hi(left), rev);
+  const __m128i cols[4] = {
+    _mm_unpackhi_epi8(c0, d0), _mm_unpacklo_epi8(c0, d0),
+    _mm_unpackhi_epi8(c1, d1), _mm_unpacklo_epi8(c1, d1)
+  };
+  __m128i row0 = filter_above(above);
+  __m128i row1 = filter_above(above + 16);
+  int i, r;
+
+  for (i = 0; i < 4; ++i) {
+    __m128i col = cols[i];
+    for (r = 0; r < 8; ++r) {
+      row1 = _mm_alignr_epi8(row1, row0, 14);
+      row0 = _mm_alignr_epi8(row0, col, 14);
+      col = _mm_slli_si128(col, 2);
+      _mm_storeu_si128((__m128i *)dst, row0);
+      _mm_storeu_si128((__m128i *)(dst + 16), row1);
+      dst += stride;
+    }
+  }
+}
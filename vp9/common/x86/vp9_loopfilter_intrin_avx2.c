@@ -984,3 +984,625 @@ void vp9_lpf_horizontal_16_avx2(unsigned char *s, int p,
     else
         mb_lpf_horizontal_edge_w_avx2_16(s, p, _blimit, _limit, _thresh);
 }
+
+// The filters below work on 16 pixels along an edge, i.e. two 8-pixel edges
+// whose thresholds sit in the low and high halves of each vector. The masks
+// and filter4 work on bytes; the flat filters widen each row to 16-bit lanes
+// so that one ymm register holds all 16 pixels.
+
+static INLINE __m128i abs_diff(__m128i a, __m128i b) {
+  return _mm_or_si128(_mm_subs_epu8(a, b), _mm_subs_epu8(b, a));
+}
+
+// 0xff in the lanes where x <= limit.
+static INLINE __m128i le_mask(__m128i x, __m128i limit) {
+  return _mm_cmpeq_epi8(_mm_subs_epu8(x, limit), _mm_setzero_si128());
+}
+
+// Arithmetic shift right by 3 of each signed byte.
+static INLINE __m128i srai_epi8_3(__m128i x) {
+  const __m128i sign = _mm_set1_epi8(0x10);
+  x = _mm_and_si128(_mm_srli_epi16(x, 3), _mm_set1_epi8(0x1f));
+  return _mm_sub_epi8(_mm_xor_si128(x, sign), sign);
+}
+
+static INLINE __m128i narrow_u8(__m256i x) {
+  return _mm_packus_epi16(_mm256_castsi256_si128(x),
+                          _mm256_extracti128_si256(x, 1));
+}
+
+static INLINE __m128i load_thresholds(const uint8_t *t0, const uint8_t *t1) {
+  return _mm_unpacklo_epi64(_mm_set1_epi8((char)*t0), _mm_set1_epi8((char)*t1));
+}
+
+// filter_mask() and hev_mask() of vp9_loopfilter_filters.c.
+static INLINE __m128i filter_mask(__m128i p3, __m128i p2, __m128i p1,
+                                  __m128i p0, __m128i q0, __m128i q1,
+                                  __m128i q2, __m128i q3, __m128i blimit,
+                                  __m128i limit, __m128i thresh,
+                                  __m128i *hev) {
+  const __m128i max_p1q1 = _mm_max_epu8(abs_diff(p1, p0), abs_diff(q1, q0));
+  __m128i mask, work;
+
+  *hev = _mm_xor_si128(le_mask(max_p1q1, thresh), _mm_set1_epi8((char)0xff));
+  work = _mm_max_epu8(_mm_max_epu8(abs_diff(p3, p2), abs_diff(p2, p1)),
+                      _mm_max_epu8(abs_diff(q3, q2), abs_diff(q2, q1)));
+  mask = le_mask(_mm_max_epu8(work, max_p1q1), limit);
+  // abs(p0 - q0) * 2 + abs(p1 - q1) / 2 <= blimit
+  work = _mm_adds_epu8(abs_diff(p0, q0), abs_diff(p0, q0));
+  work = _mm_adds_epu8(work, _mm_srli_epi16(
+      _mm_and_si128(abs_diff(p1, q1), _mm_set1_epi8((char)0xfe)), 1));
+  return _mm_and_si128(mask, le_mask(work, blimit));
+}
+
+// 0xff in the lanes where the pixels on each side differ by at most 1 from
+// p0 and q0 respectively, as in flat_mask4().
+static INLINE __m128i flat_mask(__m128i p3, __m128i p2, __m128i p1,
+                                __m128i p0, __m128i q0, __m128i q1,
+                                __m128i q2, __m128i q3) {
+  __m128i work = _mm_max_epu8(abs_diff(p1, p0), abs_diff(q1, q0));
+  work = _mm_max_epu8(work, _mm_max_epu8(abs_diff(p2, p0), abs_diff(q2, q0)));
+  work = _mm_max_epu8(work, _mm_max_epu8(abs_diff(p3, p0), abs_diff(q3, q0)));
+  return le_mask(work, _mm_set1_epi8(1));
+}
+
+// filter4(), with saturating byte arithmetic standing in for
+// signed_char_clamp().
+static INLINE void filter4(__m128i mask, __m128i hev, __m128i *p1,
+                           __m128i *p0, __m128i *q0, __m128i *q1) {
+  const __m128i t80 = _mm_set1_epi8((char)0x80);
+  const __m128i ps1 = _mm_xor_si128(*p1, t80);
+  const __m128i ps0 = _mm_xor_si128(*p0, t80);
+  const __m128i qs0 = _mm_xor_si128(*q0, t80);
+  const __m128i qs1 = _mm_xor_si128(*q1, t80);
+  const __m128i step = _mm_subs_epi8(qs0, ps0);
+  __m128i filter, filter1, filter2;
+
+  filter = _mm_and_si128(_mm_subs_epi8(ps1, qs1), hev);
+  filter = _mm_adds_epi8(filter, step);
+  filter = _mm_adds_epi8(filter, step);
+  filter = _mm_adds_epi8(filter, step);
+  filter = _mm_and_si128(filter, mask);
+
+  filter1 = srai_epi8_3(_mm_adds_epi8(filter, _mm_set1_epi8(4)));
+  filter2 = srai_epi8_3(_mm_adds_epi8(filter, _mm_set1_epi8(3)));
+  *q0 = _mm_xor_si128(_mm_subs_epi8(qs0, filter1), t80);
+  *p0 = _mm_xor_si128(_mm_adds_epi8(ps0, filter2), t80);
+
+  // ROUND_POWER_OF_TWO(filter1, 1), through the unsigned average.
+  filter = _mm_xor_si128(_mm_avg_epu8(_mm_xor_si128(filter1, t80), t80), t80);
+  filter = _mm_andnot_si128(hev, filter);
+  *q1 = _mm_xor_si128(_mm_subs_epi8(qs1, filter), t80);
+  *p1 = _mm_xor_si128(_mm_adds_epi8(ps1, filter), t80);
+}
+
+// Each output of the flat filters is the sum of a window of pixels around it
+// plus the pixel itself, rounded. The window slides by removing one pixel and
+// adding one at each step.
+static INLINE __m256i slide(__m256i sum, __m256i out, __m256i in) {
+  return _mm256_add_epi16(_mm256_sub_epi16(sum, out), in);
+}
+
+static INLINE __m128i flat_blend(__m128i pixel, __m256i sum, __m256i centre,
+                                 __m128i flat, int bits) {
+  const __m256i total = _mm256_add_epi16(sum, centre);
+  const __m128i filtered = narrow_u8(bits == 3 ? _mm256_srli_epi16(total, 3)
+                                               : _mm256_srli_epi16(total, 4));
+  return _mm_blendv_epi8(pixel, filtered, flat);
+}
+
+// The 7-tap filter of filter8() on the lanes set in flat, reading the
+// unfiltered pixels in x[0] (p3) to x[7] (q3).
+static INLINE void flat_filter8(const __m128i *x, __m128i flat, __m128i *op2,
+                                __m128i *op1, __m128i *op0, __m128i *oq0,
+                                __m128i *oq1, __m128i *oq2) {
+  const __m256i p3 = _mm256_cvtepu8_epi16(x[0]);
+  const __m256i p2 = _mm256_cvtepu8_epi16(x[1]);
+  const __m256i p1 = _mm256_cvtepu8_epi16(x[2]);
+  const __m256i p0 = _mm256_cvtepu8_epi16(x[3]);
+  const __m256i q0 = _mm256_cvtepu8_epi16(x[4]);
+  const __m256i q1 = _mm256_cvtepu8_epi16(x[5]);
+  const __m256i q2 = _mm256_cvtepu8_epi16(x[6]);
+  const __m256i q3 = _mm256_cvtepu8_epi16(x[7]);
+  __m256i sum;
+
+  sum = _mm256_add_epi16(_mm256_set1_epi16(4), _mm256_add_epi16(p3, p3));
+  sum = _mm256_add_epi16(sum, _mm256_add_epi16(p3, p2));
+  sum = _mm256_add_epi16(sum, _mm256_add_epi16(p1, p0));
+  sum = _mm256_add_epi16(sum, q0);
+  *op2 = flat_blend(*op2, sum, p2, flat, 3);
+  sum = slide(sum, p3, q1);
+  *op1 = flat_blend(*op1, sum, p1, flat, 3);
+  sum = slide(sum, p3, q2);
+  *op0 = flat_blend(*op0, sum, p0, flat, 3);
+  sum = slide(sum, p3, q3);
+  *oq0 = flat_blend(*oq0, sum, q0, flat, 3);
+  sum = slide(sum, p2, q3);
+  *oq1 = flat_blend(*oq1, sum, q1, flat, 3);
+  sum = slide(sum, p1, q3);
+  *oq2 = flat_blend(*oq2, sum, q2, flat, 3);
+}
+
+// The 15-tap filter of filter16() on the lanes set in flat2, reading the
+// unfiltered pixels in x[0] (p7) to x[15] (q7) and updating y[1] to y[14].
+static INLINE void flat_filter16(const __m128i *x, __m128i flat2,
+                                 __m128i *y) {
+  const __m256i p7 = _mm256_cvtepu8_epi16(x[0]);
+  const __m256i p6 = _mm256_cvtepu8_epi16(x[1]);
+  const __m256i p5 = _mm256_cvtepu8_epi16(x[2]);
+  const __m256i p4 = _mm256_cvtepu8_epi16(x[3]);
+  const __m256i p3 = _mm256_cvtepu8_epi16(x[4]);
+  const __m256i p2 = _mm256_cvtepu8_epi16(x[5]);
+  const __m256i p1 = _mm256_cvtepu8_epi16(x[6]);
+  const __m256i p0 = _mm256_cvtepu8_epi16(x[7]);
+  const __m256i q0 = _mm256_cvtepu8_epi16(x[8]);
+  const __m256i q1 = _mm256_cvtepu8_epi16(x[9]);
+  const __m256i q2 = _mm256_cvtepu8_epi16(x[10]);
+  const __m256i q3 = _mm256_cvtepu8_epi16(x[11]);
+  const __m256i q4 = _mm256_cvtepu8_epi16(x[12]);
+  const __m256i q5 = _mm256_cvtepu8_epi16(x[13]);
+  const __m256i q6 = _mm256_cvtepu8_epi16(x[14]);
+  const __m256i q7 = _mm256_cvtepu8_epi16(x[15]);
+  __m256i sum;
+
+  sum = _mm256_sub_epi16(_mm256_slli_epi16(p7, 3), p7);
+  sum = _mm256_add_epi16(sum, _mm256_set1_epi16(8));
+  sum = _mm256_add_epi16(sum, _mm256_add_epi16(p6, p5));
+  sum = _mm256_add_epi16(sum, _mm256_add_epi16(p4, p3));
+  sum = _mm256_add_epi16(sum, _mm256_add_epi16(p2, p1));
+  sum = _mm256_add_epi16(sum, _mm256_add_epi16(p0, q0));
+  y[1] = flat_blend(y[1], sum, p6, flat2, 4);
+  sum = slide(sum, p7, q1);
+  y[2] = flat_blend(y[2], sum, p5, flat2, 4);
+  sum = slide(sum, p7, q2);
+  y[3] = flat_blend(y[3], sum, p4, flat2, 4);
+  sum = slide(sum, p7, q3);
+  y[4] = flat_blend(y[4], sum, p3, flat2, 4);
+  sum = slide(sum, p7, q4);
+  y[5] = flat_blend(y[5], sum, p2, flat2, 4);
+  sum = slide(sum, p7, q5);
+  y[6] = flat_blend(y[6], sum, p1, flat2, 4);
+  sum = slide(sum, p7, q6);
+  y[7] = flat_blend(y[7], sum, p0, flat2, 4);
+  sum = slide(sum, p7, q7);
+  y[8] = flat_blend(y[8], sum, q0, flat2, 4);
+  sum = slide(sum, p6, q7);
+  y[9] = flat_blend(y[9], sum, q1, flat2, 4);
+  sum = slide(sum, p5, q7);
+  y[10] = flat_blend(y[10], sum, q2, flat2, 4);
+  sum = slide(sum, p4, q7);
+  y[11] = flat_blend(y[11], sum, q3, flat2, 4);
+  sum = slide(sum, p3, q7);
+  y[12] = flat_blend(y[12], sum, q4, flat2, 4);
+  sum = slide(sum, p2, q7);
+  y[13] = flat_blend(y[13], sum, q5, flat2, 4);
+  sum = slide(sum, p1, q7);
+  y[14] = flat_blend(y[14], sum, q6, flat2, 4);
+}
+
+// Filter the edge between x[3] and x[4] with filter4() or filter8(). Returns 0
+// if no pixel needs filtering.
+static INLINE int filter_edge8(__m128i *x, int flat_taps, __m128i blimit,
+                                __m128i limit, __m128i thresh) {
+  __m128i mask, hev, flat;
+  __m128i p2, p1, p0, q0, q1, q2;
+
+  mask = filter_mask(x[0], x[1], x[2], x[3], x[4], x[5], x[6], x[7],
+                     blimit, limit, thresh, &hev);
+  if (!_mm_movemask_epi8(mask))
+    return 0;
+
+  p2 = x[1];
+  p1 = x[2];
+  p0 = x[3];
+  q0 = x[4];
+  q1 = x[5];
+  q2 = x[6];
+  filter4(mask, hev, &p1, &p0, &q0, &q1);
+  if (flat_taps) {
+    flat = _mm_and_si128(flat_mask(x[0], x[1], x[2], x[3], x[4], x[5], x[6],
+                                   x[7]), mask);
+    if (_mm_movemask_epi8(flat))
+      flat_filter8(x, flat, &p2, &p1, &p0, &q0, &q1, &q2);
+    x[1] = p2;
+    x[6] = q2;
+  }
+  x[2] = p1;
+  x[3] = p0;
+  x[4] = q0;
+  x[5] = q1;
+  return 1;
+}
+
+// Filter the edge between x[7] and x[8] with filter16(), leaving the result
+// in x[1] to x[14] of y. Returns 0 if no pixel needs filtering.
+static INLINE int filter_edge16(const __m128i *x, __m128i *y, __m128i blimit,
+                                __m128i limit, __m128i thresh) {
+  __m128i mask, hev, flat, flat2;
+
+  mask = filter_mask(x[4], x[5], x[6], x[7], x[8], x[9], x[10], x[11],
+                     blimit, limit, thresh, &hev);
+  if (!_mm_movemask_epi8(mask))
+    return 0;
+
+  y[0] = x[0];
+  y[1] = x[1];
+  y[2] = x[2];
+  y[3] = x[3];
+  y[4] = x[4];
+  y[5] = x[5];
+  y[6] = x[6];
+  y[7] = x[7];
+  y[8] = x[8];
+  y[9] = x[9];
+  y[10] = x[10];
+  y[11] = x[11];
+  y[12] = x[12];
+  y[13] = x[13];
+  y[14] = x[14];
+  y[15] = x[15];
+  filter4(mask, hev, &y[6], &y[7], &y[8], &y[9]);
+  flat = _mm_and_si128(flat_mask(x[4], x[5], x[6], x[7], x[8], x[9], x[10],
+                                 x[11]), mask);
+  if (_mm_movemask_epi8(flat)) {
+    flat_filter8(x + 4, flat, &y[5], &y[6], &y[7], &y[8], &y[9], &y[10]);
+    flat2 = flat_mask(x[1], x[2], x[3], x[7], x[8], x[12], x[13], x[14]);
+    flat2 = _mm_and_si128(flat2, le_mask(_mm_max_epu8(abs_diff(x[0], x[7]),
+                                                      abs_diff(x[15], x[8])),
+                                         _mm_set1_epi8(1)));
+    flat2 = _mm_and_si128(flat2, flat);
+    if (_mm_movemask_epi8(flat2))
+      flat_filter16(x, flat2, y);
+  }
+  return 1;
+}
+
+// Finish the transpose of 16 rows into 8 columns of 16 pixels, a[i] holding
+// rows 2i and 2i + 1 interleaved: 16-bit lane j holds column j of both.
+static INLINE void transpose_paired_rows(const __m128i *a, __m128i *out) {
+  // b0, b1: 32-bit lane j holds column j, resp. j + 4, of rows 0 to 3.
+  const __m128i b0 = _mm_unpacklo_epi16(a[0], a[1]);
+  const __m128i b1 = _mm_unpackhi_epi16(a[0], a[1]);
+  const __m128i b2 = _mm_unpacklo_epi16(a[2], a[3]);
+  const __m128i b3 = _mm_unpackhi_epi16(a[2], a[3]);
+  const __m128i b4 = _mm_unpacklo_epi16(a[4], a[5]);
+  const __m128i b5 = _mm_unpackhi_epi16(a[4], a[5]);
+  const __m128i b6 = _mm_unpacklo_epi16(a[6], a[7]);
+  const __m128i b7 = _mm_unpackhi_epi16(a[6], a[7]);
+  // c0: 64-bit lane k holds column k of rows 0 to 7.
+  const __m128i c0 = _mm_unpacklo_epi32(b0, b2);
+  const __m128i c1 = _mm_unpackhi_epi32(b0, b2);
+  const __m128i c2 = _mm_unpacklo_epi32(b1, b3);
+  const __m128i c3 = _mm_unpackhi_epi32(b1, b3);
+  const __m128i c4 = _mm_unpacklo_epi32(b4, b6);
+  const __m128i c5 = _mm_unpackhi_epi32(b4, b6);
+  const __m128i c6 = _mm_unpacklo_epi32(b5, b7);
+  const __m128i c7 = _mm_unpackhi_epi32(b5, b7);
+  out[0] = _mm_unpacklo_epi64(c0, c4);
+  out[1] = _mm_unpackhi_epi64(c0, c4);
+  out[2] = _mm_unpacklo_epi64(c1, c5);
+  out[3] = _mm_unpackhi_epi64(c1, c5);
+  out[4] = _mm_unpacklo_epi64(c2, c6);
+  out[5] = _mm_unpackhi_epi64(c2, c6);
+  out[6] = _mm_unpacklo_epi64(c3, c7);
+  out[7] = _mm_unpackhi_epi64(c3, c7);
+}
+
+// Transpose 16 rows of 8 bytes, held in the low halves of in[], into the 8
+// columns out[].
+static INLINE void transpose_16x8(const __m128i *in, __m128i *out) {
+  __m128i a[8];
+  a[0] = _mm_unpacklo_epi8(in[0], in[1]);
+  a[1] = _mm_unpacklo_epi8(in[2], in[3]);
+  a[2] = _mm_unpacklo_epi8(in[4], in[5]);
+  a[3] = _mm_unpacklo_epi8(in[6], in[7]);
+  a[4] = _mm_unpacklo_epi8(in[8], in[9]);
+  a[5] = _mm_unpacklo_epi8(in[10], in[11]);
+  a[6] = _mm_unpacklo_epi8(in[12], in[13]);
+  a[7] = _mm_unpacklo_epi8(in[14], in[15]);
+  transpose_paired_rows(a, out);
+}
+
+// The inverse of transpose_16x8(): out[i] receives rows 2i and 2i + 1.
+static INLINE void transpose_8x16(const __m128i *in, __m128i *out) {
+  // a0, a1: 16-bit lane j holds columns 0 and 1 of row j, resp. j + 8.
+  const __m128i a0 = _mm_unpacklo_epi8(in[0], in[1]);
+  const __m128i a1 = _mm_unpackhi_epi8(in[0], in[1]);
+  const __m128i a2 = _mm_unpacklo_epi8(in[2], in[3]);
+  const __m128i a3 = _mm_unpackhi_epi8(in[2], in[3]);
+  const __m128i a4 = _mm_unpacklo_epi8(in[4], in[5]);
+  const __m128i a5 = _mm_unpackhi_epi8(in[4], in[5]);
+  const __m128i a6 = _mm_unpacklo_epi8(in[6], in[7]);
+  const __m128i a7 = _mm_unpackhi_epi8(in[6], in[7]);
+  // b0: 32-bit lane k holds columns 0 to 3 of row k; b2 columns 4 to 7.
+  const __m128i b0 = _mm_unpacklo_epi16(a0, a2);
+  const __m128i b1 = _mm_unpackhi_epi16(a0, a2);
+  const __m128i b2 = _mm_unpacklo_epi16(a4, a6);
+  const __m128i b3 = _mm_unpackhi_epi16(a4, a6);
+  const __m128i b4 = _mm_unpacklo_epi16(a1, a3);
+  const __m128i b5 = _mm_unpackhi_epi16(a1, a3);
+  const __m128i b6 = _mm_unpacklo_epi16(a5, a7);
+  const __m128i b7 = _mm_unpackhi_epi16(a5, a7);
+  out[0] = _mm_unpacklo_epi32(b0, b2);
+  out[1] = _mm_unpackhi_epi32(b0, b2);
+  out[2] = _mm_unpacklo_epi32(b1, b3);
+  out[3] = _mm_unpackhi_epi32(b1, b3);
+  out[4] = _mm_unpacklo_epi32(b4, b6);
+  out[5] = _mm_unpackhi_epi32(b4, b6);
+  out[6] = _mm_unpacklo_epi32(b5, b7);
+  out[7] = _mm_unpackhi_epi32(b5, b7);
+}
+
+// Transpose the 16x16 block of bytes in[] into out[].
+static INLINE void transpose_16x16(const __m128i *in, __m128i *out) {
+  __m128i a[8], b[8];
+  a[0] = _mm_unpacklo_epi8(in[0], in[1]);
+  a[1] = _mm_unpacklo_epi8(in[2], in[3]);
+  a[2] = _mm_unpacklo_epi8(in[4], in[5]);
+  a[3] = _mm_unpacklo_epi8(in[6], in[7]);
+  a[4] = _mm_unpacklo_epi8(in[8], in[9]);
+  a[5] = _mm_unpacklo_epi8(in[10], in[11]);
+  a[6] = _mm_unpacklo_epi8(in[12], in[13]);
+  a[7] = _mm_unpacklo_epi8(in[14], in[15]);
+  b[0] = _mm_unpackhi_epi8(in[0], in[1]);
+  b[1] = _mm_unpackhi_epi8(in[2], in[3]);
+  b[2] = _mm_unpackhi_epi8(in[4], in[5]);
+  b[3] = _mm_unpackhi_epi8(in[6], in[7]);
+  b[4] = _mm_unpackhi_epi8(in[8], in[9]);
+  b[5] = _mm_unpackhi_epi8(in[10], in[11]);
+  b[6] = _mm_unpackhi_epi8(in[12], in[13]);
+  b[7] = _mm_unpackhi_epi8(in[14], in[15]);
+  transpose_paired_rows(a, out);
+  transpose_paired_rows(b, out + 8);
+}
+
+// Load rows 0 to 7 of a vertical edge from s0 and rows 8 to 15 from s1, as
+// 8 columns of 16 pixels.
+static INLINE void load_columns_8(const uint8_t *s0, const uint8_t *s1, int p,
+                                  __m128i *x) {
+  __m128i t[16];
+  t[0] = _mm_loadl_epi64((const __m128i *)(s0 + 0 * p));
+  t[1] = _mm_loadl_epi64((const __m128i *)(s0 + 1 * p));
+  t[2] = _mm_loadl_epi64((const __m128i *)(s0 + 2 * p));
+  t[3] = _mm_loadl_epi64((const __m128i *)(s0 + 3 * p));
+  t[4] = _mm_loadl_epi64((const __m128i *)(s0 + 4 * p));
+  t[5] = _mm_loadl_epi64((const __m128i *)(s0 + 5 * p));
+  t[6] = _mm_loadl_epi64((const __m128i *)(s0 + 6 * p));
+  t[7] = _mm_loadl_epi64((const __m128i *)(s0 + 7 * p));
+  t[8] = _mm_loadl_epi64((const __m128i *)(s1 + 0 * p));
+  t[9] = _mm_loadl_epi64((const __m128i *)(s1 + 1 * p));
+  t[10] = _mm_loadl_epi64((const __m128i *)(s1 + 2 * p));
+  t[11] = _mm_loadl_epi64((const __m128i *)(s1 + 3 * p));
+  t[12] = _mm_loadl_epi64((const __m128i *)(s1 + 4 * p));
+  t[13] = _mm_loadl_epi64((const __m128i *)(s1 + 5 * p));
+  t[14] = _mm_loadl_epi64((const __m128i *)(s1 + 6 * p));
+  t[15] = _mm_loadl_epi64((const __m128i *)(s1 + 7 * p));
+  transpose_16x8(t, x);
+}
+
+// Store 8 rows from 4 registers of two rows each.
+static INLINE void store_rows_8x8(uint8_t *s, int p, const __m128i *t) {
+  _mm_storel_epi64((__m128i *)(s + 0 * p), t[0]);
+  _mm_storeh_pd((double *)(s + 1 * p), _mm_castsi128_pd(t[0]));
+  _mm_storel_epi64((__m128i *)(s + 2 * p), t[1]);
+  _mm_storeh_pd((double *)(s + 3 * p), _mm_castsi128_pd(t[1]));
+  _mm_storel_epi64((__m128i *)(s + 4 * p), t[2]);
+  _mm_storeh_pd((double *)(s + 5 * p), _mm_castsi128_pd(t[2]));
+  _mm_storel_epi64((__m128i *)(s + 6 * p), t[3]);
+  _mm_storeh_pd((double *)(s + 7 * p), _mm_castsi128_pd(t[3]));
+}
+
+// Filter an edge of 8 or 16 pixels with filter4() or filter8().
+static void lpf_8x(uint8_t *s, int p, int vertical, int flat_taps, int size,
+                   __m128i blimit, __m128i limit, __m128i thresh) {
+  __m128i x[8];
+
+  if (vertical) {
+    // A single 8-row edge is loaded twice rather than reading past it.
+    load_columns_8(s - 4, s - 4 + (size == 16 ? 8 * p : 0), p, x);
+  } else if (size == 16) {
+    x[0] = _mm_loadu_si128((const __m128i *)(s - 4 * p));
+    x[1] = _mm_loadu_si128((const __m128i *)(s - 3 * p));
+    x[2] = _mm_loadu_si128((const __m128i *)(s - 2 * p));
+    x[3] = _mm_loadu_si128((const __m128i *)(s - 1 * p));
+    x[4] = _mm_loadu_si128((const __m128i *)(s + 0 * p));
+    x[5] = _mm_loadu_si128((const __m128i *)(s + 1 * p));
+    x[6] = _mm_loadu_si128((const __m128i *)(s + 2 * p));
+    x[7] = _mm_loadu_si128((const __m128i *)(s + 3 * p));
+  } else {
+    x[0] = _mm_loadl_epi64((const __m128i *)(s - 4 * p));
+    x[1] = _mm_loadl_epi64((const __m128i *)(s - 3 * p));
+    x[2] = _mm_loadl_epi64((const __m128i *)(s - 2 * p));
+    x[3] = _mm_loadl_epi64((const __m128i *)(s - 1 * p));
+    x[4] = _mm_loadl_epi64((const __m128i *)(s + 0 * p));
+    x[5] = _mm_loadl_epi64((const __m128i *)(s + 1 * p));
+    x[6] = _mm_loadl_epi64((const __m128i *)(s + 2 * p));
+    x[7] = _mm_loadl_epi64((const __m128i *)(s + 3 * p));
+  }
+
+  if (!filter_edge8(x, flat_taps, blimit, limit, thresh))
+    return;
+
+  if (vertical) {
+    __m128i t[8];
+    transpose_8x16(x, t);
+    store_rows_8x8(s - 4, p, t);
+    if (size == 16)
+      store_rows_8x8(s - 4 + 8 * p, p, t + 4);
+  } else if (size == 16) {
+    _mm_storeu_si128((__m128i *)(s - 3 * p), x[1]);
+    _mm_storeu_si128((__m128i *)(s - 2 * p), x[2]);
+    _mm_storeu_si128((__m128i *)(s - 1 * p), x[3]);
+    _mm_storeu_si128((__m128i *)(s + 0 * p), x[4]);
+    _mm_storeu_si128((__m128i *)(s + 1 * p), x[5]);
+    _mm_storeu_si128((__m128i *)(s + 2 * p), x[6]);
+  } else {
+    _mm_storel_epi64((__m128i *)(s - 3 * p), x[1]);
+    _mm_storel_epi64((__m128i *)(s - 2 * p), x[2]);
+    _mm_storel_epi64((__m128i *)(s - 1 * p), x[3]);
+    _mm_storel_epi64((__m128i *)(s + 0 * p), x[4]);
+    _mm_storel_epi64((__m128i *)(s + 1 * p), x[5]);
+    _mm_storel_epi64((__m128i *)(s + 2 * p), x[6]);
+  }
+}
+
+void vp9_lpf_horizontal_8_avx2(unsigned char *s, int p,
+                               const unsigned char *blimit,
+                               const unsigned char *limit,
+                               const unsigned char *thresh, int count) {
+  const __m128i b = load_thresholds(blimit, blimit);
+  const __m128i l = load_thresholds(limit, limit);
+  const __m128i t = load_thresholds(thresh, thresh);
+  for (; count > 1; count -= 2, s += 16)
+    lpf_8x(s, p, 0, 1, 16, b, l, t);
+  if (count)
+    lpf_8x(s, p, 0, 1, 8, b, l, t);
+}
+
+void vp9_lpf_horizontal_8_dual_avx2(uint8_t *s, int p,
+                                    const uint8_t *blimit0,
+                                    const uint8_t *limit0,
+                                    const uint8_t *thresh0,
+                                    const uint8_t *blimit1,
+                                    const uint8_t *limit1,
+                                    const uint8_t *thresh1) {
+  lpf_8x(s, p, 0, 1, 16, load_thresholds(blimit0, blimit1),
+         load_thresholds(limit0, limit1), load_thresholds(thresh0, thresh1));
+}
+
+void vp9_lpf_horizontal_4_avx2(unsigned char *s, int p,
+                               const unsigned char *blimit,
+                               const unsigned char *limit,
+                               const unsigned char *thresh, int count) {
+  const __m128i b = load_thresholds(blimit, blimit);
+  const __m128i l = load_thresholds(limit, limit);
+  const __m128i t = load_thresholds(thresh, thresh);
+  for (; count > 1; count -= 2, s += 16)
+    lpf_8x(s, p, 0, 0, 16, b, l, t);
+  if (count)
+    lpf_8x(s, p, 0, 0, 8, b, l, t);
+}
+
+void vp9_lpf_horizontal_4_dual_avx2(uint8_t *s, int p,
+                                    const uint8_t *blimit0,
+                                    const uint8_t *limit0,
+                                    const uint8_t *thresh0,
+                                    const uint8_t *blimit1,
+                                    const uint8_t *limit1,
+                                    const uint8_t *thresh1) {
+  lpf_8x(s, p, 0, 0, 16, load_thresholds(blimit0, blimit1),
+         load_thresholds(limit0, limit1), load_thresholds(thresh0, thresh1));
+}
+
+void vp9_lpf_vertical_8_avx2(unsigned char *s, int p,
+                             const unsigned char *blimit,
+                             const unsigned char *limit,
+                             const unsigned char *thresh, int count) {
+  const __m128i b = load_thresholds(blimit, blimit);
+  const __m128i l = load_thresholds(limit, limit);
+  const __m128i t = load_thresholds(thresh, thresh);
+  for (; count > 1; count -= 2, s += 16 * p)
+    lpf_8x(s, p, 1, 1, 16, b, l, t);
+  if (count)
+    lpf_8x(s, p, 1, 1, 8, b, l, t);
+}
+
+void vp9_lpf_vertical_8_dual_avx2(uint8_t *s, int p,
+                                  const uint8_t *blimit0,
+                                  const uint8_t *limit0,
+                                  const uint8_t *thresh0,
+                                  const uint8_t *blimit1,
+                                  const uint8_t *limit1,
+                                  const uint8_t *thresh1) {
+  lpf_8x(s, p, 1, 1, 16, load_thresholds(blimit0, blimit1),
+         load_thresholds(limit0, limit1), load_thresholds(thresh0, thresh1));
+}
+
+void vp9_lpf_vertical_4_avx2(unsigned char *s, int p,
+                             const unsigned char *blimit,
+                             const unsigned char *limit,
+                             const unsigned char *thresh, int count) {
+  const __m128i b = load_thresholds(blimit, blimit);
+  const __m128i l = load_thresholds(limit, limit);
+  const __m128i t = load_thresholds(thresh, thresh);
+  for (; count > 1; count -= 2, s += 16 * p)
+    lpf_8x(s, p, 1, 0, 16, b, l, t);
+  if (count)
+    lpf_8x(s, p, 1, 0, 8, b, l, t);
+}
+
+void vp9_lpf_vertical_4_dual_avx2(uint8_t *s, int p,
+                                  const uint8_t *blimit0,
+                                  const uint8_t *limit0,
+                                  const uint8_t *thresh0,
+                                  const uint8_t *blimit1,
+                                  const uint8_t *limit1,
+                                  const uint8_t *thresh1) {
+  lpf_8x(s, p, 1, 0, 16, load_thresholds(blimit0, blimit1),
+         load_thresholds(limit0, limit1), load_thresholds(thresh0, thresh1));
+}
+
+// Filter a vertical edge of 8 or 16 rows with filter16(). A single 8-row edge
+// is loaded twice rather than reading past it.
+static void lpf_vertical_16x(uint8_t *s, int p, int rows,
+                             const uint8_t *blimit, const uint8_t *limit,
+                             const uint8_t *thresh) {
+  uint8_t *const s0 = s - 8;
+  uint8_t *const s1 = s0 + (rows == 16 ? 8 * p : 0);
+  __m128i t[16], x[16], y[16];
+
+  t[0] = _mm_loadu_si128((const __m128i *)(s0 + 0 * p));
+  t[1] = _mm_loadu_si128((const __m128i *)(s0 + 1 * p));
+  t[2] = _mm_loadu_si128((const __m128i *)(s0 + 2 * p));
+  t[3] = _mm_loadu_si128((const __m128i *)(s0 + 3 * p));
+  t[4] = _mm_loadu_si128((const __m128i *)(s0 + 4 * p));
+  t[5] = _mm_loadu_si128((const __m128i *)(s0 + 5 * p));
+  t[6] = _mm_loadu_si128((const __m128i *)(s0 + 6 * p));
+  t[7] = _mm_loadu_si128((const __m128i *)(s0 + 7 * p));
+  t[8] = _mm_loadu_si128((const __m128i *)(s1 + 0 * p));
+  t[9] = _mm_loadu_si128((const __m128i *)(s1 + 1 * p));
+  t[10] = _mm_loadu_si128((const __m128i *)(s1 + 2 * p));
+  t[11] = _mm_loadu_si128((const __m128i *)(s1 + 3 * p));
+  t[12] = _mm_loadu_si128((const __m128i *)(s1 + 4 * p));
+  t[13] = _mm_loadu_si128((const __m128i *)(s1 + 5 * p));
+  t[14] = _mm_loadu_si128((const __m128i *)(s1 + 6 * p));
+  t[15] = _mm_loadu_si128((const __m128i *)(s1 + 7 * p));
+  transpose_16x16(t, x);
+  if (!filter_edge16(x, y, load_thresholds(blimit, blimit),
+                     load_thresholds(limit, limit),
+                     load_thresholds(thresh, thresh)))
+    return;
+  transpose_16x16(y, t);
+  _mm_storeu_si128((__m128i *)(s0 + 0 * p), t[0]);
+  _mm_storeu_si128((__m128i *)(s0 + 1 * p), t[1]);
+  _mm_storeu_si128((__m128i *)(s0 + 2 * p), t[2]);
+  _mm_storeu_si128((__m128i *)(s0 + 3 * p), t[3]);
+  _mm_storeu_si128((__m128i *)(s0 + 4 * p), t[4]);
+  _mm_storeu_si128((__m128i *)(s0 + 5 * p), t[5]);
+  _mm_storeu_si128((__m128i *)(s0 + 6 * p), t[6]);
+  _mm_storeu_si128((__m128i *)(s0 + 7 * p), t[7]);
+  if (rows == 16) {
+    _mm_storeu_si128((__m128i *)(s1 + 0 * p), t[8]);
+    _mm_storeu_si128((__m128i *)(s1 + 1 * p), t[9]);
+    _mm_storeu_si128((__m128i *)(s1 + 2 * p), t[10]);
+    _mm_storeu_si128((__m128i *)(s1 + 3 * p), t[11]);
+    _mm_storeu_si128((__m128i *)(s1 + 4 * p), t[12]);
+    _mm_storeu_si128((__m128i *)(s1 + 5 * p), t[13]);
+    _mm_storeu_si128((__m128i *)(s1 + 6 * p), t[14]);
+    _mm_storeu_si128((__m128i *)(s1 + 7 * p), t[15]);
+  }
+}
+
+void vp9_lpf_vertical_16_avx2(unsigned char *s, int p,
+                              const unsigned char *blimit,
+                              const unsigned char *limit,
+                              const unsigned char *thresh) {
+  lpf_vertical_16x(s, p, 8, blimit, limit, thresh);
+}
+
+void vp9_lpf_vertical_16_dual_avx2(unsigned char *s, int p,
+                                   const uint8_t *blimit,
+                                   const uint8_t *limit,
+                                   const uint8_t *thresh) {
+  lpf_vertical_16x(s, p, 16, blimit, limit, thresh);
+}
@@ -858,12 +858,6 @@ static void setup_tile_info(VP9_COMMON *cm, struct vp9_read_bit_buffer *rb) {
     cm->log2_tile_rows += vp9_rb_read_bit(rb);
 }
 
-typedef struct TileBuffer {
-  const uint8_t *data;
-  size_t size;
-  int col;  // only used with multi-threaded decoding
-} TileBuffer;
-
 // Reads the next tile returning its size and adjusting '*data' accordingly
 // based on 'is_last'.
 static void get_tile_buffer(const uint8_t *const data_end,
@@ -1057,10 +1051,69 @@ static const uint8_t *decode_tiles(VP9Decoder *pbi,
   return vp9_reader_find_end(&tile_data->bit_reader);
 }
 
-static int tile_worker_hook(TileWorkerData *const tile_data,
-                            const TileInfo *const tile) {
+static void queue_job(DecJobQueue *const queue, const DecJob *const job) {
+  assert(queue->num_jobs < queue->allocated_jobs);
+  queue->jobs[queue->num_jobs++] = *job;
+}
+
+// Called when a tile column has decoded the superblock row at mi_row. Once all
+// tile columns are done with it, the row above is no longer needed unfiltered
+// for intra prediction and is queued for loopfiltering. Tile columns decode
+// their rows in order, so rows complete, and are queued, in order.
+static void sb_row_decoded(VP9Decoder *const pbi, int mi_row) {
+  VP9_COMMON *const cm = &pbi->common;
+  DecJobQueue *const queue = &pbi->job_queue;
+  const int tile_cols = 1 << cm->log2_tile_cols;
+  const int sb_row = mi_row >> MI_BLOCK_SIZE_LOG2;
+  DecJob job;
+
+  job.type = DEC_JOB_LPF_ROW;
+#if CONFIG_MULTITHREAD
+  pthread_mutex_lock(queue->mutex_);
+#endif
+  if (++queue->sb_row_tiles_done[sb_row] == tile_cols && !queue->aborted) {
+    if (sb_row > 0) {
+      job.mi_row = mi_row - MI_BLOCK_SIZE;
+      queue_job(queue, &job);
+    }
+    if (mi_row + MI_BLOCK_SIZE >= cm->mi_rows) {
+      job.mi_row = mi_row;
+      queue_job(queue, &job);
+    }
+#if CONFIG_MULTITHREAD
+    pthread_cond_broadcast(queue->cond_);
+#endif
+  }
+#if CONFIG_MULTITHREAD
+  pthread_mutex_unlock(queue->mutex_);
+#endif
+}
+
+// Stop waiting for jobs that will never be queued after a tile failed.
+static void abort_jobs(DecJobQueue *const queue) {
+#if CONFIG_MULTITHREAD
+  pthread_mutex_lock(queue->mutex_);
+#endif
+  queue->aborted = 1;
+#if CONFIG_MULTITHREAD
+  pthread_cond_broadcast(queue->cond_);
+  pthread_mutex_unlock(queue->mutex_);
+#endif
+}
+
+// Decode one tile column. Errors are reported through the worker's own error
+// info so that a corrupt tile only marks its worker as failed.
+static int decode_tile_col(TileWorkerData *const tile_data,
+                           const TileBuffer *const buf) {
+  VP9Decoder *const pbi = tile_data->pbi;
+  VP9_COMMON *const cm = &pbi->common;
+  const int tile_cols = 1 << cm->log2_tile_cols;
+  TileInfo tile;
   int mi_row, mi_col;
 
+  tile_data->xd = pbi->mb;
+  tile_data->xd.corrupted = 0;
+
   if (setjmp(tile_data->error_info.jmp)) {
     tile_data->error_info.setjmp = 0;
     tile_data->xd.corrupted = 1;
@@ -1070,20 +1123,101 @@ static int tile_worker_hook(TileWorkerData *const tile_data,
   tile_data->error_info.setjmp = 1;
   tile_data->xd.error_info = &tile_data->error_info;
 
-  for (mi_row = tile->mi_row_start; mi_row < tile->mi_row_end;
+  vp9_tile_init(&tile, cm, 0, buf->col);
+  setup_token_decoder(buf->data, pbi->job_queue.data_end, buf->size,
+                      &tile_data->error_info, &tile_data->bit_reader,
+                      pbi->decrypt_cb, pbi->decrypt_state);
+  init_macroblockd(cm, &tile_data->xd);
+
+  for (mi_row = tile.mi_row_start; mi_row < tile.mi_row_end;
        mi_row += MI_BLOCK_SIZE) {
     vp9_zero(tile_data->xd.left_context);
     vp9_zero(tile_data->xd.left_seg_context);
-    for (mi_col = tile->mi_col_start; mi_col < tile->mi_col_end;
+    for (mi_col = tile.mi_col_start; mi_col < tile.mi_col_end;
          mi_col += MI_BLOCK_SIZE) {
-      decode_partition(tile_data->pbi, &tile_data->xd, &tile_data->counts,
-                       tile, mi_row, mi_col, &tile_data->bit_reader,
-                       BLOCK_64X64);
+      decode_partition(pbi, &tile_data->xd, &tile_data->counts, &tile, mi_row,
+                       mi_col, &tile_data->bit_reader, BLOCK_64X64);
     }
+    if (pbi->pipelined_lpf && cm->lf.filter_level)
+      sb_row_decoded(pbi, mi_row);
   }
+
+  if (buf->col == tile_cols - 1)
+    pbi->job_queue.bit_reader_end = vp9_reader_find_end(&tile_data->bit_reader);
+
+  tile_data->error_info.setjmp = 0;
   return !tile_data->xd.corrupted;
 }
 
+static int get_next_job(DecJobQueue *const queue, DecJob *const job) {
+  int found = 0;
+#if CONFIG_MULTITHREAD
+  pthread_mutex_lock(queue->mutex_);
+  while (queue->next_job == queue->num_jobs &&
+         queue->num_jobs < queue->total_jobs && !queue->aborted)
+    pthread_cond_wait(queue->cond_, queue->mutex_);
+#endif
+  if (queue->next_job < queue->num_jobs) {
+    *job = queue->jobs[queue->next_job++];
+    found = 1;
+  }
+#if CONFIG_MULTITHREAD
+  pthread_mutex_unlock(queue->mutex_);
+#endif
+  return found;
+}
+
+// Tile worker hook: run jobs from the decoder's job queue until it is empty.
+static int dec_job_worker_hook(TileWorkerData *const tile_data, void *unused) {
+  VP9Decoder *const pbi = tile_data->pbi;
+  VP9_COMMON *const cm = &pbi->common;
+  DecJob job;
+  int corrupted = 0;
+  (void)unused;
+
+  while (get_next_job(&pbi->job_queue, &job)) {
+    switch (job.type) {
+      case DEC_JOB_TILE:
+        if (!decode_tile_col(tile_data, &job.tile)) {
+          corrupted = 1;
+          abort_jobs(&pbi->job_queue);
+        }
+        break;
+      case DEC_JOB_LPF_ROW:
+        vp9_loop_filter_sb_row(get_frame_new_buffer(cm), cm,
+                               tile_data->xd.plane, job.mi_row, 0,
+                               &pbi->lf_row_sync);
+        break;
+    }
+  }
+  return !corrupted;
+}
+
+// Launch all tile workers on the queued jobs and wait for them to finish.
+static void run_dec_jobs(VP9Decoder *pbi) {
+  const VP9WorkerInterface *const winterface = vp9_get_worker_interface();
+  const int num_workers = pbi->num_tile_workers;
+  int i;
+
+  pbi->job_queue.next_job = 0;
+  for (i = 0; i < num_workers; ++i) {
+    VP9Worker *const worker = &pbi->tile_workers[i];
+    worker->had_error = 0;
+    if (i == num_workers - 1) {
+      winterface->execute(worker);
+    } else {
+      winterface->launch(worker);
+    }
+  }
+
+  for (i = 0; i < num_workers; ++i) {
+    // TODO(jzern): The tile may have specific error data associated with
+    // its vpx_internal_error_info which could be propagated to the main info
+    // in cm.
+    pbi->mb.corrupted |= !winterface->sync(&pbi->tile_workers[i]);
+  }
+}
+
 // sorts in descending order
 static int compare_tile_buffers(const void *a, const void *b) {
   const TileBuffer *const buf1 = (const TileBuffer*)a;
@@ -1091,19 +1225,26 @@ static int compare_tile_buffers(const void *a, const void *b) {
   return (int)(buf2->size - buf1->size);
 }
 
+// Decode the tile columns and loopfilter the frame with one pool of workers.
+// The pool is created on first use with max_threads workers, the last one
+// being the calling thread, and is kept for the decoder's lifetime. Tile
+// columns and superblock rows are queued as jobs, so the number of workers
+// kept busy is not bounded by the number of tile columns. The rows are
+// filtered after all tiles are decoded, or with pipelined_lpf, as soon as
+// the tile columns have moved past them.
 static const uint8_t *decode_tiles_mt(VP9Decoder *pbi,
                                       const uint8_t *data,
                                       const uint8_t *data_end) {
   VP9_COMMON *const cm = &pbi->common;
-  const VP9WorkerInterface *const winterface = vp9_get_worker_interface();
-  const uint8_t *bit_reader_end = NULL;
   const int aligned_mi_cols = mi_cols_aligned_to_sb(cm->mi_cols);
+  const int sb_rows = mi_cols_aligned_to_sb(cm->mi_rows) >> MI_BLOCK_SIZE_LOG2;
   const int tile_cols = 1 << cm->log2_tile_cols;
   const int tile_rows = 1 << cm->log2_tile_rows;
-  const int num_workers = MIN(pbi->max_threads & ~1, tile_cols);
+  const int pipelined_lpf = pbi->pipelined_lpf && cm->lf.filter_level;
+  DecJobQueue *const queue = &pbi->job_queue;
   TileBuffer tile_buffers[1][1 << 6];
-  int n;
-  int final_worker = -1;
+  DecJob job;
+  int i, n;
 
   assert(tile_cols <= (1 << 6));
   assert(tile_rows == 1);
@@ -1112,10 +1253,14 @@ static const uint8_t *decode_tiles_mt(VP9Decoder *pbi,
   // TODO(jzern): See if we can remove the restriction of passing in max
   // threads to the decoder.
   if (pbi->num_tile_workers == 0) {
-    const int num_threads = pbi->max_threads & ~1;
-    int i;
-    // TODO(jzern): Allocate one less worker, as in the current code we only
-    // use num_threads - 1 workers.
+    const VP9WorkerInterface *const winterface = vp9_get_worker_interface();
+    const int num_threads = pbi->max_threads;
+#if CONFIG_MULTITHREAD
+    CHECK_MEM_ERROR(cm, queue->mutex_, vpx_malloc(sizeof(*queue->mutex_)));
+    pthread_mutex_init(queue->mutex_, NULL);
+    CHECK_MEM_ERROR(cm, queue->cond_, vpx_malloc(sizeof(*queue->cond_)));
+    pthread_cond_init(queue->cond_, NULL);
+#endif
     CHECK_MEM_ERROR(cm, pbi->tile_workers,
                     vpx_malloc(num_threads * sizeof(*pbi->tile_workers)));
     // Ensure tile data offsets will be properly aligned. This may fail on
@@ -1124,13 +1269,15 @@ static const uint8_t *decode_tiles_mt(VP9Decoder *pbi,
     CHECK_MEM_ERROR(cm, pbi->tile_worker_data,
                     vpx_memalign(32, num_threads *
                                  sizeof(*pbi->tile_worker_data)));
-    CHECK_MEM_ERROR(cm, pbi->tile_worker_info,
-                    vpx_malloc(num_threads * sizeof(*pbi->tile_worker_info)));
     for (i = 0; i < num_threads; ++i) {
       VP9Worker *const worker = &pbi->tile_workers[i];
       ++pbi->num_tile_workers;
 
       winterface->init(worker);
+      worker->hook = (VP9WorkerHook)dec_job_worker_hook;
+      worker->data1 = &pbi->tile_worker_data[i];
+      worker->data2 = NULL;
+      pbi->tile_worker_data[i].pbi = pbi;
       if (i < num_threads - 1 && !winterface->reset(worker)) {
         vpx_internal_error(&cm->error, VPX_CODEC_ERROR,
                            "Tile decoder thread creation failed");
@@ -1138,13 +1285,25 @@ static const uint8_t *decode_tiles_mt(VP9Decoder *pbi,
     }
   }
 
-  // Reset tile decoding hook
-  for (n = 0; n < num_workers; ++n) {
-    VP9Worker *const worker = &pbi->tile_workers[n];
-    winterface->sync(worker);
-    worker->hook = (VP9WorkerHook)tile_worker_hook;
-    worker->data1 = &pbi->tile_worker_data[n];
-    worker->data2 = &pbi->tile_worker_info[n];
+  if (queue->allocated_jobs < tile_cols + sb_rows) {
+    vpx_free(queue->jobs);
+    vpx_free(queue->sb_row_tiles_done);
+    queue->allocated_jobs = 0;
+    CHECK_MEM_ERROR(cm, queue->jobs,
+                    vpx_malloc((tile_cols + sb_rows) * sizeof(*queue->jobs)));
+    CHECK_MEM_ERROR(cm, queue->sb_row_tiles_done,
+                    vpx_malloc(sb_rows * sizeof(*queue->sb_row_tiles_done)));
+    queue->allocated_jobs = tile_cols + sb_rows;
+  }
+
+  if (cm->lf.filter_level) {
+    VP9LfSync *const lf_sync = &pbi->lf_row_sync;
+    if (!lf_sync->sync_range || sb_rows != lf_sync->rows) {
+      vp9_loop_filter_dealloc(lf_sync);
+      vp9_loop_filter_alloc(lf_sync, cm, sb_rows, cm->width,
+                            pbi->num_tile_workers);
+    }
+    memset(lf_sync->cur_sb_col, -1, sizeof(*lf_sync->cur_sb_col) * sb_rows);
   }
 
   // Note: this memset assumes above_context[0], [1] and [2]
@@ -1157,95 +1316,54 @@ static const uint8_t *decode_tiles_mt(VP9Decoder *pbi,
   // Load tile data into tile_buffers
   get_tile_buffers(pbi, data, data_end, tile_cols, tile_rows, tile_buffers);
 
-  // Sort the buffers based on size in descending order.
+  // Sort the buffers based on size in descending order, so the largest, and
+  // presumably the most difficult, tiles are started first.
   qsort(tile_buffers[0], tile_cols, sizeof(tile_buffers[0][0]),
         compare_tile_buffers);
 
-  // Rearrange the tile buffers such that per-tile group the largest, and
-  // presumably the most difficult, tile will be decoded in the main thread.
-  // This should help minimize the number of instances where the main thread is
-  // waiting for a worker to complete.
-  {
-    int group_start = 0;
-    while (group_start < tile_cols) {
-      const TileBuffer largest = tile_buffers[0][group_start];
-      const int group_end = MIN(group_start + num_workers, tile_cols) - 1;
-      memmove(tile_buffers[0] + group_start, tile_buffers[0] + group_start + 1,
-              (group_end - group_start) * sizeof(tile_buffers[0][0]));
-      tile_buffers[0][group_end] = largest;
-      group_start = group_end + 1;
-    }
-  }
-
   // Initialize thread frame counts.
   if (!cm->frame_parallel_decoding_mode) {
-    int i;
-
-    for (i = 0; i < num_workers; ++i) {
-      TileWorkerData *const tile_data =
-          (TileWorkerData*)pbi->tile_workers[i].data1;
-      vp9_zero(tile_data->counts);
-    }
+    for (i = 0; i < pbi->num_tile_workers; ++i)
+      vp9_zero(pbi->tile_worker_data[i].counts);
   }
 
-  n = 0;
-  while (n < tile_cols) {
-    int i;
-    for (i = 0; i < num_workers && n < tile_cols; ++i) {
-      VP9Worker *const worker = &pbi->tile_workers[i];
-      TileWorkerData *const tile_data = (TileWorkerData*)worker->data1;
-      TileInfo *const tile = (TileInfo*)worker->data2;
-      TileBuffer *const buf = &tile_buffers[0][n];
-
-      tile_data->pbi = pbi;
-      tile_data->xd = pbi->mb;
-      tile_data->xd.corrupted = 0;
-      vp9_tile_init(tile, cm, 0, buf->col);
-      setup_token_decoder(buf->data, data_end, buf->size, &cm->error,
-                          &tile_data->bit_reader, pbi->decrypt_cb,
-                          pbi->decrypt_state);
-      init_macroblockd(cm, &tile_data->xd);
-
-      worker->had_error = 0;
-      if (i == num_workers - 1 || n == tile_cols - 1) {
-        winterface->execute(worker);
-      } else {
-        winterface->launch(worker);
-      }
-
-      if (buf->col == tile_cols - 1) {
-        final_worker = i;
-      }
-
-      ++n;
-    }
+  for (i = 0; i < pbi->num_tile_workers; ++i)
+    pbi->tile_worker_data[i].xd = pbi->mb;
+
+  queue->data_end = data_end;
+  queue->bit_reader_end = NULL;
+  queue->aborted = 0;
+  queue->num_jobs = 0;
+  queue->total_jobs = tile_cols + (pipelined_lpf ? sb_rows : 0);
+  memset(queue->sb_row_tiles_done, 0,
+         sb_rows * sizeof(*queue->sb_row_tiles_done));
+  job.type = DEC_JOB_TILE;
+  for (n = 0; n < tile_cols; ++n) {
+    job.tile = tile_buffers[0][n];
+    queue_job(queue, &job);
+  }
+  run_dec_jobs(pbi);
 
-    for (; i > 0; --i) {
-      VP9Worker *const worker = &pbi->tile_workers[i - 1];
-      // TODO(jzern): The tile may have specific error data associated with
-      // its vpx_internal_error_info which could be propagated to the main info
-      // in cm. Additionally once the threads have been synced and an error is
-      // detected, there's no point in continuing to decode tiles.
-      pbi->mb.corrupted |= !winterface->sync(worker);
-    }
-    if (final_worker > -1) {
-      TileWorkerData *const tile_data =
-          (TileWorkerData*)pbi->tile_workers[final_worker].data1;
-      bit_reader_end = vp9_reader_find_end(&tile_data->bit_reader);
-      final_worker = -1;
-    }
+  // Accumulate thread frame counts.
+  if (!cm->frame_parallel_decoding_mode) {
+    for (i = 0; i < pbi->num_tile_workers; ++i)
+      vp9_accumulate_frame_counts(cm, &pbi->tile_worker_data[i].counts, 1);
+  }
 
-    // Accumulate thread frame counts.
-    if (n >= tile_cols && !cm->frame_parallel_decoding_mode) {
-      for (i = 0; i < num_workers; ++i) {
-        TileWorkerData *const tile_data =
-            (TileWorkerData*)pbi->tile_workers[i].data1;
-        vp9_accumulate_frame_counts(cm, &tile_data->counts, 1);
-      }
+  // Otherwise loopfilter the superblock rows on the same workers now. The
+  // rows are queued in order and synchronized through lf_row_sync.
+  if (cm->lf.filter_level && !pipelined_lpf && !pbi->mb.corrupted) {
+    queue->num_jobs = 0;
+    queue->total_jobs = sb_rows;
+    job.type = DEC_JOB_LPF_ROW;
+    for (n = 0; n < sb_rows; ++n) {
+      job.mi_row = n << MI_BLOCK_SIZE_LOG2;
+      queue_job(queue, &job);
     }
+    run_dec_jobs(pbi);
   }
 
-  return bit_reader_end;
+  return queue->bit_reader_end;
 }
 
 static void error_handler(void *data) {
@@ -1688,16 +1806,9 @@ void vp9_decode_frame(VP9Decoder *pbi,
   if (pbi->max_threads > 1 && tile_rows == 1 && tile_cols > 1) {
     // Multi-threaded tile decoder
     *p_data_end = decode_tiles_mt(pbi, data + first_partition_size, data_end);
-    if (!xd->corrupted) {
-      // If multiple threads are used to decode tiles, then we use those threads
-      // to do parallel loopfiltering.
-      vp9_loop_filter_frame_mt(new_fb, cm, pbi->mb.plane, cm->lf.filter_level,
-                               0, 0, pbi->tile_workers, pbi->num_tile_workers,
-                               &pbi->lf_row_sync);
-    } else {
+    if (xd->corrupted) {
       vpx_internal_error(&cm->error, VPX_CODEC_CORRUPT_FRAME,
                          "Decode failed. Frame data is corrupted.");
-
     }
   } else {
     *p_data_end = decode_tiles(pbi, data + first_partition_size, data_end);
@@ -134,8 +134,19 @@ void vp9_decoder_remove(VP9Decoder *pbi) {
     vp9_get_worker_interface()->end(worker);
   }
   vpx_free(pbi->tile_worker_data);
-  vpx_free(pbi->tile_worker_info);
   vpx_free(pbi->tile_workers);
+  vpx_free(pbi->job_queue.jobs);
+  vpx_free(pbi->job_queue.sb_row_tiles_done);
+#if CONFIG_MULTITHREAD
+  if (pbi->job_queue.mutex_ != NULL) {
+    pthread_mutex_destroy(pbi->job_queue.mutex_);
+    vpx_free(pbi->job_queue.mutex_);
+  }
+  if (pbi->job_queue.cond_ != NULL) {
+    pthread_cond_destroy(pbi->job_queue.cond_);
+    vpx_free(pbi->job_queue.cond_);
+  }
+#endif
 
   if (pbi->num_tile_workers > 0) {
     vp9_loop_filter_dealloc(&pbi->lf_row_sync);
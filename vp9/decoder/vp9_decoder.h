@@ -26,6 +26,12 @@
 extern "C" {
 #endif
 
+typedef struct TileBuffer {
+  const uint8_t *data;
+  size_t size;
+  int col;  // only used with multi-threaded decoding
+} TileBuffer;
+
 // TODO(hkuang): combine this with TileWorkerData.
 typedef struct TileData {
   VP9_COMMON *cm;
@@ -41,6 +47,39 @@ typedef struct TileWorkerData {
   struct vpx_internal_error_info error_info;
 } TileWorkerData;
 
+typedef enum {
+  DEC_JOB_TILE,     // Decode a tile column.
+  DEC_JOB_LPF_ROW   // Loopfilter a superblock row.
+} DEC_JOB_TYPE;
+
+typedef struct DecJob {
+  DEC_JOB_TYPE type;
+  TileBuffer tile;  // Tile to decode, for DEC_JOB_TILE.
+  int mi_row;       // First mi row of the superblock row, for DEC_JOB_LPF_ROW.
+} DecJob;
+
+// Jobs handed out to the tile workers. Workers take jobs in queue order and
+// wait for more while fewer than total_jobs have been queued.
+typedef struct DecJobQueue {
+#if CONFIG_MULTITHREAD
+  pthread_mutex_t *mutex_;
+  pthread_cond_t *cond_;
+#endif
+  DecJob *jobs;
+  int num_jobs;
+  int next_job;
+  int total_jobs;
+  int allocated_jobs;
+  // Set when a tile fails to decode. No further jobs will be queued.
+  int aborted;
+  // Number of tile columns that have decoded each superblock row, used to
+  // queue loopfilter rows while tiles are still being decoded.
+  int *sb_row_tiles_done;
+  const uint8_t *data_end;
+  // End of the last tile column, set by the worker that decodes it.
+  const uint8_t *bit_reader_end;
+} DecJobQueue;
+
 typedef struct VP9Decoder {
   DECLARE_ALIGNED(16, MACROBLOCKD, mb);
 
@@ -60,8 +99,8 @@ typedef struct VP9Decoder {
   VP9Worker lf_worker;
   VP9Worker *tile_workers;
   TileWorkerData *tile_worker_data;
-  TileInfo *tile_worker_info;
   int num_tile_workers;
+  DecJobQueue job_queue;
 
   TileData *tile_data;
   int total_tiles;
@@ -73,6 +112,9 @@ typedef struct VP9Decoder {
 
   int max_threads;
   int inv_tile_order;
+  // Loopfilter superblock rows as soon as all tile columns have decoded the
+  // row below them, instead of after the whole frame is decoded.
+  int pipelined_lpf;
   int need_resync;  // wait for key/intra-only frame.
   int hold_ref_buf;  // hold the reference buffer.
 } VP9Decoder;
@@ -119,13 +119,14 @@ static void update_switchable_interp_probs(VP9_COMMON *cm, vp9_writer *w,
                      counts->switchable_interp[j], SWITCHABLE_FILTERS, w);
 }
 
-static void pack_mb_tokens(vp9_writer *w,
+static void pack_mb_tokens(vp9_writer *w, const vp9_prob *const probs_base,
                            TOKENEXTRA **tp, const TOKENEXTRA *const stop,
                            vpx_bit_depth_t bit_depth) {
   TOKENEXTRA *p = *tp;
 
   while (p < stop && p->token != EOSB_TOKEN) {
     const int t = p->token;
+    const vp9_prob *const context_tree = probs_base + p->context_offset;
     const struct vp9_token *const a = &vp9_coef_encodings[t];
     int i = 0;
     int v = a->value;
@@ -160,12 +161,12 @@ static void pack_mb_tokens(vp9_writer *w,
     if (t >= TWO_TOKEN && t < EOB_TOKEN) {
       int len = UNCONSTRAINED_NODES - p->skip_eob_node;
       int bits = v >> (n - len);
-      vp9_write_tree(w, vp9_coef_tree, p->context_tree, bits, len, i);
+      vp9_write_tree(w, vp9_coef_tree, context_tree, bits, len, i);
       vp9_write_tree(w, vp9_coef_con_tree,
-                     vp9_pareto8_full[p->context_tree[PIVOT_NODE] - 1],
+                     vp9_pareto8_full[context_tree[PIVOT_NODE] - 1],
                      v, n - len, 0);
     } else {
-      vp9_write_tree(w, vp9_coef_tree, p->context_tree, v, n, i);
+      vp9_write_tree(w, vp9_coef_tree, context_tree, v, n, i);
     }
 
     if (b->base_val) {
@@ -234,12 +235,12 @@ static void write_ref_frames(const VP9_COMMON *cm, const MACROBLOCKD *xd,
   }
 }
 
-static void pack_inter_mode_mvs(VP9_COMP *cpi, const MODE_INFO *mi,
-                                vp9_writer *w) {
+static void pack_inter_mode_mvs(VP9_COMP *cpi, const MACROBLOCKD *const xd,
+                                const MODE_INFO *mi, vp9_writer *w,
+                                unsigned int *const max_mv_magnitude,
+                                int interp_filter_selected[SWITCHABLE]) {
   VP9_COMMON *const cm = &cpi->common;
   const nmv_context *nmvc = &cm->fc->nmvc;
-  const MACROBLOCK *const x = &cpi->td.mb;
-  const MACROBLOCKD *const xd = &x->e_mbd;
   const struct segmentation *const seg = &cm->seg;
   const MB_MODE_INFO *const mbmi = &mi->mbmi;
   const PREDICTION_MODE mode = mbmi->mode;
@@ -304,7 +305,7 @@ static void pack_inter_mode_mvs(VP9_COMP *cpi, const MODE_INFO *mi,
       vp9_write_token(w, vp9_switchable_interp_tree,
                       cm->fc->switchable_interp_prob[ctx],
                       &switchable_interp_encodings[mbmi->interp_filter]);
-      ++cpi->interp_filter_selected[0][mbmi->interp_filter];
+      ++interp_filter_selected[mbmi->interp_filter];
     } else {
       assert(mbmi->interp_filter == cm->interp_filter);
     }
@@ -322,7 +323,7 @@ static void pack_inter_mode_mvs(VP9_COMP *cpi, const MODE_INFO *mi,
             for (ref = 0; ref < 1 + is_compound; ++ref)
               vp9_encode_mv(cpi, w, &mi->bmi[j].as_mv[ref].as_mv,
                             &mbmi->ref_mvs[mbmi->ref_frame[ref]][0].as_mv,
-                            nmvc, allow_hp);
+                            nmvc, allow_hp, max_mv_magnitude);
           }
         }
       }
@@ -331,7 +332,7 @@ static void pack_inter_mode_mvs(VP9_COMP *cpi, const MODE_INFO *mi,
         for (ref = 0; ref < 1 + is_compound; ++ref)
           vp9_encode_mv(cpi, w, &mbmi->mv[ref].as_mv,
                         &mbmi->ref_mvs[mbmi->ref_frame[ref]][0].as_mv, nmvc,
-                        allow_hp);
+                        allow_hp, max_mv_magnitude);
       }
     }
   }
@@ -373,12 +374,13 @@ static void write_mb_modes_kf(const VP9_COMMON *cm, const MACROBLOCKD *xd,
   write_intra_mode(w, mbmi->uv_mode, vp9_kf_uv_mode_prob[mbmi->mode]);
 }
 
-static void write_modes_b(VP9_COMP *cpi, const TileInfo *const tile,
-                          vp9_writer *w, TOKENEXTRA **tok,
-                          const TOKENEXTRA *const tok_end,
+static void write_modes_b(VP9_COMP *cpi, MACROBLOCKD *const xd,
+                          const TileInfo *const tile, vp9_writer *w,
+                          TOKENEXTRA **tok, const TOKENEXTRA *const tok_end,
+                          unsigned int *const max_mv_magnitude,
+                          int interp_filter_selected[SWITCHABLE],
                           int mi_row, int mi_col) {
   const VP9_COMMON *const cm = &cpi->common;
-  MACROBLOCKD *const xd = &cpi->td.mb.e_mbd;
   MODE_INFO *m;
 
   xd->mi = cm->mi_grid_visible + (mi_row * cm->mi_stride + mi_col);
@@ -391,11 +393,13 @@ static void write_modes_b(VP9_COMP *cpi, const TileInfo *const tile,
   if (frame_is_intra_only(cm)) {
     write_mb_modes_kf(cm, xd, xd->mi, w);
   } else {
-    pack_inter_mode_mvs(cpi, m, w);
+    pack_inter_mode_mvs(cpi, xd, m, w, max_mv_magnitude,
+                        interp_filter_selected);
   }
 
   assert(*tok < tok_end);
-  pack_mb_tokens(w, tok, tok_end, cm->bit_depth);
+  pack_mb_tokens(w, cm->fc->coef_probs[0][0][0][0][0], tok, tok_end,
+                 cm->bit_depth);
 }
 
 static void write_partition(const VP9_COMMON *const cm,
@@ -420,12 +424,13 @@ static void write_partition(const VP9_COMMON *const cm,
   }
 }
 
-static void write_modes_sb(VP9_COMP *cpi,
+static void write_modes_sb(VP9_COMP *cpi, MACROBLOCKD *const xd,
                            const TileInfo *const tile, vp9_writer *w,
                            TOKENEXTRA **tok, const TOKENEXTRA *const tok_end,
+                           unsigned int *const max_mv_magnitude,
+                           int interp_filter_selected[SWITCHABLE],
                            int mi_row, int mi_col, BLOCK_SIZE bsize) {
   const VP9_COMMON *const cm = &cpi->common;
-  MACROBLOCKD *const xd = &cpi->td.mb.e_mbd;
 
   const int bsl = b_width_log2_lookup[bsize];
   const int bs = (1 << bsl) / 4;
@@ -442,29 +447,37 @@ static void write_modes_sb(VP9_COMP *cpi,
   write_partition(cm, xd, bs, mi_row, mi_col, partition, bsize, w);
   subsize = get_subsize(bsize, partition);
   if (subsize < BLOCK_8X8) {
-    write_modes_b(cpi, tile, w, tok, tok_end, mi_row, mi_col);
+    write_modes_b(cpi, xd, tile, w, tok, tok_end, max_mv_magnitude,
+                  interp_filter_selected, mi_row, mi_col);
   } else {
     switch (partition) {
       case PARTITION_NONE:
-        write_modes_b(cpi, tile, w, tok, tok_end, mi_row, mi_col);
+        write_modes_b(cpi, xd, tile, w, tok, tok_end, max_mv_magnitude,
+                      interp_filter_selected, mi_row, mi_col);
         break;
       case PARTITION_HORZ:
-        write_modes_b(cpi, tile, w, tok, tok_end, mi_row, mi_col);
+        write_modes_b(cpi, xd, tile, w, tok, tok_end, max_mv_magnitude,
+                      interp_filter_selected, mi_row, mi_col);
         if (mi_row + bs < cm->mi_rows)
-          write_modes_b(cpi, tile, w, tok, tok_end, mi_row + bs, mi_col);
+          write_modes_b(cpi, xd, tile, w, tok, tok_end, max_mv_magnitude,
+                        interp_filter_selected, mi_row + bs, mi_col);
         break;
       case PARTITION_VERT:
-        write_modes_b(cpi, tile, w, tok, tok_end, mi_row, mi_col);
+        write_modes_b(cpi, xd, tile, w, tok, tok_end, max_mv_magnitude,
+                      interp_filter_selected, mi_row, mi_col);
         if (mi_col + bs < cm->mi_cols)
-          write_modes_b(cpi, tile, w, tok, tok_end, mi_row, mi_col + bs);
+          write_modes_b(cpi, xd, tile, w, tok, tok_end, max_mv_magnitude,
+                        interp_filter_selected, mi_row, mi_col + bs);
         break;
       case PARTITION_SPLIT:
-        write_modes_sb(cpi, tile, w, tok, tok_end, mi_row, mi_col, subsize);
-        write_modes_sb(cpi, tile, w, tok, tok_end, mi_row, mi_col + bs,
-                       subsize);
-        write_modes_sb(cpi, tile, w, tok, tok_end, mi_row + bs, mi_col,
-                       subsize);
-        write_modes_sb(cpi, tile, w, tok, tok_end, mi_row + bs, mi_col + bs,
+        write_modes_sb(cpi, xd, tile, w, tok, tok_end, max_mv_magnitude,
+                       interp_filter_selected, mi_row, mi_col, subsize);
+        write_modes_sb(cpi, xd, tile, w, tok, tok_end, max_mv_magnitude,
+                       interp_filter_selected, mi_row, mi_col + bs, subsize);
+        write_modes_sb(cpi, xd, tile, w, tok, tok_end, max_mv_magnitude,
+                       interp_filter_selected, mi_row + bs, mi_col, subsize);
+        write_modes_sb(cpi, xd, tile, w, tok, tok_end, max_mv_magnitude,
+                       interp_filter_selected, mi_row + bs, mi_col + bs,
                        subsize);
         break;
       default:
@@ -478,19 +491,26 @@ static void write_modes_sb(VP9_COMP *cpi,
     update_partition_context(xd, mi_row, mi_col, subsize, bsize);
 }
 
-static void write_modes(VP9_COMP *cpi,
+static void write_modes(VP9_COMP *cpi, MACROBLOCKD *const xd,
                         const TileInfo *const tile, vp9_writer *w,
-                        TOKENEXTRA **tok, const TOKENEXTRA *const tok_end) {
-  MACROBLOCKD *const xd = &cpi->td.mb.e_mbd;
+                        const TOKENLIST *const tplist,
+                        unsigned int *const max_mv_magnitude,
+                        int interp_filter_selected[SWITCHABLE]) {
   int mi_row, mi_col;
 
   for (mi_row = tile->mi_row_start; mi_row < tile->mi_row_end;
        mi_row += MI_BLOCK_SIZE) {
+    const TOKENLIST *const row_tokens =
+        &tplist[(mi_row - tile->mi_row_start) >> MI_BLOCK_SIZE_LOG2];
+    TOKENEXTRA *tok = row_tokens->start;
+    const TOKENEXTRA *const tok_end = row_tokens->stop;
+
     vp9_zero(xd->left_seg_context);
     for (mi_col = tile->mi_col_start; mi_col < tile->mi_col_end;
          mi_col += MI_BLOCK_SIZE)
-      write_modes_sb(cpi, tile, w, tok, tok_end, mi_row, mi_col,
-                     BLOCK_64X64);
+      write_modes_sb(cpi, xd, tile, w, &tok, tok_end, max_mv_magnitude,
+                     interp_filter_selected, mi_row, mi_col, BLOCK_64X64);
+    assert(tok == tok_end);
   }
 }
 
@@ -919,34 +939,225 @@ static int get_refresh_mask(VP9_COMP *cpi) {
   }
 }
 
+// Number of above partition contexts a tile may update, up to the end of its
+// last superblock.
+static int tile_above_seg_context_size(const TileInfo *tile) {
+  return mi_cols_aligned_to_sb(tile->mi_col_end) - tile->mi_col_start;
+}
+
+// Allocates the worker scratch state on first use and grows each scratch
+// buffer to twice the raw size of the widest tile column. The coded size of a
+// tile is not bounded by its raw size, so the workers write through a bounded
+// writer and encode_tiles_mt() repacks any tile that does not fit.
+static void encode_tiles_buffer_alloc(VP9_COMP *cpi, int num_workers) {
+  VP9_COMMON *const cm = &cpi->common;
+  const int tile_cols = 1 << cm->log2_tile_cols;
+#if CONFIG_VP9_HIGHBITDEPTH
+  const int bytes_per_sample = cm->use_highbitdepth ? 2 : 1;
+#else
+  const int bytes_per_sample = 1;
+#endif  // CONFIG_VP9_HIGHBITDEPTH
+  int max_mi_cols = 0;
+  size_t luma_size, chroma_size, dest_size;
+  int above_size;
+  int i;
+
+  for (i = 0; i < tile_cols; ++i) {
+    const TileInfo *const tile = &cpi->tile_data[i].tile_info;
+    max_mi_cols = MAX(max_mi_cols, tile->mi_col_end - tile->mi_col_start);
+  }
+  luma_size = (size_t)(max_mi_cols * MI_SIZE) * (cm->mi_rows * MI_SIZE);
+  chroma_size = luma_size >> (cm->subsampling_x + cm->subsampling_y);
+  dest_size = 2 * (luma_size + 2 * chroma_size) * bytes_per_sample;
+  dest_size = MIN(dest_size, UINT_MAX);
+  above_size = mi_cols_aligned_to_sb(max_mi_cols);
+
+  if (cpi->bitstream_worker_data == NULL) {
+    CHECK_MEM_ERROR(cm, cpi->bitstream_worker_data,
+                    vpx_memalign(16, cpi->num_workers *
+                                     sizeof(*cpi->bitstream_worker_data)));
+    memset(cpi->bitstream_worker_data, 0,
+           cpi->num_workers * sizeof(*cpi->bitstream_worker_data));
+  }
+
+  for (i = 0; i < num_workers; ++i) {
+    VP9BitstreamWorkerData *const data = &cpi->bitstream_worker_data[i];
+    if (data->dest_size < dest_size) {
+      vpx_free(data->dest);
+      data->dest_size = 0;
+      CHECK_MEM_ERROR(cm, data->dest, vpx_malloc(dest_size));
+      data->dest_size = dest_size;
+    }
+    if (data->above_seg_context_size < above_size) {
+      vpx_free(data->above_seg_context);
+      data->above_seg_context_size = 0;
+      CHECK_MEM_ERROR(cm, data->above_seg_context,
+                      vpx_malloc(above_size *
+                                 sizeof(*data->above_seg_context)));
+      data->above_seg_context_size = above_size;
+    }
+  }
+}
+
+void vp9_bitstream_encode_tiles_buffer_dealloc(VP9_COMP *cpi) {
+  if (cpi->bitstream_worker_data != NULL) {
+    int i;
+    for (i = 0; i < cpi->num_workers; ++i) {
+      vpx_free(cpi->bitstream_worker_data[i].dest);
+      vpx_free(cpi->bitstream_worker_data[i].above_seg_context);
+    }
+    vpx_free(cpi->bitstream_worker_data);
+    cpi->bitstream_worker_data = NULL;
+  }
+}
+
+static int encode_tile_worker(VP9_COMP *cpi, VP9BitstreamWorkerData *data) {
+  const VP9_COMMON *const cm = &cpi->common;
+  const int tile_cols = 1 << cm->log2_tile_cols;
+  const int tile_row = data->tile_idx / tile_cols;
+  const int tile_col = data->tile_idx % tile_cols;
+
+  vp9_start_bounded_encode(&data->bit_writer, data->dest,
+                           (unsigned int)data->dest_size);
+  write_modes(cpi, &data->xd, &cpi->tile_data[data->tile_idx].tile_info,
+              &data->bit_writer, cpi->tplist[tile_row][tile_col],
+              &data->max_mv_magnitude, data->interp_filter_selected);
+  vp9_stop_encode(&data->bit_writer);
+  return 1;
+}
+
+// Packs the tile columns of each tile row in parallel, every worker writing
+// one tile into its own scratch buffer. Tile rows are still packed in order
+// as they share the above partition context.
+static size_t encode_tiles_mt(VP9_COMP *cpi, uint8_t *data_ptr) {
+  const VP9WorkerInterface *const winterface = vp9_get_worker_interface();
+  VP9_COMMON *const cm = &cpi->common;
+  const int tile_cols = 1 << cm->log2_tile_cols;
+  const int tile_rows = 1 << cm->log2_tile_rows;
+  const int num_workers = MIN(cpi->num_workers, tile_cols);
+  size_t total_size = 0;
+  int tile_row, tile_col;
+
+  encode_tiles_buffer_alloc(cpi, num_workers);
+
+  memset(cm->above_seg_context, 0,
+         sizeof(*cm->above_seg_context) * mi_cols_aligned_to_sb(cm->mi_cols));
+
+  for (tile_row = 0; tile_row < tile_rows; ++tile_row) {
+    for (tile_col = 0; tile_col < tile_cols; tile_col += num_workers) {
+      const int num_tiles = MIN(num_workers, tile_cols - tile_col);
+      int i;
+
+      for (i = 0; i < num_tiles; ++i) {
+        VP9Worker *const worker = &cpi->workers[i];
+        VP9BitstreamWorkerData *const data = &cpi->bitstream_worker_data[i];
+
+        const TileInfo *tile;
+
+        data->tile_idx = tile_row * tile_cols + tile_col + i;
+        data->xd = cpi->td.mb.e_mbd;
+        data->max_mv_magnitude = cpi->max_mv_magnitude;
+        vp9_zero(data->interp_filter_selected);
+        tile = &cpi->tile_data[data->tile_idx].tile_info;
+        memcpy(data->above_seg_context,
+               cm->above_seg_context + tile->mi_col_start,
+               tile_above_seg_context_size(tile) *
+                   sizeof(*data->above_seg_context));
+
+        worker->hook = (VP9WorkerHook)encode_tile_worker;
+        worker->data1 = cpi;
+        worker->data2 = data;
+
+        // The last tile of the batch is packed on the calling thread.
+        if (i == num_tiles - 1)
+          winterface->execute(worker);
+        else
+          winterface->launch(worker);
+      }
+
+      for (i = 0; i < num_tiles; ++i) {
+        VP9Worker *const worker = &cpi->workers[i];
+        VP9BitstreamWorkerData *const data = &cpi->bitstream_worker_data[i];
+        const TileInfo *const tile = &cpi->tile_data[data->tile_idx].tile_info;
+        const int has_size = tile_col + i < tile_cols - 1 ||
+                             tile_row < tile_rows - 1;
+        uint8_t *const tile_ptr = data_ptr + total_size + (has_size ? 4 : 0);
+        size_t tile_size;
+        int j;
+
+        if (!winterface->sync(worker))
+          vpx_internal_error(&cm->error, VPX_CODEC_ERROR,
+                             "Failed to pack tile");
+
+        if (data->bit_writer.error) {
+          // The tile did not fit in the scratch buffer. Pack it again
+          // straight into the output, starting from the same contexts.
+          vp9_writer residual_bc;
+
+          memcpy(cm->above_seg_context + tile->mi_col_start,
+                 data->above_seg_context,
+                 tile_above_seg_context_size(tile) *
+                     sizeof(*data->above_seg_context));
+          data->xd = cpi->td.mb.e_mbd;
+          data->max_mv_magnitude = cpi->max_mv_magnitude;
+          vp9_zero(data->interp_filter_selected);
+
+          vp9_start_encode(&residual_bc, tile_ptr);
+          write_modes(cpi, &data->xd, tile, &residual_bc,
+                      cpi->tplist[tile_row][tile_col + i],
+                      &data->max_mv_magnitude, data->interp_filter_selected);
+          vp9_stop_encode(&residual_bc);
+          tile_size = residual_bc.pos;
+        } else {
+          tile_size = data->bit_writer.pos;
+          memcpy(tile_ptr, data->dest, tile_size);
+        }
+
+        cpi->max_mv_magnitude = MAX(cpi->max_mv_magnitude,
+                                    data->max_mv_magnitude);
+        for (j = 0; j < SWITCHABLE; ++j)
+          cpi->interp_filter_selected[0][j] += data->interp_filter_selected[j];
+
+        if (has_size) {
+          // size of this tile
+          mem_put_be32(data_ptr + total_size, (unsigned int)tile_size);
+          total_size += 4;
+        }
+        total_size += tile_size;
+      }
+    }
+  }
+
+  return total_size;
+}
+
 static size_t encode_tiles(VP9_COMP *cpi, uint8_t *data_ptr) {
   VP9_COMMON *const cm = &cpi->common;
+  MACROBLOCKD *const xd = &cpi->td.mb.e_mbd;
   vp9_writer residual_bc;
   int tile_row, tile_col;
-  TOKENEXTRA *tok_end;
   size_t total_size = 0;
   const int tile_cols = 1 << cm->log2_tile_cols;
   const int tile_rows = 1 << cm->log2_tile_rows;
 
+  if (cpi->num_workers > 1 && tile_cols > 1)
+    return encode_tiles_mt(cpi, data_ptr);
+
   memset(cm->above_seg_context, 0,
          sizeof(*cm->above_seg_context) * mi_cols_aligned_to_sb(cm->mi_cols));
 
   for (tile_row = 0; tile_row < tile_rows; tile_row++) {
     for (tile_col = 0; tile_col < tile_cols; tile_col++) {
       int tile_idx = tile_row * tile_cols + tile_col;
-      TOKENEXTRA *tok = cpi->tile_tok[tile_row][tile_col];
-
-      tok_end = cpi->tile_tok[tile_row][tile_col] +
-          cpi->tok_count[tile_row][tile_col];
 
       if (tile_col < tile_cols - 1 || tile_row < tile_rows - 1)
         vp9_start_encode(&residual_bc, data_ptr + total_size + 4);
       else
         vp9_start_encode(&residual_bc, data_ptr + total_size);
 
-      write_modes(cpi, &cpi->tile_data[tile_idx].tile_info,
-                  &residual_bc, &tok, tok_end);
-      assert(tok == tok_end);
+      write_modes(cpi, xd, &cpi->tile_data[tile_idx].tile_info,
+                  &residual_bc, cpi->tplist[tile_row][tile_col],
+                  &cpi->max_mv_magnitude, cpi->interp_filter_selected[0]);
       vp9_stop_encode(&residual_bc);
       if (tile_col < tile_cols - 1 || tile_row < tile_rows - 1) {
         // size of this tile
@@ -17,9 +17,27 @@ extern "C" {
 #endif
 
 #include "vp9/encoder/vp9_encoder.h"
+#include "vp9/encoder/vp9_writer.h"
+
+// State of a worker thread packing one tile into its own scratch buffer.
+typedef struct VP9BitstreamWorkerData {
+  uint8_t *dest;
+  size_t dest_size;
+  // The tile's above partition context as it was before packing, restored
+  // when the tile overflows dest and has to be packed again.
+  PARTITION_CONTEXT *above_seg_context;
+  int above_seg_context_size;
+  vp9_writer bit_writer;
+  int tile_idx;
+  unsigned int max_mv_magnitude;
+  int interp_filter_selected[SWITCHABLE];
+  MACROBLOCKD xd;
+} VP9BitstreamWorkerData;
 
 void vp9_pack_bitstream(VP9_COMP *cpi, uint8_t *dest, size_t *size);
 
+void vp9_bitstream_encode_tiles_buffer_dealloc(VP9_COMP *cpi);
+
 static INLINE int vp9_preserve_existing_gf(VP9_COMP *cpi) {
   return !cpi->multi_arf_allowed && cpi->refresh_golden_frame &&
          cpi->rc.is_src_frame_alt_ref &&
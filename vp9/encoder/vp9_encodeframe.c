@@ -2790,6 +2790,7 @@ static void rd_pick_partition(VP9_COMP *cpi, ThreadData *td,
 static void encode_rd_sb_row(VP9_COMP *cpi,
                              ThreadData *td,
                              TileDataEnc *tile_data,
+                             VP9RowMTSync *const row_mt_sync,
                              int mi_row,
                              TOKENEXTRA **tp) {
   VP9_COMMON *const cm = &cpi->common;
@@ -2797,6 +2798,10 @@ static void encode_rd_sb_row(VP9_COMP *cpi,
   MACROBLOCK *const x = &td->mb;
   MACROBLOCKD *const xd = &x->e_mbd;
   SPEED_FEATURES *const sf = &cpi->sf;
+  const int sb_row = mi_row >> MI_BLOCK_SIZE_LOG2;
+  const int sb_cols = mi_cols_aligned_to_sb(tile_info->mi_col_end -
+                                            tile_info->mi_col_start) >>
+                      MI_BLOCK_SIZE_LOG2;
   int mi_col;
 
   // Initialize the left context for the new SB row
@@ -2807,6 +2812,7 @@ static void encode_rd_sb_row(VP9_COMP *cpi,
   for (mi_col = tile_info->mi_col_start; mi_col < tile_info->mi_col_end;
        mi_col += MI_BLOCK_SIZE) {
     const struct segmentation *const seg = &cm->seg;
+    const int sb_col = (mi_col - tile_info->mi_col_start) >> MI_BLOCK_SIZE_LOG2;
     int dummy_rate;
     int64_t dummy_dist;
     RD_COST dummy_rdc;
@@ -2816,6 +2822,8 @@ static void encode_rd_sb_row(VP9_COMP *cpi,
     const int idx_str = cm->mi_stride * mi_row + mi_col;
     MODE_INFO **mi = cm->mi_grid_visible + idx_str;
 
+    cpi->row_mt_sync_read_ptr(row_mt_sync, sb_row, sb_col);
+
     if (sf->adaptive_pred_interp_filter) {
       for (i = 0; i < 64; ++i)
         td->leaf_tree[i].pred_interp_filter = SWITCHABLE;
@@ -2869,6 +2877,8 @@ static void encode_rd_sb_row(VP9_COMP *cpi,
       rd_pick_partition(cpi, td, tile_data, tp, mi_row, mi_col, BLOCK_64X64,
                         &dummy_rdc, INT64_MAX, td->pc_root);
     }
+
+    cpi->row_mt_sync_write_ptr(row_mt_sync, sb_row, sb_col, sb_cols);
   }
 }
 
@@ -3552,6 +3562,7 @@ static void nonrd_use_partition(VP9_COMP *cpi,
 static void encode_nonrd_sb_row(VP9_COMP *cpi,
                                 ThreadData *td,
                                 TileDataEnc *tile_data,
+                                VP9RowMTSync *const row_mt_sync,
                                 int mi_row,
                                 TOKENEXTRA **tp) {
   SPEED_FEATURES *const sf = &cpi->sf;
@@ -3559,6 +3570,10 @@ static void encode_nonrd_sb_row(VP9_COMP *cpi,
   TileInfo *const tile_info = &tile_data->tile_info;
   MACROBLOCK *const x = &td->mb;
   MACROBLOCKD *const xd = &x->e_mbd;
+  const int sb_row = mi_row >> MI_BLOCK_SIZE_LOG2;
+  const int sb_cols = mi_cols_aligned_to_sb(tile_info->mi_col_end -
+                                            tile_info->mi_col_start) >>
+                      MI_BLOCK_SIZE_LOG2;
   int mi_col;
 
   // Initialize the left context for the new SB row
@@ -3569,12 +3584,16 @@ static void encode_nonrd_sb_row(VP9_COMP *cpi,
   for (mi_col = tile_info->mi_col_start; mi_col < tile_info->mi_col_end;
        mi_col += MI_BLOCK_SIZE) {
     const struct segmentation *const seg = &cm->seg;
+    const int sb_col = (mi_col - tile_info->mi_col_start) >> MI_BLOCK_SIZE_LOG2;
     RD_COST dummy_rdc;
     const int idx_str = cm->mi_stride * mi_row + mi_col;
     MODE_INFO **mi = cm->mi_grid_visible + idx_str;
     PARTITION_SEARCH_TYPE partition_search_type = sf->partition_search_type;
     BLOCK_SIZE bsize = BLOCK_64X64;
     int seg_skip = 0;
+
+    cpi->row_mt_sync_read_ptr(row_mt_sync, sb_row, sb_col);
+
     x->source_variance = UINT_MAX;
     vp9_zero(x->pred_mv);
     vp9_rd_cost_init(&dummy_rdc);
@@ -3634,6 +3653,8 @@ static void encode_nonrd_sb_row(VP9_COMP *cpi,
         assert(0);
         break;
     }
+
+    cpi->row_mt_sync_write_ptr(row_mt_sync, sb_row, sb_col, sb_cols);
   }
 }
 // end RTC play code
@@ -3770,7 +3791,9 @@ void vp9_init_tile_data(VP9_COMP *cpi) {
   const int tile_rows = 1 << cm->log2_tile_rows;
   int tile_col, tile_row;
   TOKENEXTRA *pre_tok = cpi->tile_tok[0][0];
+  TOKENLIST *tplist = cpi->tplist[0][0];
   int tile_tok = 0;
+  int tplist_count = 0;
 
   if (cpi->tile_data == NULL) {
     CHECK_MEM_ERROR(cm, cpi->tile_data,
@@ -3798,10 +3821,43 @@ void vp9_init_tile_data(VP9_COMP *cpi) {
       cpi->tile_tok[tile_row][tile_col] = pre_tok + tile_tok;
       pre_tok = cpi->tile_tok[tile_row][tile_col];
       tile_tok = allocated_tokens(*tile_info);
+
+      cpi->tplist[tile_row][tile_col] = tplist + tplist_count;
+      tplist = cpi->tplist[tile_row][tile_col];
+      tplist_count = mi_cols_aligned_to_sb(tile_info->mi_row_end -
+                                           tile_info->mi_row_start) >>
+                     MI_BLOCK_SIZE_LOG2;
     }
   }
 }
 
+void vp9_encode_sb_row(VP9_COMP *cpi, ThreadData *td,
+                       TileDataEnc *tile_data, int tile_row, int tile_col,
+                       int mi_row) {
+  const TileInfo *const tile_info = &tile_data->tile_info;
+  const int tile_mb_cols = (tile_info->mi_col_end -
+                            tile_info->mi_col_start + 1) >> 1;
+  const int sb_row_in_tile =
+      (mi_row - tile_info->mi_row_start) >> MI_BLOCK_SIZE_LOG2;
+  // Every superblock row owns a fixed slice of the tile's token buffer, so
+  // that rows can be tokenized in any order.
+  TOKENEXTRA *tok = cpi->tile_tok[tile_row][tile_col] +
+      get_token_alloc((mi_row - tile_info->mi_row_start) >> 1, tile_mb_cols);
+  TOKENLIST *const tplist = &cpi->tplist[tile_row][tile_col][sb_row_in_tile];
+  VP9RowMTSync *const row_mt_sync = &cpi->row_mt_sync[tile_col];
+
+  tplist->start = tok;
+  if (cpi->sf.use_nonrd_pick_mode)
+    encode_nonrd_sb_row(cpi, td, tile_data, row_mt_sync, mi_row, &tok);
+  else
+    encode_rd_sb_row(cpi, td, tile_data, row_mt_sync, mi_row, &tok);
+  tplist->stop = tok;
+
+  assert(tok - tplist->start <=
+      get_token_alloc((MIN(mi_row + MI_BLOCK_SIZE, tile_info->mi_row_end) -
+                       mi_row + 1) >> 1, tile_mb_cols));
+}
+
 void vp9_encode_tile(VP9_COMP *cpi, ThreadData *td,
                      int tile_row, int tile_col) {
   VP9_COMMON *const cm = &cpi->common;
@@ -3809,20 +3865,11 @@ void vp9_encode_tile(VP9_COMP *cpi, ThreadData *td,
   TileDataEnc *this_tile =
       &cpi->tile_data[tile_row * tile_cols + tile_col];
   const TileInfo * const tile_info = &this_tile->tile_info;
-  TOKENEXTRA *tok = cpi->tile_tok[tile_row][tile_col];
   int mi_row;
 
   for (mi_row = tile_info->mi_row_start; mi_row < tile_info->mi_row_end;
-       mi_row += MI_BLOCK_SIZE) {
-    if (cpi->sf.use_nonrd_pick_mode)
-      encode_nonrd_sb_row(cpi, td, this_tile, mi_row, &tok);
-    else
-      encode_rd_sb_row(cpi, td, this_tile, mi_row, &tok);
-  }
-  cpi->tok_count[tile_row][tile_col] =
-      (unsigned int)(tok - cpi->tile_tok[tile_row][tile_col]);
-  assert(tok - cpi->tile_tok[tile_row][tile_col] <=
-      allocated_tokens(*tile_info));
+       mi_row += MI_BLOCK_SIZE)
+    vp9_encode_sb_row(cpi, td, this_tile, tile_row, tile_col, mi_row);
 }
 
 static void encode_tiles(VP9_COMP *cpi) {
@@ -3945,8 +3992,11 @@ static void encode_frame_internal(VP9_COMP *cpi) {
   }
 #endif
 
-    // If allowed, encoding tiles in parallel with one thread handling one tile.
-    if (MIN(cpi->oxcf.max_threads, 1 << cm->log2_tile_cols) > 1)
+    // If allowed, encoding tiles in parallel with one thread handling one tile,
+    // or superblock rows in parallel when row based multi-threading is on.
+    if (cpi->oxcf.row_mt)
+      vp9_encode_tiles_row_mt(cpi);
+    else if (MIN(cpi->oxcf.max_threads, 1 << cm->log2_tile_cols) > 1)
       vp9_encode_tiles_mt(cpi);
     else
       encode_tiles(cpi);
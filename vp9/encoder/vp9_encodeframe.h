@@ -22,6 +22,7 @@ struct macroblock;
 struct yv12_buffer_config;
 struct VP9_COMP;
 struct ThreadData;
+struct TileDataEnc;
 
 // Constants used in SOURCE_VAR_BASED_PARTITION
 #define VAR_HIST_MAX_BG_VAR 1000
@@ -39,6 +40,9 @@ void vp9_encode_frame(struct VP9_COMP *cpi);
 void vp9_init_tile_data(struct VP9_COMP *cpi);
 void vp9_encode_tile(struct VP9_COMP *cpi, struct ThreadData *td,
                      int tile_row, int tile_col);
+void vp9_encode_sb_row(struct VP9_COMP *cpi, struct ThreadData *td,
+                       struct TileDataEnc *tile_data, int tile_row,
+                       int tile_col, int mi_row);
 
 void vp9_set_variance_partition_thresholds(struct VP9_COMP *cpi, int q);
 
@@ -201,7 +201,8 @@ void vp9_write_nmv_probs(VP9_COMMON *cm, int usehp, vp9_writer *w,
 
 void vp9_encode_mv(VP9_COMP* cpi, vp9_writer* w,
                    const MV* mv, const MV* ref,
-                   const nmv_context* mvctx, int usehp) {
+                   const nmv_context* mvctx, int usehp,
+                   unsigned int *const max_mv_magnitude) {
   const MV diff = {mv->row - ref->row,
                    mv->col - ref->col};
   const MV_JOINT_TYPE j = vp9_get_mv_joint(&diff);
@@ -218,7 +219,7 @@ void vp9_encode_mv(VP9_COMP* cpi, vp9_writer* w,
   // motion vector component used.
   if (cpi->sf.mv.auto_mv_step_size) {
     unsigned int maxv = MAX(abs(mv->row), abs(mv->col)) >> 3;
-    cpi->max_mv_magnitude = MAX(maxv, cpi->max_mv_magnitude);
+    *max_mv_magnitude = MAX(maxv, *max_mv_magnitude);
   }
 }
 
@@ -23,8 +23,11 @@ void vp9_entropy_mv_init(void);
 void vp9_write_nmv_probs(VP9_COMMON *cm, int usehp, vp9_writer *w,
                          nmv_context_counts *const counts);
 
+// When auto_mv_step_size is on, the largest motion vector component written
+// is tracked in *max_mv_magnitude.
 void vp9_encode_mv(VP9_COMP *cpi, vp9_writer* w, const MV* mv, const MV* ref,
-                   const nmv_context* mvctx, int usehp);
+                   const nmv_context* mvctx, int usehp,
+                   unsigned int *const max_mv_magnitude);
 
 void vp9_build_nmv_cost_table(int *mvjoint, int *mvcost[2],
                               const nmv_context* mvctx, int usehp);
@@ -380,11 +380,19 @@ static void dealloc_compressor_data(VP9_COMP *cpi) {
   vp9_free_frame_buffer(&cpi->scaled_source);
   vp9_free_frame_buffer(&cpi->scaled_last_source);
   vp9_free_frame_buffer(&cpi->alt_ref_buffer);
+
+  vp9_free_search_pyramid(&cpi->src_pyramid);
+  for (i = 0; i < FRAME_BUFFERS; ++i)
+    vp9_free_search_pyramid(&cpi->ref_pyramid[i]);
+
   vp9_lookahead_destroy(cpi->lookahead);
 
   vpx_free(cpi->tile_tok[0][0]);
   cpi->tile_tok[0][0] = 0;
 
+  vpx_free(cpi->tplist[0][0]);
+  cpi->tplist[0][0] = NULL;
+
   vp9_free_pc_tree(&cpi->td);
 
   for (i = 0; i < cpi->svc.number_spatial_layers; ++i) {
@@ -616,7 +624,9 @@ static void alloc_raw_frame_buffers(VP9_COMP *cpi) {
 #if CONFIG_VP9_HIGHBITDEPTH
                                       cm->use_highbitdepth,
 #endif
-                                      oxcf->lag_in_frames);
+                                      oxcf->lag_in_frames,
+                                      oxcf->max_threads > 1 &&
+                                          oxcf->lag_in_frames > 0);
   if (!cpi->lookahead)
     vpx_internal_error(&cm->error, VPX_CODEC_MEM_ERROR,
                        "Failed to allocate lag buffers");
@@ -683,6 +693,15 @@ void vp9_alloc_compressor_data(VP9_COMP *cpi) {
         vpx_calloc(tokens, sizeof(*cpi->tile_tok[0][0])));
   }
 
+  vpx_free(cpi->tplist[0][0]);
+
+  {
+    const int sb_rows =
+        mi_cols_aligned_to_sb(cm->mi_rows) >> MI_BLOCK_SIZE_LOG2;
+    CHECK_MEM_ERROR(cm, cpi->tplist[0][0],
+        vpx_calloc(sb_rows * (1 << 6), sizeof(*cpi->tplist[0][0])));
+  }
+
   vp9_setup_pc_tree(&cpi->common, &cpi->td);
 }
 
@@ -1596,6 +1615,9 @@ VP9_COMP *vp9_create_compressor(VP9EncoderConfig *oxcf,
   cpi->use_svc = 0;
   cpi->common.buffer_pool = pool;
 
+  cpi->row_mt_sync_read_ptr = vp9_row_mt_sync_read_dummy;
+  cpi->row_mt_sync_write_ptr = vp9_row_mt_sync_write_dummy;
+
   init_config(cpi, oxcf);
   vp9_rc_init(&cpi->oxcf, oxcf->pass, &cpi->rc);
 
@@ -2007,6 +2029,18 @@ void vp9_remove_compressor(VP9_COMP *cpi) {
   if (cpi->num_workers > 1)
     vp9_loop_filter_dealloc(&cpi->lf_row_sync);
 
+  for (t = 0; t < (int)(sizeof(cpi->row_mt_sync) /
+                        sizeof(cpi->row_mt_sync[0])); ++t)
+    vp9_row_mt_sync_mem_dealloc(&cpi->row_mt_sync[t]);
+  vpx_free(cpi->row_tile_data);
+  vpx_free(cpi->fp_row_data);
+  vpx_free(cpi->lpf_band_sse);
+  vpx_free(cpi->frame_band_sse);
+#if CONFIG_INTERNAL_STATS
+  vpx_free(cpi->metrics_job_result);
+#endif
+  vp9_bitstream_encode_tiles_buffer_dealloc(cpi);
+
   dealloc_compressor_data(cpi);
 
   for (i = 0; i < sizeof(cpi->mbgraph_stats) /
@@ -2054,47 +2088,6 @@ void vp9_remove_compressor(VP9_COMP *cpi) {
 #endif
 }
 
-static int64_t get_sse(const uint8_t *a, int a_stride,
-                       const uint8_t *b, int b_stride,
-                       int width, int height) {
-  const int dw = width % 16;
-  const int dh = height % 16;
-  int64_t total_sse = 0;
-  unsigned int sse = 0;
-  int sum = 0;
-  int x, y;
-
-  if (dw > 0) {
-    variance(&a[width - dw], a_stride, &b[width - dw], b_stride,
-             dw, height, &sse, &sum);
-    total_sse += sse;
-  }
-
-  if (dh > 0) {
-    variance(&a[(height - dh) * a_stride], a_stride,
-             &b[(height - dh) * b_stride], b_stride,
-             width - dw, dh, &sse, &sum);
-    total_sse += sse;
-  }
-
-  for (y = 0; y < height / 16; ++y) {
-    const uint8_t *pa = a;
-    const uint8_t *pb = b;
-    for (x = 0; x < width / 16; ++x) {
-      vpx_mse16x16(pa, a_stride, pb, b_stride, &sse);
-      total_sse += sse;
-
-      pa += 16;
-      pb += 16;
-    }
-
-    a += 16 * a_stride;
-    b += 16 * b_stride;
-  }
-
-  return total_sse;
-}
-
 #if CONFIG_VP9_HIGHBITDEPTH
 static int64_t highbd_get_sse_shift(const uint8_t *a8, int a_stride,
                                     const uint8_t *b8, int b_stride,
@@ -2115,42 +2108,51 @@ static int64_t highbd_get_sse_shift(const uint8_t *a8, int a_stride,
   }
   return total_sse;
 }
+#endif  // CONFIG_VP9_HIGHBITDEPTH
 
-static int64_t highbd_get_sse(const uint8_t *a, int a_stride,
-                              const uint8_t *b, int b_stride,
-                              int width, int height) {
-  int64_t total_sse = 0;
-  int x, y;
-  const int dw = width % 16;
-  const int dh = height % 16;
-  unsigned int sse = 0;
-  int sum = 0;
-  if (dw > 0) {
-    highbd_8_variance(&a[width - dw], a_stride, &b[width - dw], b_stride,
-                      dw, height, &sse, &sum);
-    total_sse += sse;
-  }
-  if (dh > 0) {
-    highbd_8_variance(&a[(height - dh) * a_stride], a_stride,
-                      &b[(height - dh) * b_stride], b_stride,
-                      width - dw, dh, &sse, &sum);
-    total_sse += sse;
-  }
-  for (y = 0; y < height / 16; ++y) {
-    const uint8_t *pa = a;
-    const uint8_t *pb = b;
-    for (x = 0; x < width / 16; ++x) {
-      vpx_highbd_8_mse16x16(pa, a_stride, pb, b_stride, &sse);
-      total_sse += sse;
-      pa += 16;
-      pb += 16;
+void vp9_get_frame_sse_rows(const YV12_BUFFER_CONFIG *a,
+                            const YV12_BUFFER_CONFIG *b,
+                            int row, int rows, unsigned int input_shift,
+                            uint64_t *sse) {
+  const int uv_row = row >> a->subsampling_y;
+  const int uv_rows = row + rows >= a->y_crop_height ?
+      a->uv_crop_height - uv_row : rows >> a->subsampling_y;
+  const int widths[3] = {
+      a->y_crop_width, a->uv_crop_width, a->uv_crop_width};
+  const int heights[3] = {rows, uv_rows, uv_rows};
+  const uint8_t *a_planes[3] = {
+      a->y_buffer + row * a->y_stride,
+      a->u_buffer + uv_row * a->uv_stride,
+      a->v_buffer + uv_row * a->uv_stride};
+  const int a_strides[3] = {a->y_stride, a->uv_stride, a->uv_stride};
+  const uint8_t *b_planes[3] = {
+      b->y_buffer + row * b->y_stride,
+      b->u_buffer + uv_row * b->uv_stride,
+      b->v_buffer + uv_row * b->uv_stride};
+  const int b_strides[3] = {b->y_stride, b->uv_stride, b->uv_stride};
+  int i;
+
+  for (i = 0; i < 3; ++i) {
+#if CONFIG_VP9_HIGHBITDEPTH
+    if (a->flags & YV12_FLAG_HIGHBITDEPTH) {
+      if (input_shift) {
+        sse[i] = highbd_get_sse_shift(a_planes[i], a_strides[i],
+                                      b_planes[i], b_strides[i],
+                                      widths[i], heights[i], input_shift);
+      } else {
+        sse[i] = vpx_highbd_sse(a_planes[i], a_strides[i],
+                                b_planes[i], b_strides[i],
+                                widths[i], heights[i]);
+      }
+      continue;
     }
-    a += 16 * a_stride;
-    b += 16 * b_stride;
+#else
+    (void)input_shift;
+#endif  // CONFIG_VP9_HIGHBITDEPTH
+    sse[i] = vpx_sse(a_planes[i], a_strides[i], b_planes[i], b_strides[i],
+                     widths[i], heights[i]);
   }
-  return total_sse;
 }
-#endif  // CONFIG_VP9_HIGHBITDEPTH
 
 typedef struct {
   double psnr[4];       // total/y/u/v
@@ -2158,33 +2160,32 @@ typedef struct {
   uint32_t samples[4];  // total/y/u/v
 } PSNR_STATS;
 
-static void calc_psnr(const YV12_BUFFER_CONFIG *a, const YV12_BUFFER_CONFIG *b,
-                      PSNR_STATS *psnr) {
-  static const double peak = 255.0;
-  const int widths[3]        = {
+// Measure the error of each plane, with bands of rows spread over the worker
+// threads when there are any.
+static void calc_psnr_stats(VP9_COMP *cpi, const YV12_BUFFER_CONFIG *a,
+                            const YV12_BUFFER_CONFIG *b, double peak,
+                            unsigned int input_shift, PSNR_STATS *psnr) {
+  const int widths[3] = {
       a->y_crop_width, a->uv_crop_width, a->uv_crop_width};
-  const int heights[3]       = {
+  const int heights[3] = {
       a->y_crop_height, a->uv_crop_height, a->uv_crop_height};
-  const uint8_t *a_planes[3] = {a->y_buffer, a->u_buffer, a->v_buffer};
-  const int a_strides[3]     = {a->y_stride, a->uv_stride, a->uv_stride};
-  const uint8_t *b_planes[3] = {b->y_buffer, b->u_buffer, b->v_buffer};
-  const int b_strides[3]     = {b->y_stride, b->uv_stride, b->uv_stride};
+  uint64_t sse[3];
   int i;
   uint64_t total_sse = 0;
   uint32_t total_samples = 0;
 
+  if (cpi->num_workers > 1)
+    vp9_frame_sse_mt(cpi, a, b, input_shift, sse);
+  else
+    vp9_get_frame_sse_rows(a, b, 0, a->y_crop_height, input_shift, sse);
+
   for (i = 0; i < 3; ++i) {
-    const int w = widths[i];
-    const int h = heights[i];
-    const uint32_t samples = w * h;
-    const uint64_t sse = get_sse(a_planes[i], a_strides[i],
-                                 b_planes[i], b_strides[i],
-                                 w, h);
-    psnr->sse[1 + i] = sse;
+    const uint32_t samples = widths[i] * heights[i];
+    psnr->sse[1 + i] = sse[i];
     psnr->samples[1 + i] = samples;
-    psnr->psnr[1 + i] = vpx_sse_to_psnr(samples, peak, (double)sse);
+    psnr->psnr[1 + i] = vpx_sse_to_psnr(samples, peak, (double)sse[i]);
 
-    total_sse += sse;
+    total_sse += sse[i];
     total_samples += samples;
   }
 
@@ -2194,75 +2195,26 @@ static void calc_psnr(const YV12_BUFFER_CONFIG *a, const YV12_BUFFER_CONFIG *b,
                                   (double)total_sse);
 }
 
+static void calc_psnr(VP9_COMP *cpi, const YV12_BUFFER_CONFIG *a,
+                      const YV12_BUFFER_CONFIG *b, PSNR_STATS *psnr) {
 #if CONFIG_VP9_HIGHBITDEPTH
-static void calc_highbd_psnr(const YV12_BUFFER_CONFIG *a,
-                             const YV12_BUFFER_CONFIG *b,
-                             PSNR_STATS *psnr,
-                             unsigned int bit_depth,
-                             unsigned int in_bit_depth) {
-  const int widths[3] =
-      {a->y_crop_width,  a->uv_crop_width,  a->uv_crop_width };
-  const int heights[3] =
-      {a->y_crop_height, a->uv_crop_height, a->uv_crop_height};
-  const uint8_t *a_planes[3] = {a->y_buffer, a->u_buffer,  a->v_buffer };
-  const int a_strides[3] = {a->y_stride, a->uv_stride, a->uv_stride};
-  const uint8_t *b_planes[3] = {b->y_buffer, b->u_buffer,  b->v_buffer };
-  const int b_strides[3] = {b->y_stride, b->uv_stride, b->uv_stride};
-  int i;
-  uint64_t total_sse = 0;
-  uint32_t total_samples = 0;
-  const double peak = (double)((1 << in_bit_depth) - 1);
-  const unsigned int input_shift = bit_depth - in_bit_depth;
-
-  for (i = 0; i < 3; ++i) {
-    const int w = widths[i];
-    const int h = heights[i];
-    const uint32_t samples = w * h;
-    uint64_t sse;
-    if (a->flags & YV12_FLAG_HIGHBITDEPTH) {
-      if (input_shift) {
-        sse = highbd_get_sse_shift(a_planes[i], a_strides[i],
-                                   b_planes[i], b_strides[i], w, h,
-                                   input_shift);
-      } else {
-        sse = highbd_get_sse(a_planes[i], a_strides[i],
-                             b_planes[i], b_strides[i], w, h);
-      }
-    } else {
-      sse = get_sse(a_planes[i], a_strides[i],
-                    b_planes[i], b_strides[i],
-                    w, h);
-    }
-    psnr->sse[1 + i] = sse;
-    psnr->samples[1 + i] = samples;
-    psnr->psnr[1 + i] = vpx_sse_to_psnr(samples, peak, (double)sse);
-
-    total_sse += sse;
-    total_samples += samples;
-  }
-
-  psnr->sse[0] = total_sse;
-  psnr->samples[0] = total_samples;
-  psnr->psnr[0] = vpx_sse_to_psnr((double)total_samples, peak,
-                                  (double)total_sse);
-}
+  const unsigned int bit_depth = cpi->td.mb.e_mbd.bd;
+  const unsigned int in_bit_depth = cpi->oxcf.input_bit_depth;
+  calc_psnr_stats(cpi, a, b, (double)((1 << in_bit_depth) - 1),
+                  bit_depth - in_bit_depth, psnr);
+#else
+  calc_psnr_stats(cpi, a, b, 255.0, 0, psnr);
 #endif  // CONFIG_VP9_HIGHBITDEPTH
+}
 
-static void generate_psnr_packet(VP9_COMP *cpi) {
+static void generate_psnr_packet(VP9_COMP *cpi, const PSNR_STATS *psnr) {
   struct vpx_codec_cx_pkt pkt;
   int i;
-  PSNR_STATS psnr;
-#if CONFIG_VP9_HIGHBITDEPTH
-  calc_highbd_psnr(cpi->Source, cpi->common.frame_to_show, &psnr,
-                   cpi->td.mb.e_mbd.bd, cpi->oxcf.input_bit_depth);
-#else
-  calc_psnr(cpi->Source, cpi->common.frame_to_show, &psnr);
-#endif
 
   for (i = 0; i < 4; ++i) {
-    pkt.data.psnr.samples[i] = psnr.samples[i];
-    pkt.data.psnr.sse[i] = psnr.sse[i];
-    pkt.data.psnr.psnr[i] = psnr.psnr[i];
+    pkt.data.psnr.samples[i] = psnr->samples[i];
+    pkt.data.psnr.sse[i] = psnr->sse[i];
+    pkt.data.psnr.psnr[i] = psnr->psnr[i];
   }
   pkt.kind = VPX_CODEC_PSNR_PKT;
   if (is_two_pass_svc(cpi))
@@ -2271,6 +2223,36 @@ static void generate_psnr_packet(VP9_COMP *cpi) {
     vpx_codec_pkt_list_add(cpi->output_pkt_list, &pkt);
 }
 
+#if CONFIG_INTERNAL_STATS
+// Measure the quality metrics of a shown frame, see vp9_frame_metrics_mt().
+static void calc_frame_metrics(VP9_COMP *cpi, const YV12_BUFFER_CONFIG *orig,
+                               const YV12_BUFFER_CONFIG *recon,
+                               const YV12_BUFFER_CONFIG *pp, int calc_ssim,
+                               FrameMetrics *metrics) {
+  const unsigned int bd = cpi->common.bit_depth;
+  int plane;
+
+  if (cpi->num_workers > 1) {
+    vp9_frame_metrics_mt(cpi, orig, recon, pp, calc_ssim, metrics);
+    return;
+  }
+
+  for (plane = 0; plane < 3; ++plane) {
+    if (calc_ssim)
+      metrics->ssim[plane] = vp9_ssim_plane(orig, recon, plane, bd);
+    if (pp != NULL)
+      metrics->ssim_pp[plane] = vp9_ssim_plane(orig, pp, plane, bd);
+#if CONFIG_VP9_HIGHBITDEPTH
+    if (orig->flags & YV12_FLAG_HIGHBITDEPTH)
+      continue;
+#endif
+    metrics->fastssim[plane] = vp9_calc_fastssim_plane(orig, recon, plane);
+    metrics->psnrhvs[plane] = vp9_psnrhvs_plane(orig, recon, plane);
+  }
+  vp9_clear_system_state();
+}
+#endif  // CONFIG_INTERNAL_STATS
+
 int vp9_use_as_reference(VP9_COMP *cpi, int ref_frame_flags) {
   if (ref_frame_flags > 7)
     return -1;
@@ -2662,6 +2644,11 @@ static void loopfilter_frame(VP9_COMP *cpi, VP9_COMMON *cm) {
 
     vpx_usec_timer_start(&timer);
 
+    // Filter and evaluate rows in parallel even when the frame was not coded
+    // with tile or row threads.
+    if (cpi->oxcf.max_threads > 1)
+      vp9_create_enc_workers(cpi, cpi->oxcf.max_threads);
+
     vp9_pick_filter_level(cpi->Source, cpi, cpi->sf.lpf_pick);
 
     vpx_usec_timer_mark(&timer);
@@ -2743,6 +2730,9 @@ void vp9_scale_references(VP9_COMP *cpi) {
         scale_and_extend_frame(ref, &new_fb_ptr->buf);
 #endif  // CONFIG_VP9_HIGHBITDEPTH
         cpi->scaled_ref_idx[ref_frame - 1] = new_fb;
+        vp9_invalidate_search_pyramid(&cpi->ref_pyramid[new_fb]);
+        cpi->fb_source_ts[new_fb] =
+            cpi->fb_source_ts[get_ref_frame_buf_idx(cpi, ref_frame)];
 
         alloc_frame_mvs(cm, new_fb);
       } else {
@@ -3047,6 +3037,9 @@ static void encode_without_recode_loop(VP9_COMP *cpi) {
 
   setup_frame(cpi);
 
+  if (frame_is_intra_only(cm) == 0)
+    vp9_setup_search_pyramids(cpi);
+
   suppress_active_map(cpi);
   // Variance adaptive and in frame q adjustment experiments are mutually
   // exclusive.
@@ -3136,6 +3129,7 @@ static void encode_with_recode_loop(VP9_COMP *cpi,
         release_scaled_references(cpi);
       }
       vp9_scale_references(cpi);
+      vp9_setup_search_pyramids(cpi);
     }
 
     vp9_set_quantizer(cm, q);
@@ -3755,7 +3749,9 @@ static void setup_denoiser_buffer(VP9_COMP *cpi) {
 
 int vp9_receive_raw_frame(VP9_COMP *cpi, unsigned int frame_flags,
                           YV12_BUFFER_CONFIG *sd, int64_t time_stamp,
-                          int64_t end_time) {
+                          int64_t end_time,
+                          const vpx_release_input_cb_t *release,
+                          void *img_priv) {
   VP9_COMMON *cm = &cpi->common;
   struct vpx_usec_timer timer;
   int res = 0;
@@ -3773,12 +3769,17 @@ int vp9_receive_raw_frame(VP9_COMP *cpi, unsigned int frame_flags,
 #endif
   vpx_usec_timer_start(&timer);
 
-  if (vp9_lookahead_push(cpi->lookahead, sd, time_stamp, end_time,
+  if (release != NULL) {
+    if (vp9_lookahead_push_external(cpi->lookahead, sd, time_stamp, end_time,
+                                    frame_flags, release, img_priv))
+      res = -1;
+  } else if (vp9_lookahead_push(cpi->lookahead, sd, time_stamp, end_time,
 #if CONFIG_VP9_HIGHBITDEPTH
-                         use_highbitdepth,
+                                use_highbitdepth,
 #endif  // CONFIG_VP9_HIGHBITDEPTH
-                         frame_flags))
+                                frame_flags)) {
     res = -1;
+  }
   vpx_usec_timer_mark(&timer);
   cpi->time_receive_data += vpx_usec_timer_elapsed(&timer);
 
@@ -3918,6 +3919,7 @@ int vp9_get_compressed_data(VP9_COMP *cpi, unsigned int *frame_flags,
   YV12_BUFFER_CONFIG *force_src_buffer = NULL;
   struct lookahead_entry *last_source = NULL;
   struct lookahead_entry *source = NULL;
+  PSNR_STATS psnr;
   int arf_src_index;
   int i;
 
@@ -4031,6 +4033,7 @@ int vp9_get_compressed_data(VP9_COMP *cpi, unsigned int *frame_flags,
   if (source) {
     cpi->un_scaled_source = cpi->Source = force_src_buffer ? force_src_buffer
                                                            : &source->img;
+    cpi->source_entry = source;
 
     cpi->unscaled_last_source = last_source != NULL ? &last_source->img : NULL;
 
@@ -4076,6 +4079,9 @@ int vp9_get_compressed_data(VP9_COMP *cpi, unsigned int *frame_flags,
   if (cm->new_fb_idx == INVALID_IDX)
     return -1;
 
+  vp9_invalidate_search_pyramid(&cpi->ref_pyramid[cm->new_fb_idx]);
+  cpi->fb_source_ts[cm->new_fb_idx] = source->ts_start;
+
   cm->cur_frame = &pool->frame_bufs[cm->new_fb_idx];
 
   if (!cpi->use_svc && cpi->multi_arf_allowed) {
@@ -4154,8 +4160,11 @@ int vp9_get_compressed_data(VP9_COMP *cpi, unsigned int *frame_flags,
   vpx_usec_timer_mark(&cmptimer);
   cpi->time_compress_data += vpx_usec_timer_elapsed(&cmptimer);
 
-  if (cpi->b_calculate_psnr && oxcf->pass != 1 && cm->show_frame)
-    generate_psnr_packet(cpi);
+  // The internal stats below reuse the PSNR of the packet.
+  if (cpi->b_calculate_psnr && oxcf->pass != 1 && cm->show_frame) {
+    calc_psnr(cpi, cpi->Source, cm->frame_to_show, &psnr);
+    generate_psnr_packet(cpi, &psnr);
+  }
 
 #if CONFIG_INTERNAL_STATS
 
@@ -4164,20 +4173,13 @@ int vp9_get_compressed_data(VP9_COMP *cpi, unsigned int *frame_flags,
     cpi->bytes += (int)(*size);
 
     if (cm->show_frame) {
+      YV12_BUFFER_CONFIG *orig = cpi->Source;
+      YV12_BUFFER_CONFIG *recon = cpi->common.frame_to_show;
+      YV12_BUFFER_CONFIG *pp = &cm->post_proc_buffer;
+      FrameMetrics metrics;
       cpi->count++;
 
       if (cpi->b_calculate_psnr) {
-        YV12_BUFFER_CONFIG *orig = cpi->Source;
-        YV12_BUFFER_CONFIG *recon = cpi->common.frame_to_show;
-        YV12_BUFFER_CONFIG *pp = &cm->post_proc_buffer;
-        PSNR_STATS psnr;
-#if CONFIG_VP9_HIGHBITDEPTH
-        calc_highbd_psnr(orig, recon, &psnr, cpi->td.mb.e_mbd.bd,
-                         cpi->oxcf.input_bit_depth);
-#else
-        calc_psnr(orig, recon, &psnr);
-#endif  // CONFIG_VP9_HIGHBITDEPTH
-
         adjust_image_stat(psnr.psnr[1], psnr.psnr[2], psnr.psnr[3],
                           psnr.psnr[0], &cpi->psnr);
         cpi->total_sq_error += psnr.sse[0];
@@ -4205,43 +4207,27 @@ int vp9_get_compressed_data(VP9_COMP *cpi, unsigned int *frame_flags,
 #endif
           vp9_clear_system_state();
 
-#if CONFIG_VP9_HIGHBITDEPTH
-          calc_highbd_psnr(orig, pp, &psnr2, cpi->td.mb.e_mbd.bd,
-                           cpi->oxcf.input_bit_depth);
-#else
-          calc_psnr(orig, pp, &psnr2);
-#endif  // CONFIG_VP9_HIGHBITDEPTH
+          calc_psnr(cpi, orig, pp, &psnr2);
 
           cpi->totalp_sq_error += psnr2.sse[0];
           cpi->totalp_samples += psnr2.samples[0];
           adjust_image_stat(psnr2.psnr[1], psnr2.psnr[2], psnr2.psnr[3],
                             psnr2.psnr[0], &cpi->psnrp);
 
-#if CONFIG_VP9_HIGHBITDEPTH
-          if (cm->use_highbitdepth) {
-            frame_ssim2 = vp9_highbd_calc_ssim(orig, recon, &weight,
-                                               (int)cm->bit_depth);
-          } else {
-            frame_ssim2 = vp9_calc_ssim(orig, recon, &weight);
-          }
-#else
-          frame_ssim2 = vp9_calc_ssim(orig, recon, &weight);
-#endif  // CONFIG_VP9_HIGHBITDEPTH
+          // The ssim, fast ssim and psnr-hvs of the frame are measured
+          // together, so they can share the worker threads.
+          calc_frame_metrics(cpi, orig, recon, pp, 1, &metrics);
+
+          frame_ssim2 = metrics.ssim[0] * .8 +
+                        .1 * (metrics.ssim[1] + metrics.ssim[2]);
+          weight = 1;
 
           cpi->worst_ssim= MIN(cpi->worst_ssim, frame_ssim2);
           cpi->summed_quality += frame_ssim2 * weight;
           cpi->summed_weights += weight;
 
-#if CONFIG_VP9_HIGHBITDEPTH
-          if (cm->use_highbitdepth) {
-            frame_ssim2 = vp9_highbd_calc_ssim(
-                orig, &cm->post_proc_buffer, &weight, (int)cm->bit_depth);
-          } else {
-            frame_ssim2 = vp9_calc_ssim(orig, &cm->post_proc_buffer, &weight);
-          }
-#else
-          frame_ssim2 = vp9_calc_ssim(orig, &cm->post_proc_buffer, &weight);
-#endif  // CONFIG_VP9_HIGHBITDEPTH
+          frame_ssim2 = metrics.ssim_pp[0] * .8 +
+                        .1 * (metrics.ssim_pp[1] + metrics.ssim_pp[2]);
 
           cpi->summedp_quality += frame_ssim2 * weight;
           cpi->summedp_weights += weight;
@@ -4255,6 +4241,9 @@ int vp9_get_compressed_data(VP9_COMP *cpi, unsigned int *frame_flags,
           }
 #endif
         }
+      } else {
+        calc_frame_metrics(cpi, orig, recon, NULL, cpi->b_calculate_ssimg,
+                           &metrics);
       }
       if (cpi->b_calculate_blockiness) {
 #if CONFIG_VP9_HIGHBITDEPTH
@@ -4292,37 +4281,30 @@ int vp9_get_compressed_data(VP9_COMP *cpi, unsigned int *frame_flags,
       }
 
       if (cpi->b_calculate_ssimg) {
-        double y, u, v, frame_all;
-#if CONFIG_VP9_HIGHBITDEPTH
-        if (cm->use_highbitdepth) {
-          frame_all = vp9_highbd_calc_ssimg(cpi->Source, cm->frame_to_show, &y,
-                                            &u, &v, (int)cm->bit_depth);
-        } else {
-          frame_all = vp9_calc_ssimg(cpi->Source, cm->frame_to_show, &y, &u,
-                                     &v);
-        }
-#else
-        frame_all = vp9_calc_ssimg(cpi->Source, cm->frame_to_show, &y, &u, &v);
-#endif  // CONFIG_VP9_HIGHBITDEPTH
-        adjust_image_stat(y, u, v, frame_all, &cpi->ssimg);
+        const double *const ssim = metrics.ssim;
+        adjust_image_stat(ssim[0], ssim[1], ssim[2],
+                          (ssim[0] * 4 + ssim[1] + ssim[2]) / 6, &cpi->ssimg);
       }
 #if CONFIG_VP9_HIGHBITDEPTH
       if (!cm->use_highbitdepth)
 #endif
       {
-        double y, u, v, frame_all;
-        frame_all = vp9_calc_fastssim(cpi->Source, cm->frame_to_show, &y, &u,
-                                      &v);
-        adjust_image_stat(y, u, v, frame_all, &cpi->fastssim);
+        const double *const fastssim = metrics.fastssim;
+        adjust_image_stat(fastssim[0], fastssim[1], fastssim[2],
+                          vp9_fastssim_frame_db(fastssim[0], fastssim[1],
+                                                fastssim[2]),
+                          &cpi->fastssim);
         /* TODO(JBB): add 10/12 bit support */
       }
 #if CONFIG_VP9_HIGHBITDEPTH
       if (!cm->use_highbitdepth)
 #endif
       {
-        double y, u, v, frame_all;
-        frame_all = vp9_psnrhvs(cpi->Source, cm->frame_to_show, &y, &u, &v);
-        adjust_image_stat(y, u, v, frame_all, &cpi->psnrhvs);
+        const double *const psnrhvs = metrics.psnrhvs;
+        adjust_image_stat(psnrhvs[0], psnrhvs[1], psnrhvs[2],
+                          vp9_psnrhvs_frame_db(psnrhvs[0], psnrhvs[1],
+                                               psnrhvs[2]),
+                          &cpi->psnrhvs);
       }
     }
   }
@@ -4445,7 +4427,7 @@ int64_t vp9_get_y_sse(const YV12_BUFFER_CONFIG *a,
   assert(a->y_crop_width == b->y_crop_width);
   assert(a->y_crop_height == b->y_crop_height);
 
-  return get_sse(a->y_buffer, a->y_stride, b->y_buffer, b->y_stride,
+  return vpx_sse(a->y_buffer, a->y_stride, b->y_buffer, b->y_stride,
                  a->y_crop_width, a->y_crop_height);
 }
 
@@ -4457,7 +4439,7 @@ int64_t vp9_highbd_get_y_sse(const YV12_BUFFER_CONFIG *a,
   assert((a->flags & YV12_FLAG_HIGHBITDEPTH) != 0);
   assert((b->flags & YV12_FLAG_HIGHBITDEPTH) != 0);
 
-  return highbd_get_sse(a->y_buffer, a->y_stride, b->y_buffer, b->y_stride,
+  return vpx_highbd_sse(a->y_buffer, a->y_stride, b->y_buffer, b->y_stride,
                         a->y_crop_width, a->y_crop_height);
 }
 #endif  // CONFIG_VP9_HIGHBITDEPTH
@@ -27,10 +27,12 @@
 #include "vp9/encoder/vp9_aq_cyclicrefresh.h"
 #include "vp9/encoder/vp9_context_tree.h"
 #include "vp9/encoder/vp9_encodemb.h"
+#include "vp9/encoder/vp9_ethread.h"
 #include "vp9/encoder/vp9_firstpass.h"
 #include "vp9/encoder/vp9_lookahead.h"
 #include "vp9/encoder/vp9_mbgraph.h"
 #include "vp9/encoder/vp9_mcomp.h"
+#include "vp9/encoder/vp9_pyramid.h"
 #include "vp9/encoder/vp9_quantize.h"
 #include "vp9/encoder/vp9_ratectrl.h"
 #include "vp9/encoder/vp9_rd.h"
@@ -223,6 +225,8 @@ typedef struct VP9EncoderConfig {
   int tile_rows;
 
   int max_threads;
+  // Encode superblock rows in parallel within each tile column.
+  int row_mt;
 
   vpx_fixed_buf_t two_pass_stats_in;
   struct vpx_codec_pkt_list *output_pkt_list;
@@ -287,6 +291,17 @@ typedef struct IMAGE_STAT {
   double worst;
 } ImageStat;
 
+// Parameters of the temporal filter shared by all the rows of the frame.
+typedef struct {
+  YV12_BUFFER_CONFIG *frames[MAX_LAG_BUFFERS];
+  int frame_count;
+  int alt_ref_index;
+  int strength;
+  struct scale_factors sf;
+  // Where to store the motion found for each frame, or NULL.
+  struct lookahead_motion_field *motion_fields[MAX_LAG_BUFFERS];
+} ARNRFilterData;
+
 typedef struct VP9_COMP {
   QUANTS quants;
   ThreadData td;
@@ -296,6 +311,7 @@ typedef struct VP9_COMP {
   VP9EncoderConfig oxcf;
   struct lookahead_ctx    *lookahead;
   struct lookahead_entry  *alt_ref_source;
+  struct lookahead_entry  *source_entry;  // Entry of the frame being coded
 
   YV12_BUFFER_CONFIG *Source;
   YV12_BUFFER_CONFIG *Last_Source;  // NULL for first frame and alt_ref frames
@@ -310,6 +326,13 @@ typedef struct VP9_COMP {
   int partition_search_skippable_frame;
 
   int scaled_ref_idx[MAX_REF_FRAMES];
+  // Downsampled source, and references indexed like the frame buffer pool,
+  // for the coarse-to-fine motion search.
+  SEARCH_PYRAMID src_pyramid;
+  SEARCH_PYRAMID ref_pyramid[FRAME_BUFFERS];
+  // Timestamp of the source frame each frame buffer was coded from, to find
+  // the lookahead motion fields that point into it.
+  int64_t fb_source_ts[FRAME_BUFFERS];
   int lst_fb_idx;
   int gld_fb_idx;
   int alt_fb_idx;
@@ -329,7 +352,7 @@ typedef struct VP9_COMP {
   YV12_BUFFER_CONFIG last_frame_uf;
 
   TOKENEXTRA *tile_tok[4][1 << 6];
-  unsigned int tok_count[4][1 << 6];
+  TOKENLIST *tplist[4][1 << 6];
 
   // Ambient reconstruction err target for force key frames
   int64_t ambient_err;
@@ -491,6 +514,35 @@ typedef struct VP9_COMP {
   VP9Worker *workers;
   struct EncWorkerData *tile_thr_data;
   VP9LfSync lf_row_sync;
+
+  // Row-based multi-threading. The spatially adaptive tile state is kept per
+  // superblock row so that the result does not depend on the thread count.
+  VP9RowMTSync row_mt_sync[1 << 6];
+  TileDataEnc *row_tile_data;
+  int allocated_row_tile_data;
+  // First pass statistics of each macroblock row.
+  FIRSTPASS_DATA *fp_row_data;
+  int allocated_fp_row_data;
+
+  ARNRFilterData arnr_filter_data;
+
+  // Luma error of each 16 row band of a loop filter level candidate.
+  int64_t *lpf_band_sse;
+  int allocated_lpf_band_sse;
+
+  // Per plane SSE of each band of rows, for the threaded PSNR.
+  uint64_t *frame_band_sse;
+  int allocated_frame_band_sse;
+#if CONFIG_INTERNAL_STATS
+  // Result of each job of the threaded quality metrics.
+  double *metrics_job_result;
+  int allocated_metrics_jobs;
+#endif
+  // Scratch state of each worker when the tile columns of a frame are packed
+  // in parallel, see encode_tiles_mt().
+  struct VP9BitstreamWorkerData *bitstream_worker_data;
+  void (*row_mt_sync_read_ptr)(VP9RowMTSync *const, int, int);
+  void (*row_mt_sync_write_ptr)(VP9RowMTSync *const, int, int, const int);
 } VP9_COMP;
 
 void vp9_initialize_enc(void);
@@ -502,10 +554,14 @@ void vp9_remove_compressor(VP9_COMP *cpi);
 void vp9_change_config(VP9_COMP *cpi, const VP9EncoderConfig *oxcf);
 
   // receive a frames worth of data. caller can assume that a copy of this
-  // frame is made and not just a copy of the pointer..
+  // frame is made and not just a copy of the pointer, unless release is
+  // given, in which case the frame is held until release is called with
+  // img_priv.
 int vp9_receive_raw_frame(VP9_COMP *cpi, unsigned int frame_flags,
                           YV12_BUFFER_CONFIG *sd, int64_t time_stamp,
-                          int64_t end_time_stamp);
+                          int64_t end_time_stamp,
+                          const vpx_release_input_cb_t *release,
+                          void *img_priv);
 
 int vp9_get_compressed_data(VP9_COMP *cpi, unsigned int *frame_flags,
                             size_t *size, uint8_t *dest,
@@ -591,6 +647,14 @@ static INLINE int allocated_tokens(TileInfo tile) {
 }
 
 int64_t vp9_get_y_sse(const YV12_BUFFER_CONFIG *a, const YV12_BUFFER_CONFIG *b);
+
+// Store in sse[0..2] the SSE of each plane between a and b over the luma rows
+// [row, row + rows) and the chroma rows they cover. input_shift is applied to
+// high bitdepth samples first.
+void vp9_get_frame_sse_rows(const YV12_BUFFER_CONFIG *a,
+                            const YV12_BUFFER_CONFIG *b,
+                            int row, int rows, unsigned int input_shift,
+                            uint64_t *sse);
 #if CONFIG_VP9_HIGHBITDEPTH
 int64_t vp9_highbd_get_y_sse(const YV12_BUFFER_CONFIG *a,
                              const YV12_BUFFER_CONFIG *b);
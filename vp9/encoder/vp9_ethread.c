@@ -8,9 +8,13 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include "./vpx_scale_rtcd.h"
+
 #include "vp9/encoder/vp9_encodeframe.h"
 #include "vp9/encoder/vp9_encoder.h"
 #include "vp9/encoder/vp9_ethread.h"
+#include "vp9/encoder/vp9_firstpass.h"
+#include "vp9/encoder/vp9_temporal_filter.h"
 
 static void accumulate_rd_opt(ThreadData *td, ThreadData *td_t) {
   int i, j, k, l, m, n;
@@ -54,15 +58,11 @@ static int enc_worker_hook(EncWorkerData *const thread_data, void *unused) {
   return 0;
 }
 
-void vp9_encode_tiles_mt(VP9_COMP *cpi) {
+void vp9_create_enc_workers(VP9_COMP *cpi, int num_workers) {
   VP9_COMMON *const cm = &cpi->common;
-  const int tile_cols = 1 << cm->log2_tile_cols;
   const VP9WorkerInterface *const winterface = vp9_get_worker_interface();
-  const int num_workers = MIN(cpi->oxcf.max_threads, tile_cols);
   int i;
 
-  vp9_init_tile_data(cpi);
-
   // Only run once to create threads and allocate thread data.
   if (cpi->num_workers == 0) {
     CHECK_MEM_ERROR(cm, cpi->workers,
@@ -108,14 +108,21 @@ void vp9_encode_tiles_mt(VP9_COMP *cpi) {
       winterface->sync(worker);
     }
   }
+}
+
+static void launch_enc_workers(VP9_COMP *cpi, VP9WorkerHook hook,
+                               void *data2) {
+  const VP9WorkerInterface *const winterface = vp9_get_worker_interface();
+  const int num_workers = cpi->num_workers;
+  int i;
 
   for (i = 0; i < num_workers; i++) {
     VP9Worker *const worker = &cpi->workers[i];
     EncWorkerData *thread_data;
 
-    worker->hook = (VP9WorkerHook)enc_worker_hook;
+    worker->hook = hook;
     worker->data1 = &cpi->tile_thr_data[i];
-    worker->data2 = NULL;
+    worker->data2 = data2;
     thread_data = (EncWorkerData*)worker->data1;
 
     // Before encoding a frame, copy the thread data from cpi.
@@ -165,15 +172,563 @@ void vp9_encode_tiles_mt(VP9_COMP *cpi) {
     VP9Worker *const worker = &cpi->workers[i];
     winterface->sync(worker);
   }
+}
 
-  for (i = 0; i < num_workers; i++) {
-    VP9Worker *const worker = &cpi->workers[i];
-    EncWorkerData *const thread_data = (EncWorkerData*)worker->data1;
+static void accumulate_enc_workers(VP9_COMP *cpi) {
+  int i;
+
+  for (i = 0; i < cpi->num_workers - 1; i++) {
+    EncWorkerData *const thread_data = &cpi->tile_thr_data[i];
 
     // Accumulate counters.
-    if (i < num_workers - 1) {
-      vp9_accumulate_frame_counts(cm, thread_data->td->counts, 0);
-      accumulate_rd_opt(&cpi->td, thread_data->td);
+    vp9_accumulate_frame_counts(&cpi->common, thread_data->td->counts, 0);
+    accumulate_rd_opt(&cpi->td, thread_data->td);
+  }
+}
+
+void vp9_encode_tiles_mt(VP9_COMP *cpi) {
+  vp9_init_tile_data(cpi);
+
+  // Workers beyond the number of tiles stay idle here, but they are kept for
+  // the stages that split the frame by rows, such as the loop filter search.
+  vp9_create_enc_workers(cpi, cpi->oxcf.max_threads);
+
+  launch_enc_workers(cpi, (VP9WorkerHook)enc_worker_hook, NULL);
+  accumulate_enc_workers(cpi);
+}
+
+void vp9_row_mt_sync_read(VP9RowMTSync *const row_mt_sync, int r, int c) {
+#if CONFIG_MULTITHREAD
+  const int nsync = row_mt_sync->sync_range;
+
+  if (r && !(c & (nsync - 1))) {
+    pthread_mutex_t *const mutex = &row_mt_sync->mutex_[r - 1];
+    mutex_lock(mutex);
+
+    while (c > row_mt_sync->cur_col[r - 1] - nsync) {
+      pthread_cond_wait(&row_mt_sync->cond_[r - 1], mutex);
+    }
+    pthread_mutex_unlock(mutex);
+  }
+#else
+  (void)row_mt_sync;
+  (void)r;
+  (void)c;
+#endif  // CONFIG_MULTITHREAD
+}
+
+void vp9_row_mt_sync_read_dummy(VP9RowMTSync *const row_mt_sync,
+                                int r, int c) {
+  (void)row_mt_sync;
+  (void)r;
+  (void)c;
+}
+
+void vp9_row_mt_sync_write(VP9RowMTSync *const row_mt_sync, int r, int c,
+                           const int cols) {
+#if CONFIG_MULTITHREAD
+  const int nsync = row_mt_sync->sync_range;
+  int cur;
+  // Only signal when there are enough encoded SB for next row to run.
+  int sig = 1;
+
+  if (c < cols - 1) {
+    cur = c;
+    if (c % nsync)
+      sig = 0;
+  } else {
+    cur = cols + nsync;
+  }
+
+  if (sig) {
+    mutex_lock(&row_mt_sync->mutex_[r]);
+
+    row_mt_sync->cur_col[r] = cur;
+
+    pthread_cond_signal(&row_mt_sync->cond_[r]);
+    pthread_mutex_unlock(&row_mt_sync->mutex_[r]);
+  }
+#else
+  (void)row_mt_sync;
+  (void)r;
+  (void)c;
+  (void)cols;
+#endif  // CONFIG_MULTITHREAD
+}
+
+void vp9_row_mt_sync_write_dummy(VP9RowMTSync *const row_mt_sync, int r, int c,
+                                 const int cols) {
+  (void)row_mt_sync;
+  (void)r;
+  (void)c;
+  (void)cols;
+}
+
+// Allocate memory for row synchronization
+void vp9_row_mt_sync_mem_alloc(VP9RowMTSync *row_mt_sync, VP9_COMMON *cm,
+                               int rows) {
+  row_mt_sync->rows = rows;
+#if CONFIG_MULTITHREAD
+  {
+    int i;
+
+    CHECK_MEM_ERROR(cm, row_mt_sync->mutex_,
+                    vpx_malloc(sizeof(*row_mt_sync->mutex_) * rows));
+    if (row_mt_sync->mutex_) {
+      for (i = 0; i < rows; ++i) {
+        pthread_mutex_init(&row_mt_sync->mutex_[i], NULL);
+      }
+    }
+
+    CHECK_MEM_ERROR(cm, row_mt_sync->cond_,
+                    vpx_malloc(sizeof(*row_mt_sync->cond_) * rows));
+    if (row_mt_sync->cond_) {
+      for (i = 0; i < rows; ++i) {
+        pthread_cond_init(&row_mt_sync->cond_[i], NULL);
+      }
+    }
+  }
+#endif  // CONFIG_MULTITHREAD
+
+  CHECK_MEM_ERROR(cm, row_mt_sync->cur_col,
+                  vpx_malloc(sizeof(*row_mt_sync->cur_col) * rows));
+
+  // Encoding a superblock costs far more than filtering it, so unlike the
+  // loop filter the rows are kept as close together as possible.
+  row_mt_sync->sync_range = 1;
+}
+
+// Deallocate row synchronization related mutex and data
+void vp9_row_mt_sync_mem_dealloc(VP9RowMTSync *row_mt_sync) {
+  if (row_mt_sync != NULL) {
+#if CONFIG_MULTITHREAD
+    int i;
+
+    if (row_mt_sync->mutex_ != NULL) {
+      for (i = 0; i < row_mt_sync->rows; ++i) {
+        pthread_mutex_destroy(&row_mt_sync->mutex_[i]);
+      }
+      vpx_free(row_mt_sync->mutex_);
+    }
+    if (row_mt_sync->cond_ != NULL) {
+      for (i = 0; i < row_mt_sync->rows; ++i) {
+        pthread_cond_destroy(&row_mt_sync->cond_[i]);
+      }
+      vpx_free(row_mt_sync->cond_);
+    }
+#endif  // CONFIG_MULTITHREAD
+    vpx_free(row_mt_sync->cur_col);
+    // clear the structure as the source of this call may be a resize in which
+    // case this call will be followed by an _alloc() which may fail.
+    vp9_zero(*row_mt_sync);
+  }
+}
+
+static int get_tile_row(const VP9_COMP *cpi, int mi_row) {
+  const VP9_COMMON *const cm = &cpi->common;
+  const int tile_cols = 1 << cm->log2_tile_cols;
+  const int tile_rows = 1 << cm->log2_tile_rows;
+  int tile_row;
+
+  for (tile_row = 0; tile_row < tile_rows - 1; ++tile_row) {
+    if (mi_row < cpi->tile_data[tile_row * tile_cols].tile_info.mi_row_end)
+      break;
+  }
+  return tile_row;
+}
+
+static int enc_row_mt_worker_hook(EncWorkerData *const thread_data,
+                                  void *unused) {
+  VP9_COMP *const cpi = thread_data->cpi;
+  const VP9_COMMON *const cm = &cpi->common;
+  const int tile_cols = 1 << cm->log2_tile_cols;
+  const int sb_rows = mi_cols_aligned_to_sb(cm->mi_rows) >> MI_BLOCK_SIZE_LOG2;
+  int job;
+
+  (void) unused;
+
+  // Superblock rows are handed out in raster order across the tile columns,
+  // so the row above any row is always owned by a worker that started
+  // earlier, which keeps the wavefront free of deadlocks.
+  for (job = thread_data->start; job < sb_rows * tile_cols;
+       job += cpi->num_workers) {
+    const int sb_row = job / tile_cols;
+    const int tile_col = job % tile_cols;
+    const int mi_row = sb_row << MI_BLOCK_SIZE_LOG2;
+    const int tile_row = get_tile_row(cpi, mi_row);
+
+    vp9_encode_sb_row(cpi, thread_data->td, &cpi->row_tile_data[job],
+                      tile_row, tile_col, mi_row);
+  }
+
+  return 0;
+}
+
+void vp9_encode_tiles_row_mt(VP9_COMP *cpi) {
+  VP9_COMMON *const cm = &cpi->common;
+  const int tile_cols = 1 << cm->log2_tile_cols;
+  const int sb_rows = mi_cols_aligned_to_sb(cm->mi_rows) >> MI_BLOCK_SIZE_LOG2;
+  const int num_jobs = sb_rows * tile_cols;
+  int sb_row, tile_col;
+
+  vp9_init_tile_data(cpi);
+
+  vp9_create_enc_workers(cpi, MAX(cpi->oxcf.max_threads, 1));
+
+  if (cpi->allocated_row_tile_data < num_jobs) {
+    vpx_free(cpi->row_tile_data);
+    cpi->allocated_row_tile_data = 0;
+    CHECK_MEM_ERROR(cm, cpi->row_tile_data,
+                    vpx_malloc(num_jobs * sizeof(*cpi->row_tile_data)));
+    cpi->allocated_row_tile_data = num_jobs;
+  }
+
+  for (tile_col = 0; tile_col < tile_cols; ++tile_col) {
+    VP9RowMTSync *const row_mt_sync = &cpi->row_mt_sync[tile_col];
+
+    if (row_mt_sync->rows != sb_rows) {
+      vp9_row_mt_sync_mem_dealloc(row_mt_sync);
+      vp9_row_mt_sync_mem_alloc(row_mt_sync, cm, sb_rows);
+    }
+
+    // Initialize cur_col to -1 for all SB rows.
+    memset(row_mt_sync->cur_col, -1, sizeof(*row_mt_sync->cur_col) * sb_rows);
+  }
+
+  // Every superblock row starts from the adaptive state its tile had at the
+  // beginning of the frame.
+  for (sb_row = 0; sb_row < sb_rows; ++sb_row) {
+    const int tile_row = get_tile_row(cpi, sb_row << MI_BLOCK_SIZE_LOG2);
+    for (tile_col = 0; tile_col < tile_cols; ++tile_col)
+      cpi->row_tile_data[sb_row * tile_cols + tile_col] =
+          cpi->tile_data[tile_row * tile_cols + tile_col];
+  }
+
+  cpi->row_mt_sync_read_ptr = vp9_row_mt_sync_read;
+  cpi->row_mt_sync_write_ptr = vp9_row_mt_sync_write;
+
+  launch_enc_workers(cpi, (VP9WorkerHook)enc_row_mt_worker_hook, NULL);
+  accumulate_enc_workers(cpi);
+
+  cpi->row_mt_sync_read_ptr = vp9_row_mt_sync_read_dummy;
+  cpi->row_mt_sync_write_ptr = vp9_row_mt_sync_write_dummy;
+
+  // Carry the state of the last superblock row of each tile over to the next
+  // frame.
+  for (sb_row = 0; sb_row < sb_rows; ++sb_row) {
+    const int mi_row = sb_row << MI_BLOCK_SIZE_LOG2;
+    const int tile_row = get_tile_row(cpi, mi_row);
+    for (tile_col = 0; tile_col < tile_cols; ++tile_col) {
+      TileDataEnc *const this_tile =
+          &cpi->tile_data[tile_row * tile_cols + tile_col];
+      if (mi_row + MI_BLOCK_SIZE >= this_tile->tile_info.mi_row_end)
+        *this_tile = cpi->row_tile_data[sb_row * tile_cols + tile_col];
+    }
+  }
+}
+
+static int fp_row_mt_worker_hook(EncWorkerData *const thread_data,
+                                 void *unused) {
+  VP9_COMP *const cpi = thread_data->cpi;
+  const VP9_COMMON *const cm = &cpi->common;
+  int mb_row;
+
+  (void) unused;
+
+  for (mb_row = thread_data->start; mb_row < cm->mb_rows;
+       mb_row += cpi->num_workers)
+    vp9_first_pass_encode_mb_row(cpi, thread_data->td,
+                                 &cpi->fp_row_data[mb_row], mb_row);
+
+  return 0;
+}
+
+void vp9_encode_fp_row_mt(VP9_COMP *cpi) {
+  VP9_COMMON *const cm = &cpi->common;
+  // The first pass does not use tiles, so the synchronization of the first
+  // tile column is borrowed for its macroblock rows.
+  VP9RowMTSync *const row_mt_sync = &cpi->row_mt_sync[0];
+
+  vp9_create_enc_workers(cpi, cpi->oxcf.max_threads);
+
+  if (row_mt_sync->rows != cm->mb_rows) {
+    vp9_row_mt_sync_mem_dealloc(row_mt_sync);
+    vp9_row_mt_sync_mem_alloc(row_mt_sync, cm, cm->mb_rows);
+  }
+  memset(row_mt_sync->cur_col, -1,
+         sizeof(*row_mt_sync->cur_col) * cm->mb_rows);
+
+  cpi->row_mt_sync_read_ptr = vp9_row_mt_sync_read;
+  cpi->row_mt_sync_write_ptr = vp9_row_mt_sync_write;
+
+  launch_enc_workers(cpi, (VP9WorkerHook)fp_row_mt_worker_hook, NULL);
+
+  cpi->row_mt_sync_read_ptr = vp9_row_mt_sync_read_dummy;
+  cpi->row_mt_sync_write_ptr = vp9_row_mt_sync_write_dummy;
+}
+
+static int temporal_filter_worker_hook(EncWorkerData *const thread_data,
+                                       void *unused) {
+  VP9_COMP *const cpi = thread_data->cpi;
+  const ARNRFilterData *const arnr_filter_data = &cpi->arnr_filter_data;
+  const YV12_BUFFER_CONFIG *const f =
+      arnr_filter_data->frames[arnr_filter_data->alt_ref_index];
+  const int mb_rows = (f->y_crop_height + 15) >> 4;
+  int mb_row;
+
+  (void) unused;
+
+  for (mb_row = thread_data->start; mb_row < mb_rows;
+       mb_row += cpi->num_workers)
+    vp9_temporal_filter_iterate_row_c(cpi, thread_data->td, mb_row);
+
+  return 0;
+}
+
+void vp9_temporal_filter_row_mt(VP9_COMP *cpi) {
+  vp9_create_enc_workers(cpi, cpi->oxcf.max_threads);
+
+  launch_enc_workers(cpi, (VP9WorkerHook)temporal_filter_worker_hook, NULL);
+}
+
+typedef struct LpfSseData {
+  const YV12_BUFFER_CONFIG *sd;
+  int64_t *band_sse;
+} LpfSseData;
+
+static int lpf_sse_worker_hook(EncWorkerData *const thread_data,
+                               LpfSseData *const lpf_sse_data) {
+  VP9_COMP *const cpi = thread_data->cpi;
+  const YV12_BUFFER_CONFIG *const sd = lpf_sse_data->sd;
+  int64_t *const band_sse = lpf_sse_data->band_sse;
+  YV12_BUFFER_CONFIG *const frame = cpi->common.frame_to_show;
+  const int bands = (frame->y_height + 15) >> 4;
+  int band;
+
+  for (band = thread_data->start; band < bands; band += cpi->num_workers) {
+    const int row = band << 4;
+    YV12_BUFFER_CONFIG src = *sd;
+    YV12_BUFFER_CONFIG dst = *frame;
+    YV12_BUFFER_CONFIG dst_uf = cpi->last_frame_uf;
+
+    src.y_buffer += row * src.y_stride;
+    dst.y_buffer += row * dst.y_stride;
+    dst_uf.y_buffer += row * dst_uf.y_stride;
+
+    // Measure the error of the visible rows of the band.
+    band_sse[band] = 0;
+    if (row < frame->y_crop_height) {
+      src.y_crop_height = MIN(16, frame->y_crop_height - row);
+      dst.y_crop_height = src.y_crop_height;
+#if CONFIG_VP9_HIGHBITDEPTH
+      if (cpi->common.use_highbitdepth)
+        band_sse[band] = vp9_highbd_get_y_sse(&src, &dst);
+      else
+        band_sse[band] = vp9_get_y_sse(&src, &dst);
+#else
+      band_sse[band] = vp9_get_y_sse(&src, &dst);
+#endif  // CONFIG_VP9_HIGHBITDEPTH
+    }
+
+    // Re-instate the unfiltered rows.
+    dst_uf.y_height = MIN(16, frame->y_height - row);
+    vpx_yv12_copy_y(&dst_uf, &dst);
+  }
+
+  return 0;
+}
+
+int64_t vp9_lpf_sse_mt(VP9_COMP *cpi, const YV12_BUFFER_CONFIG *sd) {
+  VP9_COMMON *const cm = &cpi->common;
+  const int bands = (cm->frame_to_show->y_height + 15) >> 4;
+  LpfSseData lpf_sse_data;
+  int64_t sse = 0;
+  int band;
+
+  if (cpi->allocated_lpf_band_sse < bands) {
+    vpx_free(cpi->lpf_band_sse);
+    cpi->allocated_lpf_band_sse = 0;
+    CHECK_MEM_ERROR(cm, cpi->lpf_band_sse,
+                    vpx_malloc(bands * sizeof(*cpi->lpf_band_sse)));
+    cpi->allocated_lpf_band_sse = bands;
+  }
+
+  lpf_sse_data.sd = sd;
+  lpf_sse_data.band_sse = cpi->lpf_band_sse;
+  launch_enc_workers(cpi, (VP9WorkerHook)lpf_sse_worker_hook, &lpf_sse_data);
+
+  for (band = 0; band < bands; ++band)
+    sse += cpi->lpf_band_sse[band];
+
+  return sse;
+}
+
+typedef struct FrameSseData {
+  const YV12_BUFFER_CONFIG *a;
+  const YV12_BUFFER_CONFIG *b;
+  unsigned int input_shift;
+  uint64_t *band_sse;
+} FrameSseData;
+
+static int frame_sse_worker_hook(EncWorkerData *const thread_data,
+                                 FrameSseData *const frame_sse_data) {
+  VP9_COMP *const cpi = thread_data->cpi;
+  const YV12_BUFFER_CONFIG *const a = frame_sse_data->a;
+  const int bands = (a->y_crop_height + 63) >> 6;
+  int band;
+
+  for (band = thread_data->start; band < bands; band += cpi->num_workers) {
+    const int row = band << 6;
+    vp9_get_frame_sse_rows(a, frame_sse_data->b, row,
+                           MIN(64, a->y_crop_height - row),
+                           frame_sse_data->input_shift,
+                           &frame_sse_data->band_sse[3 * band]);
+  }
+
+  return 0;
+}
+
+void vp9_frame_sse_mt(VP9_COMP *cpi, const YV12_BUFFER_CONFIG *a,
+                      const YV12_BUFFER_CONFIG *b, unsigned int input_shift,
+                      uint64_t *sse) {
+  VP9_COMMON *const cm = &cpi->common;
+  const int bands = (a->y_crop_height + 63) >> 6;
+  FrameSseData frame_sse_data;
+  int band, i;
+
+  if (cpi->allocated_frame_band_sse < bands) {
+    vpx_free(cpi->frame_band_sse);
+    cpi->allocated_frame_band_sse = 0;
+    CHECK_MEM_ERROR(cm, cpi->frame_band_sse,
+                    vpx_malloc(3 * bands * sizeof(*cpi->frame_band_sse)));
+    cpi->allocated_frame_band_sse = bands;
+  }
+
+  frame_sse_data.a = a;
+  frame_sse_data.b = b;
+  frame_sse_data.input_shift = input_shift;
+  frame_sse_data.band_sse = cpi->frame_band_sse;
+  launch_enc_workers(cpi, (VP9WorkerHook)frame_sse_worker_hook,
+                     &frame_sse_data);
+
+  for (i = 0; i < 3; ++i) {
+    sse[i] = 0;
+    for (band = 0; band < bands; ++band)
+      sse[i] += cpi->frame_band_sse[3 * band + i];
+  }
+}
+
+#if CONFIG_INTERNAL_STATS
+// The fast ssim and psnr-hvs planes are the longest jobs, so they come first
+// and are spread over the workers before the ssim bands.
+#define NUM_HVS_JOBS 6
+static const int hvs_job_plane[NUM_HVS_JOBS] = { 0, 0, 1, 2, 1, 2 };
+static const int hvs_job_is_fastssim[NUM_HVS_JOBS] = { 1, 0, 1, 1, 0, 0 };
+
+typedef struct MetricsData {
+  const YV12_BUFFER_CONFIG *orig;
+  const YV12_BUFFER_CONFIG *recon;
+  const YV12_BUFFER_CONFIG *pp;
+  unsigned int bd;
+  int hvs_jobs;
+  // Number of ssim bands of each plane, and of each of recon and pp.
+  int plane_bands[3];
+  int ssim_jobs[2];
+  int num_jobs;
+  double *result;
+} MetricsData;
+
+static double run_metrics_job(const MetricsData *data, int job) {
+  const YV12_BUFFER_CONFIG *dest = data->recon;
+  int plane;
+
+  if (job < data->hvs_jobs) {
+    return hvs_job_is_fastssim[job] ?
+        vp9_calc_fastssim_plane(data->orig, data->recon, hvs_job_plane[job]) :
+        vp9_psnrhvs_plane(data->orig, data->recon, hvs_job_plane[job]);
+  }
+
+  job -= data->hvs_jobs;
+  if (job >= data->ssim_jobs[0]) {
+    job -= data->ssim_jobs[0];
+    dest = data->pp;
+  }
+  for (plane = 0; job >= data->plane_bands[plane]; ++plane)
+    job -= data->plane_bands[plane];
+  return vp9_ssim_plane_band(data->orig, dest, plane, job, data->bd);
+}
+
+static int metrics_worker_hook(EncWorkerData *const thread_data,
+                               MetricsData *const data) {
+  VP9_COMP *const cpi = thread_data->cpi;
+  int job;
+
+  for (job = thread_data->start; job < data->num_jobs;
+       job += cpi->num_workers)
+    data->result[job] = run_metrics_job(data, job);
+
+  return 0;
+}
+
+void vp9_frame_metrics_mt(VP9_COMP *cpi, const YV12_BUFFER_CONFIG *orig,
+                          const YV12_BUFFER_CONFIG *recon,
+                          const YV12_BUFFER_CONFIG *pp, int calc_ssim,
+                          FrameMetrics *metrics) {
+  VP9_COMMON *const cm = &cpi->common;
+  MetricsData data;
+  const double *result;
+  int plane, job;
+
+  memset(&data, 0, sizeof(data));
+  data.orig = orig;
+  data.recon = recon;
+  data.pp = pp;
+  data.bd = cm->bit_depth;
+#if CONFIG_VP9_HIGHBITDEPTH
+  if (!(orig->flags & YV12_FLAG_HIGHBITDEPTH))
+#endif
+    data.hvs_jobs = NUM_HVS_JOBS;
+  for (plane = 0; plane < 3; ++plane) {
+    data.plane_bands[plane] = vp9_ssim_plane_bands(orig, plane);
+    if (calc_ssim)
+      data.ssim_jobs[0] += data.plane_bands[plane];
+    if (pp != NULL)
+      data.ssim_jobs[1] += data.plane_bands[plane];
+  }
+  data.num_jobs = data.hvs_jobs + data.ssim_jobs[0] + data.ssim_jobs[1];
+
+  if (cpi->allocated_metrics_jobs < data.num_jobs) {
+    vpx_free(cpi->metrics_job_result);
+    cpi->allocated_metrics_jobs = 0;
+    CHECK_MEM_ERROR(cm, cpi->metrics_job_result,
+                    vpx_malloc(data.num_jobs *
+                               sizeof(*cpi->metrics_job_result)));
+    cpi->allocated_metrics_jobs = data.num_jobs;
+  }
+  data.result = cpi->metrics_job_result;
+
+  launch_enc_workers(cpi, (VP9WorkerHook)metrics_worker_hook, &data);
+  vp9_clear_system_state();
+
+  result = data.result;
+  for (job = 0; job < data.hvs_jobs; ++job) {
+    if (hvs_job_is_fastssim[job])
+      metrics->fastssim[hvs_job_plane[job]] = result[job];
+    else
+      metrics->psnrhvs[hvs_job_plane[job]] = result[job];
+  }
+  result += data.hvs_jobs;
+  if (calc_ssim) {
+    for (plane = 0; plane < 3; ++plane) {
+      metrics->ssim[plane] = vp9_ssim_plane_mean(orig, plane, result);
+      result += data.plane_bands[plane];
+    }
+  }
+  if (pp != NULL) {
+    for (plane = 0; plane < 3; ++plane) {
+      metrics->ssim_pp[plane] = vp9_ssim_plane_mean(orig, plane, result);
+      result += data.plane_bands[plane];
     }
   }
 }
+#endif  // CONFIG_INTERNAL_STATS
@@ -11,8 +11,13 @@
 #ifndef VP9_ENCODER_VP9_ETHREAD_H_
 #define VP9_ENCODER_VP9_ETHREAD_H_
 
+#include "./vpx_config.h"
+#include "vp9/common/vp9_thread.h"
+
 struct VP9_COMP;
+struct VP9Common;
 struct ThreadData;
+struct yv12_buffer_config;
 
 typedef struct EncWorkerData {
   struct VP9_COMP *cpi;
@@ -20,6 +25,88 @@ typedef struct EncWorkerData {
   int start;
 } EncWorkerData;
 
+// Encoder row synchronization
+typedef struct VP9RowMTSyncData {
+#if CONFIG_MULTITHREAD
+  pthread_mutex_t *mutex_;
+  pthread_cond_t *cond_;
+#endif
+  // Allocate memory to store the encoded superblock index in each row.
+  int *cur_col;
+  // Number of superblocks a row has to be ahead of the row below it before
+  // the row below is signalled.
+  int sync_range;
+  int rows;
+} VP9RowMTSync;
+
+// Create the encoder worker threads and their thread data. The last worker is
+// the calling thread. Only the first call has an effect.
+void vp9_create_enc_workers(struct VP9_COMP *cpi, int num_workers);
+
 void vp9_encode_tiles_mt(struct VP9_COMP *cpi);
 
+// Encode the frame with superblock rows distributed over the worker threads.
+// Rows of the same tile column are synchronized as a wavefront, so the number
+// of useful threads is no longer bounded by the number of tile columns.
+void vp9_encode_tiles_row_mt(struct VP9_COMP *cpi);
+
+// Run the first pass with macroblock rows distributed over the worker threads.
+// Each row keeps its own statistics, see vp9_first_pass().
+void vp9_encode_fp_row_mt(struct VP9_COMP *cpi);
+
+// Build the alt-ref frame with the rows of the temporal filter distributed
+// over the worker threads. Rows are independent, so the result matches the
+// serial filter.
+void vp9_temporal_filter_row_mt(struct VP9_COMP *cpi);
+
+// Return the luma SSE between sd and the loop filtered frame_to_show, then
+// re-instate the unfiltered luma from last_frame_uf. Rows of 16 pixels are
+// spread over the worker threads and their errors are summed in order.
+int64_t vp9_lpf_sse_mt(struct VP9_COMP *cpi,
+                       const struct yv12_buffer_config *sd);
+
+// Compute the SSE of each plane between a and b, see
+// vp9_get_frame_sse_rows(). Bands of 64 luma rows are spread over the worker
+// threads, so the result matches the serial sum.
+void vp9_frame_sse_mt(struct VP9_COMP *cpi,
+                      const struct yv12_buffer_config *a,
+                      const struct yv12_buffer_config *b,
+                      unsigned int input_shift, uint64_t *sse);
+
+#if CONFIG_INTERNAL_STATS
+// Per plane quality metrics of a shown frame against its source.
+typedef struct FrameMetrics {
+  double ssim[3];
+  double ssim_pp[3];
+  double fastssim[3];
+  double psnrhvs[3];
+} FrameMetrics;
+
+// Measure the ssim of recon, when calc_ssim is set, and of pp, when it is not
+// NULL, against orig. The fast ssim and psnr-hvs of recon are measured for 8
+// bit frames. Each plane of those and each band of the ssim planes is a job for
+// the worker threads, and the band sums are added in order, so the result
+// matches the serial metrics.
+void vp9_frame_metrics_mt(struct VP9_COMP *cpi,
+                          const struct yv12_buffer_config *orig,
+                          const struct yv12_buffer_config *recon,
+                          const struct yv12_buffer_config *pp,
+                          int calc_ssim, FrameMetrics *metrics);
+#endif  // CONFIG_INTERNAL_STATS
+
+// Allocate memory for encoder row synchronization.
+void vp9_row_mt_sync_mem_alloc(VP9RowMTSync *row_mt_sync,
+                               struct VP9Common *cm, int rows);
+
+// Deallocate encoder row synchronization related mutex and data.
+void vp9_row_mt_sync_mem_dealloc(VP9RowMTSync *row_mt_sync);
+
+void vp9_row_mt_sync_read(VP9RowMTSync *const row_mt_sync, int r, int c);
+void vp9_row_mt_sync_read_dummy(VP9RowMTSync *const row_mt_sync, int r, int c);
+
+void vp9_row_mt_sync_write(VP9RowMTSync *const row_mt_sync, int r, int c,
+                           const int cols);
+void vp9_row_mt_sync_write_dummy(VP9RowMTSync *const row_mt_sync, int r, int c,
+                                 const int cols);
+
 #endif  // VP9_ENCODER_VP9_ETHREAD_H_
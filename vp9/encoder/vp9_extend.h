@@ -19,6 +19,8 @@ extern "C" {
 #endif
 
 
+// src and dst may share their planes, in which case only the border of the
+// frame is written.
 void vp9_copy_and_extend_frame(const YV12_BUFFER_CONFIG *src,
                                YV12_BUFFER_CONFIG *dst);
 
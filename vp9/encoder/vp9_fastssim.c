@@ -443,23 +443,29 @@ static double convert_ssim_db(double _ssim, double _weight) {
   return 10 * (log10(_weight) - log10(_weight - _ssim));
 }
 
-double vp9_calc_fastssim(YV12_BUFFER_CONFIG *source, YV12_BUFFER_CONFIG *dest,
-                         double *ssim_y, double *ssim_u, double *ssim_v) {
-  double ssimv;
+double vp9_calc_fastssim_plane(const YV12_BUFFER_CONFIG *source,
+                               const YV12_BUFFER_CONFIG *dest, int plane) {
   vp9_clear_system_state();
+  if (plane == 0)
+    return calc_ssim(source->y_buffer, source->y_stride, dest->y_buffer,
+                     dest->y_stride, source->y_crop_width,
+                     source->y_crop_height);
+  return calc_ssim(plane == 1 ? source->u_buffer : source->v_buffer,
+                   source->uv_stride,
+                   plane == 1 ? dest->u_buffer : dest->v_buffer,
+                   dest->uv_stride, source->uv_crop_width,
+                   source->uv_crop_height);
+}
 
-  *ssim_y = calc_ssim(source->y_buffer, source->y_stride, dest->y_buffer,
-                      dest->y_stride, source->y_crop_width,
-                      source->y_crop_height);
-
-  *ssim_u = calc_ssim(source->u_buffer, source->uv_stride, dest->u_buffer,
-                      dest->uv_stride, source->uv_crop_width,
-                      source->uv_crop_height);
-
-  *ssim_v = calc_ssim(source->v_buffer, source->uv_stride, dest->v_buffer,
-                      dest->uv_stride, source->uv_crop_width,
-                      source->uv_crop_height);
-  ssimv = (*ssim_y) * .8 + .1 * ((*ssim_u) + (*ssim_v));
-
+double vp9_fastssim_frame_db(double ssim_y, double ssim_u, double ssim_v) {
+  const double ssimv = ssim_y * .8 + .1 * (ssim_u + ssim_v);
   return convert_ssim_db(ssimv, 1.0);
 }
+
+double vp9_calc_fastssim(YV12_BUFFER_CONFIG *source, YV12_BUFFER_CONFIG *dest,
+                         double *ssim_y, double *ssim_u, double *ssim_v) {
+  *ssim_y = vp9_calc_fastssim_plane(source, dest, 0);
+  *ssim_u = vp9_calc_fastssim_plane(source, dest, 1);
+  *ssim_v = vp9_calc_fastssim_plane(source, dest, 2);
+  return vp9_fastssim_frame_db(*ssim_y, *ssim_u, *ssim_v);
+}
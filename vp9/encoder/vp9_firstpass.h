@@ -11,6 +11,7 @@
 #ifndef VP9_ENCODER_VP9_FIRSTPASS_H_
 #define VP9_ENCODER_VP9_FIRSTPASS_H_
 
+#include "vp9/common/vp9_mv.h"
 #include "vp9/encoder/vp9_lookahead.h"
 #include "vp9/encoder/vp9_ratectrl.h"
 
@@ -64,6 +65,32 @@ typedef struct {
   int64_t spatial_layer_id;
 } FIRSTPASS_STATS;
 
+// Statistics gathered by the first pass over one row of macroblocks. Rows are
+// merged in raster order so the frame statistics do not depend on how the rows
+// were distributed over threads.
+typedef struct {
+  int64_t intra_error;
+  int64_t coded_error;
+  int64_t sr_coded_error;
+  int64_t sum_mvrs;
+  int64_t sum_mvcs;
+  int sum_mvr;
+  int sum_mvc;
+  int sum_mvr_abs;
+  int sum_mvc_abs;
+  int mvcount;
+  int intercount;
+  int second_ref_count;
+  int new_mv_count;
+  int sum_in_vectors;
+  double intra_factor;
+  double brightness_factor;
+  double neutral_count;
+  // First and last non-zero motion vectors of the row.
+  MV first_mv;
+  MV last_mv;
+} FIRSTPASS_DATA;
+
 typedef enum {
   KF_UPDATE = 0,
   LF_UPDATE = 1,
@@ -128,10 +155,14 @@ typedef struct {
 } TWO_PASS;
 
 struct VP9_COMP;
+struct ThreadData;
 
 void vp9_init_first_pass(struct VP9_COMP *cpi);
 void vp9_rc_get_first_pass_params(struct VP9_COMP *cpi);
 void vp9_first_pass(struct VP9_COMP *cpi, const struct lookahead_entry *source);
+// Runs the first pass over one row of macroblocks using the thread data td.
+void vp9_first_pass_encode_mb_row(struct VP9_COMP *cpi, struct ThreadData *td,
+                                  FIRSTPASS_DATA *fp_data, int mb_row);
 void vp9_end_first_pass(struct VP9_COMP *cpi);
 
 void vp9_init_second_pass(struct VP9_COMP *cpi);
@@ -143,6 +174,22 @@ void vp9_twopass_postencode_update(struct VP9_COMP *cpi);
 
 void vp9_init_subsampling(struct VP9_COMP *cpi);
 
+struct VP9EncoderConfig;
+
+// Splits the num_frames frames described by the first pass stats into chunks
+// of at most max_frames frames that can be coded by independent encoders.
+// Returns the number of chunks and the first frame of each in chunk_start,
+// which must hold num_frames entries.
+int vp9_twopass_split_chunks(const FIRSTPASS_STATS *stats, int num_frames,
+                             int max_frames, int *chunk_start);
+
+// Writes the stats of frames [start, end) followed by their total to out,
+// which must hold end - start + 1 entries. Returns the share of the bit
+// budget of all num_frames frames that the chunk should be coded with.
+int64_t vp9_twopass_chunk_stats(const struct VP9EncoderConfig *oxcf,
+                                const FIRSTPASS_STATS *stats, int num_frames,
+                                int start, int end, FIRSTPASS_STATS *out);
+
 void calculate_coded_size(struct VP9_COMP *cpi,
                           int *scaled_frame_width,
                           int *scaled_frame_height);
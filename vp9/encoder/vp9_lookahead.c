@@ -8,6 +8,7 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 #include <assert.h>
+#include <limits.h>
 #include <stdlib.h>
 
 #include "./vpx_config.h"
@@ -31,14 +32,47 @@ static struct lookahead_entry *pop(struct lookahead_ctx *ctx,
   return buf;
 }
 
+static int copy_frame_worker(struct lookahead_ctx *ctx, void *unused) {
+  (void)unused;
+  vp9_copy_and_extend_frame(&ctx->pending_src, &ctx->pending->img);
+  return 1;
+}
+
+// Hands an application frame back and restores the entry's own buffer.
+static void release_entry(struct lookahead_entry *buf) {
+  if (buf->release.release != NULL) {
+    buf->release.release(buf->release.cb_priv, buf->img_priv);
+    buf->release.release = NULL;
+    buf->img = buf->own_img;
+  }
+}
+
+void vp9_lookahead_sync(struct lookahead_ctx *ctx) {
+  if (ctx != NULL && ctx->pending != NULL) {
+    vp9_get_worker_interface()->sync(ctx->worker);
+    ctx->pending = NULL;
+  }
+}
+
 
 void vp9_lookahead_destroy(struct lookahead_ctx *ctx) {
   if (ctx) {
+    if (ctx->worker) {
+      vp9_get_worker_interface()->end(ctx->worker);
+      free(ctx->worker);
+    }
     if (ctx->buf) {
       unsigned int i;
 
-      for (i = 0; i < ctx->max_sz; i++)
+      for (i = 0; i < ctx->max_sz; i++) {
+        int j;
+        release_entry(&ctx->buf[i]);
         vp9_free_frame_buffer(&ctx->buf[i].img);
+        for (j = 0; j < MAX_MOTION_FIELDS; j++) {
+          free(ctx->buf[i].motion_fields[j].mv);
+          free(ctx->buf[i].motion_fields[j].err);
+        }
+      }
       free(ctx->buf);
     }
     free(ctx);
@@ -53,7 +87,8 @@ struct lookahead_ctx *vp9_lookahead_init(unsigned int width,
 #if CONFIG_VP9_HIGHBITDEPTH
                                          int use_highbitdepth,
 #endif
-                                         unsigned int depth) {
+                                         unsigned int depth,
+                                         int use_worker) {
   struct lookahead_ctx *ctx = NULL;
 
   // Clamp the lookahead queue depth
@@ -80,6 +115,21 @@ struct lookahead_ctx *vp9_lookahead_init(unsigned int width,
                                  VP9_ENC_BORDER_IN_PIXELS,
                                  legacy_byte_alignment))
         goto bail;
+    if (use_worker) {
+      const VP9WorkerInterface *const winterface = vp9_get_worker_interface();
+      ctx->worker = calloc(1, sizeof(*ctx->worker));
+      if (!ctx->worker)
+        goto bail;
+      winterface->init(ctx->worker);
+      // Fall back to copying on the calling thread if none can be created.
+      if (!winterface->reset(ctx->worker)) {
+        free(ctx->worker);
+        ctx->worker = NULL;
+      } else {
+        ctx->worker->hook = (VP9WorkerHook)copy_frame_worker;
+        ctx->worker->data1 = ctx;
+      }
+    }
   }
   return ctx;
  bail:
@@ -109,10 +159,12 @@ int vp9_lookahead_push(struct lookahead_ctx *ctx, YV12_BUFFER_CONFIG   *src,
   int subsampling_y = src->subsampling_y;
   int larger_dimensions, new_dimensions;
 
+  vp9_lookahead_sync(ctx);
   if (ctx->sz + 1  + MAX_PRE_FRAMES > ctx->max_sz)
     return 1;
   ctx->sz++;
   buf = pop(ctx, &ctx->write_idx);
+  release_entry(buf);
 
   new_dimensions = width != buf->img.y_crop_width ||
                    height != buf->img.y_crop_height ||
@@ -191,7 +243,13 @@ int vp9_lookahead_push(struct lookahead_ctx *ctx, YV12_BUFFER_CONFIG   *src,
       buf->img.subsampling_y = src->subsampling_y;
     }
     // Partial copy not implemented yet
-    vp9_copy_and_extend_frame(src, &buf->img);
+    if (ctx->worker) {
+      ctx->pending = buf;
+      ctx->pending_src = *src;
+      vp9_get_worker_interface()->launch(ctx->worker);
+    } else {
+      vp9_copy_and_extend_frame(src, &buf->img);
+    }
 #if USE_PARTIAL_COPY
   }
 #endif
@@ -199,6 +257,68 @@ int vp9_lookahead_push(struct lookahead_ctx *ctx, YV12_BUFFER_CONFIG   *src,
   buf->ts_start = ts_start;
   buf->ts_end = ts_end;
   buf->flags = flags;
+  buf->num_motion_fields = 0;
+  return 0;
+}
+
+int vp9_lookahead_push_external(struct lookahead_ctx *ctx,
+                                YV12_BUFFER_CONFIG *src,
+                                int64_t ts_start, int64_t ts_end,
+                                unsigned int flags,
+                                const vpx_release_input_cb_t *release,
+                                void *img_priv) {
+  struct lookahead_entry *buf;
+  YV12_BUFFER_CONFIG *img;
+
+  vp9_lookahead_sync(ctx);
+  if (ctx->sz + 1 + MAX_PRE_FRAMES > ctx->max_sz) {
+    release->release(release->cb_priv, img_priv);
+    return 1;
+  }
+  ctx->sz++;
+  buf = pop(ctx, &ctx->write_idx);
+  release_entry(buf);
+  buf->own_img = buf->img;
+
+  // Describe the application frame the way a lookahead buffer of its size
+  // would be, so that the encoder sees the same layout either way.
+  img = &buf->img;
+  img->y_crop_width = src->y_crop_width;
+  img->y_crop_height = src->y_crop_height;
+  img->y_width = (src->y_crop_width + 7) & ~7;
+  img->y_height = (src->y_crop_height + 7) & ~7;
+  img->y_stride = src->y_stride;
+  img->uv_crop_width = src->uv_crop_width;
+  img->uv_crop_height = src->uv_crop_height;
+  img->uv_width = img->y_width >> src->subsampling_x;
+  img->uv_height = img->y_height >> src->subsampling_y;
+  img->uv_stride = src->uv_stride;
+  img->y_buffer = src->y_buffer;
+  img->u_buffer = src->u_buffer;
+  img->v_buffer = src->v_buffer;
+  img->buffer_alloc = NULL;
+  img->buffer_alloc_sz = 0;
+  img->frame_size = 0;
+  img->border = VP9_ENC_BORDER_IN_PIXELS;
+  img->subsampling_x = src->subsampling_x;
+  img->subsampling_y = src->subsampling_y;
+  img->flags = src->flags;
+
+  // The border is extended in place, with the same extent as a copy.
+  if (ctx->worker) {
+    ctx->pending = buf;
+    ctx->pending_src = *src;
+    vp9_get_worker_interface()->launch(ctx->worker);
+  } else {
+    vp9_copy_and_extend_frame(src, img);
+  }
+
+  buf->ts_start = ts_start;
+  buf->ts_end = ts_end;
+  buf->flags = flags;
+  buf->release = *release;
+  buf->img_priv = img_priv;
+  buf->num_motion_fields = 0;
   return 0;
 }
 
@@ -210,6 +330,8 @@ struct lookahead_entry *vp9_lookahead_pop(struct lookahead_ctx *ctx,
   if (ctx->sz && (drain || ctx->sz == ctx->max_sz - MAX_PRE_FRAMES)) {
     buf = pop(ctx, &ctx->read_idx);
     ctx->sz--;
+    if (buf == ctx->pending)
+      vp9_lookahead_sync(ctx);
   }
   return buf;
 }
@@ -226,6 +348,8 @@ struct lookahead_entry *vp9_lookahead_peek(struct lookahead_ctx *ctx,
       if (index >= (int)ctx->max_sz)
         index -= ctx->max_sz;
       buf = ctx->buf + index;
+      if (buf == ctx->pending)
+        vp9_lookahead_sync(ctx);
     }
   } else if (index < 0) {
     // Backward peek
@@ -240,6 +364,71 @@ struct lookahead_entry *vp9_lookahead_peek(struct lookahead_ctx *ctx,
   return buf;
 }
 
+struct lookahead_motion_field *vp9_lookahead_motion_field(
+    struct lookahead_entry *entry, int64_t ref_ts, int mb_rows, int mb_cols) {
+  struct lookahead_motion_field *field = NULL;
+  const int sz = mb_rows * mb_cols;
+  int i;
+
+  for (i = 0; i < entry->num_motion_fields; i++) {
+    if (entry->motion_fields[i].ref_ts == ref_ts) {
+      field = &entry->motion_fields[i];
+      if (field->mb_rows == mb_rows && field->mb_cols == mb_cols)
+        return field;
+      break;
+    }
+  }
+
+  if (field == NULL) {
+    if (entry->num_motion_fields == MAX_MOTION_FIELDS) {
+      // Move the oldest field to the end, keeping its allocation.
+      const struct lookahead_motion_field oldest = entry->motion_fields[0];
+      memmove(entry->motion_fields, entry->motion_fields + 1,
+              (MAX_MOTION_FIELDS - 1) * sizeof(*entry->motion_fields));
+      entry->motion_fields[MAX_MOTION_FIELDS - 1] = oldest;
+      entry->num_motion_fields--;
+    }
+    field = &entry->motion_fields[entry->num_motion_fields];
+  }
+
+  if (sz > field->alloc_sz) {
+    free(field->mv);
+    free(field->err);
+    field->mv = malloc(sz * sizeof(*field->mv));
+    field->err = malloc(sz * sizeof(*field->err));
+    if (!field->mv || !field->err) {
+      free(field->mv);
+      free(field->err);
+      field->mv = NULL;
+      field->err = NULL;
+      field->alloc_sz = 0;
+      // The results are only a cache, so the others can go as well.
+      entry->num_motion_fields = 0;
+      return NULL;
+    }
+    field->alloc_sz = sz;
+  }
+
+  if (field == entry->motion_fields + entry->num_motion_fields)
+    entry->num_motion_fields++;
+  field->ref_ts = ref_ts;
+  field->mb_rows = mb_rows;
+  field->mb_cols = mb_cols;
+  memset(field->mv, 0, sz * sizeof(*field->mv));
+  for (i = 0; i < sz; i++)
+    field->err[i] = UINT_MAX;
+  return field;
+}
+
+const struct lookahead_motion_field *vp9_lookahead_find_motion_field(
+    const struct lookahead_entry *entry, int64_t ref_ts) {
+  int i;
+  for (i = 0; i < entry->num_motion_fields; i++)
+    if (entry->motion_fields[i].ref_ts == ref_ts)
+      return &entry->motion_fields[i];
+  return NULL;
+}
+
 unsigned int vp9_lookahead_depth(struct lookahead_ctx *ctx) {
   return ctx->sz;
 }
@@ -12,10 +12,13 @@
 #define VP9_ENCODER_VP9_LOOKAHEAD_H_
 
 #include "vpx_scale/yv12config.h"
+#include "vpx/vp8cx.h"
 #include "vpx/vpx_integer.h"
 
+#include "vp9/common/vp9_mv.h"
+#include "vp9/common/vp9_thread.h"
+
 #if CONFIG_SPATIAL_SVC
-#include "vpx/vp8cx.h"
 #include "vpx/vpx_encoder.h"
 #endif
 
@@ -25,11 +28,33 @@ extern "C" {
 
 #define MAX_LAG_BUFFERS 25
 
+// Number of motion fields kept per frame, enough for the golden frame and
+// two levels of alt ref frames.
+#define MAX_MOTION_FIELDS 3
+
+// Best matches of the 16x16 blocks of a frame in the source frame that
+// starts at ref_ts, as found by the analysis done before the frame is coded.
+struct lookahead_motion_field {
+  int64_t       ref_ts;
+  int           mb_rows;
+  int           mb_cols;
+  int           alloc_sz;
+  MV           *mv;   // In 1/8 pel
+  unsigned int *err;  // UINT_MAX for blocks that were not searched
+};
+
 struct lookahead_entry {
   YV12_BUFFER_CONFIG  img;
   int64_t             ts_start;
   int64_t             ts_end;
   unsigned int        flags;
+  // Set while img refers to an application frame rather than a copy, in
+  // which case the entry's own buffer is kept in own_img.
+  vpx_release_input_cb_t release;
+  void               *img_priv;
+  YV12_BUFFER_CONFIG  own_img;
+  struct lookahead_motion_field motion_fields[MAX_MOTION_FIELDS];
+  int                 num_motion_fields;
 };
 
 // The max of past frames we want to keep in the queue.
@@ -41,12 +66,18 @@ struct lookahead_ctx {
   unsigned int read_idx;       /* Read index */
   unsigned int write_idx;      /* Write index */
   struct lookahead_entry *buf; /* Buffer list */
+  VP9Worker *worker;           /* Background copy worker, or NULL */
+  struct lookahead_entry *pending;  /* Entry the worker is filling */
+  YV12_BUFFER_CONFIG pending_src;   /* Source of the pending copy */
 };
 
 /**\brief Initializes the lookahead stage
  *
  * The lookahead stage is a queue of frame buffers on which some analysis
  * may be done when buffers are enqueued.
+ *
+ * If use_worker is set, the copy and border extension of pushed frames is
+ * done on a background thread, overlapping the encode of earlier frames.
  */
 struct lookahead_ctx *vp9_lookahead_init(unsigned int width,
                                          unsigned int height,
@@ -55,7 +86,8 @@ struct lookahead_ctx *vp9_lookahead_init(unsigned int width,
 #if CONFIG_VP9_HIGHBITDEPTH
                                          int use_highbitdepth,
 #endif
-                                         unsigned int depth);
+                                         unsigned int depth,
+                                         int use_worker);
 
 
 /**\brief Destroys the lookahead stage
@@ -68,6 +100,10 @@ void vp9_lookahead_destroy(struct lookahead_ctx *ctx);
  * This function will copy the source image into a new framebuffer with
  * the expected stride/border.
  *
+ * When the context has a worker the copy may still be in progress on
+ * return, and the source must stay valid until vp9_lookahead_sync() is
+ * called. Peeking or popping the new entry waits for its copy.
+ *
  * If active_map is non-NULL and there is only one frame in the queue, then copy
  * only active macroblocks.
  *
@@ -86,6 +122,37 @@ int vp9_lookahead_push(struct lookahead_ctx *ctx, YV12_BUFFER_CONFIG *src,
                        unsigned int flags);
 
 
+/**\brief Enqueue an application frame without copying it
+ *
+ * The frame's border is extended in place and the entry refers to its
+ * planes until it is reused or the lookahead is destroyed, at which point
+ * release is called with img_priv. The frame must have a border of
+ * VP9_ENC_BORDER_IN_PIXELS. If it cannot be queued it is released before
+ * this function returns.
+ *
+ * \param[in] ctx         Pointer to the lookahead context
+ * \param[in] src         Pointer to the frame to enqueue
+ * \param[in] ts_start    Timestamp for the start of this frame
+ * \param[in] ts_end      Timestamp for the end of this frame
+ * \param[in] flags       Flags set on this frame
+ * \param[in] release     Callback that releases the frame
+ * \param[in] img_priv    Argument identifying the frame to release
+ */
+int vp9_lookahead_push_external(struct lookahead_ctx *ctx,
+                                YV12_BUFFER_CONFIG *src,
+                                int64_t ts_start, int64_t ts_end,
+                                unsigned int flags,
+                                const vpx_release_input_cb_t *release,
+                                void *img_priv);
+
+
+/**\brief Wait for the copy started by the last push to complete
+ *
+ * \param[in] ctx       Pointer to the lookahead context
+ */
+void vp9_lookahead_sync(struct lookahead_ctx *ctx);
+
+
 /**\brief Get the next source buffer to encode
  *
  *
@@ -111,6 +178,35 @@ struct lookahead_entry *vp9_lookahead_peek(struct lookahead_ctx *ctx,
                                            int index);
 
 
+/**\brief Get the motion field of a frame for storing new results
+ *
+ * Returns the field of the entry that holds the motion towards the source
+ * frame starting at ref_ts, with all blocks marked as not searched if it is
+ * new or its size changed. The oldest field of the entry is replaced if all
+ * are in use. Fields are dropped when the entry is reused for a new frame.
+ *
+ * \param[in] entry     Entry of the frame the blocks belong to
+ * \param[in] ref_ts    Timestamp of the frame the motion points into
+ * \param[in] mb_rows   Number of 16x16 block rows of the field
+ * \param[in] mb_cols   Number of 16x16 block columns of the field
+ *
+ * \retval NULL, if the field cannot be allocated
+ */
+struct lookahead_motion_field *vp9_lookahead_motion_field(
+    struct lookahead_entry *entry, int64_t ref_ts, int mb_rows, int mb_cols);
+
+
+/**\brief Find the motion field of a frame towards another source frame
+ *
+ * \param[in] entry     Entry of the frame the blocks belong to
+ * \param[in] ref_ts    Timestamp of the frame the motion points into
+ *
+ * \retval NULL, if no motion towards that frame has been stored
+ */
+const struct lookahead_motion_field *vp9_lookahead_find_motion_field(
+    const struct lookahead_entry *entry, int64_t ref_ts);
+
+
 /**\brief Get the number of frames currently in the lookahead queue
  *
  * \param[in] ctx       Pointer to the lookahead context
@@ -378,6 +378,10 @@ void vp9_update_mbgraph_stats(VP9_COMP *cpi) {
   VP9_COMMON *const cm = &cpi->common;
   int i, n_frames = vp9_lookahead_depth(cpi->lookahead);
   YV12_BUFFER_CONFIG *golden_ref = get_ref_frame_buffer(cpi, GOLDEN_FRAME);
+  // Motion fields are kept at the size of the source frames only.
+  const int keep_motion = !cpi->use_svc &&
+      cpi->un_scaled_source->y_crop_width == cm->width &&
+      cpi->un_scaled_source->y_crop_height == cm->height;
 
   assert(golden_ref != NULL);
 
@@ -408,6 +412,21 @@ void vp9_update_mbgraph_stats(VP9_COMP *cpi) {
 
     update_mbgraph_frame_stats(cpi, frame_stats, &q_cur->img,
                                golden_ref, cpi->Source);
+
+    // The frames of the group are coded with this golden frame as a
+    // reference, so keep the motion towards it for their own search.
+    if (keep_motion) {
+      struct lookahead_motion_field *const field = vp9_lookahead_motion_field(
+          q_cur, cpi->fb_source_ts[get_ref_frame_buf_idx(cpi, GOLDEN_FRAME)],
+          cm->mb_rows, cm->mb_cols);
+      if (field != NULL) {
+        int j;
+        for (j = 0; j < cm->mb_rows * cm->mb_cols; j++) {
+          field->mv[j] = frame_stats->mb_stats[j].ref[GOLDEN_FRAME].m.mv.as_mv;
+          field->err[j] = frame_stats->mb_stats[j].ref[GOLDEN_FRAME].err;
+        }
+      }
+    }
   }
 
   vp9_clear_system_state();
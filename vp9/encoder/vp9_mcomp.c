@@ -2306,6 +2306,165 @@ int vp9_refining_search_8p_c(const MACROBLOCK *x,
   return best_sad;
 }
 
+// Returns the SAD of a full pel start point plus the cost of its MV.
+static unsigned int start_mv_cost(const MACROBLOCK *x,
+                                  const vp9_variance_fn_ptr_t *fn_ptr,
+                                  const MV *mv, const MV *ref_mv,
+                                  int error_per_bit) {
+  const struct buf_2d *const src = &x->plane[0].src;
+  const struct buf_2d *const pre = &x->e_mbd.plane[0].pre[0];
+  const MV fcenter_mv = {ref_mv->row >> 3, ref_mv->col >> 3};
+  return fn_ptr->sdf(src->buf, src->stride, get_buf_from_mv(pre, mv),
+                     pre->stride) +
+         mvsad_err_cost(x, mv, &fcenter_mv, error_per_bit);
+}
+
+// Searches the downsampled source and reference coarse-to-fine, starting from
+// mvp_full on the smallest level, and replaces mvp_full with the result if it
+// matches better at full resolution. Returns 1 if it did, and 0 otherwise,
+// including for blocks too small to be downsampled.
+static int pyramid_search(const VP9_COMP *cpi, MACROBLOCK *x,
+                          BLOCK_SIZE bsize, MV *mvp_full, int step_param,
+                          int error_per_bit, const MV *ref_mv) {
+  MACROBLOCKD *const xd = &x->e_mbd;
+  const MV_REFERENCE_FRAME ref = xd->mi[0]->mbmi.ref_frame[0];
+  const int buf_idx = ref > INTRA_FRAME ? cpi->scaled_ref_idx[ref - 1]
+                                        : INVALID_IDX;
+  const SEARCH_PYRAMID *const src_pyramid = &cpi->src_pyramid;
+  const SEARCH_PYRAMID *ref_pyramid;
+  const struct buf_2d src = x->plane[0].src;
+  const struct buf_2d pre = xd->plane[0].pre[0];
+  const int col_min = x->mv_col_min;
+  const int col_max = x->mv_col_max;
+  const int row_min = x->mv_row_min;
+  const int row_max = x->mv_row_max;
+  // Position of the block in the frame, in pixels.
+  const int row = -xd->mb_to_top_edge >> 3;
+  const int col = -xd->mb_to_left_edge >> 3;
+  const vp9_variance_fn_ptr_t *const fn_ptr = &cpi->fn_ptr[bsize];
+  const vp9_variance_fn_ptr_t *level_fn_ptr[MAX_PYRAMID_LEVELS];
+  const MV zero_mv = {0, 0};
+  BLOCK_SIZE level_bsize = bsize;
+  int levels = 0, max_levels, level;
+  MV mv = *mvp_full;
+  MV pred_mv = *mvp_full;
+
+  if (buf_idx == INVALID_IDX)
+    return 0;
+  ref_pyramid = &cpi->ref_pyramid[buf_idx];
+  max_levels = MIN(cpi->sf.mv.search_pyramid_levels,
+                   MIN(src_pyramid->num_levels, ref_pyramid->num_levels));
+
+  // Use the levels on which the block is still at least 8x8, and on which
+  // the search range is not empty.
+  while (levels < max_levels) {
+    const int shift = levels + 1;
+    level_bsize = ss_size_lookup[level_bsize][1][1];
+    if (level_bsize == BLOCK_INVALID ||
+        num_4x4_blocks_wide_lookup[level_bsize] < 2 ||
+        num_4x4_blocks_high_lookup[level_bsize] < 2 ||
+        -(-col_min >> shift) > (col_max >> shift) ||
+        -(-row_min >> shift) > (row_max >> shift))
+      break;
+    level_fn_ptr[levels++] = &cpi->fn_ptr[level_bsize];
+  }
+  if (levels == 0)
+    return 0;
+
+  mv.row >>= levels;
+  mv.col >>= levels;
+  for (level = levels - 1; level >= 0; --level) {
+    const int shift = level + 1;
+    const YV12_BUFFER_CONFIG *const src_level = &src_pyramid->levels[level];
+    const YV12_BUFFER_CONFIG *const ref_level = &ref_pyramid->levels[level];
+    // The smallest level covers the search range of the full pel search, the
+    // others only refine the MV scaled up from the level below.
+    const int search_param = level == levels - 1 ?
+        MIN(step_param + shift, MAX_MVSEARCH_STEPS - 1) :
+        MAX_MVSEARCH_STEPS - 2;
+
+    x->plane[0].src.buf = src_level->y_buffer +
+        (row >> shift) * src_level->y_stride + (col >> shift);
+    x->plane[0].src.stride = src_level->y_stride;
+    xd->plane[0].pre[0].buf = ref_level->y_buffer +
+        (row >> shift) * ref_level->y_stride + (col >> shift);
+    xd->plane[0].pre[0].stride = ref_level->y_stride;
+    // Round the limits towards zero to stay within the level borders.
+    x->mv_col_min = -(-col_min >> shift);
+    x->mv_col_max = col_max >> shift;
+    x->mv_row_min = -(-row_min >> shift);
+    x->mv_row_max = row_max >> shift;
+
+    // The MV costs are only meaningful at full resolution.
+    vp9_hex_search(x, &mv, search_param, 0, 1, NULL, level_fn_ptr[level], 0,
+                   &zero_mv, &mv);
+    mv.row *= 2;
+    mv.col *= 2;
+  }
+
+  x->plane[0].src = src;
+  xd->plane[0].pre[0] = pre;
+  x->mv_col_min = col_min;
+  x->mv_col_max = col_max;
+  x->mv_row_min = row_min;
+  x->mv_row_max = row_max;
+
+  clamp_mv(&mv, col_min, col_max, row_min, row_max);
+  clamp_mv(&pred_mv, col_min, col_max, row_min, row_max);
+  if (start_mv_cost(x, fn_ptr, &mv, ref_mv, error_per_bit) >=
+      start_mv_cost(x, fn_ptr, &pred_mv, ref_mv, error_per_bit))
+    return 0;
+  *mvp_full = mv;
+  return 1;
+}
+
+// Looks up the motion of the 16x16 block at the center of the block towards
+// the reference, if it was found while analysing the lookahead frames, and
+// replaces mvp_full with it if it matches better. Returns 1 if it did, with
+// the SAD plus MV cost of the new start point in start_cost.
+static int motion_field_search(const VP9_COMP *cpi, MACROBLOCK *x,
+                               BLOCK_SIZE bsize, MV *mvp_full,
+                               int error_per_bit, const MV *ref_mv,
+                               unsigned int *start_cost) {
+  const VP9_COMMON *const cm = &cpi->common;
+  const MACROBLOCKD *const xd = &x->e_mbd;
+  const MV_REFERENCE_FRAME ref = xd->mi[0]->mbmi.ref_frame[0];
+  const int buf_idx = ref > INTRA_FRAME ? cpi->scaled_ref_idx[ref - 1]
+                                        : INVALID_IDX;
+  const struct lookahead_motion_field *field;
+  int mb_row, mb_col;
+  MV mv, pred_mv = *mvp_full;
+
+  if (buf_idx == INVALID_IDX || cpi->source_entry == NULL || cpi->use_svc)
+    return 0;
+  field = vp9_lookahead_find_motion_field(cpi->source_entry,
+                                          cpi->fb_source_ts[buf_idx]);
+  if (field == NULL || field->mb_rows != cm->mb_rows ||
+      field->mb_cols != cm->mb_cols)
+    return 0;
+
+  mb_row = MIN(((-xd->mb_to_top_edge >> 3) +
+                num_4x4_blocks_high_lookup[bsize] * 2) >> 4, cm->mb_rows - 1);
+  mb_col = MIN(((-xd->mb_to_left_edge >> 3) +
+                num_4x4_blocks_wide_lookup[bsize] * 2) >> 4, cm->mb_cols - 1);
+  if (field->err[mb_row * field->mb_cols + mb_col] == UINT_MAX)
+    return 0;
+
+  mv = field->mv[mb_row * field->mb_cols + mb_col];
+  mv.row = (mv.row + 4) >> 3;
+  mv.col = (mv.col + 4) >> 3;
+  clamp_mv(&mv, x->mv_col_min, x->mv_col_max, x->mv_row_min, x->mv_row_max);
+  clamp_mv(&pred_mv, x->mv_col_min, x->mv_col_max,
+           x->mv_row_min, x->mv_row_max);
+  *start_cost = start_mv_cost(x, &cpi->fn_ptr[bsize], &mv, ref_mv,
+                              error_per_bit);
+  if (*start_cost >=
+      start_mv_cost(x, &cpi->fn_ptr[bsize], &pred_mv, ref_mv, error_per_bit))
+    return 0;
+  *mvp_full = mv;
+  return 1;
+}
+
 int vp9_full_pixel_search(VP9_COMP *cpi, MACROBLOCK *x,
                           BLOCK_SIZE bsize, MV *mvp_full,
                           int step_param, int error_per_bit,
@@ -2315,6 +2474,8 @@ int vp9_full_pixel_search(VP9_COMP *cpi, MACROBLOCK *x,
   const SPEED_FEATURES *const sf = &cpi->sf;
   const SEARCH_METHODS method = sf->mv.search_method;
   vp9_variance_fn_ptr_t *fn_ptr = &cpi->fn_ptr[bsize];
+  unsigned int start_cost;
+  int skip_search = 0;
   int var = 0;
   if (cost_list) {
     cost_list[0] = INT_MAX;
@@ -2324,6 +2485,33 @@ int vp9_full_pixel_search(VP9_COMP *cpi, MACROBLOCK *x,
     cost_list[4] = INT_MAX;
   }
 
+  // A start point found by the lookahead analysis or on the pyramid that
+  // beats the predicted one is within a pixel or two of the best match, so
+  // only the smallest steps of the full pel search are taken from it. The
+  // search is skipped altogether when the lookahead motion already matches
+  // to within the skip threshold.
+  if (sf->mv.use_lookahead_motion &&
+      motion_field_search(cpi, x, bsize, mvp_full, error_per_bit, ref_mv,
+                          &start_cost)) {
+    skip_search = start_cost < ((unsigned int)sf->mv.lookahead_motion_skip_sad
+                                << num_pels_log2_lookup[bsize]);
+    step_param = MAX(step_param, MAX_MVSEARCH_STEPS - 2);
+  } else if (sf->mv.search_pyramid_levels > 0 &&
+             pyramid_search(cpi, x, bsize, mvp_full, step_param,
+                            error_per_bit, ref_mv)) {
+    step_param = MAX(step_param, MAX_MVSEARCH_STEPS - 2);
+  }
+
+  if (skip_search) {
+    *tmp_mv = *mvp_full;
+    if (cost_list)
+      calc_int_cost_list(x, ref_mv, error_per_bit, fn_ptr, tmp_mv, cost_list);
+    var = start_cost;
+    if (method == NSTEP || (rd && var < var_max))
+      var = vp9_get_mvpred_var(x, tmp_mv, ref_mv, fn_ptr, 1);
+    return var;
+  }
+
   switch (method) {
     case FAST_DIAMOND:
       var = vp9_fast_dia_search(x, mvp_full, step_param, error_per_bit, 0,
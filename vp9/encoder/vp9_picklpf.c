@@ -21,6 +21,7 @@
 #include "vp9/common/vp9_quant_common.h"
 
 #include "vp9/encoder/vp9_encoder.h"
+#include "vp9/encoder/vp9_ethread.h"
 #include "vp9/encoder/vp9_picklpf.h"
 #include "vp9/encoder/vp9_quantize.h"
 
@@ -40,13 +41,16 @@ static int64_t try_filter_frame(const YV12_BUFFER_CONFIG *sd,
   VP9_COMMON *const cm = &cpi->common;
   int64_t filt_err;
 
-  if (cpi->num_workers > 1)
+  if (cpi->num_workers > 1) {
     vp9_loop_filter_frame_mt(cm->frame_to_show, cm, cpi->td.mb.e_mbd.plane,
                              filt_level, 1, partial_frame,
                              cpi->workers, cpi->num_workers, &cpi->lf_row_sync);
-  else
-    vp9_loop_filter_frame(cm->frame_to_show, cm, &cpi->td.mb.e_mbd, filt_level,
-                          1, partial_frame);
+    // Measure and undo the filtering with the same threads.
+    return vp9_lpf_sse_mt(cpi, sd);
+  }
+
+  vp9_loop_filter_frame(cm->frame_to_show, cm, &cpi->td.mb.e_mbd, filt_level,
+                        1, partial_frame);
 
 #if CONFIG_VP9_HIGHBITDEPTH
   if (cm->use_highbitdepth) {
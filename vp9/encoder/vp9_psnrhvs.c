@@ -200,24 +200,34 @@ static double calc_psnrhvs(const unsigned char *_src, int _systride,
   ret /= pixels;
   return ret;
 }
-double vp9_psnrhvs(YV12_BUFFER_CONFIG *source, YV12_BUFFER_CONFIG *dest,
-                   double *y_psnrhvs, double *u_psnrhvs, double *v_psnrhvs) {
-  double psnrhvs;
+double vp9_psnrhvs_plane(const YV12_BUFFER_CONFIG *source,
+                         const YV12_BUFFER_CONFIG *dest, int plane) {
   double par = 1.0;
   int step = 7;
   vp9_clear_system_state();
-  *y_psnrhvs = calc_psnrhvs(source->y_buffer, source->y_stride, dest->y_buffer,
-                            dest->y_stride, par, source->y_crop_width,
-                            source->y_crop_height, step, csf_y);
-
-  *u_psnrhvs = calc_psnrhvs(source->u_buffer, source->uv_stride, dest->u_buffer,
-                            dest->uv_stride, par, source->uv_crop_width,
-                            source->uv_crop_height, step, csf_cb420);
-
-  *v_psnrhvs = calc_psnrhvs(source->v_buffer, source->uv_stride, dest->v_buffer,
-                            dest->uv_stride, par, source->uv_crop_width,
-                            source->uv_crop_height, step, csf_cr420);
-  psnrhvs = (*y_psnrhvs) * .8 + .1 * ((*u_psnrhvs) + (*v_psnrhvs));
+  if (plane == 0)
+    return calc_psnrhvs(source->y_buffer, source->y_stride, dest->y_buffer,
+                        dest->y_stride, par, source->y_crop_width,
+                        source->y_crop_height, step, csf_y);
+  if (plane == 1)
+    return calc_psnrhvs(source->u_buffer, source->uv_stride, dest->u_buffer,
+                        dest->uv_stride, par, source->uv_crop_width,
+                        source->uv_crop_height, step, csf_cb420);
+  return calc_psnrhvs(source->v_buffer, source->uv_stride, dest->v_buffer,
+                      dest->uv_stride, par, source->uv_crop_width,
+                      source->uv_crop_height, step, csf_cr420);
+}
 
+double vp9_psnrhvs_frame_db(double psnrhvs_y, double psnrhvs_u,
+                            double psnrhvs_v) {
+  const double psnrhvs = psnrhvs_y * .8 + .1 * (psnrhvs_u + psnrhvs_v);
   return convert_score_db(psnrhvs, 1.0);
 }
+
+double vp9_psnrhvs(YV12_BUFFER_CONFIG *source, YV12_BUFFER_CONFIG *dest,
+                   double *y_psnrhvs, double *u_psnrhvs, double *v_psnrhvs) {
+  *y_psnrhvs = vp9_psnrhvs_plane(source, dest, 0);
+  *u_psnrhvs = vp9_psnrhvs_plane(source, dest, 1);
+  *v_psnrhvs = vp9_psnrhvs_plane(source, dest, 2);
+  return vp9_psnrhvs_frame_db(*y_psnrhvs, *u_psnrhvs, *v_psnrhvs);
+}
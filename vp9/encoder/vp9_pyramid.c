@@ -0,0 +1,94 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "./vpx_scale_rtcd.h"
+
+#include "vp9/common/vp9_common.h"
+#include "vp9/encoder/vp9_encoder.h"
+#include "vp9/encoder/vp9_pyramid.h"
+#include "vp9/encoder/vp9_resize.h"
+
+// The motion search may place a block entirely outside the frame, so each
+// level keeps a border proportional to the one of the full size frame.
+static int level_border(int level) {
+  return ALIGN_POWER_OF_TWO(VP9_ENC_BORDER_IN_PIXELS >> (level + 1), 5);
+}
+
+static void build_level(VP9_COMMON *cm, const YV12_BUFFER_CONFIG *src,
+                        YV12_BUFFER_CONFIG *dst, int level) {
+  const int width = (src->y_crop_width + 1) >> 1;
+  const int height = (src->y_crop_height + 1) >> 1;
+
+  if (vp9_realloc_frame_buffer(dst, width, height, 1, 1,
+#if CONFIG_VP9_HIGHBITDEPTH
+                               cm->use_highbitdepth,
+#endif
+                               level_border(level), cm->byte_alignment,
+                               NULL, NULL, NULL))
+    vpx_internal_error(&cm->error, VPX_CODEC_MEM_ERROR,
+                       "Failed to allocate search pyramid");
+
+#if CONFIG_VP9_HIGHBITDEPTH
+  if (src->flags & YV12_FLAG_HIGHBITDEPTH) {
+    vp9_highbd_resize_plane(src->y_buffer, src->y_crop_height,
+                            src->y_crop_width, src->y_stride, dst->y_buffer,
+                            height, width, dst->y_stride, (int)cm->bit_depth);
+  } else {
+    vp9_resize_plane(src->y_buffer, src->y_crop_height, src->y_crop_width,
+                     src->y_stride, dst->y_buffer, height, width,
+                     dst->y_stride);
+  }
+#else
+  vp9_resize_plane(src->y_buffer, src->y_crop_height, src->y_crop_width,
+                   src->y_stride, dst->y_buffer, height, width, dst->y_stride);
+#endif  // CONFIG_VP9_HIGHBITDEPTH
+  // Only the luma plane is used; the chroma planes stay as allocated.
+  vp9_extend_frame_borders(dst);
+}
+
+static void build_pyramid(VP9_COMMON *cm, const YV12_BUFFER_CONFIG *frame,
+                          SEARCH_PYRAMID *pyramid, int num_levels) {
+  int i;
+  for (i = 0; i < num_levels; ++i)
+    build_level(cm, i == 0 ? frame : &pyramid->levels[i - 1],
+                &pyramid->levels[i], i);
+  pyramid->num_levels = num_levels;
+}
+
+void vp9_setup_search_pyramids(VP9_COMP *cpi) {
+  VP9_COMMON *const cm = &cpi->common;
+  const int num_levels = MIN(cpi->sf.mv.search_pyramid_levels,
+                             MAX_PYRAMID_LEVELS);
+  MV_REFERENCE_FRAME ref_frame;
+
+  if (num_levels == 0)
+    return;
+
+  build_pyramid(cm, cpi->Source, &cpi->src_pyramid, num_levels);
+
+  for (ref_frame = LAST_FRAME; ref_frame <= ALTREF_FRAME; ++ref_frame) {
+    const int buf_idx = cpi->scaled_ref_idx[ref_frame - 1];
+    SEARCH_PYRAMID *pyramid;
+
+    if (buf_idx == INVALID_IDX)
+      continue;
+    pyramid = &cpi->ref_pyramid[buf_idx];
+    if (pyramid->num_levels < num_levels)
+      build_pyramid(cm, &cm->buffer_pool->frame_bufs[buf_idx].buf, pyramid,
+                    num_levels);
+  }
+}
+
+void vp9_free_search_pyramid(SEARCH_PYRAMID *pyramid) {
+  int i;
+  for (i = 0; i < MAX_PYRAMID_LEVELS; ++i)
+    vp9_free_frame_buffer(&pyramid->levels[i]);
+  pyramid->num_levels = 0;
+}
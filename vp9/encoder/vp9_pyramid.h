@@ -0,0 +1,50 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef VP9_ENCODER_VP9_PYRAMID_H_
+#define VP9_ENCODER_VP9_PYRAMID_H_
+
+#include "./vpx_config.h"
+#include "vpx_scale/yv12config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MAX_PYRAMID_LEVELS 3
+
+// The luma plane of a frame downsampled by 2 at each level, with borders for
+// motion search. Level 0 is half the size of the frame.
+typedef struct {
+  YV12_BUFFER_CONFIG levels[MAX_PYRAMID_LEVELS];
+  // Number of levels that match the current contents of the frame.
+  int num_levels;
+} SEARCH_PYRAMID;
+
+struct VP9_COMP;
+
+// Marks the pyramid stale after the frame it was built from is overwritten.
+static INLINE void vp9_invalidate_search_pyramid(SEARCH_PYRAMID *pyramid) {
+  pyramid->num_levels = 0;
+}
+
+// Builds the pyramids of the source frame and of the references of the frame
+// being encoded, as deep as sf.mv.search_pyramid_levels asks for. Reference
+// pyramids are kept with their frame buffers and only rebuilt once the buffer
+// gets new contents.
+void vp9_setup_search_pyramids(struct VP9_COMP *cpi);
+
+void vp9_free_search_pyramid(SEARCH_PYRAMID *pyramid);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // VP9_ENCODER_VP9_PYRAMID_H_
@@ -109,6 +109,8 @@ static void set_good_speed_feature(VP9_COMP *cpi, VP9_COMMON *cm,
     sf->use_rd_breakout = 1;
     sf->adaptive_motion_search = 1;
     sf->mv.auto_mv_step_size = 1;
+    sf->mv.use_lookahead_motion = 1;
+    sf->mv.lookahead_motion_skip_sad = 2;
     sf->adaptive_rd_thresh = 2;
     sf->mv.subpel_iters_per_step = 1;
     sf->mode_skip_start = 10;
@@ -141,6 +143,8 @@ static void set_good_speed_feature(VP9_COMP *cpi, VP9_COMMON *cm,
     sf->auto_min_max_partition_size = RELAXED_NEIGHBORING_MIN_MAX;
     sf->rd_auto_partition_min_limit = set_partition_min_limit(cpi);
     sf->allow_partition_search_skip = 1;
+    // Measured to cost bitrate at this speed.
+    sf->mv.use_lookahead_motion = 0;
   }
 
   if (speed >= 3) {
@@ -158,6 +162,7 @@ static void set_good_speed_feature(VP9_COMP *cpi, VP9_COMMON *cm,
     sf->intra_y_mode_mask[TX_32X32] = INTRA_DC;
     sf->intra_uv_mode_mask[TX_32X32] = INTRA_DC;
     sf->adaptive_interp_filter_search = 1;
+    sf->mv.use_lookahead_motion = 1;
   }
 
   if (speed >= 4) {
@@ -165,6 +170,9 @@ static void set_good_speed_feature(VP9_COMP *cpi, VP9_COMMON *cm,
     sf->tx_size_search_method = USE_LARGESTALL;
     sf->mv.search_method = BIGDIA;
     sf->mv.subpel_search_method = SUBPEL_TREE_PRUNED_MORE;
+    sf->mv.search_pyramid_levels = 2;
+    // The pyramid search picks the start point at these speeds.
+    sf->mv.use_lookahead_motion = 0;
     sf->adaptive_rd_thresh = 4;
     if (cm->frame_type != KEY_FRAME)
       sf->mode_search_skip_flags |= FLAG_EARLY_TERMINATE;
@@ -305,6 +313,7 @@ static void set_rt_speed_feature(VP9_COMP *cpi, SPEED_FEATURES *sf,
     sf->intra_y_mode_mask[TX_32X32] = INTRA_DC;
     sf->frame_parameter_update = 0;
     sf->mv.search_method = FAST_HEX;
+    sf->mv.search_pyramid_levels = 2;
 
     sf->inter_mode_mask[BLOCK_32X32] = INTER_NEAREST_NEAR_NEW;
     sf->inter_mode_mask[BLOCK_32X64] = INTER_NEAREST;
@@ -369,6 +378,7 @@ static void set_rt_speed_feature(VP9_COMP *cpi, SPEED_FEATURES *sf,
     sf->adaptive_rd_thresh = 3;
     sf->mv.search_method = FAST_DIAMOND;
     sf->mv.fullpel_search_step_param = 10;
+    sf->mv.search_pyramid_levels = 0;
   }
   if (speed >= 8) {
     sf->adaptive_rd_thresh = 4;
@@ -426,6 +436,9 @@ void vp9_set_speed_features_framesize_independent(VP9_COMP *cpi) {
   sf->coeff_prob_appx_step = 1;
   sf->mv.auto_mv_step_size = 0;
   sf->mv.fullpel_search_step_param = 6;
+  sf->mv.search_pyramid_levels = 0;
+  sf->mv.use_lookahead_motion = 0;
+  sf->mv.lookahead_motion_skip_sad = 0;
   sf->comp_inter_joint_search_thresh = BLOCK_4X4;
   sf->adaptive_rd_thresh = 0;
   sf->tx_size_search_method = USE_FULL_RD;
@@ -193,6 +193,20 @@ typedef struct MV_SPEED_FEATURES {
 
   // This variable sets the step_param used in full pel motion search.
   int fullpel_search_step_param;
+
+  // Number of downsampled levels searched coarse-to-fine to pick the start
+  // point of the full pel search, which then only refines it. Blocks too
+  // small to be downsampled are searched as usual. 0 disables it.
+  int search_pyramid_levels;
+
+  // Start the full pel search from the motion found by the temporal filter
+  // and the mbgraph analysis of the lookahead frames, when it is known for
+  // the reference and matches better, and then only refine it.
+  int use_lookahead_motion;
+
+  // Average SAD per pixel below which the start point found with
+  // use_lookahead_motion is kept without any full pel search. 0 disables it.
+  int lookahead_motion_skip_sad;
 } MV_SPEED_FEATURES;
 
 typedef struct SPEED_FEATURES {
@@ -9,6 +9,8 @@
  */
 
 #include <math.h>
+#include <string.h>
+
 #include "./vp9_rtcd.h"
 #include "vpx_ports/mem.h"
 #include "vp9/encoder/vp9_ssim.h"
@@ -85,20 +87,67 @@ static double similarity(unsigned long sum_s, unsigned long sum_r,
   return ssim_n * 1.0 / ssim_d;
 }
 
-static double ssim_8x8(uint8_t *s, int sp, uint8_t *r, int rp) {
-  unsigned long sum_s = 0, sum_r = 0, sum_sq_s = 0, sum_sq_r = 0, sum_sxr = 0;
-  vp9_ssim_parms_8x8(s, sp, r, rp, &sum_s, &sum_r, &sum_sq_s, &sum_sq_r,
-                     &sum_sxr);
-  return similarity(sum_s, sum_r, sum_sq_s, sum_sq_r, sum_sxr, 64);
+// Sums over a 4x4 block of the source and reference. An 8x8 window on the
+// 4x4 grid covers 2x2 blocks, so each block is shared by up to four windows.
+typedef struct {
+  uint32_t sum_s;
+  uint32_t sum_r;
+  uint32_t sum_sq_s;
+  uint32_t sum_sq_r;
+  uint32_t sum_sxr;
+} BlockSums;
+
+typedef void (*block_sums_fn_t)(const uint8_t *s, int sp, const uint8_t *r,
+                                int rp, BlockSums *sums);
+
+static void block_sums_4x4(const uint8_t *s, int sp, const uint8_t *r, int rp,
+                           BlockSums *sums) {
+  int i, j;
+  memset(sums, 0, sizeof(*sums));
+  for (i = 0; i < 4; i++, s += sp, r += rp) {
+    for (j = 0; j < 4; j++) {
+      sums->sum_s += s[j];
+      sums->sum_r += r[j];
+      sums->sum_sq_s += s[j] * s[j];
+      sums->sum_sq_r += r[j] * r[j];
+      sums->sum_sxr += s[j] * r[j];
+    }
+  }
 }
 
 #if CONFIG_VP9_HIGHBITDEPTH
-static double highbd_ssim_8x8(uint16_t *s, int sp, uint16_t *r, int rp,
-                              unsigned int bd) {
-  uint32_t sum_s = 0, sum_r = 0, sum_sq_s = 0, sum_sq_r = 0, sum_sxr = 0;
-  const int oshift = bd - 8;
-  vp9_highbd_ssim_parms_8x8(s, sp, r, rp, &sum_s, &sum_r, &sum_sq_s, &sum_sq_r,
-                            &sum_sxr);
+static void highbd_block_sums_4x4(const uint8_t *s8, int sp,
+                                  const uint8_t *r8, int rp, BlockSums *sums) {
+  const uint16_t *s = CONVERT_TO_SHORTPTR(s8);
+  const uint16_t *r = CONVERT_TO_SHORTPTR(r8);
+  int i, j;
+  memset(sums, 0, sizeof(*sums));
+  for (i = 0; i < 4; i++, s += sp, r += rp) {
+    for (j = 0; j < 4; j++) {
+      sums->sum_s += s[j];
+      sums->sum_r += r[j];
+      sums->sum_sq_s += s[j] * s[j];
+      sums->sum_sq_r += r[j] * r[j];
+      sums->sum_sxr += s[j] * r[j];
+    }
+  }
+}
+#endif  // CONFIG_VP9_HIGHBITDEPTH
+
+// The ssim of the 8x8 window made of the blocks top[0], top[1], bottom[0] and
+// bottom[1]. The sums are scaled down to 8 bits by oshift.
+static double window_ssim(const BlockSums *top, const BlockSums *bottom,
+                          int oshift) {
+  const uint32_t sum_s = top[0].sum_s + top[1].sum_s +
+                         bottom[0].sum_s + bottom[1].sum_s;
+  const uint32_t sum_r = top[0].sum_r + top[1].sum_r +
+                         bottom[0].sum_r + bottom[1].sum_r;
+  const uint32_t sum_sq_s = top[0].sum_sq_s + top[1].sum_sq_s +
+                            bottom[0].sum_sq_s + bottom[1].sum_sq_s;
+  const uint32_t sum_sq_r = top[0].sum_sq_r + top[1].sum_sq_r +
+                            bottom[0].sum_sq_r + bottom[1].sum_sq_r;
+  const uint32_t sum_sxr = top[0].sum_sxr + top[1].sum_sxr +
+                           bottom[0].sum_sxr + bottom[1].sum_sxr;
   return similarity(sum_s >> oshift,
                     sum_r >> oshift,
                     sum_sq_s >> (2 * oshift),
@@ -106,27 +155,79 @@ static double highbd_ssim_8x8(uint16_t *s, int sp, uint16_t *r, int rp,
                     sum_sxr >> (2 * oshift),
                     64);
 }
-#endif  // CONFIG_VP9_HIGHBITDEPTH
+
+// Windows are summed in bands of SSIM_BAND_WINDOWS rows of windows, 64 rows
+// of pixels, and in strips of at most SSIM_STRIP_WINDOWS columns of windows.
+#define SSIM_BAND_WINDOWS 16
+#define SSIM_STRIP_WINDOWS 64
+
+static int ssim2_window_rows(int height) {
+  return height >= 8 ? (height - 8) / 4 + 1 : 0;
+}
+
+static int ssim2_window_cols(int width) {
+  return width >= 8 ? (width - 8) / 4 + 1 : 0;
+}
+
+static int ssim2_bands(int height) {
+  return (ssim2_window_rows(height) + SSIM_BAND_WINDOWS - 1) /
+         SSIM_BAND_WINDOWS;
+}
+
+// Return the sum of the ssim of the 8x8 windows in band. Each strip keeps the
+// sums of two rows of 4x4 blocks, so every block is summed once per strip
+// instead of once for each of the windows covering it.
+static double ssim2_band(const uint8_t *img1, const uint8_t *img2,
+                         int stride_img1, int stride_img2, int width,
+                         int height, int band, block_sums_fn_t block_sums,
+                         int oshift) {
+  const int cols = ssim2_window_cols(width);
+  const int row_start = band * SSIM_BAND_WINDOWS;
+  const int row_end = MIN(ssim2_window_rows(height),
+                          row_start + SSIM_BAND_WINDOWS);
+  double ssim_total = 0;
+  int col_start;
+
+  for (col_start = 0; col_start < cols; col_start += SSIM_STRIP_WINDOWS) {
+    const int n = MIN(cols - col_start, SSIM_STRIP_WINDOWS);
+    BlockSums block_rows[2][SSIM_STRIP_WINDOWS + 1];
+    BlockSums *top = block_rows[0];
+    BlockSums *bottom = block_rows[1];
+    int i, j;
+
+    for (i = row_start; i <= row_end; i++) {
+      const uint8_t *s = img1 + 4 * (i * stride_img1 + col_start);
+      const uint8_t *r = img2 + 4 * (i * stride_img2 + col_start);
+      BlockSums *const tmp = top;
+
+      for (j = 0; j <= n; j++)
+        block_sums(s + 4 * j, stride_img1, r + 4 * j, stride_img2, &bottom[j]);
+
+      if (i > row_start) {
+        for (j = 0; j < n; j++)
+          ssim_total += window_ssim(&top[j], &bottom[j], oshift);
+      }
+
+      top = bottom;
+      bottom = tmp;
+    }
+  }
+  return ssim_total;
+}
 
 // We are using a 8x8 moving window with starting location of each 8x8 window
 // on the 4x4 pixel grid. Such arrangement allows the windows to overlap
 // block boundaries to penalize blocking artifacts.
 double vp9_ssim2(uint8_t *img1, uint8_t *img2, int stride_img1,
                  int stride_img2, int width, int height) {
-  int i, j;
-  int samples = 0;
+  const int bands = ssim2_bands(height);
   double ssim_total = 0;
+  int band;
 
-  // sample point start with each 4x4 location
-  for (i = 0; i <= height - 8;
-       i += 4, img1 += stride_img1 * 4, img2 += stride_img2 * 4) {
-    for (j = 0; j <= width - 8; j += 4) {
-      double v = ssim_8x8(img1 + j, stride_img1, img2 + j, stride_img2);
-      ssim_total += v;
-      samples++;
-    }
-  }
-  ssim_total /= samples;
+  for (band = 0; band < bands; band++)
+    ssim_total += ssim2_band(img1, img2, stride_img1, stride_img2, width,
+                             height, band, block_sums_4x4, 0);
+  ssim_total /= ssim2_window_rows(height) * ssim2_window_cols(width);
   return ssim_total;
 }
 
@@ -134,26 +235,83 @@ double vp9_ssim2(uint8_t *img1, uint8_t *img2, int stride_img1,
 double vp9_highbd_ssim2(uint8_t *img1, uint8_t *img2, int stride_img1,
                         int stride_img2, int width, int height,
                         unsigned int bd) {
-  int i, j;
-  int samples = 0;
+  const int bands = ssim2_bands(height);
   double ssim_total = 0;
+  int band;
 
-  // sample point start with each 4x4 location
-  for (i = 0; i <= height - 8;
-       i += 4, img1 += stride_img1 * 4, img2 += stride_img2 * 4) {
-    for (j = 0; j <= width - 8; j += 4) {
-      double v = highbd_ssim_8x8(CONVERT_TO_SHORTPTR(img1 + j), stride_img1,
-                                 CONVERT_TO_SHORTPTR(img2 + j), stride_img2,
-                                 bd);
-      ssim_total += v;
-      samples++;
-    }
-  }
-  ssim_total /= samples;
+  for (band = 0; band < bands; band++)
+    ssim_total += ssim2_band(img1, img2, stride_img1, stride_img2, width,
+                             height, band, highbd_block_sums_4x4, bd - 8);
+  ssim_total /= ssim2_window_rows(height) * ssim2_window_cols(width);
   return ssim_total;
 }
 #endif  // CONFIG_VP9_HIGHBITDEPTH
 
+static const uint8_t *plane_buffer(const YV12_BUFFER_CONFIG *buf, int plane) {
+  return plane == 0 ? buf->y_buffer :
+         plane == 1 ? buf->u_buffer : buf->v_buffer;
+}
+
+static int plane_stride(const YV12_BUFFER_CONFIG *buf, int plane) {
+  return plane == 0 ? buf->y_stride : buf->uv_stride;
+}
+
+static int plane_width(const YV12_BUFFER_CONFIG *buf, int plane) {
+  return plane == 0 ? buf->y_crop_width : buf->uv_crop_width;
+}
+
+static int plane_height(const YV12_BUFFER_CONFIG *buf, int plane) {
+  return plane == 0 ? buf->y_crop_height : buf->uv_crop_height;
+}
+
+int vp9_ssim_plane_bands(const YV12_BUFFER_CONFIG *source, int plane) {
+  return ssim2_bands(plane_height(source, plane));
+}
+
+double vp9_ssim_plane_band(const YV12_BUFFER_CONFIG *source,
+                           const YV12_BUFFER_CONFIG *dest, int plane,
+                           int band, unsigned int bd) {
+#if CONFIG_VP9_HIGHBITDEPTH
+  if (source->flags & YV12_FLAG_HIGHBITDEPTH)
+    return ssim2_band(plane_buffer(source, plane), plane_buffer(dest, plane),
+                      plane_stride(source, plane), plane_stride(dest, plane),
+                      plane_width(source, plane), plane_height(source, plane),
+                      band, highbd_block_sums_4x4, bd - 8);
+#endif  // CONFIG_VP9_HIGHBITDEPTH
+  (void)bd;
+  return ssim2_band(plane_buffer(source, plane), plane_buffer(dest, plane),
+                    plane_stride(source, plane), plane_stride(dest, plane),
+                    plane_width(source, plane), plane_height(source, plane),
+                    band, block_sums_4x4, 0);
+}
+
+double vp9_ssim_plane_mean(const YV12_BUFFER_CONFIG *source, int plane,
+                           const double *band_ssim) {
+  const int bands = vp9_ssim_plane_bands(source, plane);
+  double ssim_total = 0;
+  int band;
+
+  for (band = 0; band < bands; band++)
+    ssim_total += band_ssim[band];
+  ssim_total /= ssim2_window_rows(plane_height(source, plane)) *
+                ssim2_window_cols(plane_width(source, plane));
+  return ssim_total;
+}
+
+double vp9_ssim_plane(const YV12_BUFFER_CONFIG *source,
+                      const YV12_BUFFER_CONFIG *dest, int plane,
+                      unsigned int bd) {
+  const int bands = vp9_ssim_plane_bands(source, plane);
+  double ssim_total = 0;
+  int band;
+
+  for (band = 0; band < bands; band++)
+    ssim_total += vp9_ssim_plane_band(source, dest, plane, band, bd);
+  ssim_total /= ssim2_window_rows(plane_height(source, plane)) *
+                ssim2_window_cols(plane_width(source, plane));
+  return ssim_total;
+}
+
 double vp9_calc_ssim(YV12_BUFFER_CONFIG *source, YV12_BUFFER_CONFIG *dest,
                      double *weight) {
   double a, b, c;
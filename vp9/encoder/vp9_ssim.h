@@ -69,12 +69,43 @@ double vp9_calc_ssim(YV12_BUFFER_CONFIG *source, YV12_BUFFER_CONFIG *dest,
 double vp9_calc_ssimg(YV12_BUFFER_CONFIG *source, YV12_BUFFER_CONFIG *dest,
                       double *ssim_y, double *ssim_u, double *ssim_v);
 
+// The ssim of a plane is the mean of the ssim of its 8x8 windows, which are
+// summed in bands of 64 rows. The band sums are added in order, so measuring
+// the bands on separate threads and passing them to vp9_ssim_plane_mean()
+// gives the same result as vp9_ssim_plane(). bd is used for high bitdepth
+// frames only.
+int vp9_ssim_plane_bands(const YV12_BUFFER_CONFIG *source, int plane);
+
+double vp9_ssim_plane_band(const YV12_BUFFER_CONFIG *source,
+                           const YV12_BUFFER_CONFIG *dest, int plane,
+                           int band, unsigned int bd);
+
+double vp9_ssim_plane_mean(const YV12_BUFFER_CONFIG *source, int plane,
+                           const double *band_ssim);
+
+double vp9_ssim_plane(const YV12_BUFFER_CONFIG *source,
+                      const YV12_BUFFER_CONFIG *dest, int plane,
+                      unsigned int bd);
+
 double vp9_calc_fastssim(YV12_BUFFER_CONFIG *source, YV12_BUFFER_CONFIG *dest,
                          double *ssim_y, double *ssim_u, double *ssim_v);
 
 double vp9_psnrhvs(YV12_BUFFER_CONFIG *source, YV12_BUFFER_CONFIG *dest,
                    double *ssim_y, double *ssim_u, double *ssim_v);
 
+// The fast ssim and psnr-hvs of one plane, and the frame score in decibels
+// that vp9_calc_fastssim() and vp9_psnrhvs() return for the plane scores.
+double vp9_calc_fastssim_plane(const YV12_BUFFER_CONFIG *source,
+                               const YV12_BUFFER_CONFIG *dest, int plane);
+
+double vp9_fastssim_frame_db(double ssim_y, double ssim_u, double ssim_v);
+
+double vp9_psnrhvs_plane(const YV12_BUFFER_CONFIG *source,
+                         const YV12_BUFFER_CONFIG *dest, int plane);
+
+double vp9_psnrhvs_frame_db(double psnrhvs_y, double psnrhvs_u,
+                            double psnrhvs_v);
+
 #if CONFIG_VP9_HIGHBITDEPTH
 double vp9_highbd_calc_ssim(YV12_BUFFER_CONFIG *source,
                             YV12_BUFFER_CONFIG *dest,
@@ -17,6 +17,10 @@ extern "C" {
 
 void vp9_temporal_filter_init(void);
 void vp9_temporal_filter(VP9_COMP *cpi, int distance);
+// Filters one row of 16x16 blocks of the alt-ref frame described by
+// cpi->arnr_filter_data, using the thread data td.
+void vp9_temporal_filter_iterate_row_c(VP9_COMP *cpi, ThreadData *td,
+                                       int mb_row);
 
 #ifdef __cplusplus
 }  // extern "C"
@@ -457,25 +457,25 @@ static void set_entropy_context_b(int plane, int block, BLOCK_SIZE plane_bsize,
                    aoff, loff);
 }
 
-static INLINE void add_token(TOKENEXTRA **t, const vp9_prob *context_tree,
+static INLINE void add_token(TOKENEXTRA **t, ptrdiff_t context_offset,
                              int32_t extra, uint8_t token,
                              uint8_t skip_eob_node,
                              unsigned int *counts) {
   (*t)->token = token;
   (*t)->extra = extra;
-  (*t)->context_tree = context_tree;
+  (*t)->context_offset = (uint16_t)context_offset;
   (*t)->skip_eob_node = skip_eob_node;
   (*t)++;
   ++counts[token];
 }
 
 static INLINE void add_token_no_extra(TOKENEXTRA **t,
-                                      const vp9_prob *context_tree,
+                                      ptrdiff_t context_offset,
                                       uint8_t token,
                                       uint8_t skip_eob_node,
                                       unsigned int *counts) {
   (*t)->token = token;
-  (*t)->context_tree = context_tree;
+  (*t)->context_offset = (uint16_t)context_offset;
   (*t)->skip_eob_node = skip_eob_node;
   (*t)++;
   ++counts[token];
@@ -513,6 +513,7 @@ static void tokenize_b(int plane, int block, BLOCK_SIZE plane_bsize,
       td->rd_counts.coef_counts[tx_size][type][ref];
   vp9_prob (*const coef_probs)[COEFF_CONTEXTS][UNCONSTRAINED_NODES] =
       cpi->common.fc->coef_probs[tx_size][type][ref];
+  const vp9_prob *const probs_base = cpi->common.fc->coef_probs[0][0][0][0][0];
   unsigned int (*const eob_branch)[COEFF_CONTEXTS] =
       td->counts->eob_branch[tx_size][type][ref];
   const uint8_t *const band = get_band_translate(tx_size);
@@ -535,7 +536,8 @@ static void tokenize_b(int plane, int block, BLOCK_SIZE plane_bsize,
     v = qcoeff[scan[c]];
 
     while (!v) {
-      add_token_no_extra(&t, coef_probs[band[c]][pt], ZERO_TOKEN, skip_eob,
+      add_token_no_extra(&t, coef_probs[band[c]][pt] - probs_base,
+                         ZERO_TOKEN, skip_eob,
                          counts[band[c]][pt]);
       eob_branch[band[c]][pt] += !skip_eob;
 
@@ -548,7 +550,7 @@ static void tokenize_b(int plane, int block, BLOCK_SIZE plane_bsize,
 
     vp9_get_token_extra(v, &token, &extra);
 
-    add_token(&t, coef_probs[band[c]][pt], extra, (uint8_t)token,
+    add_token(&t, coef_probs[band[c]][pt] - probs_base, extra, (uint8_t)token,
               (uint8_t)skip_eob, counts[band[c]][pt]);
     eob_branch[band[c]][pt] += !skip_eob;
 
@@ -557,7 +559,7 @@ static void tokenize_b(int plane, int block, BLOCK_SIZE plane_bsize,
     pt = get_coef_context(nb, token_cache, c);
   }
   if (c < seg_eob) {
-    add_token_no_extra(&t, coef_probs[band[c]][pt], EOB_TOKEN, 0,
+    add_token_no_extra(&t, coef_probs[band[c]][pt] - probs_base, EOB_TOKEN, 0,
                        counts[band[c]][pt]);
     ++eob_branch[band[c]][pt];
   }
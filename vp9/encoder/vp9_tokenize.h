@@ -34,13 +34,23 @@ typedef struct {
   EXTRABIT extra;
 } TOKENVALUE;
 
+// The context tree of a token is stored as its offset into the frame's
+// coefficient probabilities, fc->coef_probs, rather than as a pointer; this
+// keeps a token to 6 bytes (8 with high bitdepth) instead of 16, which
+// matters as the token buffer covers the whole frame.
 typedef struct {
-  const vp9_prob *context_tree;
   EXTRABIT extra;
+  uint16_t context_offset;
   uint8_t token;
   uint8_t skip_eob_node;
 } TOKENEXTRA;
 
+// The tokens of one superblock row of a tile.
+typedef struct {
+  TOKENEXTRA *start;
+  TOKENEXTRA *stop;
+} TOKENLIST;
+
 extern const vp9_tree_index vp9_coef_tree[];
 extern const vp9_tree_index vp9_coef_con_tree[];
 extern const struct vp9_token vp9_coef_encodings[];
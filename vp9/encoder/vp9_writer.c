@@ -9,15 +9,23 @@
  */
 
 #include <assert.h>
+#include <limits.h>
 #include "vp9/encoder/vp9_writer.h"
 #include "vp9/common/vp9_entropy.h"
 
 void vp9_start_encode(vp9_writer *br, uint8_t *source) {
+  vp9_start_bounded_encode(br, source, UINT_MAX);
+}
+
+void vp9_start_bounded_encode(vp9_writer *br, uint8_t *source,
+                              unsigned int size) {
   br->lowvalue = 0;
   br->range    = 255;
   br->count    = -24;
   br->buffer   = source;
   br->pos      = 0;
+  br->size     = size;
+  br->error    = 0;
   vp9_write_bit(br, 0);
 }
 
@@ -28,7 +36,11 @@ void vp9_stop_encode(vp9_writer *br) {
     vp9_write_bit(br, 0);
 
   // Ensure there's no ambigous collision with any index marker bytes
-  if ((br->buffer[br->pos - 1] & 0xe0) == 0xc0)
-    br->buffer[br->pos++] = 0;
+  if (br->pos > 0 && (br->buffer[br->pos - 1] & 0xe0) == 0xc0) {
+    if (br->pos < br->size)
+      br->buffer[br->pos++] = 0;
+    else
+      br->error = 1;
+  }
 }
 
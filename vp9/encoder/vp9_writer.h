@@ -24,10 +24,16 @@ typedef struct vp9_writer {
   unsigned int range;
   int count;
   unsigned int pos;
+  unsigned int size;
+  int error;
   uint8_t *buffer;
 } vp9_writer;
 
 void vp9_start_encode(vp9_writer *bc, uint8_t *buffer);
+// Like vp9_start_encode() but never writes past buffer[size - 1]. Once the
+// buffer is full the remaining output is dropped and bc->error is set.
+void vp9_start_bounded_encode(vp9_writer *bc, uint8_t *buffer,
+                              unsigned int size);
 void vp9_stop_encode(vp9_writer *bc);
 
 static INLINE void vp9_write(vp9_writer *br, int bit, int probability) {
@@ -65,7 +71,10 @@ static INLINE void vp9_write(vp9_writer *br, int bit, int probability) {
       br->buffer[x] += 1;
     }
 
-    br->buffer[br->pos++] = (lowvalue >> (24 - offset));
+    if (br->pos < br->size)
+      br->buffer[br->pos++] = (lowvalue >> (24 - offset));
+    else
+      br->error = 1;
     lowvalue <<= offset;
     shift = count;
     lowvalue &= 0xffffff;
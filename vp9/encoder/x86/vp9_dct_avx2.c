@@ -8,7 +8,10 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <assert.h>
 #include <immintrin.h>  // AVX2
+
+#include "./vp9_rtcd.h"
 #include "vp9/common/vp9_idct.h"  // for cospi constants
 #include "vpx_ports/mem.h"
 
@@ -24,3 +27,1208 @@
 #include "vp9/encoder/x86/vp9_dct32x32_avx2_impl.h" // NOLINT
 #undef  FDCT32x32_2D_AVX2
 #undef  FDCT32x32_HIGH_PRECISION
+
+// The 8x8 transforms keep two rows of 8 coefficients in each register. The
+// rows are loaded as natural pairs, [r0 r1], [r2 r3], [r4 r5] and [r6 r7].
+// The 1-D transforms move whole lanes around so that each multiply sees the
+// same operand pairs as the SSE2 and C versions, and return their outputs
+// as [o0 o4], [o1 o5], [o2 o6] and [o3 o7], which is what the transpose
+// below takes.
+
+// [(a0, b0) x 4 | (a1, b1) x 4]
+#define lane_pair256_set_epi16(a0, b0, a1, b1) \
+  _mm256_set_epi16((int16_t)(b1), (int16_t)(a1), (int16_t)(b1), (int16_t)(a1), \
+                   (int16_t)(b1), (int16_t)(a1), (int16_t)(b1), (int16_t)(a1), \
+                   (int16_t)(b0), (int16_t)(a0), (int16_t)(b0), (int16_t)(a0), \
+                   (int16_t)(b0), (int16_t)(a0), (int16_t)(b0), (int16_t)(a0))
+
+static INLINE __m256i swap_lanes_avx2(__m256i a) {
+  return _mm256_permute4x64_epi64(a, 0x4e);
+}
+
+static INLINE __m256i round_shift_avx2(__m256i a) {
+  const __m256i rounding = _mm256_set1_epi32(DCT_CONST_ROUNDING);
+  return _mm256_srai_epi32(_mm256_add_epi32(a, rounding), DCT_CONST_BITS);
+}
+
+// fdct_round_shift(a * k[0] + b * k[1]) for each column of a and b.
+static INLINE __m256i mult_round_shift_avx2(__m256i a, __m256i b, __m256i k) {
+  const __m256i lo = _mm256_madd_epi16(_mm256_unpacklo_epi16(a, b), k);
+  const __m256i hi = _mm256_madd_epi16(_mm256_unpackhi_epi16(a, b), k);
+  return _mm256_packs_epi32(round_shift_avx2(lo), round_shift_avx2(hi));
+}
+
+static INLINE void load_buffer_8x8_avx2(const int16_t *input, __m256i *in,
+                                        int stride) {
+  int i;
+  for (i = 0; i < 4; ++i) {
+    const __m128i r0 = _mm_loadu_si128((const __m128i *)(input +
+                                                         2 * i * stride));
+    const __m128i r1 = _mm_loadu_si128((const __m128i *)(input +
+                                                         (2 * i + 1) * stride));
+    in[i] = _mm256_inserti128_si256(_mm256_castsi128_si256(r0), r1, 1);
+    in[i] = _mm256_slli_epi16(in[i], 2);
+  }
+}
+
+static INLINE void write_buffer_8x8_avx2(tran_low_t *output,
+                                         const __m256i *in) {
+  int i;
+  for (i = 0; i < 4; ++i) {
+#if CONFIG_VP9_HIGHBITDEPTH
+    _mm256_storeu_si256((__m256i *)(output + i * 16),
+                        _mm256_cvtepi16_epi32(_mm256_castsi256_si128(in[i])));
+    _mm256_storeu_si256((__m256i *)(output + i * 16 + 8),
+                        _mm256_cvtepi16_epi32(
+                            _mm256_extracti128_si256(in[i], 1)));
+#else
+    _mm256_storeu_si256((__m256i *)(output + i * 16), in[i]);
+#endif  // CONFIG_VP9_HIGHBITDEPTH
+  }
+}
+
+// Transpose the [o0 o4] ... [o3 o7] output of the 1-D transforms back into
+// natural pairs of rows.
+static INLINE void transpose_8x8_avx2(__m256i *in) {
+  const __m256i tr0_0 = _mm256_unpacklo_epi16(in[0], in[1]);
+  const __m256i tr0_1 = _mm256_unpacklo_epi16(in[2], in[3]);
+  const __m256i tr0_2 = _mm256_unpackhi_epi16(in[0], in[1]);
+  const __m256i tr0_3 = _mm256_unpackhi_epi16(in[2], in[3]);
+  // Each 64 bits now hold one column of four rows: the low lane rows 0-3
+  // and the high lane rows 4-7. Bring the halves of each column together.
+  in[0] = _mm256_permute4x64_epi64(_mm256_unpacklo_epi32(tr0_0, tr0_1), 0xd8);
+  in[1] = _mm256_permute4x64_epi64(_mm256_unpackhi_epi32(tr0_0, tr0_1), 0xd8);
+  in[2] = _mm256_permute4x64_epi64(_mm256_unpacklo_epi32(tr0_2, tr0_3), 0xd8);
+  in[3] = _mm256_permute4x64_epi64(_mm256_unpackhi_epi32(tr0_2, tr0_3), 0xd8);
+}
+
+// (x + (x < 0)) >> 1, as in vp9_fdct8x8_c() and vp9_fht8x8_c().
+static INLINE void right_shift_8x8_avx2(__m256i *in) {
+  int i;
+  for (i = 0; i < 4; ++i) {
+    const __m256i sign = _mm256_srai_epi16(in[i], 15);
+    in[i] = _mm256_srai_epi16(_mm256_sub_epi16(in[i], sign), 1);
+  }
+}
+
+static void fdct8_avx2(__m256i *in) {
+  // perform 8x8 1-D DCT for 8 columns
+  const __m256i k__cospi_p16_p16_m16_p16 =
+      lane_pair256_set_epi16(cospi_16_64, cospi_16_64,
+                             -cospi_16_64, cospi_16_64);
+  const __m256i k__cospi_p08_p24_m08_p24 =
+      lane_pair256_set_epi16(cospi_8_64, cospi_24_64,
+                             -cospi_8_64, cospi_24_64);
+  const __m256i k__cospi_p16_m16_p16_p16 =
+      lane_pair256_set_epi16(cospi_16_64, -cospi_16_64,
+                             cospi_16_64, cospi_16_64);
+  const __m256i k__cospi_p28_p04_p12_p20 =
+      lane_pair256_set_epi16(cospi_28_64, cospi_4_64,
+                             cospi_12_64, cospi_20_64);
+  const __m256i k__cospi_m04_p28_m20_p12 =
+      lane_pair256_set_epi16(-cospi_4_64, cospi_28_64,
+                             -cospi_20_64, cospi_12_64);
+  __m256i s01, s23, s76, s54, x01, x32, t, x03, x12, a, b;
+
+  // stage 1
+  s01 = _mm256_add_epi16(in[0], swap_lanes_avx2(in[3]));
+  s23 = _mm256_add_epi16(in[1], swap_lanes_avx2(in[2]));
+  s76 = _mm256_sub_epi16(in[0], swap_lanes_avx2(in[3]));
+  s54 = _mm256_sub_epi16(in[1], swap_lanes_avx2(in[2]));
+
+  // fdct4(step, step);
+  x01 = _mm256_add_epi16(s01, swap_lanes_avx2(s23));
+  x32 = _mm256_sub_epi16(s01, swap_lanes_avx2(s23));
+  in[0] = mult_round_shift_avx2(x01, swap_lanes_avx2(x01),
+                                k__cospi_p16_p16_m16_p16);
+  in[2] = mult_round_shift_avx2(x32, swap_lanes_avx2(x32),
+                                k__cospi_p08_p24_m08_p24);
+
+  // Stage 2: [s6 s5]
+  a = _mm256_permute2x128_si256(s76, s54, 0x21);
+  t = mult_round_shift_avx2(a, swap_lanes_avx2(a), k__cospi_p16_m16_p16_p16);
+
+  // Stage 3: [s4 s7] +/- t
+  a = _mm256_permute2x128_si256(s76, s54, 0x03);
+  x03 = _mm256_add_epi16(a, t);
+  x12 = _mm256_sub_epi16(a, t);
+
+  // Stage 4
+  a = _mm256_permute2x128_si256(x03, x12, 0x20);
+  b = _mm256_permute2x128_si256(x03, x12, 0x31);
+  in[1] = mult_round_shift_avx2(a, b, k__cospi_p28_p04_p12_p20);
+  in[3] = swap_lanes_avx2(mult_round_shift_avx2(a, b,
+                                                k__cospi_m04_p28_m20_p12));
+}
+
+static void fadst8_avx2(__m256i *in) {
+  // Constants
+  const __m256i k__cospi_p02_p30_p10_p22 =
+      lane_pair256_set_epi16(cospi_2_64, cospi_30_64,
+                             cospi_10_64, cospi_22_64);
+  const __m256i k__cospi_p30_m02_p22_m10 =
+      lane_pair256_set_epi16(cospi_30_64, -cospi_2_64,
+                             cospi_22_64, -cospi_10_64);
+  const __m256i k__cospi_p18_p14_p26_p06 =
+      lane_pair256_set_epi16(cospi_18_64, cospi_14_64,
+                             cospi_26_64, cospi_6_64);
+  const __m256i k__cospi_p14_m18_p06_m26 =
+      lane_pair256_set_epi16(cospi_14_64, -cospi_18_64,
+                             cospi_6_64, -cospi_26_64);
+  const __m256i k__cospi_p08_p24_m24_p08 =
+      lane_pair256_set_epi16(cospi_8_64, cospi_24_64,
+                             -cospi_24_64, cospi_8_64);
+  const __m256i k__cospi_p24_m08_p08_p24 =
+      lane_pair256_set_epi16(cospi_24_64, -cospi_8_64,
+                             cospi_8_64, cospi_24_64);
+  const __m256i k__cospi_p16_p16 = _mm256_set1_epi16((int16_t)cospi_16_64);
+  const __m256i k__cospi_p16_m16 = pair256_set_epi16(cospi_16_64,
+                                                     -cospi_16_64);
+  const __m256i kZero = _mm256_setzero_si256();
+  __m256i u[4], v[8], w[8];
+  __m256i x02, x13, x46, x57, x01, x23, x45, x67, x26, x37;
+  int i;
+
+  // stage 1
+  // [in7 in5] [in0 in2] and [in3 in1] [in4 in6] pair up x0..x7.
+  u[0] = _mm256_permute2x128_si256(in[3], in[2], 0x31);
+  u[1] = _mm256_permute2x128_si256(in[0], in[1], 0x20);
+  u[2] = _mm256_permute2x128_si256(in[1], in[0], 0x31);
+  u[3] = _mm256_permute2x128_si256(in[2], in[3], 0x20);
+
+  w[0] = _mm256_unpacklo_epi16(u[0], u[1]);
+  w[1] = _mm256_unpackhi_epi16(u[0], u[1]);
+  w[2] = _mm256_unpacklo_epi16(u[2], u[3]);
+  w[3] = _mm256_unpackhi_epi16(u[2], u[3]);
+
+  v[0] = _mm256_madd_epi16(w[0], k__cospi_p02_p30_p10_p22);  // [s0 s2]
+  v[1] = _mm256_madd_epi16(w[1], k__cospi_p02_p30_p10_p22);
+  v[2] = _mm256_madd_epi16(w[0], k__cospi_p30_m02_p22_m10);  // [s1 s3]
+  v[3] = _mm256_madd_epi16(w[1], k__cospi_p30_m02_p22_m10);
+  v[4] = _mm256_madd_epi16(w[2], k__cospi_p18_p14_p26_p06);  // [s4 s6]
+  v[5] = _mm256_madd_epi16(w[3], k__cospi_p18_p14_p26_p06);
+  v[6] = _mm256_madd_epi16(w[2], k__cospi_p14_m18_p06_m26);  // [s5 s7]
+  v[7] = _mm256_madd_epi16(w[3], k__cospi_p14_m18_p06_m26);
+
+  for (i = 0; i < 4; ++i) {
+    w[i] = round_shift_avx2(_mm256_add_epi32(v[i], v[i + 4]));
+    w[i + 4] = round_shift_avx2(_mm256_sub_epi32(v[i], v[i + 4]));
+  }
+  x02 = _mm256_packs_epi32(w[0], w[1]);
+  x13 = _mm256_packs_epi32(w[2], w[3]);
+  x46 = _mm256_packs_epi32(w[4], w[5]);
+  x57 = _mm256_packs_epi32(w[6], w[7]);
+
+  // stage 2
+  u[0] = _mm256_permute2x128_si256(x02, x13, 0x20);
+  u[1] = _mm256_permute2x128_si256(x02, x13, 0x31);
+  x01 = _mm256_add_epi16(u[0], u[1]);
+  x23 = _mm256_sub_epi16(u[0], u[1]);
+
+  w[0] = _mm256_unpacklo_epi16(x46, x57);
+  w[1] = _mm256_unpackhi_epi16(x46, x57);
+  v[0] = _mm256_madd_epi16(w[0], k__cospi_p08_p24_m24_p08);  // [s4 s6]
+  v[1] = _mm256_madd_epi16(w[1], k__cospi_p08_p24_m24_p08);
+  v[2] = _mm256_madd_epi16(w[0], k__cospi_p24_m08_p08_p24);  // [s5 s7]
+  v[3] = _mm256_madd_epi16(w[1], k__cospi_p24_m08_p08_p24);
+  // [s4 s5] +/- [s6 s7]
+  for (i = 0; i < 2; ++i) {
+    const __m256i s45 = _mm256_permute2x128_si256(v[i], v[i + 2], 0x20);
+    const __m256i s67 = _mm256_permute2x128_si256(v[i], v[i + 2], 0x31);
+    w[i] = round_shift_avx2(_mm256_add_epi32(s45, s67));
+    w[i + 2] = round_shift_avx2(_mm256_sub_epi32(s45, s67));
+  }
+  x45 = _mm256_packs_epi32(w[0], w[1]);
+  x67 = _mm256_packs_epi32(w[2], w[3]);
+
+  // stage 3
+  u[0] = _mm256_permute2x128_si256(x23, x67, 0x20);
+  u[1] = _mm256_permute2x128_si256(x23, x67, 0x31);
+  x26 = mult_round_shift_avx2(u[0], u[1], k__cospi_p16_p16);
+  x37 = mult_round_shift_avx2(u[0], u[1], k__cospi_p16_m16);
+
+  // in[0] = [x0 x3], in[1] = -[x4 x7], in[2] = [x6 x5], in[3] = -[x2 x1]
+  in[0] = _mm256_permute2x128_si256(x01, x37, 0x20);
+  in[1] = _mm256_sub_epi16(kZero,
+                           _mm256_permute2x128_si256(x45, x37, 0x30));
+  in[2] = _mm256_permute2x128_si256(x26, x45, 0x31);
+  in[3] = _mm256_sub_epi16(kZero,
+                           _mm256_permute2x128_si256(x26, x01, 0x30));
+}
+
+void vp9_fdct8x8_avx2(const int16_t *input, tran_low_t *output, int stride) {
+  __m256i in[4];
+
+  load_buffer_8x8_avx2(input, in, stride);
+  fdct8_avx2(in);
+  transpose_8x8_avx2(in);
+  fdct8_avx2(in);
+  transpose_8x8_avx2(in);
+  right_shift_8x8_avx2(in);
+  write_buffer_8x8_avx2(output, in);
+}
+
+void vp9_fht8x8_avx2(const int16_t *input, tran_low_t *output,
+                     int stride, int tx_type) {
+  __m256i in[4];
+
+  if (tx_type == DCT_DCT) {
+    vp9_fdct8x8_avx2(input, output, stride);
+    return;
+  }
+
+  load_buffer_8x8_avx2(input, in, stride);
+  switch (tx_type) {
+    case ADST_DCT:
+      fadst8_avx2(in);
+      transpose_8x8_avx2(in);
+      fdct8_avx2(in);
+      break;
+    case DCT_ADST:
+      fdct8_avx2(in);
+      transpose_8x8_avx2(in);
+      fadst8_avx2(in);
+      break;
+    case ADST_ADST:
+      fadst8_avx2(in);
+      transpose_8x8_avx2(in);
+      fadst8_avx2(in);
+      break;
+    default:
+      assert(0);
+      break;
+  }
+  transpose_8x8_avx2(in);
+  right_shift_8x8_avx2(in);
+  write_buffer_8x8_avx2(output, in);
+}
+
+// The 16x16 transforms keep one whole row of 16 coefficients in each
+// register. Every step of the 1-D transforms below works within 128-bit
+// lanes, so they produce exactly the same results as the 8 column SSE2
+// versions, for all 16 columns at once.
+
+static INLINE void load_buffer_16x16_avx2(const int16_t *input, __m256i *in,
+                                          int stride) {
+  int i;
+  for (i = 0; i < 16; ++i) {
+    in[i] = _mm256_loadu_si256((const __m256i *)(input + i * stride));
+    in[i] = _mm256_slli_epi16(in[i], 2);
+  }
+}
+
+static INLINE void write_buffer_16x16_avx2(tran_low_t *output,
+                                           const __m256i *in) {
+  int i;
+  for (i = 0; i < 16; ++i) {
+#if CONFIG_VP9_HIGHBITDEPTH
+    _mm256_storeu_si256((__m256i *)(output + i * 16),
+                        _mm256_cvtepi16_epi32(_mm256_castsi256_si128(in[i])));
+    _mm256_storeu_si256((__m256i *)(output + i * 16 + 8),
+                        _mm256_cvtepi16_epi32(
+                            _mm256_extracti128_si256(in[i], 1)));
+#else
+    _mm256_storeu_si256((__m256i *)(output + i * 16), in[i]);
+#endif  // CONFIG_VP9_HIGHBITDEPTH
+  }
+}
+
+// Transpose the 8x8 blocks held in the low and high lanes of in[0..7].
+static INLINE void transpose_8x8_lanes_avx2(__m256i *in) {
+  const __m256i tr0_0 = _mm256_unpacklo_epi16(in[0], in[1]);
+  const __m256i tr0_1 = _mm256_unpacklo_epi16(in[2], in[3]);
+  const __m256i tr0_2 = _mm256_unpackhi_epi16(in[0], in[1]);
+  const __m256i tr0_3 = _mm256_unpackhi_epi16(in[2], in[3]);
+  const __m256i tr0_4 = _mm256_unpacklo_epi16(in[4], in[5]);
+  const __m256i tr0_5 = _mm256_unpacklo_epi16(in[6], in[7]);
+  const __m256i tr0_6 = _mm256_unpackhi_epi16(in[4], in[5]);
+  const __m256i tr0_7 = _mm256_unpackhi_epi16(in[6], in[7]);
+  const __m256i tr1_0 = _mm256_unpacklo_epi32(tr0_0, tr0_1);
+  const __m256i tr1_1 = _mm256_unpacklo_epi32(tr0_4, tr0_5);
+  const __m256i tr1_2 = _mm256_unpackhi_epi32(tr0_0, tr0_1);
+  const __m256i tr1_3 = _mm256_unpackhi_epi32(tr0_4, tr0_5);
+  const __m256i tr1_4 = _mm256_unpacklo_epi32(tr0_2, tr0_3);
+  const __m256i tr1_5 = _mm256_unpacklo_epi32(tr0_6, tr0_7);
+  const __m256i tr1_6 = _mm256_unpackhi_epi32(tr0_2, tr0_3);
+  const __m256i tr1_7 = _mm256_unpackhi_epi32(tr0_6, tr0_7);
+  in[0] = _mm256_unpacklo_epi64(tr1_0, tr1_1);
+  in[1] = _mm256_unpackhi_epi64(tr1_0, tr1_1);
+  in[2] = _mm256_unpacklo_epi64(tr1_2, tr1_3);
+  in[3] = _mm256_unpackhi_epi64(tr1_2, tr1_3);
+  in[4] = _mm256_unpacklo_epi64(tr1_4, tr1_5);
+  in[5] = _mm256_unpackhi_epi64(tr1_4, tr1_5);
+  in[6] = _mm256_unpacklo_epi64(tr1_6, tr1_7);
+  in[7] = _mm256_unpackhi_epi64(tr1_6, tr1_7);
+}
+
+static INLINE void transpose_16x16_avx2(__m256i *in) {
+  int i;
+  transpose_8x8_lanes_avx2(in);
+  transpose_8x8_lanes_avx2(in + 8);
+  // Rows 0-7 now hold the transposed top left and top right blocks, rows 8-15
+  // the bottom ones. Swap the top right and bottom left blocks.
+  for (i = 0; i < 8; ++i) {
+    const __m256i top = in[i];
+    in[i] = _mm256_permute2x128_si256(top, in[i + 8], 0x20);
+    in[i + 8] = _mm256_permute2x128_si256(top, in[i + 8], 0x31);
+  }
+}
+
+// Round the first pass output of the hybrid transforms:
+// (x + 1 + (x < 0)) >> 2, as in vp9_fht16x16_c().
+static INLINE void right_shift_16x16_avx2(__m256i *in) {
+  const __m256i one = _mm256_set1_epi16(1);
+  int i;
+  for (i = 0; i < 16; ++i) {
+    const __m256i sign = _mm256_srai_epi16(in[i], 15);
+    in[i] = _mm256_sub_epi16(_mm256_add_epi16(in[i], one), sign);
+    in[i] = _mm256_srai_epi16(in[i], 2);
+  }
+}
+
+static void fdct16_avx2(__m256i *in) {
+  // perform 16x16 1-D DCT for 16 columns
+  __m256i i[8], s[8], p[8], t[8], u[16], v[16];
+  const __m256i k__cospi_p16_p16 = _mm256_set1_epi16((int16_t)cospi_16_64);
+  const __m256i k__cospi_p16_m16 = pair256_set_epi16(cospi_16_64, -cospi_16_64);
+  const __m256i k__cospi_m16_p16 = pair256_set_epi16(-cospi_16_64, cospi_16_64);
+  const __m256i k__cospi_p24_p08 = pair256_set_epi16(cospi_24_64, cospi_8_64);
+  const __m256i k__cospi_p08_m24 = pair256_set_epi16(cospi_8_64, -cospi_24_64);
+  const __m256i k__cospi_m08_p24 = pair256_set_epi16(-cospi_8_64, cospi_24_64);
+  const __m256i k__cospi_p28_p04 = pair256_set_epi16(cospi_28_64, cospi_4_64);
+  const __m256i k__cospi_m04_p28 = pair256_set_epi16(-cospi_4_64, cospi_28_64);
+  const __m256i k__cospi_p12_p20 = pair256_set_epi16(cospi_12_64, cospi_20_64);
+  const __m256i k__cospi_m20_p12 = pair256_set_epi16(-cospi_20_64, cospi_12_64);
+  const __m256i k__cospi_p30_p02 = pair256_set_epi16(cospi_30_64, cospi_2_64);
+  const __m256i k__cospi_p14_p18 = pair256_set_epi16(cospi_14_64, cospi_18_64);
+  const __m256i k__cospi_m02_p30 = pair256_set_epi16(-cospi_2_64, cospi_30_64);
+  const __m256i k__cospi_m18_p14 = pair256_set_epi16(-cospi_18_64, cospi_14_64);
+  const __m256i k__cospi_p22_p10 = pair256_set_epi16(cospi_22_64, cospi_10_64);
+  const __m256i k__cospi_p06_p26 = pair256_set_epi16(cospi_6_64, cospi_26_64);
+  const __m256i k__cospi_m10_p22 = pair256_set_epi16(-cospi_10_64, cospi_22_64);
+  const __m256i k__cospi_m26_p06 = pair256_set_epi16(-cospi_26_64, cospi_6_64);
+  const __m256i k__DCT_CONST_ROUNDING = _mm256_set1_epi32(DCT_CONST_ROUNDING);
+
+  // stage 1
+  i[0] = _mm256_add_epi16(in[0], in[15]);
+  i[1] = _mm256_add_epi16(in[1], in[14]);
+  i[2] = _mm256_add_epi16(in[2], in[13]);
+  i[3] = _mm256_add_epi16(in[3], in[12]);
+  i[4] = _mm256_add_epi16(in[4], in[11]);
+  i[5] = _mm256_add_epi16(in[5], in[10]);
+  i[6] = _mm256_add_epi16(in[6], in[9]);
+  i[7] = _mm256_add_epi16(in[7], in[8]);
+
+  s[0] = _mm256_sub_epi16(in[7], in[8]);
+  s[1] = _mm256_sub_epi16(in[6], in[9]);
+  s[2] = _mm256_sub_epi16(in[5], in[10]);
+  s[3] = _mm256_sub_epi16(in[4], in[11]);
+  s[4] = _mm256_sub_epi16(in[3], in[12]);
+  s[5] = _mm256_sub_epi16(in[2], in[13]);
+  s[6] = _mm256_sub_epi16(in[1], in[14]);
+  s[7] = _mm256_sub_epi16(in[0], in[15]);
+
+  p[0] = _mm256_add_epi16(i[0], i[7]);
+  p[1] = _mm256_add_epi16(i[1], i[6]);
+  p[2] = _mm256_add_epi16(i[2], i[5]);
+  p[3] = _mm256_add_epi16(i[3], i[4]);
+  p[4] = _mm256_sub_epi16(i[3], i[4]);
+  p[5] = _mm256_sub_epi16(i[2], i[5]);
+  p[6] = _mm256_sub_epi16(i[1], i[6]);
+  p[7] = _mm256_sub_epi16(i[0], i[7]);
+
+  u[0] = _mm256_add_epi16(p[0], p[3]);
+  u[1] = _mm256_add_epi16(p[1], p[2]);
+  u[2] = _mm256_sub_epi16(p[1], p[2]);
+  u[3] = _mm256_sub_epi16(p[0], p[3]);
+
+  v[0] = _mm256_unpacklo_epi16(u[0], u[1]);
+  v[1] = _mm256_unpackhi_epi16(u[0], u[1]);
+  v[2] = _mm256_unpacklo_epi16(u[2], u[3]);
+  v[3] = _mm256_unpackhi_epi16(u[2], u[3]);
+
+  u[0] = _mm256_madd_epi16(v[0], k__cospi_p16_p16);
+  u[1] = _mm256_madd_epi16(v[1], k__cospi_p16_p16);
+  u[2] = _mm256_madd_epi16(v[0], k__cospi_p16_m16);
+  u[3] = _mm256_madd_epi16(v[1], k__cospi_p16_m16);
+  u[4] = _mm256_madd_epi16(v[2], k__cospi_p24_p08);
+  u[5] = _mm256_madd_epi16(v[3], k__cospi_p24_p08);
+  u[6] = _mm256_madd_epi16(v[2], k__cospi_m08_p24);
+  u[7] = _mm256_madd_epi16(v[3], k__cospi_m08_p24);
+
+  v[0] = _mm256_add_epi32(u[0], k__DCT_CONST_ROUNDING);
+  v[1] = _mm256_add_epi32(u[1], k__DCT_CONST_ROUNDING);
+  v[2] = _mm256_add_epi32(u[2], k__DCT_CONST_ROUNDING);
+  v[3] = _mm256_add_epi32(u[3], k__DCT_CONST_ROUNDING);
+  v[4] = _mm256_add_epi32(u[4], k__DCT_CONST_ROUNDING);
+  v[5] = _mm256_add_epi32(u[5], k__DCT_CONST_ROUNDING);
+  v[6] = _mm256_add_epi32(u[6], k__DCT_CONST_ROUNDING);
+  v[7] = _mm256_add_epi32(u[7], k__DCT_CONST_ROUNDING);
+
+  u[0] = _mm256_srai_epi32(v[0], DCT_CONST_BITS);
+  u[1] = _mm256_srai_epi32(v[1], DCT_CONST_BITS);
+  u[2] = _mm256_srai_epi32(v[2], DCT_CONST_BITS);
+  u[3] = _mm256_srai_epi32(v[3], DCT_CONST_BITS);
+  u[4] = _mm256_srai_epi32(v[4], DCT_CONST_BITS);
+  u[5] = _mm256_srai_epi32(v[5], DCT_CONST_BITS);
+  u[6] = _mm256_srai_epi32(v[6], DCT_CONST_BITS);
+  u[7] = _mm256_srai_epi32(v[7], DCT_CONST_BITS);
+
+  in[0] = _mm256_packs_epi32(u[0], u[1]);
+  in[4] = _mm256_packs_epi32(u[4], u[5]);
+  in[8] = _mm256_packs_epi32(u[2], u[3]);
+  in[12] = _mm256_packs_epi32(u[6], u[7]);
+
+  u[0] = _mm256_unpacklo_epi16(p[5], p[6]);
+  u[1] = _mm256_unpackhi_epi16(p[5], p[6]);
+  v[0] = _mm256_madd_epi16(u[0], k__cospi_m16_p16);
+  v[1] = _mm256_madd_epi16(u[1], k__cospi_m16_p16);
+  v[2] = _mm256_madd_epi16(u[0], k__cospi_p16_p16);
+  v[3] = _mm256_madd_epi16(u[1], k__cospi_p16_p16);
+
+  u[0] = _mm256_add_epi32(v[0], k__DCT_CONST_ROUNDING);
+  u[1] = _mm256_add_epi32(v[1], k__DCT_CONST_ROUNDING);
+  u[2] = _mm256_add_epi32(v[2], k__DCT_CONST_ROUNDING);
+  u[3] = _mm256_add_epi32(v[3], k__DCT_CONST_ROUNDING);
+
+  v[0] = _mm256_srai_epi32(u[0], DCT_CONST_BITS);
+  v[1] = _mm256_srai_epi32(u[1], DCT_CONST_BITS);
+  v[2] = _mm256_srai_epi32(u[2], DCT_CONST_BITS);
+  v[3] = _mm256_srai_epi32(u[3], DCT_CONST_BITS);
+
+  u[0] = _mm256_packs_epi32(v[0], v[1]);
+  u[1] = _mm256_packs_epi32(v[2], v[3]);
+
+  t[0] = _mm256_add_epi16(p[4], u[0]);
+  t[1] = _mm256_sub_epi16(p[4], u[0]);
+  t[2] = _mm256_sub_epi16(p[7], u[1]);
+  t[3] = _mm256_add_epi16(p[7], u[1]);
+
+  u[0] = _mm256_unpacklo_epi16(t[0], t[3]);
+  u[1] = _mm256_unpackhi_epi16(t[0], t[3]);
+  u[2] = _mm256_unpacklo_epi16(t[1], t[2]);
+  u[3] = _mm256_unpackhi_epi16(t[1], t[2]);
+
+  v[0] = _mm256_madd_epi16(u[0], k__cospi_p28_p04);
+  v[1] = _mm256_madd_epi16(u[1], k__cospi_p28_p04);
+  v[2] = _mm256_madd_epi16(u[2], k__cospi_p12_p20);
+  v[3] = _mm256_madd_epi16(u[3], k__cospi_p12_p20);
+  v[4] = _mm256_madd_epi16(u[2], k__cospi_m20_p12);
+  v[5] = _mm256_madd_epi16(u[3], k__cospi_m20_p12);
+  v[6] = _mm256_madd_epi16(u[0], k__cospi_m04_p28);
+  v[7] = _mm256_madd_epi16(u[1], k__cospi_m04_p28);
+
+  u[0] = _mm256_add_epi32(v[0], k__DCT_CONST_ROUNDING);
+  u[1] = _mm256_add_epi32(v[1], k__DCT_CONST_ROUNDING);
+  u[2] = _mm256_add_epi32(v[2], k__DCT_CONST_ROUNDING);
+  u[3] = _mm256_add_epi32(v[3], k__DCT_CONST_ROUNDING);
+  u[4] = _mm256_add_epi32(v[4], k__DCT_CONST_ROUNDING);
+  u[5] = _mm256_add_epi32(v[5], k__DCT_CONST_ROUNDING);
+  u[6] = _mm256_add_epi32(v[6], k__DCT_CONST_ROUNDING);
+  u[7] = _mm256_add_epi32(v[7], k__DCT_CONST_ROUNDING);
+
+  v[0] = _mm256_srai_epi32(u[0], DCT_CONST_BITS);
+  v[1] = _mm256_srai_epi32(u[1], DCT_CONST_BITS);
+  v[2] = _mm256_srai_epi32(u[2], DCT_CONST_BITS);
+  v[3] = _mm256_srai_epi32(u[3], DCT_CONST_BITS);
+  v[4] = _mm256_srai_epi32(u[4], DCT_CONST_BITS);
+  v[5] = _mm256_srai_epi32(u[5], DCT_CONST_BITS);
+  v[6] = _mm256_srai_epi32(u[6], DCT_CONST_BITS);
+  v[7] = _mm256_srai_epi32(u[7], DCT_CONST_BITS);
+
+  in[2] = _mm256_packs_epi32(v[0], v[1]);
+  in[6] = _mm256_packs_epi32(v[4], v[5]);
+  in[10] = _mm256_packs_epi32(v[2], v[3]);
+  in[14] = _mm256_packs_epi32(v[6], v[7]);
+
+  // stage 2
+  u[0] = _mm256_unpacklo_epi16(s[2], s[5]);
+  u[1] = _mm256_unpackhi_epi16(s[2], s[5]);
+  u[2] = _mm256_unpacklo_epi16(s[3], s[4]);
+  u[3] = _mm256_unpackhi_epi16(s[3], s[4]);
+
+  v[0] = _mm256_madd_epi16(u[0], k__cospi_m16_p16);
+  v[1] = _mm256_madd_epi16(u[1], k__cospi_m16_p16);
+  v[2] = _mm256_madd_epi16(u[2], k__cospi_m16_p16);
+  v[3] = _mm256_madd_epi16(u[3], k__cospi_m16_p16);
+  v[4] = _mm256_madd_epi16(u[2], k__cospi_p16_p16);
+  v[5] = _mm256_madd_epi16(u[3], k__cospi_p16_p16);
+  v[6] = _mm256_madd_epi16(u[0], k__cospi_p16_p16);
+  v[7] = _mm256_madd_epi16(u[1], k__cospi_p16_p16);
+
+  u[0] = _mm256_add_epi32(v[0], k__DCT_CONST_ROUNDING);
+  u[1] = _mm256_add_epi32(v[1], k__DCT_CONST_ROUNDING);
+  u[2] = _mm256_add_epi32(v[2], k__DCT_CONST_ROUNDING);
+  u[3] = _mm256_add_epi32(v[3], k__DCT_CONST_ROUNDING);
+  u[4] = _mm256_add_epi32(v[4], k__DCT_CONST_ROUNDING);
+  u[5] = _mm256_add_epi32(v[5], k__DCT_CONST_ROUNDING);
+  u[6] = _mm256_add_epi32(v[6], k__DCT_CONST_ROUNDING);
+  u[7] = _mm256_add_epi32(v[7], k__DCT_CONST_ROUNDING);
+
+  v[0] = _mm256_srai_epi32(u[0], DCT_CONST_BITS);
+  v[1] = _mm256_srai_epi32(u[1], DCT_CONST_BITS);
+  v[2] = _mm256_srai_epi32(u[2], DCT_CONST_BITS);
+  v[3] = _mm256_srai_epi32(u[3], DCT_CONST_BITS);
+  v[4] = _mm256_srai_epi32(u[4], DCT_CONST_BITS);
+  v[5] = _mm256_srai_epi32(u[5], DCT_CONST_BITS);
+  v[6] = _mm256_srai_epi32(u[6], DCT_CONST_BITS);
+  v[7] = _mm256_srai_epi32(u[7], DCT_CONST_BITS);
+
+  t[2] = _mm256_packs_epi32(v[0], v[1]);
+  t[3] = _mm256_packs_epi32(v[2], v[3]);
+  t[4] = _mm256_packs_epi32(v[4], v[5]);
+  t[5] = _mm256_packs_epi32(v[6], v[7]);
+
+  // stage 3
+  p[0] = _mm256_add_epi16(s[0], t[3]);
+  p[1] = _mm256_add_epi16(s[1], t[2]);
+  p[2] = _mm256_sub_epi16(s[1], t[2]);
+  p[3] = _mm256_sub_epi16(s[0], t[3]);
+  p[4] = _mm256_sub_epi16(s[7], t[4]);
+  p[5] = _mm256_sub_epi16(s[6], t[5]);
+  p[6] = _mm256_add_epi16(s[6], t[5]);
+  p[7] = _mm256_add_epi16(s[7], t[4]);
+
+  // stage 4
+  u[0] = _mm256_unpacklo_epi16(p[1], p[6]);
+  u[1] = _mm256_unpackhi_epi16(p[1], p[6]);
+  u[2] = _mm256_unpacklo_epi16(p[2], p[5]);
+  u[3] = _mm256_unpackhi_epi16(p[2], p[5]);
+
+  v[0] = _mm256_madd_epi16(u[0], k__cospi_m08_p24);
+  v[1] = _mm256_madd_epi16(u[1], k__cospi_m08_p24);
+  v[2] = _mm256_madd_epi16(u[2], k__cospi_p24_p08);
+  v[3] = _mm256_madd_epi16(u[3], k__cospi_p24_p08);
+  v[4] = _mm256_madd_epi16(u[2], k__cospi_p08_m24);
+  v[5] = _mm256_madd_epi16(u[3], k__cospi_p08_m24);
+  v[6] = _mm256_madd_epi16(u[0], k__cospi_p24_p08);
+  v[7] = _mm256_madd_epi16(u[1], k__cospi_p24_p08);
+
+  u[0] = _mm256_add_epi32(v[0], k__DCT_CONST_ROUNDING);
+  u[1] = _mm256_add_epi32(v[1], k__DCT_CONST_ROUNDING);
+  u[2] = _mm256_add_epi32(v[2], k__DCT_CONST_ROUNDING);
+  u[3] = _mm256_add_epi32(v[3], k__DCT_CONST_ROUNDING);
+  u[4] = _mm256_add_epi32(v[4], k__DCT_CONST_ROUNDING);
+  u[5] = _mm256_add_epi32(v[5], k__DCT_CONST_ROUNDING);
+  u[6] = _mm256_add_epi32(v[6], k__DCT_CONST_ROUNDING);
+  u[7] = _mm256_add_epi32(v[7], k__DCT_CONST_ROUNDING);
+
+  v[0] = _mm256_srai_epi32(u[0], DCT_CONST_BITS);
+  v[1] = _mm256_srai_epi32(u[1], DCT_CONST_BITS);
+  v[2] = _mm256_srai_epi32(u[2], DCT_CONST_BITS);
+  v[3] = _mm256_srai_epi32(u[3], DCT_CONST_BITS);
+  v[4] = _mm256_srai_epi32(u[4], DCT_CONST_BITS);
+  v[5] = _mm256_srai_epi32(u[5], DCT_CONST_BITS);
+  v[6] = _mm256_srai_epi32(u[6], DCT_CONST_BITS);
+  v[7] = _mm256_srai_epi32(u[7], DCT_CONST_BITS);
+
+  t[1] = _mm256_packs_epi32(v[0], v[1]);
+  t[2] = _mm256_packs_epi32(v[2], v[3]);
+  t[5] = _mm256_packs_epi32(v[4], v[5]);
+  t[6] = _mm256_packs_epi32(v[6], v[7]);
+
+  // stage 5
+  s[0] = _mm256_add_epi16(p[0], t[1]);
+  s[1] = _mm256_sub_epi16(p[0], t[1]);
+  s[2] = _mm256_add_epi16(p[3], t[2]);
+  s[3] = _mm256_sub_epi16(p[3], t[2]);
+  s[4] = _mm256_sub_epi16(p[4], t[5]);
+  s[5] = _mm256_add_epi16(p[4], t[5]);
+  s[6] = _mm256_sub_epi16(p[7], t[6]);
+  s[7] = _mm256_add_epi16(p[7], t[6]);
+
+  // stage 6
+  u[0] = _mm256_unpacklo_epi16(s[0], s[7]);
+  u[1] = _mm256_unpackhi_epi16(s[0], s[7]);
+  u[2] = _mm256_unpacklo_epi16(s[1], s[6]);
+  u[3] = _mm256_unpackhi_epi16(s[1], s[6]);
+  u[4] = _mm256_unpacklo_epi16(s[2], s[5]);
+  u[5] = _mm256_unpackhi_epi16(s[2], s[5]);
+  u[6] = _mm256_unpacklo_epi16(s[3], s[4]);
+  u[7] = _mm256_unpackhi_epi16(s[3], s[4]);
+
+  v[0] = _mm256_madd_epi16(u[0], k__cospi_p30_p02);
+  v[1] = _mm256_madd_epi16(u[1], k__cospi_p30_p02);
+  v[2] = _mm256_madd_epi16(u[2], k__cospi_p14_p18);
+  v[3] = _mm256_madd_epi16(u[3], k__cospi_p14_p18);
+  v[4] = _mm256_madd_epi16(u[4], k__cospi_p22_p10);
+  v[5] = _mm256_madd_epi16(u[5], k__cospi_p22_p10);
+  v[6] = _mm256_madd_epi16(u[6], k__cospi_p06_p26);
+  v[7] = _mm256_madd_epi16(u[7], k__cospi_p06_p26);
+  v[8] = _mm256_madd_epi16(u[6], k__cospi_m26_p06);
+  v[9] = _mm256_madd_epi16(u[7], k__cospi_m26_p06);
+  v[10] = _mm256_madd_epi16(u[4], k__cospi_m10_p22);
+  v[11] = _mm256_madd_epi16(u[5], k__cospi_m10_p22);
+  v[12] = _mm256_madd_epi16(u[2], k__cospi_m18_p14);
+  v[13] = _mm256_madd_epi16(u[3], k__cospi_m18_p14);
+  v[14] = _mm256_madd_epi16(u[0], k__cospi_m02_p30);
+  v[15] = _mm256_madd_epi16(u[1], k__cospi_m02_p30);
+
+  u[0] = _mm256_add_epi32(v[0], k__DCT_CONST_ROUNDING);
+  u[1] = _mm256_add_epi32(v[1], k__DCT_CONST_ROUNDING);
+  u[2] = _mm256_add_epi32(v[2], k__DCT_CONST_ROUNDING);
+  u[3] = _mm256_add_epi32(v[3], k__DCT_CONST_ROUNDING);
+  u[4] = _mm256_add_epi32(v[4], k__DCT_CONST_ROUNDING);
+  u[5] = _mm256_add_epi32(v[5], k__DCT_CONST_ROUNDING);
+  u[6] = _mm256_add_epi32(v[6], k__DCT_CONST_ROUNDING);
+  u[7] = _mm256_add_epi32(v[7], k__DCT_CONST_ROUNDING);
+  u[8] = _mm256_add_epi32(v[8], k__DCT_CONST_ROUNDING);
+  u[9] = _mm256_add_epi32(v[9], k__DCT_CONST_ROUNDING);
+  u[10] = _mm256_add_epi32(v[10], k__DCT_CONST_ROUNDING);
+  u[11] = _mm256_add_epi32(v[11], k__DCT_CONST_ROUNDING);
+  u[12] = _mm256_add_epi32(v[12], k__DCT_CONST_ROUNDING);
+  u[13] = _mm256_add_epi32(v[13], k__DCT_CONST_ROUNDING);
+  u[14] = _mm256_add_epi32(v[14], k__DCT_CONST_ROUNDING);
+  u[15] = _mm256_add_epi32(v[15], k__DCT_CONST_ROUNDING);
+
+  v[0] = _mm256_srai_epi32(u[0], DCT_CONST_BITS);
+  v[1] = _mm256_srai_epi32(u[1], DCT_CONST_BITS);
+  v[2] = _mm256_srai_epi32(u[2], DCT_CONST_BITS);
+  v[3] = _mm256_srai_epi32(u[3], DCT_CONST_BITS);
+  v[4] = _mm256_srai_epi32(u[4], DCT_CONST_BITS);
+  v[5] = _mm256_srai_epi32(u[5], DCT_CONST_BITS);
+  v[6] = _mm256_srai_epi32(u[6], DCT_CONST_BITS);
+  v[7] = _mm256_srai_epi32(u[7], DCT_CONST_BITS);
+  v[8] = _mm256_srai_epi32(u[8], DCT_CONST_BITS);
+  v[9] = _mm256_srai_epi32(u[9], DCT_CONST_BITS);
+  v[10] = _mm256_srai_epi32(u[10], DCT_CONST_BITS);
+  v[11] = _mm256_srai_epi32(u[11], DCT_CONST_BITS);
+  v[12] = _mm256_srai_epi32(u[12], DCT_CONST_BITS);
+  v[13] = _mm256_srai_epi32(u[13], DCT_CONST_BITS);
+  v[14] = _mm256_srai_epi32(u[14], DCT_CONST_BITS);
+  v[15] = _mm256_srai_epi32(u[15], DCT_CONST_BITS);
+
+  in[1]  = _mm256_packs_epi32(v[0], v[1]);
+  in[9]  = _mm256_packs_epi32(v[2], v[3]);
+  in[5]  = _mm256_packs_epi32(v[4], v[5]);
+  in[13] = _mm256_packs_epi32(v[6], v[7]);
+  in[3]  = _mm256_packs_epi32(v[8], v[9]);
+  in[11] = _mm256_packs_epi32(v[10], v[11]);
+  in[7]  = _mm256_packs_epi32(v[12], v[13]);
+  in[15] = _mm256_packs_epi32(v[14], v[15]);
+}
+
+static void fadst16_avx2(__m256i *in) {
+  // perform 16x16 1-D ADST for 16 columns
+  __m256i s[16], x[16], u[32], v[32];
+  const __m256i k__cospi_p01_p31 = pair256_set_epi16(cospi_1_64, cospi_31_64);
+  const __m256i k__cospi_p31_m01 = pair256_set_epi16(cospi_31_64, -cospi_1_64);
+  const __m256i k__cospi_p05_p27 = pair256_set_epi16(cospi_5_64, cospi_27_64);
+  const __m256i k__cospi_p27_m05 = pair256_set_epi16(cospi_27_64, -cospi_5_64);
+  const __m256i k__cospi_p09_p23 = pair256_set_epi16(cospi_9_64, cospi_23_64);
+  const __m256i k__cospi_p23_m09 = pair256_set_epi16(cospi_23_64, -cospi_9_64);
+  const __m256i k__cospi_p13_p19 = pair256_set_epi16(cospi_13_64, cospi_19_64);
+  const __m256i k__cospi_p19_m13 = pair256_set_epi16(cospi_19_64, -cospi_13_64);
+  const __m256i k__cospi_p17_p15 = pair256_set_epi16(cospi_17_64, cospi_15_64);
+  const __m256i k__cospi_p15_m17 = pair256_set_epi16(cospi_15_64, -cospi_17_64);
+  const __m256i k__cospi_p21_p11 = pair256_set_epi16(cospi_21_64, cospi_11_64);
+  const __m256i k__cospi_p11_m21 = pair256_set_epi16(cospi_11_64, -cospi_21_64);
+  const __m256i k__cospi_p25_p07 = pair256_set_epi16(cospi_25_64, cospi_7_64);
+  const __m256i k__cospi_p07_m25 = pair256_set_epi16(cospi_7_64, -cospi_25_64);
+  const __m256i k__cospi_p29_p03 = pair256_set_epi16(cospi_29_64, cospi_3_64);
+  const __m256i k__cospi_p03_m29 = pair256_set_epi16(cospi_3_64, -cospi_29_64);
+  const __m256i k__cospi_p04_p28 = pair256_set_epi16(cospi_4_64, cospi_28_64);
+  const __m256i k__cospi_p28_m04 = pair256_set_epi16(cospi_28_64, -cospi_4_64);
+  const __m256i k__cospi_p20_p12 = pair256_set_epi16(cospi_20_64, cospi_12_64);
+  const __m256i k__cospi_p12_m20 = pair256_set_epi16(cospi_12_64, -cospi_20_64);
+  const __m256i k__cospi_m28_p04 = pair256_set_epi16(-cospi_28_64, cospi_4_64);
+  const __m256i k__cospi_m12_p20 = pair256_set_epi16(-cospi_12_64, cospi_20_64);
+  const __m256i k__cospi_p08_p24 = pair256_set_epi16(cospi_8_64, cospi_24_64);
+  const __m256i k__cospi_p24_m08 = pair256_set_epi16(cospi_24_64, -cospi_8_64);
+  const __m256i k__cospi_m24_p08 = pair256_set_epi16(-cospi_24_64, cospi_8_64);
+  const __m256i k__cospi_m16_m16 = _mm256_set1_epi16((int16_t)-cospi_16_64);
+  const __m256i k__cospi_p16_p16 = _mm256_set1_epi16((int16_t)cospi_16_64);
+  const __m256i k__cospi_p16_m16 = pair256_set_epi16(cospi_16_64, -cospi_16_64);
+  const __m256i k__cospi_m16_p16 = pair256_set_epi16(-cospi_16_64, cospi_16_64);
+  const __m256i k__DCT_CONST_ROUNDING = _mm256_set1_epi32(DCT_CONST_ROUNDING);
+  const __m256i kZero = _mm256_set1_epi16(0);
+
+  u[0] = _mm256_unpacklo_epi16(in[15], in[0]);
+  u[1] = _mm256_unpackhi_epi16(in[15], in[0]);
+  u[2] = _mm256_unpacklo_epi16(in[13], in[2]);
+  u[3] = _mm256_unpackhi_epi16(in[13], in[2]);
+  u[4] = _mm256_unpacklo_epi16(in[11], in[4]);
+  u[5] = _mm256_unpackhi_epi16(in[11], in[4]);
+  u[6] = _mm256_unpacklo_epi16(in[9], in[6]);
+  u[7] = _mm256_unpackhi_epi16(in[9], in[6]);
+  u[8] = _mm256_unpacklo_epi16(in[7], in[8]);
+  u[9] = _mm256_unpackhi_epi16(in[7], in[8]);
+  u[10] = _mm256_unpacklo_epi16(in[5], in[10]);
+  u[11] = _mm256_unpackhi_epi16(in[5], in[10]);
+  u[12] = _mm256_unpacklo_epi16(in[3], in[12]);
+  u[13] = _mm256_unpackhi_epi16(in[3], in[12]);
+  u[14] = _mm256_unpacklo_epi16(in[1], in[14]);
+  u[15] = _mm256_unpackhi_epi16(in[1], in[14]);
+
+  v[0] = _mm256_madd_epi16(u[0], k__cospi_p01_p31);
+  v[1] = _mm256_madd_epi16(u[1], k__cospi_p01_p31);
+  v[2] = _mm256_madd_epi16(u[0], k__cospi_p31_m01);
+  v[3] = _mm256_madd_epi16(u[1], k__cospi_p31_m01);
+  v[4] = _mm256_madd_epi16(u[2], k__cospi_p05_p27);
+  v[5] = _mm256_madd_epi16(u[3], k__cospi_p05_p27);
+  v[6] = _mm256_madd_epi16(u[2], k__cospi_p27_m05);
+  v[7] = _mm256_madd_epi16(u[3], k__cospi_p27_m05);
+  v[8] = _mm256_madd_epi16(u[4], k__cospi_p09_p23);
+  v[9] = _mm256_madd_epi16(u[5], k__cospi_p09_p23);
+  v[10] = _mm256_madd_epi16(u[4], k__cospi_p23_m09);
+  v[11] = _mm256_madd_epi16(u[5], k__cospi_p23_m09);
+  v[12] = _mm256_madd_epi16(u[6], k__cospi_p13_p19);
+  v[13] = _mm256_madd_epi16(u[7], k__cospi_p13_p19);
+  v[14] = _mm256_madd_epi16(u[6], k__cospi_p19_m13);
+  v[15] = _mm256_madd_epi16(u[7], k__cospi_p19_m13);
+  v[16] = _mm256_madd_epi16(u[8], k__cospi_p17_p15);
+  v[17] = _mm256_madd_epi16(u[9], k__cospi_p17_p15);
+  v[18] = _mm256_madd_epi16(u[8], k__cospi_p15_m17);
+  v[19] = _mm256_madd_epi16(u[9], k__cospi_p15_m17);
+  v[20] = _mm256_madd_epi16(u[10], k__cospi_p21_p11);
+  v[21] = _mm256_madd_epi16(u[11], k__cospi_p21_p11);
+  v[22] = _mm256_madd_epi16(u[10], k__cospi_p11_m21);
+  v[23] = _mm256_madd_epi16(u[11], k__cospi_p11_m21);
+  v[24] = _mm256_madd_epi16(u[12], k__cospi_p25_p07);
+  v[25] = _mm256_madd_epi16(u[13], k__cospi_p25_p07);
+  v[26] = _mm256_madd_epi16(u[12], k__cospi_p07_m25);
+  v[27] = _mm256_madd_epi16(u[13], k__cospi_p07_m25);
+  v[28] = _mm256_madd_epi16(u[14], k__cospi_p29_p03);
+  v[29] = _mm256_madd_epi16(u[15], k__cospi_p29_p03);
+  v[30] = _mm256_madd_epi16(u[14], k__cospi_p03_m29);
+  v[31] = _mm256_madd_epi16(u[15], k__cospi_p03_m29);
+
+  u[0] = _mm256_add_epi32(v[0], v[16]);
+  u[1] = _mm256_add_epi32(v[1], v[17]);
+  u[2] = _mm256_add_epi32(v[2], v[18]);
+  u[3] = _mm256_add_epi32(v[3], v[19]);
+  u[4] = _mm256_add_epi32(v[4], v[20]);
+  u[5] = _mm256_add_epi32(v[5], v[21]);
+  u[6] = _mm256_add_epi32(v[6], v[22]);
+  u[7] = _mm256_add_epi32(v[7], v[23]);
+  u[8] = _mm256_add_epi32(v[8], v[24]);
+  u[9] = _mm256_add_epi32(v[9], v[25]);
+  u[10] = _mm256_add_epi32(v[10], v[26]);
+  u[11] = _mm256_add_epi32(v[11], v[27]);
+  u[12] = _mm256_add_epi32(v[12], v[28]);
+  u[13] = _mm256_add_epi32(v[13], v[29]);
+  u[14] = _mm256_add_epi32(v[14], v[30]);
+  u[15] = _mm256_add_epi32(v[15], v[31]);
+  u[16] = _mm256_sub_epi32(v[0], v[16]);
+  u[17] = _mm256_sub_epi32(v[1], v[17]);
+  u[18] = _mm256_sub_epi32(v[2], v[18]);
+  u[19] = _mm256_sub_epi32(v[3], v[19]);
+  u[20] = _mm256_sub_epi32(v[4], v[20]);
+  u[21] = _mm256_sub_epi32(v[5], v[21]);
+  u[22] = _mm256_sub_epi32(v[6], v[22]);
+  u[23] = _mm256_sub_epi32(v[7], v[23]);
+  u[24] = _mm256_sub_epi32(v[8], v[24]);
+  u[25] = _mm256_sub_epi32(v[9], v[25]);
+  u[26] = _mm256_sub_epi32(v[10], v[26]);
+  u[27] = _mm256_sub_epi32(v[11], v[27]);
+  u[28] = _mm256_sub_epi32(v[12], v[28]);
+  u[29] = _mm256_sub_epi32(v[13], v[29]);
+  u[30] = _mm256_sub_epi32(v[14], v[30]);
+  u[31] = _mm256_sub_epi32(v[15], v[31]);
+
+  v[0] = _mm256_add_epi32(u[0], k__DCT_CONST_ROUNDING);
+  v[1] = _mm256_add_epi32(u[1], k__DCT_CONST_ROUNDING);
+  v[2] = _mm256_add_epi32(u[2], k__DCT_CONST_ROUNDING);
+  v[3] = _mm256_add_epi32(u[3], k__DCT_CONST_ROUNDING);
+  v[4] = _mm256_add_epi32(u[4], k__DCT_CONST_ROUNDING);
+  v[5] = _mm256_add_epi32(u[5], k__DCT_CONST_ROUNDING);
+  v[6] = _mm256_add_epi32(u[6], k__DCT_CONST_ROUNDING);
+  v[7] = _mm256_add_epi32(u[7], k__DCT_CONST_ROUNDING);
+  v[8] = _mm256_add_epi32(u[8], k__DCT_CONST_ROUNDING);
+  v[9] = _mm256_add_epi32(u[9], k__DCT_CONST_ROUNDING);
+  v[10] = _mm256_add_epi32(u[10], k__DCT_CONST_ROUNDING);
+  v[11] = _mm256_add_epi32(u[11], k__DCT_CONST_ROUNDING);
+  v[12] = _mm256_add_epi32(u[12], k__DCT_CONST_ROUNDING);
+  v[13] = _mm256_add_epi32(u[13], k__DCT_CONST_ROUNDING);
+  v[14] = _mm256_add_epi32(u[14], k__DCT_CONST_ROUNDING);
+  v[15] = _mm256_add_epi32(u[15], k__DCT_CONST_ROUNDING);
+  v[16] = _mm256_add_epi32(u[16], k__DCT_CONST_ROUNDING);
+  v[17] = _mm256_add_epi32(u[17], k__DCT_CONST_ROUNDING);
+  v[18] = _mm256_add_epi32(u[18], k__DCT_CONST_ROUNDING);
+  v[19] = _mm256_add_epi32(u[19], k__DCT_CONST_ROUNDING);
+  v[20] = _mm256_add_epi32(u[20], k__DCT_CONST_ROUNDING);
+  v[21] = _mm256_add_epi32(u[21], k__DCT_CONST_ROUNDING);
+  v[22] = _mm256_add_epi32(u[22], k__DCT_CONST_ROUNDING);
+  v[23] = _mm256_add_epi32(u[23], k__DCT_CONST_ROUNDING);
+  v[24] = _mm256_add_epi32(u[24], k__DCT_CONST_ROUNDING);
+  v[25] = _mm256_add_epi32(u[25], k__DCT_CONST_ROUNDING);
+  v[26] = _mm256_add_epi32(u[26], k__DCT_CONST_ROUNDING);
+  v[27] = _mm256_add_epi32(u[27], k__DCT_CONST_ROUNDING);
+  v[28] = _mm256_add_epi32(u[28], k__DCT_CONST_ROUNDING);
+  v[29] = _mm256_add_epi32(u[29], k__DCT_CONST_ROUNDING);
+  v[30] = _mm256_add_epi32(u[30], k__DCT_CONST_ROUNDING);
+  v[31] = _mm256_add_epi32(u[31], k__DCT_CONST_ROUNDING);
+
+  u[0] = _mm256_srai_epi32(v[0], DCT_CONST_BITS);
+  u[1] = _mm256_srai_epi32(v[1], DCT_CONST_BITS);
+  u[2] = _mm256_srai_epi32(v[2], DCT_CONST_BITS);
+  u[3] = _mm256_srai_epi32(v[3], DCT_CONST_BITS);
+  u[4] = _mm256_srai_epi32(v[4], DCT_CONST_BITS);
+  u[5] = _mm256_srai_epi32(v[5], DCT_CONST_BITS);
+  u[6] = _mm256_srai_epi32(v[6], DCT_CONST_BITS);
+  u[7] = _mm256_srai_epi32(v[7], DCT_CONST_BITS);
+  u[8] = _mm256_srai_epi32(v[8], DCT_CONST_BITS);
+  u[9] = _mm256_srai_epi32(v[9], DCT_CONST_BITS);
+  u[10] = _mm256_srai_epi32(v[10], DCT_CONST_BITS);
+  u[11] = _mm256_srai_epi32(v[11], DCT_CONST_BITS);
+  u[12] = _mm256_srai_epi32(v[12], DCT_CONST_BITS);
+  u[13] = _mm256_srai_epi32(v[13], DCT_CONST_BITS);
+  u[14] = _mm256_srai_epi32(v[14], DCT_CONST_BITS);
+  u[15] = _mm256_srai_epi32(v[15], DCT_CONST_BITS);
+  u[16] = _mm256_srai_epi32(v[16], DCT_CONST_BITS);
+  u[17] = _mm256_srai_epi32(v[17], DCT_CONST_BITS);
+  u[18] = _mm256_srai_epi32(v[18], DCT_CONST_BITS);
+  u[19] = _mm256_srai_epi32(v[19], DCT_CONST_BITS);
+  u[20] = _mm256_srai_epi32(v[20], DCT_CONST_BITS);
+  u[21] = _mm256_srai_epi32(v[21], DCT_CONST_BITS);
+  u[22] = _mm256_srai_epi32(v[22], DCT_CONST_BITS);
+  u[23] = _mm256_srai_epi32(v[23], DCT_CONST_BITS);
+  u[24] = _mm256_srai_epi32(v[24], DCT_CONST_BITS);
+  u[25] = _mm256_srai_epi32(v[25], DCT_CONST_BITS);
+  u[26] = _mm256_srai_epi32(v[26], DCT_CONST_BITS);
+  u[27] = _mm256_srai_epi32(v[27], DCT_CONST_BITS);
+  u[28] = _mm256_srai_epi32(v[28], DCT_CONST_BITS);
+  u[29] = _mm256_srai_epi32(v[29], DCT_CONST_BITS);
+  u[30] = _mm256_srai_epi32(v[30], DCT_CONST_BITS);
+  u[31] = _mm256_srai_epi32(v[31], DCT_CONST_BITS);
+
+  s[0] = _mm256_packs_epi32(u[0], u[1]);
+  s[1] = _mm256_packs_epi32(u[2], u[3]);
+  s[2] = _mm256_packs_epi32(u[4], u[5]);
+  s[3] = _mm256_packs_epi32(u[6], u[7]);
+  s[4] = _mm256_packs_epi32(u[8], u[9]);
+  s[5] = _mm256_packs_epi32(u[10], u[11]);
+  s[6] = _mm256_packs_epi32(u[12], u[13]);
+  s[7] = _mm256_packs_epi32(u[14], u[15]);
+  s[8] = _mm256_packs_epi32(u[16], u[17]);
+  s[9] = _mm256_packs_epi32(u[18], u[19]);
+  s[10] = _mm256_packs_epi32(u[20], u[21]);
+  s[11] = _mm256_packs_epi32(u[22], u[23]);
+  s[12] = _mm256_packs_epi32(u[24], u[25]);
+  s[13] = _mm256_packs_epi32(u[26], u[27]);
+  s[14] = _mm256_packs_epi32(u[28], u[29]);
+  s[15] = _mm256_packs_epi32(u[30], u[31]);
+
+  // stage 2
+  u[0] = _mm256_unpacklo_epi16(s[8], s[9]);
+  u[1] = _mm256_unpackhi_epi16(s[8], s[9]);
+  u[2] = _mm256_unpacklo_epi16(s[10], s[11]);
+  u[3] = _mm256_unpackhi_epi16(s[10], s[11]);
+  u[4] = _mm256_unpacklo_epi16(s[12], s[13]);
+  u[5] = _mm256_unpackhi_epi16(s[12], s[13]);
+  u[6] = _mm256_unpacklo_epi16(s[14], s[15]);
+  u[7] = _mm256_unpackhi_epi16(s[14], s[15]);
+
+  v[0] = _mm256_madd_epi16(u[0], k__cospi_p04_p28);
+  v[1] = _mm256_madd_epi16(u[1], k__cospi_p04_p28);
+  v[2] = _mm256_madd_epi16(u[0], k__cospi_p28_m04);
+  v[3] = _mm256_madd_epi16(u[1], k__cospi_p28_m04);
+  v[4] = _mm256_madd_epi16(u[2], k__cospi_p20_p12);
+  v[5] = _mm256_madd_epi16(u[3], k__cospi_p20_p12);
+  v[6] = _mm256_madd_epi16(u[2], k__cospi_p12_m20);
+  v[7] = _mm256_madd_epi16(u[3], k__cospi_p12_m20);
+  v[8] = _mm256_madd_epi16(u[4], k__cospi_m28_p04);
+  v[9] = _mm256_madd_epi16(u[5], k__cospi_m28_p04);
+  v[10] = _mm256_madd_epi16(u[4], k__cospi_p04_p28);
+  v[11] = _mm256_madd_epi16(u[5], k__cospi_p04_p28);
+  v[12] = _mm256_madd_epi16(u[6], k__cospi_m12_p20);
+  v[13] = _mm256_madd_epi16(u[7], k__cospi_m12_p20);
+  v[14] = _mm256_madd_epi16(u[6], k__cospi_p20_p12);
+  v[15] = _mm256_madd_epi16(u[7], k__cospi_p20_p12);
+
+  u[0] = _mm256_add_epi32(v[0], v[8]);
+  u[1] = _mm256_add_epi32(v[1], v[9]);
+  u[2] = _mm256_add_epi32(v[2], v[10]);
+  u[3] = _mm256_add_epi32(v[3], v[11]);
+  u[4] = _mm256_add_epi32(v[4], v[12]);
+  u[5] = _mm256_add_epi32(v[5], v[13]);
+  u[6] = _mm256_add_epi32(v[6], v[14]);
+  u[7] = _mm256_add_epi32(v[7], v[15]);
+  u[8] = _mm256_sub_epi32(v[0], v[8]);
+  u[9] = _mm256_sub_epi32(v[1], v[9]);
+  u[10] = _mm256_sub_epi32(v[2], v[10]);
+  u[11] = _mm256_sub_epi32(v[3], v[11]);
+  u[12] = _mm256_sub_epi32(v[4], v[12]);
+  u[13] = _mm256_sub_epi32(v[5], v[13]);
+  u[14] = _mm256_sub_epi32(v[6], v[14]);
+  u[15] = _mm256_sub_epi32(v[7], v[15]);
+
+  v[0] = _mm256_add_epi32(u[0], k__DCT_CONST_ROUNDING);
+  v[1] = _mm256_add_epi32(u[1], k__DCT_CONST_ROUNDING);
+  v[2] = _mm256_add_epi32(u[2], k__DCT_CONST_ROUNDING);
+  v[3] = _mm256_add_epi32(u[3], k__DCT_CONST_ROUNDING);
+  v[4] = _mm256_add_epi32(u[4], k__DCT_CONST_ROUNDING);
+  v[5] = _mm256_add_epi32(u[5], k__DCT_CONST_ROUNDING);
+  v[6] = _mm256_add_epi32(u[6], k__DCT_CONST_ROUNDING);
+  v[7] = _mm256_add_epi32(u[7], k__DCT_CONST_ROUNDING);
+  v[8] = _mm256_add_epi32(u[8], k__DCT_CONST_ROUNDING);
+  v[9] = _mm256_add_epi32(u[9], k__DCT_CONST_ROUNDING);
+  v[10] = _mm256_add_epi32(u[10], k__DCT_CONST_ROUNDING);
+  v[11] = _mm256_add_epi32(u[11], k__DCT_CONST_ROUNDING);
+  v[12] = _mm256_add_epi32(u[12], k__DCT_CONST_ROUNDING);
+  v[13] = _mm256_add_epi32(u[13], k__DCT_CONST_ROUNDING);
+  v[14] = _mm256_add_epi32(u[14], k__DCT_CONST_ROUNDING);
+  v[15] = _mm256_add_epi32(u[15], k__DCT_CONST_ROUNDING);
+
+  u[0] = _mm256_srai_epi32(v[0], DCT_CONST_BITS);
+  u[1] = _mm256_srai_epi32(v[1], DCT_CONST_BITS);
+  u[2] = _mm256_srai_epi32(v[2], DCT_CONST_BITS);
+  u[3] = _mm256_srai_epi32(v[3], DCT_CONST_BITS);
+  u[4] = _mm256_srai_epi32(v[4], DCT_CONST_BITS);
+  u[5] = _mm256_srai_epi32(v[5], DCT_CONST_BITS);
+  u[6] = _mm256_srai_epi32(v[6], DCT_CONST_BITS);
+  u[7] = _mm256_srai_epi32(v[7], DCT_CONST_BITS);
+  u[8] = _mm256_srai_epi32(v[8], DCT_CONST_BITS);
+  u[9] = _mm256_srai_epi32(v[9], DCT_CONST_BITS);
+  u[10] = _mm256_srai_epi32(v[10], DCT_CONST_BITS);
+  u[11] = _mm256_srai_epi32(v[11], DCT_CONST_BITS);
+  u[12] = _mm256_srai_epi32(v[12], DCT_CONST_BITS);
+  u[13] = _mm256_srai_epi32(v[13], DCT_CONST_BITS);
+  u[14] = _mm256_srai_epi32(v[14], DCT_CONST_BITS);
+  u[15] = _mm256_srai_epi32(v[15], DCT_CONST_BITS);
+
+  x[0] = _mm256_add_epi16(s[0], s[4]);
+  x[1] = _mm256_add_epi16(s[1], s[5]);
+  x[2] = _mm256_add_epi16(s[2], s[6]);
+  x[3] = _mm256_add_epi16(s[3], s[7]);
+  x[4] = _mm256_sub_epi16(s[0], s[4]);
+  x[5] = _mm256_sub_epi16(s[1], s[5]);
+  x[6] = _mm256_sub_epi16(s[2], s[6]);
+  x[7] = _mm256_sub_epi16(s[3], s[7]);
+  x[8] = _mm256_packs_epi32(u[0], u[1]);
+  x[9] = _mm256_packs_epi32(u[2], u[3]);
+  x[10] = _mm256_packs_epi32(u[4], u[5]);
+  x[11] = _mm256_packs_epi32(u[6], u[7]);
+  x[12] = _mm256_packs_epi32(u[8], u[9]);
+  x[13] = _mm256_packs_epi32(u[10], u[11]);
+  x[14] = _mm256_packs_epi32(u[12], u[13]);
+  x[15] = _mm256_packs_epi32(u[14], u[15]);
+
+  // stage 3
+  u[0] = _mm256_unpacklo_epi16(x[4], x[5]);
+  u[1] = _mm256_unpackhi_epi16(x[4], x[5]);
+  u[2] = _mm256_unpacklo_epi16(x[6], x[7]);
+  u[3] = _mm256_unpackhi_epi16(x[6], x[7]);
+  u[4] = _mm256_unpacklo_epi16(x[12], x[13]);
+  u[5] = _mm256_unpackhi_epi16(x[12], x[13]);
+  u[6] = _mm256_unpacklo_epi16(x[14], x[15]);
+  u[7] = _mm256_unpackhi_epi16(x[14], x[15]);
+
+  v[0] = _mm256_madd_epi16(u[0], k__cospi_p08_p24);
+  v[1] = _mm256_madd_epi16(u[1], k__cospi_p08_p24);
+  v[2] = _mm256_madd_epi16(u[0], k__cospi_p24_m08);
+  v[3] = _mm256_madd_epi16(u[1], k__cospi_p24_m08);
+  v[4] = _mm256_madd_epi16(u[2], k__cospi_m24_p08);
+  v[5] = _mm256_madd_epi16(u[3], k__cospi_m24_p08);
+  v[6] = _mm256_madd_epi16(u[2], k__cospi_p08_p24);
+  v[7] = _mm256_madd_epi16(u[3], k__cospi_p08_p24);
+  v[8] = _mm256_madd_epi16(u[4], k__cospi_p08_p24);
+  v[9] = _mm256_madd_epi16(u[5], k__cospi_p08_p24);
+  v[10] = _mm256_madd_epi16(u[4], k__cospi_p24_m08);
+  v[11] = _mm256_madd_epi16(u[5], k__cospi_p24_m08);
+  v[12] = _mm256_madd_epi16(u[6], k__cospi_m24_p08);
+  v[13] = _mm256_madd_epi16(u[7], k__cospi_m24_p08);
+  v[14] = _mm256_madd_epi16(u[6], k__cospi_p08_p24);
+  v[15] = _mm256_madd_epi16(u[7], k__cospi_p08_p24);
+
+  u[0] = _mm256_add_epi32(v[0], v[4]);
+  u[1] = _mm256_add_epi32(v[1], v[5]);
+  u[2] = _mm256_add_epi32(v[2], v[6]);
+  u[3] = _mm256_add_epi32(v[3], v[7]);
+  u[4] = _mm256_sub_epi32(v[0], v[4]);
+  u[5] = _mm256_sub_epi32(v[1], v[5]);
+  u[6] = _mm256_sub_epi32(v[2], v[6]);
+  u[7] = _mm256_sub_epi32(v[3], v[7]);
+  u[8] = _mm256_add_epi32(v[8], v[12]);
+  u[9] = _mm256_add_epi32(v[9], v[13]);
+  u[10] = _mm256_add_epi32(v[10], v[14]);
+  u[11] = _mm256_add_epi32(v[11], v[15]);
+  u[12] = _mm256_sub_epi32(v[8], v[12]);
+  u[13] = _mm256_sub_epi32(v[9], v[13]);
+  u[14] = _mm256_sub_epi32(v[10], v[14]);
+  u[15] = _mm256_sub_epi32(v[11], v[15]);
+
+  u[0] = _mm256_add_epi32(u[0], k__DCT_CONST_ROUNDING);
+  u[1] = _mm256_add_epi32(u[1], k__DCT_CONST_ROUNDING);
+  u[2] = _mm256_add_epi32(u[2], k__DCT_CONST_ROUNDING);
+  u[3] = _mm256_add_epi32(u[3], k__DCT_CONST_ROUNDING);
+  u[4] = _mm256_add_epi32(u[4], k__DCT_CONST_ROUNDING);
+  u[5] = _mm256_add_epi32(u[5], k__DCT_CONST_ROUNDING);
+  u[6] = _mm256_add_epi32(u[6], k__DCT_CONST_ROUNDING);
+  u[7] = _mm256_add_epi32(u[7], k__DCT_CONST_ROUNDING);
+  u[8] = _mm256_add_epi32(u[8], k__DCT_CONST_ROUNDING);
+  u[9] = _mm256_add_epi32(u[9], k__DCT_CONST_ROUNDING);
+  u[10] = _mm256_add_epi32(u[10], k__DCT_CONST_ROUNDING);
+  u[11] = _mm256_add_epi32(u[11], k__DCT_CONST_ROUNDING);
+  u[12] = _mm256_add_epi32(u[12], k__DCT_CONST_ROUNDING);
+  u[13] = _mm256_add_epi32(u[13], k__DCT_CONST_ROUNDING);
+  u[14] = _mm256_add_epi32(u[14], k__DCT_CONST_ROUNDING);
+  u[15] = _mm256_add_epi32(u[15], k__DCT_CONST_ROUNDING);
+
+  v[0] = _mm256_srai_epi32(u[0], DCT_CONST_BITS);
+  v[1] = _mm256_srai_epi32(u[1], DCT_CONST_BITS);
+  v[2] = _mm256_srai_epi32(u[2], DCT_CONST_BITS);
+  v[3] = _mm256_srai_epi32(u[3], DCT_CONST_BITS);
+  v[4] = _mm256_srai_epi32(u[4], DCT_CONST_BITS);
+  v[5] = _mm256_srai_epi32(u[5], DCT_CONST_BITS);
+  v[6] = _mm256_srai_epi32(u[6], DCT_CONST_BITS);
+  v[7] = _mm256_srai_epi32(u[7], DCT_CONST_BITS);
+  v[8] = _mm256_srai_epi32(u[8], DCT_CONST_BITS);
+  v[9] = _mm256_srai_epi32(u[9], DCT_CONST_BITS);
+  v[10] = _mm256_srai_epi32(u[10], DCT_CONST_BITS);
+  v[11] = _mm256_srai_epi32(u[11], DCT_CONST_BITS);
+  v[12] = _mm256_srai_epi32(u[12], DCT_CONST_BITS);
+  v[13] = _mm256_srai_epi32(u[13], DCT_CONST_BITS);
+  v[14] = _mm256_srai_epi32(u[14], DCT_CONST_BITS);
+  v[15] = _mm256_srai_epi32(u[15], DCT_CONST_BITS);
+
+  s[0] = _mm256_add_epi16(x[0], x[2]);
+  s[1] = _mm256_add_epi16(x[1], x[3]);
+  s[2] = _mm256_sub_epi16(x[0], x[2]);
+  s[3] = _mm256_sub_epi16(x[1], x[3]);
+  s[4] = _mm256_packs_epi32(v[0], v[1]);
+  s[5] = _mm256_packs_epi32(v[2], v[3]);
+  s[6] = _mm256_packs_epi32(v[4], v[5]);
+  s[7] = _mm256_packs_epi32(v[6], v[7]);
+  s[8] = _mm256_add_epi16(x[8], x[10]);
+  s[9] = _mm256_add_epi16(x[9], x[11]);
+  s[10] = _mm256_sub_epi16(x[8], x[10]);
+  s[11] = _mm256_sub_epi16(x[9], x[11]);
+  s[12] = _mm256_packs_epi32(v[8], v[9]);
+  s[13] = _mm256_packs_epi32(v[10], v[11]);
+  s[14] = _mm256_packs_epi32(v[12], v[13]);
+  s[15] = _mm256_packs_epi32(v[14], v[15]);
+
+  // stage 4
+  u[0] = _mm256_unpacklo_epi16(s[2], s[3]);
+  u[1] = _mm256_unpackhi_epi16(s[2], s[3]);
+  u[2] = _mm256_unpacklo_epi16(s[6], s[7]);
+  u[3] = _mm256_unpackhi_epi16(s[6], s[7]);
+  u[4] = _mm256_unpacklo_epi16(s[10], s[11]);
+  u[5] = _mm256_unpackhi_epi16(s[10], s[11]);
+  u[6] = _mm256_unpacklo_epi16(s[14], s[15]);
+  u[7] = _mm256_unpackhi_epi16(s[14], s[15]);
+
+  v[0] = _mm256_madd_epi16(u[0], k__cospi_m16_m16);
+  v[1] = _mm256_madd_epi16(u[1], k__cospi_m16_m16);
+  v[2] = _mm256_madd_epi16(u[0], k__cospi_p16_m16);
+  v[3] = _mm256_madd_epi16(u[1], k__cospi_p16_m16);
+  v[4] = _mm256_madd_epi16(u[2], k__cospi_p16_p16);
+  v[5] = _mm256_madd_epi16(u[3], k__cospi_p16_p16);
+  v[6] = _mm256_madd_epi16(u[2], k__cospi_m16_p16);
+  v[7] = _mm256_madd_epi16(u[3], k__cospi_m16_p16);
+  v[8] = _mm256_madd_epi16(u[4], k__cospi_p16_p16);
+  v[9] = _mm256_madd_epi16(u[5], k__cospi_p16_p16);
+  v[10] = _mm256_madd_epi16(u[4], k__cospi_m16_p16);
+  v[11] = _mm256_madd_epi16(u[5], k__cospi_m16_p16);
+  v[12] = _mm256_madd_epi16(u[6], k__cospi_m16_m16);
+  v[13] = _mm256_madd_epi16(u[7], k__cospi_m16_m16);
+  v[14] = _mm256_madd_epi16(u[6], k__cospi_p16_m16);
+  v[15] = _mm256_madd_epi16(u[7], k__cospi_p16_m16);
+
+  u[0] = _mm256_add_epi32(v[0], k__DCT_CONST_ROUNDING);
+  u[1] = _mm256_add_epi32(v[1], k__DCT_CONST_ROUNDING);
+  u[2] = _mm256_add_epi32(v[2], k__DCT_CONST_ROUNDING);
+  u[3] = _mm256_add_epi32(v[3], k__DCT_CONST_ROUNDING);
+  u[4] = _mm256_add_epi32(v[4], k__DCT_CONST_ROUNDING);
+  u[5] = _mm256_add_epi32(v[5], k__DCT_CONST_ROUNDING);
+  u[6] = _mm256_add_epi32(v[6], k__DCT_CONST_ROUNDING);
+  u[7] = _mm256_add_epi32(v[7], k__DCT_CONST_ROUNDING);
+  u[8] = _mm256_add_epi32(v[8], k__DCT_CONST_ROUNDING);
+  u[9] = _mm256_add_epi32(v[9], k__DCT_CONST_ROUNDING);
+  u[10] = _mm256_add_epi32(v[10], k__DCT_CONST_ROUNDING);
+  u[11] = _mm256_add_epi32(v[11], k__DCT_CONST_ROUNDING);
+  u[12] = _mm256_add_epi32(v[12], k__DCT_CONST_ROUNDING);
+  u[13] = _mm256_add_epi32(v[13], k__DCT_CONST_ROUNDING);
+  u[14] = _mm256_add_epi32(v[14], k__DCT_CONST_ROUNDING);
+  u[15] = _mm256_add_epi32(v[15], k__DCT_CONST_ROUNDING);
+
+  v[0] = _mm256_srai_epi32(u[0], DCT_CONST_BITS);
+  v[1] = _mm256_srai_epi32(u[1], DCT_CONST_BITS);
+  v[2] = _mm256_srai_epi32(u[2], DCT_CONST_BITS);
+  v[3] = _mm256_srai_epi32(u[3], DCT_CONST_BITS);
+  v[4] = _mm256_srai_epi32(u[4], DCT_CONST_BITS);
+  v[5] = _mm256_srai_epi32(u[5], DCT_CONST_BITS);
+  v[6] = _mm256_srai_epi32(u[6], DCT_CONST_BITS);
+  v[7] = _mm256_srai_epi32(u[7], DCT_CONST_BITS);
+  v[8] = _mm256_srai_epi32(u[8], DCT_CONST_BITS);
+  v[9] = _mm256_srai_epi32(u[9], DCT_CONST_BITS);
+  v[10] = _mm256_srai_epi32(u[10], DCT_CONST_BITS);
+  v[11] = _mm256_srai_epi32(u[11], DCT_CONST_BITS);
+  v[12] = _mm256_srai_epi32(u[12], DCT_CONST_BITS);
+  v[13] = _mm256_srai_epi32(u[13], DCT_CONST_BITS);
+  v[14] = _mm256_srai_epi32(u[14], DCT_CONST_BITS);
+  v[15] = _mm256_srai_epi32(u[15], DCT_CONST_BITS);
+
+  in[0] = s[0];
+  in[1] = _mm256_sub_epi16(kZero, s[8]);
+  in[2] = s[12];
+  in[3] = _mm256_sub_epi16(kZero, s[4]);
+  in[4] = _mm256_packs_epi32(v[4], v[5]);
+  in[5] = _mm256_packs_epi32(v[12], v[13]);
+  in[6] = _mm256_packs_epi32(v[8], v[9]);
+  in[7] = _mm256_packs_epi32(v[0], v[1]);
+  in[8] = _mm256_packs_epi32(v[2], v[3]);
+  in[9] = _mm256_packs_epi32(v[10], v[11]);
+  in[10] = _mm256_packs_epi32(v[14], v[15]);
+  in[11] = _mm256_packs_epi32(v[6], v[7]);
+  in[12] = s[5];
+  in[13] = _mm256_sub_epi16(kZero, s[13]);
+  in[14] = s[9];
+  in[15] = _mm256_sub_epi16(kZero, s[1]);
+}
+
+
+void vp9_fdct16x16_avx2(const int16_t *input, tran_low_t *output,
+                        int stride) {
+  const __m256i one = _mm256_set1_epi16(1);
+  __m256i in[16];
+  int i;
+
+  load_buffer_16x16_avx2(input, in, stride);
+  fdct16_avx2(in);
+  transpose_16x16_avx2(in);
+  // The second pass of vp9_fdct16x16_c() starts from (x + 1) >> 2.
+  for (i = 0; i < 16; ++i)
+    in[i] = _mm256_srai_epi16(_mm256_add_epi16(in[i], one), 2);
+  fdct16_avx2(in);
+  transpose_16x16_avx2(in);
+  write_buffer_16x16_avx2(output, in);
+}
+
+void vp9_fht16x16_avx2(const int16_t *input, tran_low_t *output,
+                       int stride, int tx_type) {
+  __m256i in[16];
+
+  if (tx_type == DCT_DCT) {
+    vp9_fdct16x16_avx2(input, output, stride);
+    return;
+  }
+
+  load_buffer_16x16_avx2(input, in, stride);
+  switch (tx_type) {
+    case ADST_DCT:
+      fadst16_avx2(in);
+      transpose_16x16_avx2(in);
+      right_shift_16x16_avx2(in);
+      fdct16_avx2(in);
+      break;
+    case DCT_ADST:
+      fdct16_avx2(in);
+      transpose_16x16_avx2(in);
+      right_shift_16x16_avx2(in);
+      fadst16_avx2(in);
+      break;
+    case ADST_ADST:
+      fadst16_avx2(in);
+      transpose_16x16_avx2(in);
+      right_shift_16x16_avx2(in);
+      fadst16_avx2(in);
+      break;
+    default:
+      assert(0);
+      break;
+  }
+  transpose_16x16_avx2(in);
+  write_buffer_16x16_avx2(output, in);
+}
@@ -0,0 +1,288 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>  // AVX2
+#include <limits.h>
+
+#include "./vp9_rtcd.h"
+#include "vpx/vpx_integer.h"
+#include "vpx_ports/mem.h"
+
+#include "vp9/common/vp9_blockd.h"
+#include "vp9/common/vp9_mv.h"
+#include "vp9/encoder/vp9_block.h"
+#include "vp9/encoder/vp9_mcomp.h"
+
+// Both searches measure candidates in groups of four, with one sdx4df call
+// when all of them are in range, and pick the best of them with vector
+// compares. A candidate replaces the best one only if its
+// SAD plus MV cost is strictly lower, and among equal totals the first one
+// wins, which gives the same result as the sequential checks of the C
+// versions.
+//
+// MVs are kept as [row col] pairs of 16-bit lanes, one candidate per 32-bit
+// lane, matching the layout of MV in memory.
+
+// Four search sites are loaded at once as [mv0 off0 mv1 off1 ...].
+typedef char search_site_size_check[sizeof(search_site) == 8 ? 1 : -1];
+
+static INLINE __m128i mv_set1(int row, int col) {
+  return _mm_set_epi16(col, row, col, row, col, row, col, row);
+}
+
+// Mask of the candidates is_mv_in() accepts.
+static INLINE __m128i mvs_in(const MACROBLOCK *x, __m128i mvs) {
+  const __m128i min = mv_set1(x->mv_row_min, x->mv_col_min);
+  const __m128i max = mv_set1(x->mv_row_max, x->mv_col_max);
+  const __m128i out = _mm_or_si128(_mm_cmplt_epi16(mvs, min),
+                                   _mm_cmpgt_epi16(mvs, max));
+  // Both components of a candidate must be in range.
+  return _mm_cmpeq_epi32(out, _mm_setzero_si128());
+}
+
+// mvsad_err_cost() of the candidates in mask; the others get 0.
+static INLINE __m128i mvsad_err_cost_x4(const MACROBLOCK *x, __m128i mvs,
+                                        __m128i fcenter, __m128i sad_per_bit,
+                                        __m128i mask) {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i diff = _mm_sub_epi16(mvs, fcenter);
+  const __m128i rows = _mm_srai_epi32(_mm_slli_epi32(diff, 16), 16);
+  const __m128i cols = _mm_srai_epi32(diff, 16);
+  // vp9_get_mv_joint(): 2 for a non-zero row plus 1 for a non-zero column.
+  const __m128i row_zero = _mm_cmpeq_epi32(rows, zero);
+  const __m128i col_zero = _mm_cmpeq_epi32(cols, zero);
+  const __m128i joints = _mm_add_epi32(
+      _mm_set1_epi32(3), _mm_add_epi32(_mm_add_epi32(row_zero, row_zero),
+                                       col_zero));
+  __m128i cost = _mm_mask_i32gather_epi32(zero, x->nmvjointsadcost, joints,
+                                          mask, 4);
+  cost = _mm_add_epi32(cost, _mm_mask_i32gather_epi32(zero, x->nmvsadcost[0],
+                                                      rows, mask, 4));
+  cost = _mm_add_epi32(cost, _mm_mask_i32gather_epi32(zero, x->nmvsadcost[1],
+                                                      cols, mask, 4));
+  cost = _mm_mullo_epi32(cost, sad_per_bit);
+  return _mm_srai_epi32(_mm_add_epi32(cost, _mm_set1_epi32(1 << 7)), 8);
+}
+
+static INLINE unsigned int mvsad_err_cost(const MACROBLOCK *x, const MV *mv,
+                                          const MV *fcenter_mv,
+                                          int sad_per_bit) {
+  const __m128i cost = mvsad_err_cost_x4(
+      x, mv_set1(mv->row, mv->col), mv_set1(fcenter_mv->row, fcenter_mv->col),
+      _mm_set1_epi32(sad_per_bit), _mm_set1_epi32(-1));
+  return (unsigned int)_mm_cvtsi128_si32(cost);
+}
+
+// Returns non-zero if any of the four SADs is below best_sad. The MV costs are
+// not negative, so the other candidates cannot improve on it and their costs
+// need not be looked up, as in the C versions.
+static INLINE int any_below(__m128i sads, unsigned int best_sad) {
+  const __m128i best = _mm_set1_epi32(best_sad);
+  const __m128i not_below = _mm_cmpeq_epi32(_mm_max_epu32(sads, best), sads);
+  return _mm_movemask_ps(_mm_castsi128_ps(not_below)) != 0xf;
+}
+
+// Returns the index of the lowest of the four totals if it is below
+// *best_sad, and updates *best_sad; returns -1 otherwise.
+static INLINE int update_best(__m128i total, unsigned int *best_sad) {
+  __m128i min = _mm_min_epu32(total, _mm_shuffle_epi32(total, 0x4e));
+  int mask, i;
+  min = _mm_min_epu32(min, _mm_shuffle_epi32(min, 0xb1));
+  if ((unsigned int)_mm_cvtsi128_si32(min) >= *best_sad)
+    return -1;
+  *best_sad = (unsigned int)_mm_cvtsi128_si32(min);
+  mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(total, min)));
+  for (i = 0; !(mask & (1 << i)); ++i) {}
+  return i;
+}
+
+int vp9_diamond_search_sad_avx2(const MACROBLOCK *x,
+                                const search_site_config *cfg,
+                                MV *ref_mv, MV *best_mv, int search_param,
+                                int sad_per_bit, int *num00,
+                                const vp9_variance_fn_ptr_t *fn_ptr,
+                                const MV *center_mv) {
+  const MACROBLOCKD *const xd = &x->e_mbd;
+  const uint8_t *const what = x->plane[0].src.buf;
+  const int what_stride = x->plane[0].src.stride;
+  const int in_what_stride = xd->plane[0].pre[0].stride;
+  const search_site *const ss =
+      &cfg->ss[search_param * cfg->searches_per_step];
+  const int tot_steps = (cfg->ss_count / cfg->searches_per_step) - search_param;
+  const MV fcenter_mv = {center_mv->row >> 3, center_mv->col >> 3};
+  const __m128i v_fcenter = mv_set1(fcenter_mv.row, fcenter_mv.col);
+  const __m128i v_sad_per_bit = _mm_set1_epi32(sad_per_bit);
+  const __m256i v_deinterleave = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+  const uint8_t *in_what;
+  const uint8_t *best_address;
+  DECLARE_ALIGNED(16, int, offsets[4]);
+  DECLARE_ALIGNED(16, unsigned int, sads[4]);
+  const uint8_t *addrs[4];
+  unsigned int bestsad;
+  int best_site = 0;
+  int last_site = 0;
+  int i = 1;
+  int step, j, t;
+
+#if defined(NEW_DIAMOND_SEARCH)
+  return vp9_diamond_search_sad_c(x, cfg, ref_mv, best_mv, search_param,
+                                  sad_per_bit, num00, fn_ptr, center_mv);
+#endif
+
+  clamp_mv(ref_mv, x->mv_col_min, x->mv_col_max, x->mv_row_min, x->mv_row_max);
+  *num00 = 0;
+  *best_mv = *ref_mv;
+
+  // Work out the start point for the search
+  in_what = xd->plane[0].pre[0].buf + ref_mv->row * in_what_stride +
+            ref_mv->col;
+  best_address = in_what;
+
+  // Check the starting position
+  bestsad = fn_ptr->sdf(what, what_stride, in_what, in_what_stride) +
+            mvsad_err_cost(x, best_mv, &fcenter_mv, sad_per_bit);
+
+  for (step = 0; step < tot_steps; ++step) {
+    const __m128i v_best_mv = mv_set1(best_mv->row, best_mv->col);
+
+    for (j = 0; j < cfg->searches_per_step; j += 4, i += 4) {
+      // [mv0 mv1 mv2 mv3 | off0 off1 off2 off3]
+      const __m256i sites = _mm256_permutevar8x32_epi32(
+          _mm256_loadu_si256((const __m256i *)&ss[i]), v_deinterleave);
+      const __m128i mvs = _mm_add_epi16(_mm256_castsi256_si128(sites),
+                                        v_best_mv);
+      const __m128i in = mvs_in(x, mvs);
+      const int in_mask = _mm_movemask_ps(_mm_castsi128_ps(in));
+      __m128i v_sads;
+
+      if (!in_mask)
+        continue;
+
+      _mm_store_si128((__m128i *)offsets, _mm256_extracti128_si256(sites, 1));
+      if (in_mask == 0xf) {
+        for (t = 0; t < 4; ++t)
+          addrs[t] = best_address + offsets[t];
+        fn_ptr->sdx4df(what, what_stride, addrs, in_what_stride, sads);
+      } else {
+        // Candidates outside the search range are not measured and can never
+        // be selected.
+        for (t = 0; t < 4; ++t) {
+          sads[t] = (in_mask & (1 << t)) ?
+              fn_ptr->sdf(what, what_stride, best_address + offsets[t],
+                          in_what_stride) : UINT_MAX;
+        }
+      }
+
+      v_sads = _mm_load_si128((const __m128i *)sads);
+      if (any_below(v_sads, bestsad)) {
+        t = update_best(_mm_add_epi32(v_sads,
+                                      mvsad_err_cost_x4(x, mvs, v_fcenter,
+                                                        v_sad_per_bit, in)),
+                        &bestsad);
+        if (t >= 0)
+          best_site = i + t;
+      }
+    }
+
+    if (best_site != last_site) {
+      best_mv->row += ss[best_site].mv.row;
+      best_mv->col += ss[best_site].mv.col;
+      best_address += ss[best_site].offset;
+      last_site = best_site;
+    } else if (best_address == in_what) {
+      (*num00)++;
+    }
+  }
+  return bestsad;
+}
+
+int vp9_full_range_search_avx2(const MACROBLOCK *x,
+                               const search_site_config *cfg,
+                               MV *ref_mv, MV *best_mv,
+                               int search_param, int sad_per_bit, int *num00,
+                               const vp9_variance_fn_ptr_t *fn_ptr,
+                               const MV *center_mv) {
+  const MACROBLOCKD *const xd = &x->e_mbd;
+  const struct buf_2d *const what = &x->plane[0].src;
+  const struct buf_2d *const in_what = &xd->plane[0].pre[0];
+  const int range = 64;
+  const MV fcenter_mv = {center_mv->row >> 3, center_mv->col >> 3};
+  const __m128i v_fcenter = mv_set1(fcenter_mv.row, fcenter_mv.col);
+  const __m128i v_sad_per_bit = _mm_set1_epi32(sad_per_bit);
+  const __m128i ones = _mm_set1_epi32(-1);
+  const __m128i col_steps = _mm_setr_epi16(0, 0, 0, 1, 0, 2, 0, 3);
+  DECLARE_ALIGNED(16, unsigned int, sads[4]);
+  const uint8_t *addrs[4];
+  unsigned int best_sad;
+  int r, c, i;
+  int start_col, end_col, start_row, end_row;
+
+  // The cfg and search_param parameters are not used in this search variant
+  (void)cfg;
+  (void)search_param;
+
+  clamp_mv(ref_mv, x->mv_col_min, x->mv_col_max, x->mv_row_min, x->mv_row_max);
+  *best_mv = *ref_mv;
+  *num00 = 11;
+  best_sad = fn_ptr->sdf(what->buf, what->stride,
+                         &in_what->buf[ref_mv->row * in_what->stride +
+                                       ref_mv->col], in_what->stride) +
+             mvsad_err_cost(x, ref_mv, &fcenter_mv, sad_per_bit);
+  start_row = MAX(-range, x->mv_row_min - ref_mv->row);
+  start_col = MAX(-range, x->mv_col_min - ref_mv->col);
+  end_row = MIN(range, x->mv_row_max - ref_mv->row);
+  end_col = MIN(range, x->mv_col_max - ref_mv->col);
+
+  for (r = start_row; r <= end_row; ++r) {
+    const int row = ref_mv->row + r;
+    const uint8_t *const row_buf = &in_what->buf[row * in_what->stride +
+                                                 ref_mv->col];
+
+    for (c = start_col; c + 3 <= end_col; c += 4) {
+      const __m128i mvs = _mm_add_epi16(mv_set1(row, ref_mv->col + c),
+                                        col_steps);
+      __m128i v_sads;
+
+      for (i = 0; i < 4; ++i)
+        addrs[i] = row_buf + c + i;
+      fn_ptr->sdx4df(what->buf, what->stride, addrs, in_what->stride, sads);
+
+      v_sads = _mm_load_si128((const __m128i *)sads);
+      if (!any_below(v_sads, best_sad))
+        continue;
+      i = update_best(_mm_add_epi32(v_sads,
+                                    mvsad_err_cost_x4(x, mvs, v_fcenter,
+                                                      v_sad_per_bit, ones)),
+                      &best_sad);
+      if (i >= 0) {
+        best_mv->row = row;
+        best_mv->col = ref_mv->col + c + i;
+      }
+    }
+
+    // The C version checks end_col - c columns of a partial group.
+    if (c <= end_col) {
+      for (i = 0; i < end_col - c; ++i) {
+        const MV mv = {row, ref_mv->col + c + i};
+        unsigned int sad = fn_ptr->sdf(what->buf, what->stride,
+                                       row_buf + c + i, in_what->stride);
+        if (sad < best_sad) {
+          sad += mvsad_err_cost(x, &mv, &fcenter_mv, sad_per_bit);
+          if (sad < best_sad) {
+            best_sad = sad;
+            *best_mv = mv;
+          }
+        }
+      }
+    }
+  }
+
+  return best_sad;
+}
@@ -0,0 +1,82 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>  // AVX2
+
+#include "./vp9_rtcd.h"
+#include "vpx/vpx_integer.h"
+#include "vpx_ports/mem.h"
+
+// Returns the filter weights of 8 pixels of the source, a, and the
+// predictor, b, widened to 32 bits. The squared difference of 12 bit pixels
+// needs more than 16 bits.
+static INLINE __m256i highbd_modifier8(__m256i a, __m256i b, __m128i strength,
+                                       __m256i rounding, __m256i weight) {
+  const __m256i sixteen = _mm256_set1_epi32(16);
+  const __m256i diff = _mm256_sub_epi32(a, b);
+  __m256i modifier = _mm256_mullo_epi32(diff, diff);
+  modifier = _mm256_add_epi32(_mm256_add_epi32(modifier, modifier), modifier);
+  modifier = _mm256_srl_epi32(_mm256_add_epi32(modifier, rounding), strength);
+  modifier = _mm256_min_epu32(modifier, sixteen);
+  return _mm256_mullo_epi32(_mm256_sub_epi32(sixteen, modifier), weight);
+}
+
+void vp9_highbd_temporal_filter_apply_avx2(uint8_t *frame1_8,
+                                           unsigned int stride,
+                                           uint8_t *frame2_8,
+                                           unsigned int block_width,
+                                           unsigned int block_height,
+                                           int strength,
+                                           int filter_weight,
+                                           unsigned int *accumulator,
+                                           uint16_t *count) {
+  const uint16_t *frame1 = CONVERT_TO_SHORTPTR(frame1_8);
+  const uint16_t *frame2 = CONVERT_TO_SHORTPTR(frame2_8);
+  const __m128i shift = _mm_cvtsi32_si128(strength);
+  const __m256i rounding =
+      _mm256_set1_epi32(strength > 0 ? 1 << (strength - 1) : 0);
+  const __m256i weight = _mm256_set1_epi32(filter_weight);
+  unsigned int i, j;
+
+  if (block_width & 7) {
+    vp9_highbd_temporal_filter_apply_c(frame1_8, stride, frame2_8,
+                                       block_width, block_height, strength,
+                                       filter_weight, accumulator, count);
+    return;
+  }
+
+  for (i = 0; i < block_height; ++i) {
+    for (j = 0; j < block_width; j += 8) {
+      const __m256i a =
+          _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)frame1));
+      const __m256i b =
+          _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)frame2));
+      const __m256i modifier =
+          highbd_modifier8(a, b, shift, rounding, weight);
+      const __m128i count_reg = _mm_loadu_si128((const __m128i *)count);
+      // The weights are at most 32, so they pack to 16 bits unchanged.
+      const __m128i modifier16 =
+          _mm_packus_epi32(_mm256_castsi256_si128(modifier),
+                           _mm256_extracti128_si256(modifier, 1));
+      const __m256i acc = _mm256_loadu_si256((const __m256i *)accumulator);
+
+      _mm_storeu_si128((__m128i *)count,
+                       _mm_add_epi16(count_reg, modifier16));
+      _mm256_storeu_si256(
+          (__m256i *)accumulator,
+          _mm256_add_epi32(acc, _mm256_mullo_epi32(modifier, b)));
+      frame1 += 8;
+      frame2 += 8;
+      accumulator += 8;
+      count += 8;
+    }
+    frame1 += stride - block_width;
+  }
+}
@@ -0,0 +1,89 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <smmintrin.h>  // SSE4.1
+
+#include "./vp9_rtcd.h"
+#include "vpx/vpx_integer.h"
+#include "vpx_ports/mem.h"
+
+// Returns the filter weights of 4 pixels of the source, a, and the
+// predictor, b, widened to 32 bits. The squared difference of 12 bit pixels
+// needs more than 16 bits, and SSE4.1 has the 32 bit multiply and minimum.
+static INLINE __m128i highbd_modifier4(__m128i a, __m128i b, __m128i strength,
+                                       __m128i rounding, __m128i weight) {
+  const __m128i sixteen = _mm_set1_epi32(16);
+  const __m128i diff = _mm_sub_epi32(a, b);
+  __m128i modifier = _mm_mullo_epi32(diff, diff);
+  modifier = _mm_add_epi32(_mm_add_epi32(modifier, modifier), modifier);
+  modifier = _mm_srl_epi32(_mm_add_epi32(modifier, rounding), strength);
+  modifier = _mm_min_epu32(modifier, sixteen);
+  return _mm_mullo_epi32(_mm_sub_epi32(sixteen, modifier), weight);
+}
+
+void vp9_highbd_temporal_filter_apply_sse4_1(uint8_t *frame1_8,
+                                             unsigned int stride,
+                                             uint8_t *frame2_8,
+                                             unsigned int block_width,
+                                             unsigned int block_height,
+                                             int strength,
+                                             int filter_weight,
+                                             unsigned int *accumulator,
+                                             uint16_t *count) {
+  const uint16_t *frame1 = CONVERT_TO_SHORTPTR(frame1_8);
+  const uint16_t *frame2 = CONVERT_TO_SHORTPTR(frame2_8);
+  const __m128i shift = _mm_cvtsi32_si128(strength);
+  const __m128i rounding =
+      _mm_set1_epi32(strength > 0 ? 1 << (strength - 1) : 0);
+  const __m128i weight = _mm_set1_epi32(filter_weight);
+  unsigned int i, j;
+
+  if (block_width & 7) {
+    vp9_highbd_temporal_filter_apply_c(frame1_8, stride, frame2_8,
+                                       block_width, block_height, strength,
+                                       filter_weight, accumulator, count);
+    return;
+  }
+
+  for (i = 0; i < block_height; ++i) {
+    for (j = 0; j < block_width; j += 8) {
+      const __m128i a = _mm_loadu_si128((const __m128i *)frame1);
+      const __m128i b = _mm_loadu_si128((const __m128i *)frame2);
+      const __m128i zero = _mm_setzero_si128();
+      const __m128i b_lo = _mm_unpacklo_epi16(b, zero);
+      const __m128i b_hi = _mm_unpackhi_epi16(b, zero);
+      const __m128i modifier_lo = highbd_modifier4(
+          _mm_unpacklo_epi16(a, zero), b_lo, shift, rounding, weight);
+      const __m128i modifier_hi = highbd_modifier4(
+          _mm_unpackhi_epi16(a, zero), b_hi, shift, rounding, weight);
+      const __m128i count_reg = _mm_loadu_si128((const __m128i *)count);
+      const __m128i acc_lo = _mm_loadu_si128((const __m128i *)accumulator);
+      const __m128i acc_hi =
+          _mm_loadu_si128((const __m128i *)(accumulator + 4));
+
+      // The weights are at most 32, so they pack to 16 bits unchanged.
+      _mm_storeu_si128(
+          (__m128i *)count,
+          _mm_add_epi16(count_reg, _mm_packus_epi32(modifier_lo,
+                                                    modifier_hi)));
+      _mm_storeu_si128((__m128i *)accumulator,
+                       _mm_add_epi32(acc_lo, _mm_mullo_epi32(modifier_lo,
+                                                             b_lo)));
+      _mm_storeu_si128((__m128i *)(accumulator + 4),
+                       _mm_add_epi32(acc_hi, _mm_mullo_epi32(modifier_hi,
+                                                             b_hi)));
+      frame1 += 8;
+      frame2 += 8;
+      accumulator += 8;
+      count += 8;
+    }
+    frame1 += stride - block_width;
+  }
+}
@@ -0,0 +1,212 @@
+/*
+ *  Copyright (c) 2015 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#include <immintrin.h>  // AVX2
+
+#include "./vp9_rtcd.h"
+#include "vp9/common/vp9_common.h"
+#include "vp9/common/vp9_filter.h"
+#include "vpx_ports/mem.h"
+
+// Bilinear filter of the 16 pixel pairs (a, b) as done by the C first and
+// second passes: ROUND_POWER_OF_TWO(a * f[0] + b * f[1], FILTER_BITS).
+static INLINE __m256i bilinear16(__m256i a, __m256i b, __m256i f) {
+  const __m256i rounding = _mm256_set1_epi32(1 << (FILTER_BITS - 1));
+  __m256i lo = _mm256_madd_epi16(_mm256_unpacklo_epi16(a, b), f);
+  __m256i hi = _mm256_madd_epi16(_mm256_unpackhi_epi16(a, b), f);
+  lo = _mm256_srai_epi32(_mm256_add_epi32(lo, rounding), FILTER_BITS);
+  hi = _mm256_srai_epi32(_mm256_add_epi32(hi, rounding), FILTER_BITS);
+  return _mm256_packus_epi32(lo, hi);
+}
+
+static INLINE __m256i filter_row16(const uint16_t *src, int xoffset,
+                                   __m256i fx) {
+  const __m256i a = _mm256_loadu_si256((const __m256i *)src);
+  if (xoffset == 0)
+    return a;
+  return bilinear16(a, _mm256_loadu_si256((const __m256i *)(src + 1)), fx);
+}
+
+static INLINE __m256i load_filter(int offset) {
+  const int16_t *const f = BILINEAR_FILTERS_2TAP(offset);
+  return _mm256_set1_epi32((uint16_t)f[0] | (f[1] << 16));
+}
+
+// Sum and sum of squares of the differences between the bilinear filtered
+// src and dst over a w x h block, w a multiple of 16. When sec is not NULL
+// the prediction is first averaged with it, sec having a stride of w.
+static INLINE void highbd_subpel_variance(const uint16_t *src, int src_stride,
+                                          int xoffset, int yoffset,
+                                          const uint16_t *dst, int dst_stride,
+                                          const uint16_t *sec, int w, int h,
+                                          uint64_t *sse, int64_t *sum) {
+  const __m256i fx = load_filter(xoffset);
+  const __m256i fy = load_filter(yoffset);
+  const __m256i one = _mm256_set1_epi16(1);
+  const __m256i zero = _mm256_setzero_si256();
+  __m256i sum_acc = _mm256_setzero_si256();
+  __m256i sse_acc = _mm256_setzero_si256();
+  int i, j;
+
+  for (j = 0; j < w; j += 16) {
+    const uint16_t *s = src + j;
+    const uint16_t *d = dst + j;
+    const uint16_t *p = sec ? sec + j : NULL;
+    // The squares of 12-bit differences of one column of 16 pixels, at most
+    // 64 rows, still fit an unsigned 32-bit lane.
+    __m256i sse_col = _mm256_setzero_si256();
+    __m256i prev = filter_row16(s, xoffset, fx);
+    for (i = 0; i < h; ++i) {
+      __m256i pred, diff;
+      s += src_stride;
+      if (yoffset == 0) {
+        pred = prev;
+        if (i + 1 < h)
+          prev = filter_row16(s, xoffset, fx);
+      } else {
+        const __m256i cur = filter_row16(s, xoffset, fx);
+        pred = bilinear16(prev, cur, fy);
+        prev = cur;
+      }
+      if (p) {
+        pred = _mm256_avg_epu16(pred, _mm256_loadu_si256((const __m256i *)p));
+        p += w;
+      }
+      diff = _mm256_sub_epi16(pred, _mm256_loadu_si256((const __m256i *)d));
+      sum_acc = _mm256_add_epi32(sum_acc, _mm256_madd_epi16(diff, one));
+      sse_col = _mm256_add_epi32(sse_col, _mm256_madd_epi16(diff, diff));
+      d += dst_stride;
+    }
+    sse_acc = _mm256_add_epi64(sse_acc, _mm256_unpacklo_epi32(sse_col, zero));
+    sse_acc = _mm256_add_epi64(sse_acc, _mm256_unpackhi_epi32(sse_col, zero));
+  }
+
+  {
+    __m128i s32 = _mm_add_epi32(_mm256_castsi256_si128(sum_acc),
+                                _mm256_extracti128_si256(sum_acc, 1));
+    __m128i s64 = _mm_add_epi64(_mm256_castsi256_si128(sse_acc),
+                                _mm256_extracti128_si256(sse_acc, 1));
+    s32 = _mm_add_epi32(s32, _mm_srli_si128(s32, 8));
+    s32 = _mm_add_epi32(s32, _mm_srli_si128(s32, 4));
+    s64 = _mm_add_epi64(s64, _mm_srli_si128(s64, 8));
+    *sum = _mm_cvtsi128_si32(s32);
+    _mm_storel_epi64((__m128i *)sse, s64);
+  }
+}
+
+// The rounding of the 10 and 12-bit results follows highbd_10_variance() and
+// highbd_12_variance() in vpx_dsp/variance.c.
+#define HIGHBD_SUBPIX_VAR_AVX2(W, H) \
+unsigned int vp9_highbd_sub_pixel_variance##W##x##H##_avx2( \
+    const uint8_t *src, int src_stride, int xoffset, int yoffset, \
+    const uint8_t *dst, int dst_stride, unsigned int *sse) { \
+  uint64_t sse_long; \
+  int64_t sum_long; \
+  int sum; \
+  highbd_subpel_variance(CONVERT_TO_SHORTPTR(src), src_stride, xoffset, \
+                         yoffset, CONVERT_TO_SHORTPTR(dst), dst_stride, \
+                         NULL, W, H, &sse_long, &sum_long); \
+  *sse = (unsigned int)sse_long; \
+  sum = (int)sum_long; \
+  return *sse - (((int64_t)sum * sum) / (W * H)); \
+} \
+\
+unsigned int vp9_highbd_10_sub_pixel_variance##W##x##H##_avx2( \
+    const uint8_t *src, int src_stride, int xoffset, int yoffset, \
+    const uint8_t *dst, int dst_stride, unsigned int *sse) { \
+  uint64_t sse_long; \
+  int64_t sum_long; \
+  int sum; \
+  highbd_subpel_variance(CONVERT_TO_SHORTPTR(src), src_stride, xoffset, \
+                         yoffset, CONVERT_TO_SHORTPTR(dst), dst_stride, \
+                         NULL, W, H, &sse_long, &sum_long); \
+  *sse = (unsigned int)ROUND_POWER_OF_TWO(sse_long, 4); \
+  sum = (int)ROUND_POWER_OF_TWO(sum_long, 2); \
+  return *sse - (((int64_t)sum * sum) / (W * H)); \
+} \
+\
+unsigned int vp9_highbd_12_sub_pixel_variance##W##x##H##_avx2( \
+    const uint8_t *src, int src_stride, int xoffset, int yoffset, \
+    const uint8_t *dst, int dst_stride, unsigned int *sse) { \
+  uint64_t sse_long; \
+  int64_t sum_long; \
+  int sum; \
+  highbd_subpel_variance(CONVERT_TO_SHORTPTR(src), src_stride, xoffset, \
+                         yoffset, CONVERT_TO_SHORTPTR(dst), dst_stride, \
+                         NULL, W, H, &sse_long, &sum_long); \
+  *sse = (unsigned int)ROUND_POWER_OF_TWO(sse_long, 8); \
+  sum = (int)ROUND_POWER_OF_TWO(sum_long, 4); \
+  return *sse - (((int64_t)sum * sum) / (W * H)); \
+}
+
+#define HIGHBD_SUBPIX_AVG_VAR_AVX2(W, H) \
+unsigned int vp9_highbd_sub_pixel_avg_variance##W##x##H##_avx2( \
+    const uint8_t *src, int src_stride, int xoffset, int yoffset, \
+    const uint8_t *dst, int dst_stride, unsigned int *sse, \
+    const uint8_t *second_pred) { \
+  uint64_t sse_long; \
+  int64_t sum_long; \
+  int sum; \
+  highbd_subpel_variance(CONVERT_TO_SHORTPTR(src), src_stride, xoffset, \
+                         yoffset, CONVERT_TO_SHORTPTR(dst), dst_stride, \
+                         CONVERT_TO_SHORTPTR(second_pred), W, H, \
+                         &sse_long, &sum_long); \
+  *sse = (unsigned int)sse_long; \
+  sum = (int)sum_long; \
+  return *sse - (((int64_t)sum * sum) / (W * H)); \
+} \
+\
+unsigned int vp9_highbd_10_sub_pixel_avg_variance##W##x##H##_avx2( \
+    const uint8_t *src, int src_stride, int xoffset, int yoffset, \
+    const uint8_t *dst, int dst_stride, unsigned int *sse, \
+    const uint8_t *second_pred) { \
+  uint64_t sse_long; \
+  int64_t sum_long; \
+  int sum; \
+  highbd_subpel_variance(CONVERT_TO_SHORTPTR(src), src_stride, xoffset, \
+                         yoffset, CONVERT_TO_SHORTPTR(dst), dst_stride, \
+                         CONVERT_TO_SHORTPTR(second_pred), W, H, \
+                         &sse_long, &sum_long); \
+  *sse = (unsigned int)ROUND_POWER_OF_TWO(sse_long, 4); \
+  sum = (int)ROUND_POWER_OF_TWO(sum_long, 2); \
+  return *sse - (((int64_t)sum * sum) / (W * H)); \
+} \
+\
+unsigned int vp9_highbd_12_sub_pixel_avg_variance##W##x##H##_avx2( \
+    const uint8_t *src, int src_stride, int xoffset, int yoffset, \
+    const uint8_t *dst, int dst_stride, unsigned int *sse, \
+    const uint8_t *second_pred) { \
+  uint64_t sse_long; \
+  int64_t sum_long; \
+  int sum; \
+  highbd_subpel_variance(CONVERT_TO_SHORTPTR(src), src_stride, xoffset, \
+                         yoffset, CONVERT_TO_SHORTPTR(dst), dst_stride, \
+                         CONVERT_TO_SHORTPTR(second_pred), W, H, \
+                         &sse_long, &sum_long); \
+  *sse = (unsigned int)ROUND_POWER_OF_TWO(sse_long, 8); \
+  sum = (int)ROUND_POWER_OF_TWO(sum_long, 4); \
+  return *sse - (((int64_t)sum * sum) / (W * H)); \
+}
+
+HIGHBD_SUBPIX_VAR_AVX2(64, 64)
+HIGHBD_SUBPIX_AVG_VAR_AVX2(64, 64)
+HIGHBD_SUBPIX_VAR_AVX2(64, 32)
+HIGHBD_SUBPIX_AVG_VAR_AVX2(64, 32)
+HIGHBD_SUBPIX_VAR_AVX2(32, 64)
+HIGHBD_SUBPIX_AVG_VAR_AVX2(32, 64)
+HIGHBD_SUBPIX_VAR_AVX2(32, 32)
+HIGHBD_SUBPIX_AVG_VAR_AVX2(32, 32)
+HIGHBD_SUBPIX_VAR_AVX2(32, 16)
+HIGHBD_SUBPIX_AVG_VAR_AVX2(32, 16)
+HIGHBD_SUBPIX_VAR_AVX2(16, 32)
+HIGHBD_SUBPIX_AVG_VAR_AVX2(16, 32)
+HIGHBD_SUBPIX_VAR_AVX2(16, 16)
+HIGHBD_SUBPIX_AVG_VAR_AVX2(16, 16)
+HIGHBD_SUBPIX_VAR_AVX2(16, 8)
+HIGHBD_SUBPIX_AVG_VAR_AVX2(16, 8)
@@ -0,0 +1,187 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>  // AVX2
+
+#include "./vp9_rtcd.h"
+#include "vpx/vpx_integer.h"
+
+// Both quantizers work on 16 coefficients per iteration. The quantizer
+// parameters hold the DC value in element 0 and the AC value in element 1;
+// the first 16 coefficients use [DC, AC x 15] and all later ones AC only.
+
+static INLINE __m256i load_dc_ac(const int16_t *ptr) {
+  // [DC AC AC AC AC AC AC AC | AC AC AC AC AC AC AC AC]
+  const __m128i ac = _mm_set1_epi16(ptr[1]);
+  const __m128i dc_ac = _mm_insert_epi16(ac, ptr[0], 0);
+  return _mm256_inserti128_si256(_mm256_castsi128_si256(dc_ac), ac, 1);
+}
+
+static INLINE __m256i ac_only(__m256i v) {
+  return _mm256_permute2x128_si256(v, v, 0x11);
+}
+
+// Return the largest iscan + 1 among the non-zero qcoeff, or 0.
+static INLINE __m256i scan_for_eob(__m256i qcoeff, const int16_t *iscan_ptr,
+                                   __m256i eob) {
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i nzero = _mm256_xor_si256(_mm256_cmpeq_epi16(qcoeff, zero),
+                                         _mm256_set1_epi16(-1));
+  __m256i iscan = _mm256_loadu_si256((const __m256i *)iscan_ptr);
+  // Add one to convert from indices to counts
+  iscan = _mm256_sub_epi16(iscan, nzero);
+  return _mm256_max_epi16(eob, _mm256_and_si256(iscan, nzero));
+}
+
+static INLINE uint16_t accumulate_eob(__m256i eob) {
+  __m128i eob128 = _mm_max_epi16(_mm256_castsi256_si128(eob),
+                                 _mm256_extracti128_si256(eob, 1));
+  eob128 = _mm_max_epi16(eob128, _mm_shuffle_epi32(eob128, 0xe));
+  eob128 = _mm_max_epi16(eob128, _mm_shufflelo_epi16(eob128, 0xe));
+  eob128 = _mm_max_epi16(eob128, _mm_shufflelo_epi16(eob128, 0x1));
+  return (uint16_t)_mm_extract_epi16(eob128, 0);
+}
+
+// abs(coeff), with abs(INT16_MIN) saturated to INT16_MAX. The C code clamps
+// abs(coeff) + round to INT16_MAX, so with a non-negative round the result
+// is the same.
+static INLINE __m256i abs_saturate(__m256i coeff) {
+  return _mm256_max_epi16(coeff,
+                          _mm256_subs_epi16(_mm256_setzero_si256(), coeff));
+}
+
+static INLINE void store_zero(tran_low_t *qcoeff_ptr,
+                              tran_low_t *dqcoeff_ptr, intptr_t n_coeffs) {
+  const __m256i zero = _mm256_setzero_si256();
+  intptr_t i;
+  for (i = 0; i < n_coeffs; i += 16) {
+    _mm256_storeu_si256((__m256i *)(qcoeff_ptr + i), zero);
+    _mm256_storeu_si256((__m256i *)(dqcoeff_ptr + i), zero);
+  }
+}
+
+void vp9_quantize_b_avx2(const tran_low_t *coeff_ptr, intptr_t n_coeffs,
+                         int skip_block, const int16_t *zbin_ptr,
+                         const int16_t *round_ptr, const int16_t *quant_ptr,
+                         const int16_t *quant_shift_ptr,
+                         tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr,
+                         const int16_t *dequant_ptr, uint16_t *eob_ptr,
+                         const int16_t *scan_ptr, const int16_t *iscan_ptr) {
+  __m256i zbin, round, quant, shift, dequant;
+  __m256i eob = _mm256_setzero_si256();
+  intptr_t i;
+  (void)scan_ptr;
+
+  if (skip_block) {
+    store_zero(qcoeff_ptr, dqcoeff_ptr, n_coeffs);
+    *eob_ptr = 0;
+    return;
+  }
+
+  // abs(coeff) >= zbin is abs(coeff) > zbin - 1.
+  zbin = _mm256_sub_epi16(load_dc_ac(zbin_ptr), _mm256_set1_epi16(1));
+  round = load_dc_ac(round_ptr);
+  quant = load_dc_ac(quant_ptr);
+  shift = load_dc_ac(quant_shift_ptr);
+  dequant = load_dc_ac(dequant_ptr);
+
+  for (i = 0; i < n_coeffs; i += 16) {
+    const __m256i coeff = _mm256_loadu_si256((const __m256i *)(coeff_ptr + i));
+    const __m256i coeff_sign = _mm256_srai_epi16(coeff, 15);
+    const __m256i abs_coeff = abs_saturate(coeff);
+    const __m256i mask = _mm256_cmpgt_epi16(abs_coeff, zbin);
+
+    if (_mm256_movemask_epi8(mask)) {
+      __m256i qcoeff = _mm256_adds_epi16(abs_coeff, round);
+      // The encoder's quant is 1 + 2^(16 + l) / d - 2^16 with l = log2(d),
+      // which lies in (-2^15, 1], so tmp + qcoeff cannot exceed INT16_MAX.
+      __m256i tmp = _mm256_mulhi_epi16(qcoeff, quant);
+      qcoeff = _mm256_mulhi_epi16(_mm256_add_epi16(tmp, qcoeff), shift);
+      // Reinsert signs and mask out the coefficients below zbin.
+      qcoeff = _mm256_sub_epi16(_mm256_xor_si256(qcoeff, coeff_sign),
+                                coeff_sign);
+      qcoeff = _mm256_and_si256(qcoeff, mask);
+
+      _mm256_storeu_si256((__m256i *)(qcoeff_ptr + i), qcoeff);
+      _mm256_storeu_si256((__m256i *)(dqcoeff_ptr + i),
+                          _mm256_mullo_epi16(qcoeff, dequant));
+      eob = scan_for_eob(qcoeff, iscan_ptr + i, eob);
+    } else {
+      const __m256i zero = _mm256_setzero_si256();
+      _mm256_storeu_si256((__m256i *)(qcoeff_ptr + i), zero);
+      _mm256_storeu_si256((__m256i *)(dqcoeff_ptr + i), zero);
+    }
+
+    if (i == 0) {
+      zbin = ac_only(zbin);
+      round = ac_only(round);
+      quant = ac_only(quant);
+      shift = ac_only(shift);
+      dequant = ac_only(dequant);
+    }
+  }
+
+  *eob_ptr = accumulate_eob(eob);
+}
+
+void vp9_quantize_fp_avx2(const tran_low_t *coeff_ptr, intptr_t n_coeffs,
+                          int skip_block, const int16_t *zbin_ptr,
+                          const int16_t *round_ptr, const int16_t *quant_ptr,
+                          const int16_t *quant_shift_ptr,
+                          tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr,
+                          const int16_t *dequant_ptr, uint16_t *eob_ptr,
+                          const int16_t *scan_ptr, const int16_t *iscan_ptr) {
+  const __m256i zero = _mm256_setzero_si256();
+  __m256i round, quant, dequant;
+  __m256i eob = _mm256_setzero_si256();
+  intptr_t i;
+  (void)zbin_ptr;
+  (void)quant_shift_ptr;
+  (void)scan_ptr;
+
+  if (skip_block) {
+    store_zero(qcoeff_ptr, dqcoeff_ptr, n_coeffs);
+    *eob_ptr = 0;
+    return;
+  }
+
+  round = load_dc_ac(round_ptr);
+  quant = load_dc_ac(quant_ptr);
+  dequant = load_dc_ac(dequant_ptr);
+
+  for (i = 0; i < n_coeffs; i += 16) {
+    const __m256i coeff = _mm256_loadu_si256((const __m256i *)(coeff_ptr + i));
+    const __m256i coeff_sign = _mm256_srai_epi16(coeff, 15);
+    __m256i qcoeff = _mm256_adds_epi16(abs_saturate(coeff), round);
+    qcoeff = _mm256_mulhi_epi16(qcoeff, quant);
+
+    // Most coefficients of a block quantize to zero; skip the sign, dequant
+    // and eob work for those groups of 16.
+    if (_mm256_movemask_epi8(_mm256_cmpeq_epi16(qcoeff, zero)) != -1) {
+      qcoeff = _mm256_sub_epi16(_mm256_xor_si256(qcoeff, coeff_sign),
+                                coeff_sign);
+      _mm256_storeu_si256((__m256i *)(qcoeff_ptr + i), qcoeff);
+      _mm256_storeu_si256((__m256i *)(dqcoeff_ptr + i),
+                          _mm256_mullo_epi16(qcoeff, dequant));
+      eob = scan_for_eob(qcoeff, iscan_ptr + i, eob);
+    } else {
+      _mm256_storeu_si256((__m256i *)(qcoeff_ptr + i), zero);
+      _mm256_storeu_si256((__m256i *)(dqcoeff_ptr + i), zero);
+    }
+
+    if (i == 0) {
+      round = ac_only(round);
+      quant = ac_only(quant);
+      dequant = ac_only(dequant);
+    }
+  }
+
+  *eob_ptr = accumulate_eob(eob);
+}
@@ -0,0 +1,100 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>  // AVX2
+
+#include "./vp9_rtcd.h"
+#include "vpx/vpx_integer.h"
+
+// Filters 16 pixels of the source, a, with the predictor, b, both widened to
+// 16 bits, and adds the results to count and accumulator.
+static INLINE void apply16(__m256i a, __m256i b, __m128i strength,
+                           __m256i rounding, __m256i weight,
+                           unsigned int *accumulator, uint16_t *count) {
+  const __m256i sixteen = _mm256_set1_epi16(16);
+  const __m256i diff = _mm256_sub_epi16(a, b);
+  __m256i modifier, count_reg, product, acc_lo, acc_hi;
+
+  // The square of the difference fits in 16 unsigned bits. Saturating the
+  // rest of the arithmetic does not change the result, since every value
+  // that saturates is clamped to 16 after the shift anyway.
+  modifier = _mm256_mullo_epi16(diff, diff);
+  modifier = _mm256_adds_epu16(_mm256_adds_epu16(modifier, modifier),
+                               modifier);
+  modifier = _mm256_adds_epu16(modifier, rounding);
+  modifier = _mm256_srl_epi16(modifier, strength);
+  modifier = _mm256_min_epu16(modifier, sixteen);
+  modifier = _mm256_mullo_epi16(_mm256_sub_epi16(sixteen, modifier), weight);
+
+  count_reg = _mm256_loadu_si256((const __m256i *)count);
+  _mm256_storeu_si256((__m256i *)count,
+                      _mm256_add_epi16(count_reg, modifier));
+
+  // At most 32 * 255, so the products fit in 16 bits.
+  product = _mm256_mullo_epi16(modifier, b);
+  acc_lo = _mm256_loadu_si256((const __m256i *)accumulator);
+  acc_hi = _mm256_loadu_si256((const __m256i *)(accumulator + 8));
+  acc_lo = _mm256_add_epi32(
+      acc_lo, _mm256_cvtepu16_epi32(_mm256_castsi256_si128(product)));
+  acc_hi = _mm256_add_epi32(
+      acc_hi, _mm256_cvtepu16_epi32(_mm256_extracti128_si256(product, 1)));
+  _mm256_storeu_si256((__m256i *)accumulator, acc_lo);
+  _mm256_storeu_si256((__m256i *)(accumulator + 8), acc_hi);
+}
+
+void vp9_temporal_filter_apply_avx2(uint8_t *frame1,
+                                    unsigned int stride,
+                                    uint8_t *frame2,
+                                    unsigned int block_width,
+                                    unsigned int block_height,
+                                    int strength,
+                                    int filter_weight,
+                                    unsigned int *accumulator,
+                                    uint16_t *count) {
+  const __m128i shift = _mm_cvtsi32_si128(strength);
+  const __m256i rounding =
+      _mm256_set1_epi16(strength > 0 ? 1 << (strength - 1) : 0);
+  const __m256i weight = _mm256_set1_epi16(filter_weight);
+  unsigned int i;
+
+  if (block_width == 16) {
+    for (i = 0; i < block_height; ++i) {
+      const __m256i a =
+          _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)frame1));
+      const __m256i b =
+          _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)frame2));
+      apply16(a, b, shift, rounding, weight, accumulator, count);
+      frame1 += stride;
+      frame2 += 16;
+      accumulator += 16;
+      count += 16;
+    }
+  } else if (block_width == 8 && (block_height & 1) == 0) {
+    // Two rows at a time. The predictor, accumulator and count are
+    // contiguous.
+    for (i = 0; i < block_height; i += 2) {
+      const __m128i rows = _mm_unpacklo_epi64(
+          _mm_loadl_epi64((const __m128i *)frame1),
+          _mm_loadl_epi64((const __m128i *)(frame1 + stride)));
+      const __m256i a = _mm256_cvtepu8_epi16(rows);
+      const __m256i b =
+          _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)frame2));
+      apply16(a, b, shift, rounding, weight, accumulator, count);
+      frame1 += 2 * stride;
+      frame2 += 16;
+      accumulator += 16;
+      count += 16;
+    }
+  } else {
+    vp9_temporal_filter_apply_c(frame1, stride, frame2, block_width,
+                                block_height, strength, filter_weight,
+                                accumulator, count);
+  }
+}
@@ -18,6 +18,7 @@
 #include "./vpx_version.h"
 #include "vp9/encoder/vp9_encoder.h"
 #include "vpx/vp8cx.h"
+#include "vp9/common/vp9_thread.h"
 #include "vp9/encoder/vp9_firstpass.h"
 #include "vp9/vp9_iface_common.h"
 
@@ -43,6 +44,8 @@ struct vp9_extracfg {
   vpx_bit_depth_t             bit_depth;
   vp9e_tune_content           content;
   vpx_color_space_t           color_space;
+  unsigned int                row_mt;
+  unsigned int                parallel_chunks;
 };
 
 static struct vp9_extracfg default_extra_cfg = {
@@ -67,8 +70,100 @@ static struct vp9_extracfg default_extra_cfg = {
   VPX_BITS_8,                 // Bit depth
   VP9E_CONTENT_DEFAULT,       // content
   VPX_CS_UNKNOWN,             // color space
+  0,                          // row_mt
+  0,                          // parallel_chunks
 };
 
+#define MAX_PARALLEL_CHUNKS 64
+
+// Most frames of encoded chunks returned by one call to encoder_encode(),
+// each with its PSNR packet.
+#define CHUNK_PKTS_PER_CALL 64
+
+// An input frame waiting to be passed to the encoder of its chunk.
+typedef struct chunk_frame {
+  YV12_BUFFER_CONFIG img;
+  int64_t ts_start;
+  int64_t ts_end;
+  vpx_enc_frame_flags_t flags;
+  struct chunk_frame *next;
+} chunk_frame_t;
+
+// A compressed frame of a chunk, stored at offset in the chunk's buffer.
+typedef struct {
+  size_t offset;
+  size_t sz;
+  int64_t ts_start;
+  int64_t ts_end;
+  vpx_codec_frame_flags_t flags;
+  int has_psnr;
+  struct vpx_psnr_pkt psnr;
+} chunk_pkt_t;
+
+// Frames [start, end) of the stream, coded by their own encoder instance.
+typedef struct {
+  int start;
+  int end;
+  // Received frames not yet passed to the encoder, guarded by the mutex of
+  // the chunk_enc_t.
+  chunk_frame_t *queue_head;
+  chunk_frame_t *queue_tail;
+  // Set, under the mutex, once the chunk's packets are final.
+  int done;
+  int failed;
+  int64_t bits;
+  uint8_t *buf;
+  size_t buf_sz;
+  size_t buf_alloc;
+  chunk_pkt_t *pkts;
+  int num_pkts;
+  int pkts_alloc;
+  // Invisible frames waiting to be packed with the next visible frame.
+  size_t pending_offset;
+  int pending_frame_count;
+  size_t pending_frame_sizes[8];
+  size_t pending_frame_magnitude;
+  // Receives the PSNR packet of each shown frame from the encoder.
+  vpx_codec_pkt_list_decl(2) psnr_pkt_list;
+} chunk_t;
+
+// Splits the last pass of a two pass encode into key frame delimited chunks,
+// placed from the first pass stats. Each worker takes the next chunk in turn
+// and codes it on its own VP9_COMP instance, fed with the input frames as
+// they arrive. The packets of each chunk are returned in stream order once
+// the chunk is done.
+typedef struct {
+  const FIRSTPASS_STATS *stats;
+  int num_frames;
+  VP9EncoderConfig oxcf;
+  int calc_psnr;
+  size_t max_frame_sz;
+  chunk_t *chunks;
+  int num_chunks;
+  VP9Worker *workers;
+  int num_workers;
+  // Input frames are queued to the chunk in_chunk. Once max_held_frames are
+  // queued, the application waits for the workers to take some.
+  int in_chunk;
+  int frames_received;
+  int held_frames;
+  int max_held_frames;
+  int flushing;
+  int aborted;
+  // Bits that the chunks done so far have spent under their budgets, or over
+  // if negative, still to be shared among the chunks not yet started.
+  int64_t bits_off_target;
+  // The next chunk for a worker to take.
+  int next_chunk;
+  // The chunks from out_chunk on hold packets not yet returned.
+  int out_chunk;
+  int out_pkt;
+#if CONFIG_MULTITHREAD
+  pthread_mutex_t mutex;
+  pthread_cond_t cond;
+#endif
+} chunk_enc_t;
+
 struct vpx_codec_alg_priv {
   vpx_codec_priv_t        base;
   vpx_codec_enc_cfg_t     cfg;
@@ -90,6 +185,11 @@ struct vpx_codec_alg_priv {
   vpx_codec_priv_output_cx_pkt_cb_pair_t output_cx_pkt_cb;
   // BufferPool that holds all reference frames.
   BufferPool              *buffer_pool;
+  // Parallel chunk encoding of the last pass, see chunk_enc_t.
+  chunk_enc_t            *chunk_enc;
+  int                     chunk_enc_checked;
+  // Releases input images that the lookahead holds instead of copying.
+  vpx_release_input_cb_t  input_release_cb;
 };
 
 static VP9_REFFRAME ref_frame_to_vp9_reframe(vpx_ref_frame_type_t frame) {
@@ -218,6 +318,8 @@ static vpx_codec_err_t validate_config(vpx_codec_alg_priv_t *ctx,
   RANGE_CHECK_HI(extra_cfg, noise_sensitivity, 6);
   RANGE_CHECK(extra_cfg, tile_columns, 0, 6);
   RANGE_CHECK(extra_cfg, tile_rows, 0, 2);
+  RANGE_CHECK_HI(extra_cfg, row_mt, 1);
+  RANGE_CHECK_HI(extra_cfg, parallel_chunks, MAX_PARALLEL_CHUNKS);
   RANGE_CHECK_HI(extra_cfg, sharpness, 7);
   RANGE_CHECK(extra_cfg, arnr_max_frames, 0, 15);
   RANGE_CHECK_HI(extra_cfg, arnr_strength, 6);
@@ -339,6 +441,41 @@ static vpx_codec_err_t validate_img(vpx_codec_alg_priv_t *ctx,
   return VPX_CODEC_OK;
 }
 
+#if VP9_INPUT_BORDER_IN_PIXELS != VP9_ENC_BORDER_IN_PIXELS
+#error "Held input images must have the lookahead border"
+#endif
+
+// Returns whether img has the border and alignment that let the lookahead
+// hold it instead of a copy, see VP9E_SET_INPUT_RELEASE_CB.
+static int can_hold_image(const vpx_image_t *img) {
+  const int bytes = (img->fmt & VPX_IMG_FMT_HIGHBITDEPTH) ? 2 : 1;
+  const int border = VP9_INPUT_BORDER_IN_PIXELS;
+  const int y_stride = img->stride[VPX_PLANE_Y];
+  ptrdiff_t offset;
+  int row, col, plane;
+
+  if (img->img_data == NULL || y_stride <= 0)
+    return 0;
+  for (plane = VPX_PLANE_Y; plane <= VPX_PLANE_V; ++plane) {
+    const int ss_x = plane != VPX_PLANE_Y ? img->x_chroma_shift : 0;
+    const int width = ((int)img->d_w + ss_x) >> ss_x;
+    if (((uintptr_t)img->planes[plane] | (uintptr_t)img->stride[plane]) & 15)
+      return 0;
+    if (img->stride[plane] < (width + 2 * (border >> ss_x)) * bytes)
+      return 0;
+  }
+
+  // The luma plane must lie inside the allocation with a border all around.
+  offset = img->planes[VPX_PLANE_Y] - img->img_data;
+  if (offset < 0)
+    return 0;
+  row = (int)(offset / y_stride);
+  col = (int)(offset % y_stride) / bytes;
+  return row >= border && col >= border &&
+         row + (int)img->d_h + border <= (int)img->h &&
+         col + (int)img->d_w + border <= (int)img->w;
+}
+
 static int get_image_bps(const vpx_image_t *img) {
   switch (img->fmt) {
     case VPX_IMG_FMT_YV12:
@@ -451,6 +588,7 @@ static vpx_codec_err_t set_encoder_config(
 
   oxcf->tile_columns = extra_cfg->tile_columns;
   oxcf->tile_rows    = extra_cfg->tile_rows;
+  oxcf->row_mt       = extra_cfg->row_mt;
 
   oxcf->error_resilient_mode         = cfg->g_error_resilient;
   oxcf->frame_parallel_decoding_mode = extra_cfg->frame_parallel_decoding_mode;
@@ -713,6 +851,20 @@ static vpx_codec_err_t ctrl_set_frame_parallel_decoding_mode(
   return update_extra_cfg(ctx, &extra_cfg);
 }
 
+static vpx_codec_err_t ctrl_set_row_mt(vpx_codec_alg_priv_t *ctx,
+                                       va_list args) {
+  struct vp9_extracfg extra_cfg = ctx->extra_cfg;
+  extra_cfg.row_mt = CAST(VP9E_SET_ROW_MT, args);
+  return update_extra_cfg(ctx, &extra_cfg);
+}
+
+static vpx_codec_err_t ctrl_set_parallel_chunks(vpx_codec_alg_priv_t *ctx,
+                                                va_list args) {
+  struct vp9_extracfg extra_cfg = ctx->extra_cfg;
+  extra_cfg.parallel_chunks = CAST(VP9E_SET_PARALLEL_CHUNKS, args);
+  return update_extra_cfg(ctx, &extra_cfg);
+}
+
 static vpx_codec_err_t ctrl_set_aq_mode(vpx_codec_alg_priv_t *ctx,
                                         va_list args) {
   struct vp9_extracfg extra_cfg = ctx->extra_cfg;
@@ -779,7 +931,64 @@ static vpx_codec_err_t encoder_init(vpx_codec_ctx_t *ctx,
   return res;
 }
 
+#if CONFIG_MULTITHREAD
+static void free_chunk_frame(chunk_frame_t *frame) {
+  vp9_free_frame_buffer(&frame->img);
+  vpx_free(frame);
+}
+
+static void free_chunk_output(chunk_t *chunk) {
+  free(chunk->buf);
+  chunk->buf = NULL;
+  chunk->buf_sz = 0;
+  chunk->buf_alloc = 0;
+  free(chunk->pkts);
+  chunk->pkts = NULL;
+  chunk->num_pkts = 0;
+  chunk->pkts_alloc = 0;
+}
+
+static void destroy_chunk_enc(chunk_enc_t *enc) {
+  int i;
+
+  if (enc == NULL)
+    return;
+
+  if (enc->workers != NULL) {
+    const VP9WorkerInterface *const winterface = vp9_get_worker_interface();
+    // Stop the workers, dropping the frames they have not taken yet.
+    pthread_mutex_lock(&enc->mutex);
+    enc->aborted = 1;
+    pthread_cond_broadcast(&enc->cond);
+    pthread_mutex_unlock(&enc->mutex);
+    for (i = 0; i < enc->num_workers; ++i)
+      winterface->end(&enc->workers[i]);
+    vpx_free(enc->workers);
+  }
+
+  if (enc->chunks != NULL) {
+    for (i = 0; i < enc->num_chunks; ++i) {
+      chunk_t *const chunk = &enc->chunks[i];
+      while (chunk->queue_head != NULL) {
+        chunk_frame_t *const frame = chunk->queue_head;
+        chunk->queue_head = frame->next;
+        free_chunk_frame(frame);
+      }
+      free_chunk_output(chunk);
+    }
+    vpx_free(enc->chunks);
+  }
+
+  pthread_cond_destroy(&enc->cond);
+  pthread_mutex_destroy(&enc->mutex);
+  vpx_free(enc);
+}
+#endif  // CONFIG_MULTITHREAD
+
 static vpx_codec_err_t encoder_destroy(vpx_codec_alg_priv_t *ctx) {
+#if CONFIG_MULTITHREAD
+  destroy_chunk_enc(ctx->chunk_enc);
+#endif
   free(ctx->cx_data);
   vp9_remove_compressor(ctx->cpi);
 #if CONFIG_MULTITHREAD
@@ -824,38 +1033,60 @@ static void pick_quickcompress_mode(vpx_codec_alg_priv_t *ctx,
   }
 }
 
-// Turn on to test if supplemental superframe data breaks decoding
-// #define TEST_SUPPLEMENTAL_SUPERFRAME_DATA
-static int write_superframe_index(vpx_codec_alg_priv_t *ctx) {
-  uint8_t marker = 0xc0;
+// Returns the size of the superframe index of frame_count frames whose sizes
+// OR together to frame_magnitude, and the number of bytes, minus one, used
+// to code each size in *mag.
+static int get_superframe_index_size(int frame_count, size_t frame_magnitude,
+                                     int *mag) {
   unsigned int mask;
-  int mag, index_sz;
-
-  assert(ctx->pending_frame_count);
-  assert(ctx->pending_frame_count <= 8);
 
-  // Add the number of frames to the marker byte
-  marker |= ctx->pending_frame_count - 1;
+  assert(frame_count);
+  assert(frame_count <= 8);
 
   // Choose the magnitude
-  for (mag = 0, mask = 0xff; mag < 4; mag++) {
-    if (ctx->pending_frame_magnitude < mask)
+  for (*mag = 0, mask = 0xff; *mag < 4; (*mag)++) {
+    if (frame_magnitude < mask)
       break;
     mask <<= 8;
     mask |= 0xff;
   }
-  marker |= mag << 3;
+  return 2 + (*mag + 1) * frame_count;
+}
+
+static void write_superframe_index_data(uint8_t *x, int frame_count,
+                                        const size_t *frame_sizes, int mag) {
+  // Add the number of frames and the magnitude to the marker byte
+  const uint8_t marker = 0xc0 | (mag << 3) | (frame_count - 1);
+  int i, j;
+
+  *x++ = marker;
+  for (i = 0; i < frame_count; i++) {
+    unsigned int this_sz = (unsigned int)frame_sizes[i];
+
+    for (j = 0; j <= mag; j++) {
+      *x++ = this_sz & 0xff;
+      this_sz >>= 8;
+    }
+  }
+  *x++ = marker;
+}
+
+// Turn on to test if supplemental superframe data breaks decoding
+// #define TEST_SUPPLEMENTAL_SUPERFRAME_DATA
+static int write_superframe_index(vpx_codec_alg_priv_t *ctx) {
+  int mag;
+  int index_sz = get_superframe_index_size(ctx->pending_frame_count,
+                                           ctx->pending_frame_magnitude, &mag);
 
   // Write the index
-  index_sz = 2 + (mag + 1) * ctx->pending_frame_count;
   if (ctx->pending_cx_data_sz + index_sz < ctx->cx_data_sz) {
     uint8_t *x = ctx->pending_cx_data + ctx->pending_cx_data_sz;
-    int i, j;
 #ifdef TEST_SUPPLEMENTAL_SUPERFRAME_DATA
     uint8_t marker_test = 0xc0;
     int mag_test = 2;     // 1 - 4
     int frames_test = 4;  // 1 - 8
     int index_sz_test = 2 + mag_test * frames_test;
+    int i;
     marker_test |= frames_test - 1;
     marker_test |= (mag_test - 1) << 3;
     *x++ = marker_test;
@@ -866,16 +1097,8 @@ static int write_superframe_index(vpx_codec_alg_priv_t *ctx) {
     printf("Added supplemental superframe data\n");
 #endif
 
-    *x++ = marker;
-    for (i = 0; i < ctx->pending_frame_count; i++) {
-      unsigned int this_sz = (unsigned int)ctx->pending_frame_sizes[i];
-
-      for (j = 0; j <= mag; j++) {
-        *x++ = this_sz & 0xff;
-        this_sz >>= 8;
-      }
-    }
-    *x++ = marker;
+    write_superframe_index_data(x, ctx->pending_frame_count,
+                                ctx->pending_frame_sizes, mag);
     ctx->pending_cx_data_sz += index_sz;
 #ifdef TEST_SUPPLEMENTAL_SUPERFRAME_DATA
     index_sz += index_sz_test;
@@ -915,12 +1138,473 @@ static vpx_codec_frame_flags_t get_frame_pkt_flags(const VP9_COMP *cpi,
   return flags;
 }
 
-static vpx_codec_err_t encoder_encode(vpx_codec_alg_priv_t  *ctx,
-                                      const vpx_image_t *img,
-                                      vpx_codec_pts_t pts,
-                                      unsigned long duration,
-                                      vpx_enc_frame_flags_t flags,
-                                      unsigned long deadline) {
+#if CONFIG_MULTITHREAD
+static int chunk_worker_hook(chunk_enc_t *enc, void *unused);
+
+static vpx_codec_err_t init_chunk_enc(vpx_codec_alg_priv_t *ctx) {
+  const VP9WorkerInterface *const winterface = vp9_get_worker_interface();
+  const vpx_codec_enc_cfg_t *const cfg = &ctx->cfg;
+  const int parallel_chunks = (int)ctx->extra_cfg.parallel_chunks;
+  const int num_frames =
+      (int)(cfg->rc_twopass_stats_in.sz / sizeof(FIRSTPASS_STATS)) - 1;
+  // Chunks no longer than the key frame interval, and short enough for all
+  // workers to get one on short clips.
+  const int max_frames =
+      MAX(1, MIN((int)cfg->kf_max_dist,
+                 (num_frames + parallel_chunks - 1) / parallel_chunks));
+  chunk_enc_t *enc;
+  int *chunk_start;
+  int i;
+
+  enc = (chunk_enc_t *)vpx_calloc(1, sizeof(*enc));
+  if (enc == NULL)
+    return VPX_CODEC_MEM_ERROR;
+  if (pthread_mutex_init(&enc->mutex, NULL)) {
+    vpx_free(enc);
+    return VPX_CODEC_MEM_ERROR;
+  }
+  if (pthread_cond_init(&enc->cond, NULL)) {
+    pthread_mutex_destroy(&enc->mutex);
+    vpx_free(enc);
+    return VPX_CODEC_MEM_ERROR;
+  }
+  ctx->chunk_enc = enc;
+
+  enc->stats = (const FIRSTPASS_STATS *)cfg->rc_twopass_stats_in.buf;
+  enc->num_frames = num_frames;
+  enc->oxcf = ctx->oxcf;
+  enc->calc_psnr = (ctx->base.init_flags & VPX_CODEC_USE_PSNR) != 0;
+  enc->max_frame_sz = ctx->cx_data_sz;
+
+  chunk_start = (int *)vpx_malloc(MAX(1, num_frames) * sizeof(*chunk_start));
+  if (chunk_start == NULL)
+    return VPX_CODEC_MEM_ERROR;
+  enc->num_chunks = vp9_twopass_split_chunks(enc->stats, num_frames,
+                                             max_frames, chunk_start);
+  enc->chunks = (chunk_t *)vpx_calloc(MAX(1, enc->num_chunks),
+                                      sizeof(*enc->chunks));
+  if (enc->chunks == NULL) {
+    vpx_free(chunk_start);
+    return VPX_CODEC_MEM_ERROR;
+  }
+  for (i = 0; i < enc->num_chunks; ++i) {
+    chunk_t *const chunk = &enc->chunks[i];
+    chunk->start = chunk_start[i];
+    chunk->end = i + 1 < enc->num_chunks ? chunk_start[i + 1] : num_frames;
+    vpx_codec_pkt_list_init(&chunk->psnr_pkt_list);
+  }
+  vpx_free(chunk_start);
+
+  // Enough frames for every worker to have a whole chunk in flight.
+  enc->num_workers = MAX(1, MIN(parallel_chunks, enc->num_chunks));
+  enc->max_held_frames = enc->num_workers * max_frames;
+  enc->workers =
+      (VP9Worker *)vpx_calloc(enc->num_workers, sizeof(*enc->workers));
+  if (enc->workers == NULL)
+    return VPX_CODEC_MEM_ERROR;
+  for (i = 0; i < enc->num_workers; ++i) {
+    VP9Worker *const worker = &enc->workers[i];
+    winterface->init(worker);
+    if (!winterface->reset(worker)) {
+      ctx->base.err_detail = "Chunk encoder thread creation failed";
+      return VPX_CODEC_ERROR;
+    }
+    worker->hook = (VP9WorkerHook)chunk_worker_hook;
+    worker->data1 = enc;
+    worker->data2 = NULL;
+    winterface->launch(worker);
+  }
+  return VPX_CODEC_OK;
+}
+
+static chunk_frame_t *copy_chunk_frame(const YV12_BUFFER_CONFIG *src) {
+#if CONFIG_VP9_HIGHBITDEPTH
+  const int use_highbitdepth = (src->flags & YV12_FLAG_HIGHBITDEPTH) != 0;
+#endif
+  chunk_frame_t *const frame =
+      (chunk_frame_t *)vpx_calloc(1, sizeof(*frame));
+  YV12_BUFFER_CONFIG *const dst = &frame->img;
+  int plane;
+
+  if (frame == NULL)
+    return NULL;
+  if (vp9_alloc_frame_buffer(dst, src->y_crop_width, src->y_crop_height,
+                             src->subsampling_x, src->subsampling_y,
+#if CONFIG_VP9_HIGHBITDEPTH
+                             use_highbitdepth,
+#endif
+                             0, 0)) {
+    free_chunk_frame(frame);
+    return NULL;
+  }
+  dst->color_space = src->color_space;
+
+  for (plane = 0; plane < 3; ++plane) {
+    const uint8_t *src_buf = plane == 0 ? src->y_buffer :
+                             plane == 1 ? src->u_buffer : src->v_buffer;
+    uint8_t *dst_buf = plane == 0 ? dst->y_buffer :
+                       plane == 1 ? dst->u_buffer : dst->v_buffer;
+    int src_stride = plane == 0 ? src->y_stride : src->uv_stride;
+    int dst_stride = plane == 0 ? dst->y_stride : dst->uv_stride;
+    int width = plane == 0 ? src->y_crop_width : src->uv_crop_width;
+    const int height = plane == 0 ? src->y_crop_height : src->uv_crop_height;
+    int row;
+
+#if CONFIG_VP9_HIGHBITDEPTH
+    if (use_highbitdepth) {
+      src_buf = (const uint8_t *)CONVERT_TO_SHORTPTR(src_buf);
+      dst_buf = (uint8_t *)CONVERT_TO_SHORTPTR(dst_buf);
+      src_stride <<= 1;
+      dst_stride <<= 1;
+      width <<= 1;
+    }
+#endif
+    for (row = 0; row < height; ++row) {
+      memcpy(dst_buf, src_buf, width);
+      src_buf += src_stride;
+      dst_buf += dst_stride;
+    }
+  }
+  return frame;
+}
+
+// Moves the frames the encoder of a chunk has ready into the chunk's buffer,
+// packing invisible frames with the next visible one as encoder_encode()
+// does.
+static int get_chunk_frames(chunk_t *chunk, VP9_COMP *cpi,
+                            size_t max_frame_sz, int flush) {
+  for (;;) {
+    unsigned int lib_flags = 0;
+    size_t size;
+    int64_t ts_start, ts_end;
+    chunk_pkt_t *pkt;
+
+    if (chunk->buf_alloc - chunk->buf_sz < max_frame_sz) {
+      const size_t alloc = 2 * chunk->buf_alloc + max_frame_sz;
+      uint8_t *const buf = (uint8_t *)realloc(chunk->buf, alloc);
+      if (buf == NULL)
+        return 0;
+      chunk->buf = buf;
+      chunk->buf_alloc = alloc;
+    }
+
+    chunk->psnr_pkt_list.head.cnt = 0;
+    if (vp9_get_compressed_data(cpi, &lib_flags, &size,
+                                chunk->buf + chunk->buf_sz, &ts_start,
+                                &ts_end, flush) == -1)
+      break;
+    if (size == 0)
+      continue;
+
+    if (!cpi->common.show_frame) {
+      if (chunk->pending_frame_count == 0)
+        chunk->pending_offset = chunk->buf_sz;
+      chunk->pending_frame_sizes[chunk->pending_frame_count++] = size;
+      chunk->pending_frame_magnitude |= size;
+      chunk->buf_sz += size;
+      continue;
+    }
+
+    if (chunk->num_pkts == chunk->pkts_alloc) {
+      const int pkts_alloc = chunk->pkts_alloc ? 2 * chunk->pkts_alloc : 64;
+      chunk_pkt_t *const pkts = (chunk_pkt_t *)realloc(
+          chunk->pkts, pkts_alloc * sizeof(*chunk->pkts));
+      if (pkts == NULL)
+        return 0;
+      chunk->pkts = pkts;
+      chunk->pkts_alloc = pkts_alloc;
+    }
+    pkt = &chunk->pkts[chunk->num_pkts++];
+    pkt->ts_start = ts_start;
+    pkt->ts_end = ts_end;
+    pkt->flags = get_frame_pkt_flags(cpi, lib_flags);
+    pkt->has_psnr = chunk->psnr_pkt_list.head.cnt > 0;
+    if (pkt->has_psnr)
+      pkt->psnr = chunk->psnr_pkt_list.head.pkts[0].data.psnr;
+
+    if (chunk->pending_frame_count) {
+      int mag, index_sz;
+      chunk->pending_frame_sizes[chunk->pending_frame_count++] = size;
+      chunk->pending_frame_magnitude |= size;
+      index_sz = get_superframe_index_size(chunk->pending_frame_count,
+                                           chunk->pending_frame_magnitude,
+                                           &mag);
+      write_superframe_index_data(chunk->buf + chunk->buf_sz + size,
+                                  chunk->pending_frame_count,
+                                  chunk->pending_frame_sizes, mag);
+      pkt->offset = chunk->pending_offset;
+      chunk->buf_sz += size + index_sz;
+      chunk->pending_frame_count = 0;
+      chunk->pending_frame_magnitude = 0;
+    } else {
+      pkt->offset = chunk->buf_sz;
+      chunk->buf_sz += size;
+    }
+    pkt->sz = chunk->buf_sz - pkt->offset;
+  }
+  return 1;
+}
+
+// Returns the next frame of the chunk, waiting for it to be received, or
+// NULL once the chunk has no more frames.
+static chunk_frame_t *take_chunk_frame(chunk_enc_t *enc, chunk_t *chunk) {
+  chunk_frame_t *frame;
+
+  pthread_mutex_lock(&enc->mutex);
+  while (chunk->queue_head == NULL && !enc->aborted && !enc->flushing &&
+         enc->frames_received < chunk->end)
+    pthread_cond_wait(&enc->cond, &enc->mutex);
+  frame = enc->aborted ? NULL : chunk->queue_head;
+  if (frame != NULL) {
+    chunk->queue_head = frame->next;
+    if (chunk->queue_head == NULL)
+      chunk->queue_tail = NULL;
+    --enc->held_frames;
+    pthread_cond_broadcast(&enc->cond);
+  }
+  pthread_mutex_unlock(&enc->mutex);
+  return frame;
+}
+
+static int encode_chunk(chunk_enc_t *enc, chunk_t *chunk) {
+  const int num_stats = chunk->end - chunk->start + 1;
+  FIRSTPASS_STATS *const stats =
+      (FIRSTPASS_STATS *)vpx_malloc(num_stats * sizeof(*stats));
+  BufferPool *const pool = (BufferPool *)vpx_calloc(1, sizeof(*pool));
+  VP9EncoderConfig oxcf = enc->oxcf;
+  VP9_COMP *cpi = NULL;
+  chunk_frame_t *frame;
+  int ok = 0;
+
+  if (stats != NULL && pool != NULL &&
+      !pthread_mutex_init(&pool->pool_mutex, NULL)) {
+    int64_t bits = vp9_twopass_chunk_stats(&enc->oxcf, enc->stats,
+                                           enc->num_frames, chunk->start,
+                                           chunk->end, stats);
+    int64_t adjustment;
+
+    // A chunk is too short for its rate control to make up for its own
+    // misses, so the chunks that follow do, as a single encoder would over
+    // the rest of the clip.
+    pthread_mutex_lock(&enc->mutex);
+    adjustment = enc->bits_off_target * (chunk->end - chunk->start) /
+                 (enc->num_frames - chunk->start);
+    adjustment = MAX(adjustment, -bits / 2);
+    enc->bits_off_target -= adjustment;
+    pthread_mutex_unlock(&enc->mutex);
+    bits += adjustment;
+    chunk->bits = bits;
+
+    oxcf.max_threads = MAX(1, oxcf.max_threads / enc->num_workers);
+    oxcf.two_pass_stats_in.buf = stats;
+    oxcf.two_pass_stats_in.sz = num_stats * sizeof(*stats);
+#if CONFIG_FP_MB_STATS
+    oxcf.firstpass_mb_stats_in.buf = NULL;
+    oxcf.firstpass_mb_stats_in.sz = 0;
+#endif
+    cpi = vp9_create_compressor(&oxcf, pool);
+    if (cpi != NULL) {
+      cpi->twopass.bits_left = bits;
+      cpi->output_pkt_list = &chunk->psnr_pkt_list.head;
+      cpi->b_calculate_psnr = enc->calc_psnr;
+      ok = 1;
+    } else {
+      pthread_mutex_destroy(&pool->pool_mutex);
+    }
+  }
+
+  // Each frame is freed as soon as the lookahead has its own copy. The
+  // frames of a failed chunk are taken and dropped so that the input never
+  // waits on it.
+  while ((frame = take_chunk_frame(enc, chunk)) != NULL) {
+    if (ok) {
+      vp9_apply_encoding_flags(cpi, frame->flags);
+      ok = !vp9_receive_raw_frame(cpi, frame->flags, &frame->img,
+                                  frame->ts_start, frame->ts_end,
+                                  NULL, NULL) &&
+           get_chunk_frames(chunk, cpi, enc->max_frame_sz, 0);
+    }
+    if (cpi != NULL)
+      vp9_lookahead_sync(cpi->lookahead);
+    free_chunk_frame(frame);
+  }
+  pthread_mutex_lock(&enc->mutex);
+  ok = ok && !enc->aborted;
+  pthread_mutex_unlock(&enc->mutex);
+  ok = ok && get_chunk_frames(chunk, cpi, enc->max_frame_sz, 1);
+
+  if (cpi != NULL) {
+    vp9_remove_compressor(cpi);
+    pthread_mutex_destroy(&pool->pool_mutex);
+  }
+  vpx_free(pool);
+  vpx_free(stats);
+  return ok;
+}
+
+// Codes chunks, in stream order, until none are left.
+static int chunk_worker_hook(chunk_enc_t *enc, void *unused) {
+  (void)unused;
+
+  for (;;) {
+    chunk_t *chunk;
+    int ok, empty;
+
+    pthread_mutex_lock(&enc->mutex);
+    if (enc->aborted || enc->next_chunk == enc->num_chunks) {
+      pthread_mutex_unlock(&enc->mutex);
+      break;
+    }
+    chunk = &enc->chunks[enc->next_chunk++];
+    // The stream may end before the frames the first pass stats describe.
+    empty = enc->flushing && chunk->start >= enc->frames_received;
+    pthread_mutex_unlock(&enc->mutex);
+
+    ok = empty || encode_chunk(enc, chunk);
+
+    pthread_mutex_lock(&enc->mutex);
+    if (ok && !empty)
+      enc->bits_off_target += chunk->bits - (int64_t)chunk->buf_sz * 8;
+    chunk->failed = !ok;
+    chunk->done = 1;
+    pthread_cond_broadcast(&enc->cond);
+    pthread_mutex_unlock(&enc->mutex);
+  }
+  return 1;
+}
+
+// Queues img to its chunk, waiting while the workers hold the most frames
+// allowed.
+static vpx_codec_err_t queue_chunk_frame(vpx_codec_alg_priv_t *ctx,
+                                         const vpx_image_t *img,
+                                         vpx_codec_pts_t pts,
+                                         unsigned long duration,
+                                         vpx_enc_frame_flags_t flags) {
+  const vpx_rational_t *const timebase = &ctx->cfg.g_timebase;
+  chunk_enc_t *const enc = ctx->chunk_enc;
+  chunk_frame_t *frame;
+  chunk_t *chunk;
+  YV12_BUFFER_CONFIG sd;
+
+  if (enc->frames_received == enc->num_frames) {
+    ctx->base.err_detail = "More frames than in the first pass stats";
+    return VPX_CODEC_INVALID_PARAM;
+  }
+
+  image2yuvconfig(img, &sd);
+  frame = copy_chunk_frame(&sd);
+  if (frame == NULL)
+    return VPX_CODEC_MEM_ERROR;
+  frame->ts_start = timebase_units_to_ticks(timebase, pts);
+  frame->ts_end = timebase_units_to_ticks(timebase, pts + duration);
+  frame->flags = flags | ctx->next_frame_flags;
+  ctx->next_frame_flags = 0;
+
+  pthread_mutex_lock(&enc->mutex);
+  while (enc->held_frames >= enc->max_held_frames)
+    pthread_cond_wait(&enc->cond, &enc->mutex);
+  while (enc->frames_received >= enc->chunks[enc->in_chunk].end)
+    ++enc->in_chunk;
+  chunk = &enc->chunks[enc->in_chunk];
+  if (chunk->queue_tail != NULL)
+    chunk->queue_tail->next = frame;
+  else
+    chunk->queue_head = frame;
+  chunk->queue_tail = frame;
+  ++enc->held_frames;
+  ++enc->frames_received;
+  pthread_cond_broadcast(&enc->cond);
+  pthread_mutex_unlock(&enc->mutex);
+  return VPX_CODEC_OK;
+}
+
+static vpx_codec_err_t encode_chunks(vpx_codec_alg_priv_t *ctx,
+                                     const vpx_image_t *img,
+                                     vpx_codec_pts_t pts,
+                                     unsigned long duration,
+                                     vpx_enc_frame_flags_t flags) {
+  const vpx_rational_t *const timebase = &ctx->cfg.g_timebase;
+  chunk_enc_t *const enc = ctx->chunk_enc;
+  vpx_codec_err_t res = VPX_CODEC_OK;
+  int num_pkts = 0;
+  int i;
+
+  // The packets of the chunks before out_chunk were returned by earlier
+  // calls, so the application is done with them.
+  for (i = 0; i < enc->out_chunk; ++i)
+    free_chunk_output(&enc->chunks[i]);
+
+  if (img != NULL) {
+    res = queue_chunk_frame(ctx, img, pts, duration, flags);
+    if (res != VPX_CODEC_OK)
+      return res;
+  } else {
+    pthread_mutex_lock(&enc->mutex);
+    enc->flushing = 1;
+    pthread_cond_broadcast(&enc->cond);
+    pthread_mutex_unlock(&enc->mutex);
+  }
+
+  // Return the packets of the chunks that are done. When flushing, wait for
+  // the next chunk so that every call returns packets until the end.
+  while (num_pkts < CHUNK_PKTS_PER_CALL && enc->out_chunk < enc->num_chunks) {
+    const chunk_t *const chunk = &enc->chunks[enc->out_chunk];
+    int done;
+
+    pthread_mutex_lock(&enc->mutex);
+    while (img == NULL && num_pkts == 0 && !chunk->done)
+      pthread_cond_wait(&enc->cond, &enc->mutex);
+    done = chunk->done;
+    pthread_mutex_unlock(&enc->mutex);
+    if (!done)
+      break;
+
+    if (chunk->failed) {
+      ctx->base.err_detail = "Failed to encode chunk";
+      return VPX_CODEC_ERROR;
+    }
+
+    while (num_pkts < CHUNK_PKTS_PER_CALL && enc->out_pkt < chunk->num_pkts) {
+      const chunk_pkt_t *const chunk_pkt = &chunk->pkts[enc->out_pkt++];
+      vpx_codec_cx_pkt_t pkt;
+
+      if (chunk_pkt->has_psnr) {
+        pkt.kind = VPX_CODEC_PSNR_PKT;
+        pkt.data.psnr = chunk_pkt->psnr;
+        vpx_codec_pkt_list_add(&ctx->pkt_list.head, &pkt);
+      }
+
+      pkt.kind = VPX_CODEC_CX_FRAME_PKT;
+      pkt.data.frame.buf = chunk->buf + chunk_pkt->offset;
+      pkt.data.frame.sz = chunk_pkt->sz;
+      pkt.data.frame.pts = ticks_to_timebase_units(timebase,
+                                                   chunk_pkt->ts_start);
+      pkt.data.frame.duration =
+          (unsigned long)ticks_to_timebase_units(timebase,
+              chunk_pkt->ts_end - chunk_pkt->ts_start);
+      pkt.data.frame.flags = chunk_pkt->flags;
+      pkt.data.frame.partition_id = -1;
+      vpx_codec_pkt_list_add(&ctx->pkt_list.head, &pkt);
+      ++num_pkts;
+    }
+
+    if (enc->out_pkt == chunk->num_pkts) {
+      ++enc->out_chunk;
+      enc->out_pkt = 0;
+    }
+  }
+
+  return res;
+}
+#endif  // CONFIG_MULTITHREAD
+
+static vpx_codec_err_t encode_image(vpx_codec_alg_priv_t *ctx,
+                                    const vpx_image_t *img,
+                                    vpx_codec_pts_t pts,
+                                    unsigned long duration,
+                                    vpx_enc_frame_flags_t flags,
+                                    unsigned long deadline,
+                                    int *img_held) {
   vpx_codec_err_t res = VPX_CODEC_OK;
   VP9_COMP *const cpi = ctx->cpi;
   const vpx_rational_t *const timebase = &ctx->cfg.g_timebase;
@@ -969,6 +1653,27 @@ static vpx_codec_err_t encoder_encode(vpx_codec_alg_priv_t  *ctx,
     }
   }
 
+#if CONFIG_MULTITHREAD
+  // Decide on parallel chunk encoding on the first frame.
+  if (res == VPX_CODEC_OK && cpi != NULL && img != NULL &&
+      !ctx->chunk_enc_checked) {
+    ctx->chunk_enc_checked = 1;
+    if (ctx->extra_cfg.parallel_chunks > 1 &&
+        ctx->cfg.g_pass == VPX_RC_LAST_PASS &&
+        ctx->cfg.ss_number_layers == 1 && ctx->cfg.ts_number_layers == 1 &&
+        ctx->output_cx_pkt_cb.output_cx_pkt == NULL) {
+      res = init_chunk_enc(ctx);
+      if (res != VPX_CODEC_OK) {
+        destroy_chunk_enc(ctx->chunk_enc);
+        ctx->chunk_enc = NULL;
+      }
+    }
+  }
+
+  if (res == VPX_CODEC_OK && ctx->chunk_enc != NULL)
+    return encode_chunks(ctx, img, pts, duration, flags);
+#endif  // CONFIG_MULTITHREAD
+
   // Initialize the encoder instance on the first frame.
   if (res == VPX_CODEC_OK && cpi != NULL) {
     unsigned int lib_flags = 0;
@@ -984,12 +1689,18 @@ static vpx_codec_err_t encoder_encode(vpx_codec_alg_priv_t  *ctx,
       cpi->b_calculate_psnr = 1;
 
     if (img != NULL) {
+      const int hold = ctx->input_release_cb.release != NULL &&
+                       can_hold_image(img);
       res = image2yuvconfig(img, &sd);
 
       // Store the original flags in to the frame buffer. Will extract the
-      // key frame flag when we actually encode this frame.
+      // key frame flag when we actually encode this frame. A held image is
+      // released by the lookahead, even if it could not be queued.
+      *img_held = hold;
       if (vp9_receive_raw_frame(cpi, flags | ctx->next_frame_flags,
-                                &sd, dst_time_stamp, dst_end_time_stamp)) {
+                                &sd, dst_time_stamp, dst_end_time_stamp,
+                                hold ? &ctx->input_release_cb : NULL,
+                                img->user_priv)) {
         res = update_error_state(ctx, &cpi->common.error);
       }
       ctx->next_frame_flags = 0;
@@ -1009,6 +1720,7 @@ static vpx_codec_err_t encoder_encode(vpx_codec_alg_priv_t  *ctx,
        * the buffer size anyway.
        */
       if (cx_data_sz < ctx->cx_data_sz / 2) {
+        vp9_lookahead_sync(cpi->lookahead);
         ctx->base.err_detail = "Compressed data buffer too small";
         return VPX_CODEC_ERROR;
       }
@@ -1117,11 +1829,31 @@ static vpx_codec_err_t encoder_encode(vpx_codec_alg_priv_t  *ctx,
 #endif
       }
     }
+
+    // The application owns img again once this call returns.
+    vp9_lookahead_sync(cpi->lookahead);
   }
 
   return res;
 }
 
+static vpx_codec_err_t encoder_encode(vpx_codec_alg_priv_t  *ctx,
+                                      const vpx_image_t *img,
+                                      vpx_codec_pts_t pts,
+                                      unsigned long duration,
+                                      vpx_enc_frame_flags_t flags,
+                                      unsigned long deadline) {
+  int img_held = 0;
+  const vpx_codec_err_t res = encode_image(ctx, img, pts, duration, flags,
+                                           deadline, &img_held);
+
+  // Images that were copied, or not taken at all, are released right away.
+  if (img != NULL && !img_held && ctx->input_release_cb.release != NULL)
+    ctx->input_release_cb.release(ctx->input_release_cb.cb_priv,
+                                  img->user_priv);
+  return res;
+}
+
 static const vpx_codec_cx_pkt_t *encoder_get_cxdata(vpx_codec_alg_priv_t *ctx,
                                                     vpx_codec_iter_t *iter) {
   return vpx_codec_pkt_list_get(&ctx->pkt_list.head, iter);
@@ -1371,6 +2103,16 @@ static vpx_codec_err_t ctrl_register_cx_callback(vpx_codec_alg_priv_t *ctx,
   return VPX_CODEC_OK;
 }
 
+static vpx_codec_err_t ctrl_set_input_release_cb(vpx_codec_alg_priv_t *ctx,
+                                                 va_list args) {
+  const vpx_release_input_cb_t *const cb =
+      va_arg(args, vpx_release_input_cb_t *);
+  if (cb == NULL)
+    return VPX_CODEC_INVALID_PARAM;
+  ctx->input_release_cb = *cb;
+  return VPX_CODEC_OK;
+}
+
 static vpx_codec_err_t ctrl_set_tune_content(vpx_codec_alg_priv_t *ctx,
                                              va_list args) {
   struct vp9_extracfg extra_cfg = ctx->extra_cfg;
@@ -1424,6 +2166,9 @@ static vpx_codec_ctrl_fn_map_t encoder_ctrl_maps[] = {
   {VP9E_SET_TUNE_CONTENT,             ctrl_set_tune_content},
   {VP9E_SET_COLOR_SPACE,              ctrl_set_color_space},
   {VP9E_SET_NOISE_SENSITIVITY,        ctrl_set_noise_sensitivity},
+  {VP9E_SET_ROW_MT,                   ctrl_set_row_mt},
+  {VP9E_SET_PARALLEL_CHUNKS,          ctrl_set_parallel_chunks},
+  {VP9E_SET_INPUT_RELEASE_CB,         ctrl_set_input_release_cb},
 
   // Getters
   {VP8E_GET_LAST_QUANTIZER,           ctrl_get_quantizer},
@@ -1530,3 +2275,4 @@ CODEC_INTERFACE(vpx_codec_vp9_cx) = {
     NULL         // vpx_codec_enc_mr_get_mem_loc_fn_t
   }
 };
+
@@ -53,8 +53,10 @@ struct vpx_codec_alg_priv {
   int                     img_avail;
   int                     flushed;
   int                     invert_tile_order;
+  int                     pipelined_lpf;
   int                     last_show_frame;  // Index of last output frame.
   int                     byte_alignment;
+  int                     frame_size_hint[2];  // Width and height.
 
   // Frame parallel related.
   int                     frame_parallel_decode;  // frame-based threading.
@@ -274,6 +276,20 @@ static vpx_codec_err_t update_error_state(vpx_codec_alg_priv_t *ctx,
   return error->error_code;
 }
 
+// Returns the size of the internal frame buffers that hold a frame of the
+// hinted size, assuming 8 bit 4:2:0, or 0 without a hint.
+static size_t get_frame_buffer_size_hint(const vpx_codec_alg_priv_t *ctx) {
+  if (ctx->frame_size_hint[0] <= 0 || ctx->frame_size_hint[1] <= 0)
+    return 0;
+  return vp9_get_frame_buffer_size(ctx->frame_size_hint[0],
+                                   ctx->frame_size_hint[1], 1, 1,
+#if CONFIG_VP9_HIGHBITDEPTH
+                                   0,
+#endif
+                                   VP9_DEC_BORDER_IN_PIXELS,
+                                   ctx->byte_alignment);
+}
+
 static void init_buffer_callbacks(vpx_codec_alg_priv_t *ctx) {
   int i;
 
@@ -298,6 +314,7 @@ static void init_buffer_callbacks(vpx_codec_alg_priv_t *ctx) {
         vpx_internal_error(&cm->error, VPX_CODEC_MEM_ERROR,
                            "Failed to initialize internal frame buffers");
 
+      pool->int_frame_buffers.size_hint = get_frame_buffer_size_hint(ctx);
       pool->cb_priv = &pool->int_frame_buffers;
     }
   }
@@ -430,6 +447,7 @@ static vpx_codec_err_t init_decoder(vpx_codec_alg_priv_t *ctx) {
         (ctx->frame_parallel_decode == 0) ? ctx->cfg.threads : 0;
 
     frame_worker_data->pbi->inv_tile_order = ctx->invert_tile_order;
+    frame_worker_data->pbi->pipelined_lpf = ctx->pipelined_lpf;
     frame_worker_data->pbi->frame_parallel_decode = ctx->frame_parallel_decode;
     frame_worker_data->pbi->common.frame_parallel_decode =
         ctx->frame_parallel_decode;
@@ -1028,6 +1046,39 @@ static vpx_codec_err_t ctrl_set_invert_tile_order(vpx_codec_alg_priv_t *ctx,
   return VPX_CODEC_OK;
 }
 
+static vpx_codec_err_t ctrl_set_pipelined_loop_filter(
+    vpx_codec_alg_priv_t *ctx, va_list args) {
+  ctx->pipelined_lpf = va_arg(args, int);
+  if (ctx->frame_workers) {
+    int i;
+    for (i = 0; i < ctx->num_frame_workers; ++i) {
+      VP9Worker *const worker = &ctx->frame_workers[i];
+      FrameWorkerData *const frame_worker_data =
+          (FrameWorkerData *)worker->data1;
+      frame_worker_data->pbi->pipelined_lpf = ctx->pipelined_lpf;
+    }
+  }
+  return VPX_CODEC_OK;
+}
+
+static vpx_codec_err_t ctrl_set_frame_size_hint(vpx_codec_alg_priv_t *ctx,
+                                               va_list args) {
+  const int *const frame_size = va_arg(args, int *);
+
+  if (frame_size == NULL || frame_size[0] < 0 || frame_size[1] < 0)
+    return VPX_CODEC_INVALID_PARAM;
+
+  ctx->frame_size_hint[0] = frame_size[0];
+  ctx->frame_size_hint[1] = frame_size[1];
+  if (ctx->buffer_pool) {
+    BufferPool *const pool = ctx->buffer_pool;
+    lock_buffer_pool(pool);
+    pool->int_frame_buffers.size_hint = get_frame_buffer_size_hint(ctx);
+    unlock_buffer_pool(pool);
+  }
+  return VPX_CODEC_OK;
+}
+
 static vpx_codec_err_t ctrl_set_decryptor(vpx_codec_alg_priv_t *ctx,
                                           va_list args) {
   vpx_decrypt_init *init = va_arg(args, vpx_decrypt_init *);
@@ -1072,6 +1123,8 @@ static vpx_codec_ctrl_fn_map_t decoder_ctrl_maps[] = {
   {VP9_INVERT_TILE_DECODE_ORDER,  ctrl_set_invert_tile_order},
   {VPXD_SET_DECRYPTOR,            ctrl_set_decryptor},
   {VP9_SET_BYTE_ALIGNMENT,        ctrl_set_byte_alignment},
+  {VP9D_SET_PIPELINED_LOOP_FILTER, ctrl_set_pipelined_loop_filter},
+  {VP9D_SET_FRAME_SIZE_HINT,      ctrl_set_frame_size_hint},
 
   // Getters
   {VP8D_GET_LAST_REF_UPDATES,     ctrl_get_last_ref_updates},
@@ -101,14 +101,22 @@ VP9_CX_SRCS-yes += encoder/vp9_temporal_filter.c
 VP9_CX_SRCS-yes += encoder/vp9_temporal_filter.h
 VP9_CX_SRCS-yes += encoder/vp9_mbgraph.c
 VP9_CX_SRCS-yes += encoder/vp9_mbgraph.h
+VP9_CX_SRCS-yes += encoder/vp9_pyramid.c
+VP9_CX_SRCS-yes += encoder/vp9_pyramid.h
 
 VP9_CX_SRCS-$(HAVE_SSE2) += encoder/x86/vp9_avg_intrin_sse2.c
 VP9_CX_SRCS-$(HAVE_AVX2) += encoder/x86/vp9_subpel_variance_impl_intrin_avx2.c
 VP9_CX_SRCS-$(HAVE_SSE2) += encoder/x86/vp9_temporal_filter_apply_sse2.asm
+VP9_CX_SRCS-$(HAVE_AVX2) += encoder/x86/vp9_temporal_filter_apply_avx2.c
 VP9_CX_SRCS-$(HAVE_SSE2) += encoder/x86/vp9_quantize_sse2.c
+VP9_CX_SRCS-$(HAVE_AVX2) += encoder/x86/vp9_quantize_avx2.c
+VP9_CX_SRCS-$(HAVE_AVX2) += encoder/x86/vp9_diamond_search_sad_avx2.c
 ifeq ($(CONFIG_VP9_HIGHBITDEPTH),yes)
 VP9_CX_SRCS-$(HAVE_SSE2) += encoder/x86/vp9_highbd_quantize_intrin_sse2.c
 VP9_CX_SRCS-$(HAVE_SSE2) += encoder/x86/vp9_highbd_block_error_intrin_sse2.c
+VP9_CX_SRCS-$(HAVE_AVX2) += encoder/x86/vp9_highbd_variance_avx2.c
+VP9_CX_SRCS-$(HAVE_SSE4_1) += encoder/x86/vp9_highbd_temporal_filter_apply_sse4.c
+VP9_CX_SRCS-$(HAVE_AVX2) += encoder/x86/vp9_highbd_temporal_filter_apply_avx2.c
 endif
 
 ifeq ($(CONFIG_USE_X86INC),yes)
@@ -516,6 +516,59 @@ enum vp8e_enc_control_id {
    * Supported in codecs: VP9
    */
   VP9E_GET_ACTIVEMAP,
+
+  /*!\brief Codec control function to enable row based multi-threading.
+   *
+   * Superblock rows of each tile are encoded in parallel, synchronized as a
+   * wavefront, so that more threads than tile columns can be used. The
+   * output does not depend on the number of threads.
+   *
+   *  0 : off, 1 : on
+   *
+   * By default, this feature is off.
+   *
+   * Supported in codecs: VP9
+   */
+  VP9E_SET_ROW_MT,
+
+  /*!\brief Codec control function to encode the last pass in parallel chunks.
+   *
+   * The stream is split into key frame delimited chunks, placed from the
+   * first pass stats, and up to this many chunks are coded at a time by
+   * independent encoder instances, each with its share of the two pass bit
+   * budget. Each input frame is copied and passed on to the encoder of its
+   * chunk as it arrives; vpx_codec_encode() waits while the copies not yet
+   * taken amount to one chunk per parallel encoder. Packets, and PSNR
+   * packets with #VPX_CODEC_USE_PSNR, are returned once their chunk is
+   * coded. Requires a build with multithreading.
+   *
+   *  0, 1 : off, 2 - 64 : number of chunks coded in parallel
+   *
+   * By default, this feature is off.
+   *
+   * Supported in codecs: VP9
+   */
+  VP9E_SET_PARALLEL_CHUNKS,
+
+  /*!\brief Codec control function to let the encoder hold input images.
+   *
+   * Once a release callback is installed, an image passed to
+   * vpx_codec_encode() that has at least #VP9_INPUT_BORDER_IN_PIXELS of
+   * allocated border on every side, 16 byte aligned planes and strides, is
+   * queued for lookahead without being copied. The encoder writes the
+   * border of such an image, and with noise sensitivity enabled may also
+   * denoise it in place. An image laid out this way can be made by
+   * allocating 2 * #VP9_INPUT_BORDER_IN_PIXELS more width and height with
+   * vpx_img_alloc() and cropping it with vpx_img_set_rect().
+   *
+   * The callback is invoked exactly once for every image passed to
+   * vpx_codec_encode() while it is installed, with that image's user_priv,
+   * when the encoder drops its reference. Images that cannot be held are
+   * copied and released before vpx_codec_encode() returns.
+   *
+   * Supported in codecs: VP9
+   */
+  VP9E_SET_INPUT_RELEASE_CB,
 };
 
 /*!\brief vpx 1-D scaling mode
@@ -573,6 +626,29 @@ typedef struct vpx_scaling_mode {
   VPX_SCALING_MODE    v_scaling_mode;  /**< vertical scaling mode   */
 } vpx_scaling_mode_t;
 
+/*!\brief Border, in pixels, of input images the encoder can hold
+ *
+ * \sa #VP9E_SET_INPUT_RELEASE_CB
+ */
+#define VP9_INPUT_BORDER_IN_PIXELS 160
+
+/*!\brief Input image release function pointer
+ *
+ * \param[in] cb_priv   Callback's private data
+ * \param[in] img_priv  user_priv of the image that is released
+ */
+typedef void (*vpx_release_input_cb_fn_t)(void *cb_priv, void *img_priv);
+
+/*!\brief Input image release callback
+ *
+ * This defines the callback installed with #VP9E_SET_INPUT_RELEASE_CB.
+ *
+ */
+typedef struct vpx_release_input_cb {
+  vpx_release_input_cb_fn_t release;  /**< NULL to copy every image */
+  void *cb_priv;                      /**< Passed to release */
+} vpx_release_input_cb_t;
+
 /*!\brief VP8 token partition mode
  *
  * This defines VP8 partitioning mode for compressed data, i.e., the number of
@@ -701,6 +777,12 @@ VPX_CTRL_USE_TYPE(VP9E_SET_TUNE_CONTENT, int) /* vp9e_tune_content */
 VPX_CTRL_USE_TYPE(VP9E_SET_COLOR_SPACE, int)
 
 VPX_CTRL_USE_TYPE(VP9E_GET_ACTIVEMAP, vpx_active_map_t *)
+
+VPX_CTRL_USE_TYPE(VP9E_SET_ROW_MT, unsigned int)
+
+VPX_CTRL_USE_TYPE(VP9E_SET_PARALLEL_CHUNKS, unsigned int)
+
+VPX_CTRL_USE_TYPE(VP9E_SET_INPUT_RELEASE_CB, vpx_release_input_cb_t *)
 /*! @} - end defgroup vp8_encoder */
 #ifdef __cplusplus
 }  // extern "C"
@@ -106,6 +106,22 @@ enum vp8_dec_control_id {
    */
   VP9_INVERT_TILE_DECODE_ORDER,
 
+  /** control function to loopfilter superblock rows as soon as every tile
+   * column has decoded past them, instead of after the whole frame. This
+   * lowers the per-frame latency of multi-threaded tile decoding and does not
+   * change the output. Takes an int, 0 (default) or 1.
+   */
+  VP9D_SET_PIPELINED_LOOP_FILTER,
+
+  /** control function to hint the largest frame size, as an int array of
+   * the width and height, that the decoder will see. The internal frame
+   * buffers are then allocated to hold frames of that size when they are
+   * first needed, instead of growing with the resolution of the stream.
+   * Has no effect with external frame buffers. { 0, 0 } (default) clears
+   * the hint.
+   */
+  VP9D_SET_FRAME_SIZE_HINT,
+
   VP8_DECODER_CTRL_ID_MAX
 };
 
@@ -149,6 +165,8 @@ VPX_CTRL_USE_TYPE(VP9D_GET_DISPLAY_SIZE,        int *)
 VPX_CTRL_USE_TYPE(VP9D_GET_BIT_DEPTH,           unsigned int *)
 VPX_CTRL_USE_TYPE(VP9D_GET_FRAME_SIZE,          int *)
 VPX_CTRL_USE_TYPE(VP9_INVERT_TILE_DECODE_ORDER, int)
+VPX_CTRL_USE_TYPE(VP9D_SET_PIPELINED_LOOP_FILTER, int)
+VPX_CTRL_USE_TYPE(VP9D_SET_FRAME_SIZE_HINT,     int *)
 
 /*! @} - end defgroup vp8_decoder */
 
@@ -117,6 +117,22 @@ MSE(16, 8)
 MSE(8, 16)
 MSE(8, 8)
 
+int64_t vpx_sse_c(const uint8_t *a, int a_stride, const uint8_t *b,
+                  int b_stride, int width, int height) {
+  int64_t sse = 0;
+  int i, j;
+
+  for (i = 0; i < height; i++) {
+    for (j = 0; j < width; j++) {
+      const int diff = a[j] - b[j];
+      sse += diff * diff;
+    }
+    a += a_stride;
+    b += b_stride;
+  }
+  return sse;
+}
+
 void vpx_comp_avg_pred_c(uint8_t *comp_pred, const uint8_t *pred, int width,
                          int height, const uint8_t *ref, int ref_stride) {
   int i, j;
@@ -273,6 +289,24 @@ HIGHBD_MSE(16, 8)
 HIGHBD_MSE(8, 16)
 HIGHBD_MSE(8, 8)
 
+int64_t vpx_highbd_sse_c(const uint8_t *a8, int a_stride, const uint8_t *b8,
+                         int b_stride, int width, int height) {
+  const uint16_t *a = CONVERT_TO_SHORTPTR(a8);
+  const uint16_t *b = CONVERT_TO_SHORTPTR(b8);
+  int64_t sse = 0;
+  int i, j;
+
+  for (i = 0; i < height; i++) {
+    for (j = 0; j < width; j++) {
+      const int diff = a[j] - b[j];
+      sse += (int64_t)diff * diff;
+    }
+    a += a_stride;
+    b += b_stride;
+  }
+  return sse;
+}
+
 HIGHBD_VAR(64, 64)
 HIGHBD_VAR(64, 32)
 HIGHBD_VAR(32, 64)
@@ -0,0 +1,146 @@
+/*
+ *  Copyright (c) 2015 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#include <immintrin.h>  // AVX2
+
+#include "./vpx_dsp_rtcd.h"
+#include "vpx/vpx_integer.h"
+#include "vpx_ports/mem.h"
+
+// Absolute difference of 16 pixels. Pixels are at most 12 bits, so up to four
+// of these may be summed in 16 bits before widening.
+static INLINE __m256i abs_diff16(__m256i a, __m256i b) {
+  return _mm256_sub_epi16(_mm256_max_epu16(a, b), _mm256_min_epu16(a, b));
+}
+
+static INLINE __m256i load_ref16(const uint16_t *ref, const uint16_t *pred) {
+  const __m256i r = _mm256_loadu_si256((const __m256i *)ref);
+  if (pred == NULL)
+    return r;
+  return _mm256_avg_epu16(r, _mm256_loadu_si256((const __m256i *)pred));
+}
+
+static INLINE unsigned int hsum_epi32(__m256i v) {
+  __m128i s = _mm_add_epi32(_mm256_castsi256_si128(v),
+                            _mm256_extracti128_si256(v, 1));
+  s = _mm_add_epi32(s, _mm_srli_si128(s, 8));
+  s = _mm_add_epi32(s, _mm_srli_si128(s, 4));
+  return (unsigned int)_mm_cvtsi128_si32(s);
+}
+
+// SAD of a w x h block, w a multiple of 16 and at most 64. When pred is not
+// NULL the reference is first averaged with it, pred having a stride of w.
+static INLINE unsigned int highbd_sad_wxh(const uint16_t *src, int src_stride,
+                                          const uint16_t *ref, int ref_stride,
+                                          const uint16_t *pred, int w, int h) {
+  const __m256i one = _mm256_set1_epi16(1);
+  __m256i sum = _mm256_setzero_si256();
+  int i, j;
+  for (i = 0; i < h; ++i) {
+    __m256i row = _mm256_setzero_si256();
+    for (j = 0; j < w; j += 16) {
+      const __m256i s = _mm256_loadu_si256((const __m256i *)(src + j));
+      const __m256i r = load_ref16(ref + j, pred ? pred + j : NULL);
+      row = _mm256_add_epi16(row, abs_diff16(s, r));
+    }
+    sum = _mm256_add_epi32(sum, _mm256_madd_epi16(row, one));
+    src += src_stride;
+    ref += ref_stride;
+    if (pred)
+      pred += w;
+  }
+  return hsum_epi32(sum);
+}
+
+static INLINE void highbd_sad_wxhx4d(const uint16_t *src, int src_stride,
+                                     const uint8_t *const ref8[4],
+                                     int ref_stride, uint32_t *sad_array,
+                                     int w, int h) {
+  const __m256i one = _mm256_set1_epi16(1);
+  const uint16_t *ref0 = CONVERT_TO_SHORTPTR(ref8[0]);
+  const uint16_t *ref1 = CONVERT_TO_SHORTPTR(ref8[1]);
+  const uint16_t *ref2 = CONVERT_TO_SHORTPTR(ref8[2]);
+  const uint16_t *ref3 = CONVERT_TO_SHORTPTR(ref8[3]);
+  __m256i sum0 = _mm256_setzero_si256();
+  __m256i sum1 = _mm256_setzero_si256();
+  __m256i sum2 = _mm256_setzero_si256();
+  __m256i sum3 = _mm256_setzero_si256();
+  int i, j;
+  for (i = 0; i < h; ++i) {
+    __m256i row0 = _mm256_setzero_si256();
+    __m256i row1 = _mm256_setzero_si256();
+    __m256i row2 = _mm256_setzero_si256();
+    __m256i row3 = _mm256_setzero_si256();
+    for (j = 0; j < w; j += 16) {
+      const __m256i s = _mm256_loadu_si256((const __m256i *)(src + j));
+      row0 = _mm256_add_epi16(row0, abs_diff16(s,
+          _mm256_loadu_si256((const __m256i *)(ref0 + j))));
+      row1 = _mm256_add_epi16(row1, abs_diff16(s,
+          _mm256_loadu_si256((const __m256i *)(ref1 + j))));
+      row2 = _mm256_add_epi16(row2, abs_diff16(s,
+          _mm256_loadu_si256((const __m256i *)(ref2 + j))));
+      row3 = _mm256_add_epi16(row3, abs_diff16(s,
+          _mm256_loadu_si256((const __m256i *)(ref3 + j))));
+    }
+    sum0 = _mm256_add_epi32(sum0, _mm256_madd_epi16(row0, one));
+    sum1 = _mm256_add_epi32(sum1, _mm256_madd_epi16(row1, one));
+    sum2 = _mm256_add_epi32(sum2, _mm256_madd_epi16(row2, one));
+    sum3 = _mm256_add_epi32(sum3, _mm256_madd_epi16(row3, one));
+    src += src_stride;
+    ref0 += ref_stride;
+    ref1 += ref_stride;
+    ref2 += ref_stride;
+    ref3 += ref_stride;
+  }
+  {
+    // Reduce the four sums together: after the two hadds each 128-bit half
+    // holds the partial sums of ref 0..3 in order.
+    const __m256i s01 = _mm256_hadd_epi32(sum0, sum1);
+    const __m256i s23 = _mm256_hadd_epi32(sum2, sum3);
+    const __m256i s = _mm256_hadd_epi32(s01, s23);
+    const __m128i r = _mm_add_epi32(_mm256_castsi256_si128(s),
+                                    _mm256_extracti128_si256(s, 1));
+    _mm_storeu_si128((__m128i *)sad_array, r);
+  }
+}
+
+#define HIGHBD_SADMXN_AVX2(m, n) \
+unsigned int vpx_highbd_sad##m##x##n##_avx2(const uint8_t *src, \
+                                            int src_stride, \
+                                            const uint8_t *ref, \
+                                            int ref_stride) { \
+  return highbd_sad_wxh(CONVERT_TO_SHORTPTR(src), src_stride, \
+                        CONVERT_TO_SHORTPTR(ref), ref_stride, NULL, m, n); \
+} \
+\
+unsigned int vpx_highbd_sad##m##x##n##_avg_avx2(const uint8_t *src, \
+                                                int src_stride, \
+                                                const uint8_t *ref, \
+                                                int ref_stride, \
+                                                const uint8_t *second_pred) { \
+  return highbd_sad_wxh(CONVERT_TO_SHORTPTR(src), src_stride, \
+                        CONVERT_TO_SHORTPTR(ref), ref_stride, \
+                        CONVERT_TO_SHORTPTR(second_pred), m, n); \
+} \
+\
+void vpx_highbd_sad##m##x##n##x4d_avx2(const uint8_t *src, int src_stride, \
+                                       const uint8_t *const ref_array[], \
+                                       int ref_stride, uint32_t *sad_array) { \
+  highbd_sad_wxhx4d(CONVERT_TO_SHORTPTR(src), src_stride, ref_array, \
+                    ref_stride, sad_array, m, n); \
+}
+
+HIGHBD_SADMXN_AVX2(64, 64)
+HIGHBD_SADMXN_AVX2(64, 32)
+HIGHBD_SADMXN_AVX2(32, 64)
+HIGHBD_SADMXN_AVX2(32, 32)
+HIGHBD_SADMXN_AVX2(32, 16)
+HIGHBD_SADMXN_AVX2(16, 32)
+HIGHBD_SADMXN_AVX2(16, 16)
+HIGHBD_SADMXN_AVX2(16, 8)
@@ -10,15 +10,53 @@
 #include <immintrin.h>  // AVX2
 #include "./vpx_dsp_rtcd.h"
 #include "vpx/vpx_integer.h"
+#include "vpx_ports/mem.h"
 
-void vpx_sad32x32x4d_avx2(const uint8_t *src,
-                          int src_stride,
-                          const uint8_t *const ref[4],
-                          int ref_stride,
-                          uint32_t res[4]) {
+static INLINE void write_sad4d(__m256i sum_ref0, __m256i sum_ref1,
+                               __m256i sum_ref2, __m256i sum_ref3,
+                               uint32_t res[4]) {
+  __m256i sum_mlow, sum_mhigh;
+  __m128i sum;
+
+  // in sum_ref-i the result is saved in the first 4 bytes
+  // the other 4 bytes are zeroed.
+  // sum_ref1 and sum_ref3 are shifted left by 4 bytes
+  sum_ref1 = _mm256_slli_si256(sum_ref1, 4);
+  sum_ref3 = _mm256_slli_si256(sum_ref3, 4);
+
+  // merge sum_ref0 and sum_ref1 also sum_ref2 and sum_ref3
+  sum_ref0 = _mm256_or_si256(sum_ref0, sum_ref1);
+  sum_ref2 = _mm256_or_si256(sum_ref2, sum_ref3);
+
+  // merge every 64 bit from each sum_ref-i
+  sum_mlow = _mm256_unpacklo_epi64(sum_ref0, sum_ref2);
+  sum_mhigh = _mm256_unpackhi_epi64(sum_ref0, sum_ref2);
+
+  // add the low 64 bit to the high 64 bit
+  sum_mlow = _mm256_add_epi32(sum_mlow, sum_mhigh);
+
+  // add the low 128 bit to the high 128 bit
+  sum = _mm_add_epi32(_mm256_castsi256_si128(sum_mlow),
+                      _mm256_extractf128_si256(sum_mlow, 1));
+
+  _mm_storeu_si128((__m128i *)(res), sum);
+}
+
+// Load two 16 byte rows into the low and high lane.
+static INLINE __m256i load_16x2(const uint8_t *ptr, int stride) {
+  return _mm256_inserti128_si256(
+      _mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)ptr)),
+      _mm_loadu_si128((const __m128i *)(ptr + stride)), 1);
+}
+
+static INLINE void sad16xhx4d_avx2(const uint8_t *src,
+                                   int src_stride,
+                                   const uint8_t *const ref[4],
+                                   int ref_stride,
+                                   int height,
+                                   uint32_t res[4]) {
   __m256i src_reg, ref0_reg, ref1_reg, ref2_reg, ref3_reg;
   __m256i sum_ref0, sum_ref1, sum_ref2, sum_ref3;
-  __m256i sum_mlow, sum_mhigh;
   int i;
   const uint8_t *ref0, *ref1, *ref2, *ref3;
 
@@ -30,7 +68,53 @@ void vpx_sad32x32x4d_avx2(const uint8_t *src,
   sum_ref1 = _mm256_set1_epi16(0);
   sum_ref2 = _mm256_set1_epi16(0);
   sum_ref3 = _mm256_set1_epi16(0);
-  for (i = 0; i < 32 ; i++) {
+  // processing two rows in a 256 bit register
+  for (i = 0; i < height; i += 2) {
+    src_reg = load_16x2(src, src_stride);
+    ref0_reg = load_16x2(ref0, ref_stride);
+    ref1_reg = load_16x2(ref1, ref_stride);
+    ref2_reg = load_16x2(ref2, ref_stride);
+    ref3_reg = load_16x2(ref3, ref_stride);
+    // sum of the absolute differences between every ref-i to src
+    ref0_reg = _mm256_sad_epu8(ref0_reg, src_reg);
+    ref1_reg = _mm256_sad_epu8(ref1_reg, src_reg);
+    ref2_reg = _mm256_sad_epu8(ref2_reg, src_reg);
+    ref3_reg = _mm256_sad_epu8(ref3_reg, src_reg);
+    // sum every ref-i
+    sum_ref0 = _mm256_add_epi32(sum_ref0, ref0_reg);
+    sum_ref1 = _mm256_add_epi32(sum_ref1, ref1_reg);
+    sum_ref2 = _mm256_add_epi32(sum_ref2, ref2_reg);
+    sum_ref3 = _mm256_add_epi32(sum_ref3, ref3_reg);
+
+    src += src_stride << 1;
+    ref0 += ref_stride << 1;
+    ref1 += ref_stride << 1;
+    ref2 += ref_stride << 1;
+    ref3 += ref_stride << 1;
+  }
+  write_sad4d(sum_ref0, sum_ref1, sum_ref2, sum_ref3, res);
+}
+
+static INLINE void sad32xhx4d_avx2(const uint8_t *src,
+                                   int src_stride,
+                                   const uint8_t *const ref[4],
+                                   int ref_stride,
+                                   int height,
+                                   uint32_t res[4]) {
+  __m256i src_reg, ref0_reg, ref1_reg, ref2_reg, ref3_reg;
+  __m256i sum_ref0, sum_ref1, sum_ref2, sum_ref3;
+  int i;
+  const uint8_t *ref0, *ref1, *ref2, *ref3;
+
+  ref0 = ref[0];
+  ref1 = ref[1];
+  ref2 = ref[2];
+  ref3 = ref[3];
+  sum_ref0 = _mm256_set1_epi16(0);
+  sum_ref1 = _mm256_set1_epi16(0);
+  sum_ref2 = _mm256_set1_epi16(0);
+  sum_ref3 = _mm256_set1_epi16(0);
+  for (i = 0; i < height ; i++) {
     // load src and all refs
     src_reg = _mm256_loadu_si256((const __m256i *)src);
     ref0_reg = _mm256_loadu_si256((const __m256i *)ref0);
@@ -54,43 +138,19 @@ void vpx_sad32x32x4d_avx2(const uint8_t *src,
     ref2+= ref_stride;
     ref3+= ref_stride;
   }
-  {
-    __m128i sum;
-    // in sum_ref-i the result is saved in the first 4 bytes
-    // the other 4 bytes are zeroed.
-    // sum_ref1 and sum_ref3 are shifted left by 4 bytes
-    sum_ref1 = _mm256_slli_si256(sum_ref1, 4);
-    sum_ref3 = _mm256_slli_si256(sum_ref3, 4);
-
-    // merge sum_ref0 and sum_ref1 also sum_ref2 and sum_ref3
-    sum_ref0 = _mm256_or_si256(sum_ref0, sum_ref1);
-    sum_ref2 = _mm256_or_si256(sum_ref2, sum_ref3);
-
-    // merge every 64 bit from each sum_ref-i
-    sum_mlow = _mm256_unpacklo_epi64(sum_ref0, sum_ref2);
-    sum_mhigh = _mm256_unpackhi_epi64(sum_ref0, sum_ref2);
-
-    // add the low 64 bit to the high 64 bit
-    sum_mlow = _mm256_add_epi32(sum_mlow, sum_mhigh);
-
-    // add the low 128 bit to the high 128 bit
-    sum = _mm_add_epi32(_mm256_castsi256_si128(sum_mlow),
-                        _mm256_extractf128_si256(sum_mlow, 1));
-
-    _mm_storeu_si128((__m128i *)(res), sum);
-  }
+  write_sad4d(sum_ref0, sum_ref1, sum_ref2, sum_ref3, res);
 }
 
-void vpx_sad64x64x4d_avx2(const uint8_t *src,
-                          int src_stride,
-                          const uint8_t *const ref[4],
-                          int ref_stride,
-                          uint32_t res[4]) {
+static INLINE void sad64xhx4d_avx2(const uint8_t *src,
+                                   int src_stride,
+                                   const uint8_t *const ref[4],
+                                   int ref_stride,
+                                   int height,
+                                   uint32_t res[4]) {
   __m256i src_reg, srcnext_reg, ref0_reg, ref0next_reg;
   __m256i ref1_reg, ref1next_reg, ref2_reg, ref2next_reg;
   __m256i ref3_reg, ref3next_reg;
   __m256i sum_ref0, sum_ref1, sum_ref2, sum_ref3;
-  __m256i sum_mlow, sum_mhigh;
   int i;
   const uint8_t *ref0, *ref1, *ref2, *ref3;
 
@@ -102,7 +162,7 @@ void vpx_sad64x64x4d_avx2(const uint8_t *src,
   sum_ref1 = _mm256_set1_epi16(0);
   sum_ref2 = _mm256_set1_epi16(0);
   sum_ref3 = _mm256_set1_epi16(0);
-  for (i = 0; i < 64 ; i++) {
+  for (i = 0; i < height ; i++) {
     // load 64 bytes from src and all refs
     src_reg = _mm256_loadu_si256((const __m256i *)src);
     srcnext_reg = _mm256_loadu_si256((const __m256i *)(src + 32));
@@ -139,30 +199,86 @@ void vpx_sad64x64x4d_avx2(const uint8_t *src,
     ref2+= ref_stride;
     ref3+= ref_stride;
   }
-  {
-    __m128i sum;
-
-    // in sum_ref-i the result is saved in the first 4 bytes
-    // the other 4 bytes are zeroed.
-    // sum_ref1 and sum_ref3 are shifted left by 4 bytes
-    sum_ref1 = _mm256_slli_si256(sum_ref1, 4);
-    sum_ref3 = _mm256_slli_si256(sum_ref3, 4);
+  write_sad4d(sum_ref0, sum_ref1, sum_ref2, sum_ref3, res);
+}
 
-    // merge sum_ref0 and sum_ref1 also sum_ref2 and sum_ref3
-    sum_ref0 = _mm256_or_si256(sum_ref0, sum_ref1);
-    sum_ref2 = _mm256_or_si256(sum_ref2, sum_ref3);
+#define SADNXMX4D_AVX2(n, m) \
+void vpx_sad##n##x##m##x4d_avx2(const uint8_t *src_ptr, \
+                                int src_stride, \
+                                const uint8_t *const ref_ptr[], \
+                                int ref_stride, \
+                                uint32_t *sad_array) { \
+  sad##n##xhx4d_avx2(src_ptr, src_stride, ref_ptr, ref_stride, m, \
+                     sad_array); \
+}
 
-    // merge every 64 bit from each sum_ref-i
-    sum_mlow = _mm256_unpacklo_epi64(sum_ref0, sum_ref2);
-    sum_mhigh = _mm256_unpackhi_epi64(sum_ref0, sum_ref2);
+SADNXMX4D_AVX2(64, 64)
+SADNXMX4D_AVX2(64, 32)
+SADNXMX4D_AVX2(32, 64)
+SADNXMX4D_AVX2(32, 32)
+SADNXMX4D_AVX2(32, 16)
+SADNXMX4D_AVX2(16, 32)
+SADNXMX4D_AVX2(16, 16)
+SADNXMX4D_AVX2(16, 8)
 
-    // add the low 64 bit to the high 64 bit
-    sum_mlow = _mm256_add_epi32(sum_mlow, sum_mhigh);
+#undef SADNXMX4D_AVX2
 
-    // add the low 128 bit to the high 128 bit
-    sum = _mm_add_epi32(_mm256_castsi256_si128(sum_mlow),
-                        _mm256_extractf128_si256(sum_mlow, 1));
+// Sums of absolute differences of a 16 wide block against the reference at
+// the 8 horizontal offsets 0..7. Each mpsadbw compares one 4 byte group of
+// two source rows against 8 overlapping positions of the same rows of the
+// reference; the upper two groups take their positions from ref + 8.
+static INLINE void sad16xhx8_avx2(const uint8_t *src, int src_stride,
+                                  const uint8_t *ref, int ref_stride,
+                                  int height, uint32_t res[8]) {
+  __m256i sum = _mm256_setzero_si256();
+  __m128i sum128;
+  int i;
 
-    _mm_storeu_si128((__m128i *)(res), sum);
+  for (i = 0; i < height; i += 2) {
+    const __m256i src_reg = load_16x2(src, src_stride);
+    const __m256i ref_lo = load_16x2(ref, ref_stride);
+    const __m256i ref_hi = load_16x2(ref + 8, ref_stride);
+    // Each row adds at most 16 * 255 per offset, so 16 rows fit in 16 bits.
+    sum = _mm256_add_epi16(sum, _mm256_mpsadbw_epu8(ref_lo, src_reg, 0x00));
+    sum = _mm256_add_epi16(sum, _mm256_mpsadbw_epu8(ref_lo, src_reg, 0x2d));
+    sum = _mm256_add_epi16(sum, _mm256_mpsadbw_epu8(ref_hi, src_reg, 0x12));
+    sum = _mm256_add_epi16(sum, _mm256_mpsadbw_epu8(ref_hi, src_reg, 0x3f));
+    src += src_stride << 1;
+    ref += ref_stride << 1;
   }
+  sum128 = _mm_add_epi16(_mm256_castsi256_si128(sum),
+                         _mm256_extracti128_si256(sum, 1));
+  _mm256_storeu_si256((__m256i *)res, _mm256_cvtepu16_epi32(sum128));
+}
+
+void vpx_sad16x16x8_avx2(const uint8_t *src_ptr, int src_stride,
+                         const uint8_t *ref_ptr, int ref_stride,
+                         uint32_t *sad_array) {
+  sad16xhx8_avx2(src_ptr, src_stride, ref_ptr, ref_stride, 16, sad_array);
+}
+
+void vpx_sad16x8x8_avx2(const uint8_t *src_ptr, int src_stride,
+                        const uint8_t *ref_ptr, int ref_stride,
+                        uint32_t *sad_array) {
+  sad16xhx8_avx2(src_ptr, src_stride, ref_ptr, ref_stride, 8, sad_array);
+}
+
+void vpx_sad16x16x3_avx2(const uint8_t *src_ptr, int src_stride,
+                         const uint8_t *ref_ptr, int ref_stride,
+                         uint32_t *sad_array) {
+  uint32_t sad[8];
+  sad16xhx8_avx2(src_ptr, src_stride, ref_ptr, ref_stride, 16, sad);
+  sad_array[0] = sad[0];
+  sad_array[1] = sad[1];
+  sad_array[2] = sad[2];
+}
+
+void vpx_sad16x8x3_avx2(const uint8_t *src_ptr, int src_stride,
+                        const uint8_t *ref_ptr, int ref_stride,
+                        uint32_t *sad_array) {
+  uint32_t sad[8];
+  sad16xhx8_avx2(src_ptr, src_stride, ref_ptr, ref_stride, 8, sad);
+  sad_array[0] = sad[0];
+  sad_array[1] = sad[1];
+  sad_array[2] = sad[2];
 }
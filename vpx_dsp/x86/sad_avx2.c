@@ -11,6 +11,13 @@
 #include "./vpx_dsp_rtcd.h"
 #include "vpx_ports/mem.h"
 
+// Load two 16 byte rows into the low and high lane.
+static INLINE __m256i load_16x2(const uint8_t *ptr, int stride) {
+  return _mm256_inserti128_si256(
+      _mm256_castsi128_si256(_mm_loadu_si128((__m128i const *)ptr)),
+      _mm_loadu_si128((__m128i const *)(ptr + stride)), 1);
+}
+
 #define FSAD64_H(h) \
 unsigned int vpx_sad64x##h##_avx2(const uint8_t *src_ptr, \
                                   int src_stride, \
@@ -72,6 +79,35 @@ unsigned int vpx_sad32x##h##_avx2(const uint8_t *src_ptr, \
   return res; \
 }
 
+#define FSAD16_H(h) \
+unsigned int vpx_sad16x##h##_avx2(const uint8_t *src_ptr, \
+                                  int src_stride, \
+                                  const uint8_t *ref_ptr, \
+                                  int ref_stride) { \
+  int i, res; \
+  __m256i sad_reg, src_reg, ref_reg; \
+  __m256i sum_sad = _mm256_setzero_si256(); \
+  __m256i sum_sad_h; \
+  __m128i sum_sad128; \
+  int ref2_stride = ref_stride << 1; \
+  int src2_stride = src_stride << 1; \
+  int max = h >> 1; \
+  for (i = 0 ; i < max ; i++) { \
+    src_reg = load_16x2(src_ptr, src_stride); \
+    ref_reg = load_16x2(ref_ptr, ref_stride); \
+    sad_reg = _mm256_sad_epu8(ref_reg, src_reg); \
+    sum_sad = _mm256_add_epi32(sum_sad, sad_reg); \
+    ref_ptr+= ref2_stride; \
+    src_ptr+= src2_stride; \
+  } \
+  sum_sad_h = _mm256_srli_si256(sum_sad, 8); \
+  sum_sad = _mm256_add_epi32(sum_sad, sum_sad_h); \
+  sum_sad128 = _mm256_extracti128_si256(sum_sad, 1); \
+  sum_sad128 = _mm_add_epi32(_mm256_castsi256_si128(sum_sad), sum_sad128); \
+  res = _mm_cvtsi128_si32(sum_sad128); \
+  return res; \
+}
+
 #define FSAD64 \
 FSAD64_H(64); \
 FSAD64_H(32);
@@ -81,13 +117,21 @@ FSAD32_H(64); \
 FSAD32_H(32); \
 FSAD32_H(16);
 
+#define FSAD16 \
+FSAD16_H(32); \
+FSAD16_H(16); \
+FSAD16_H(8);
+
 FSAD64;
 FSAD32;
+FSAD16;
 
 #undef FSAD64
 #undef FSAD32
+#undef FSAD16
 #undef FSAD64_H
 #undef FSAD32_H
+#undef FSAD16_H
 
 #define FSADAVG64_H(h) \
 unsigned int vpx_sad64x##h##_avg_avx2(const uint8_t *src_ptr, \
@@ -163,6 +207,39 @@ unsigned int vpx_sad32x##h##_avg_avx2(const uint8_t *src_ptr, \
   return res; \
 }
 
+#define FSADAVG16_H(h) \
+unsigned int vpx_sad16x##h##_avg_avx2(const uint8_t *src_ptr, \
+                                      int src_stride, \
+                                      const uint8_t *ref_ptr, \
+                                      int  ref_stride, \
+                                      const uint8_t *second_pred) { \
+  int i, res; \
+  __m256i sad_reg, src_reg, ref_reg; \
+  __m256i sum_sad = _mm256_setzero_si256(); \
+  __m256i sum_sad_h; \
+  __m128i sum_sad128; \
+  int ref2_stride = ref_stride << 1; \
+  int src2_stride = src_stride << 1; \
+  int max = h >> 1; \
+  for (i = 0 ; i < max ; i++) { \
+    src_reg = load_16x2(src_ptr, src_stride); \
+    ref_reg = load_16x2(ref_ptr, ref_stride); \
+    ref_reg = _mm256_avg_epu8(ref_reg, \
+              _mm256_loadu_si256((__m256i const *)second_pred)); \
+    sad_reg = _mm256_sad_epu8(ref_reg, src_reg); \
+    sum_sad = _mm256_add_epi32(sum_sad, sad_reg); \
+    ref_ptr+= ref2_stride; \
+    src_ptr+= src2_stride; \
+    second_pred+= 32; \
+  } \
+  sum_sad_h = _mm256_srli_si256(sum_sad, 8); \
+  sum_sad = _mm256_add_epi32(sum_sad, sum_sad_h); \
+  sum_sad128 = _mm256_extracti128_si256(sum_sad, 1); \
+  sum_sad128 = _mm_add_epi32(_mm256_castsi256_si128(sum_sad), sum_sad128); \
+  res = _mm_cvtsi128_si32(sum_sad128); \
+  return res; \
+}
+
 #define FSADAVG64 \
 FSADAVG64_H(64); \
 FSADAVG64_H(32);
@@ -172,10 +249,18 @@ FSADAVG32_H(64); \
 FSADAVG32_H(32); \
 FSADAVG32_H(16);
 
+#define FSADAVG16 \
+FSADAVG16_H(32); \
+FSADAVG16_H(16); \
+FSADAVG16_H(8);
+
 FSADAVG64;
 FSADAVG32;
+FSADAVG16;
 
 #undef FSADAVG64
 #undef FSADAVG32
+#undef FSADAVG16
 #undef FSADAVG64_H
 #undef FSADAVG32_H
+#undef FSADAVG16_H
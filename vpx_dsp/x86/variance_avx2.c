@@ -7,12 +7,19 @@
  *  in the file PATENTS.  All contributing project authors may
  *  be found in the AUTHORS file in the root of the source tree.
  */
+#include <immintrin.h>
+
 #include "./vpx_dsp_rtcd.h"
+#include "vpx_ports/mem.h"
 
 typedef void (*get_var_avx2)(const uint8_t *src, int src_stride,
                              const uint8_t *ref, int ref_stride,
                              unsigned int *sse, int *sum);
 
+void vpx_get16x8var_avx2(const uint8_t *src, int src_stride,
+                         const uint8_t *ref, int ref_stride,
+                         unsigned int *sse, int *sum);
+
 void vpx_get32x32var_avx2(const uint8_t *src, int src_stride,
                           const uint8_t *ref, int ref_stride,
                           unsigned int *sse, int *sum);
@@ -48,6 +55,23 @@ unsigned int vpx_variance16x16_avx2(const uint8_t *src, int src_stride,
   return *sse - (((unsigned int)sum * sum) >> 8);
 }
 
+unsigned int vpx_variance16x8_avx2(const uint8_t *src, int src_stride,
+                                   const uint8_t *ref, int ref_stride,
+                                   unsigned int *sse) {
+  int sum;
+  vpx_get16x8var_avx2(src, src_stride, ref, ref_stride, sse, &sum);
+  return *sse - (((unsigned int)sum * sum) >> 7);
+}
+
+unsigned int vpx_variance16x32_avx2(const uint8_t *src, int src_stride,
+                                    const uint8_t *ref, int ref_stride,
+                                    unsigned int *sse) {
+  int sum;
+  variance_avx2(src, src_stride, ref, ref_stride, 16, 32,
+                sse, &sum, vpx_get16x16var_avx2, 16);
+  return *sse - (((int64_t)sum * sum) >> 9);
+}
+
 unsigned int vpx_mse16x16_avx2(const uint8_t *src, int src_stride,
                                const uint8_t *ref, int ref_stride,
                                unsigned int *sse) {
@@ -56,6 +80,14 @@ unsigned int vpx_mse16x16_avx2(const uint8_t *src, int src_stride,
   return *sse;
 }
 
+unsigned int vpx_mse16x8_avx2(const uint8_t *src, int src_stride,
+                              const uint8_t *ref, int ref_stride,
+                              unsigned int *sse) {
+  int sum;
+  vpx_get16x8var_avx2(src, src_stride, ref, ref_stride, sse, &sum);
+  return *sse;
+}
+
 unsigned int vpx_variance32x16_avx2(const uint8_t *src, int src_stride,
                                     const uint8_t *ref, int ref_stride,
                                     unsigned int *sse) {
@@ -74,6 +106,15 @@ unsigned int vpx_variance32x32_avx2(const uint8_t *src, int src_stride,
   return *sse - (((int64_t)sum * sum) >> 10);
 }
 
+unsigned int vpx_variance32x64_avx2(const uint8_t *src, int src_stride,
+                                    const uint8_t *ref, int ref_stride,
+                                    unsigned int *sse) {
+  int sum;
+  variance_avx2(src, src_stride, ref, ref_stride, 32, 64,
+                sse, &sum, vpx_get32x32var_avx2, 32);
+  return *sse - (((int64_t)sum * sum) >> 11);
+}
+
 unsigned int vpx_variance64x64_avx2(const uint8_t *src, int src_stride,
                                     const uint8_t *ref, int ref_stride,
                                     unsigned int *sse) {
@@ -91,3 +132,92 @@ unsigned int vpx_variance64x32_avx2(const uint8_t *src, int src_stride,
                 sse, &sum, vpx_get32x32var_avx2, 32);
   return *sse - (((int64_t)sum * sum) >> 11);
 }
+
+// Adds the eight 32 bit lanes of v to the four 64 bit lanes of acc.
+static INLINE __m256i add_32_to_64_avx2(__m256i acc, __m256i v) {
+  const __m256i zero = _mm256_setzero_si256();
+  acc = _mm256_add_epi64(acc, _mm256_unpacklo_epi32(v, zero));
+  return _mm256_add_epi64(acc, _mm256_unpackhi_epi32(v, zero));
+}
+
+static INLINE int64_t sum_64_avx2(__m256i v) {
+  int64_t sum[2];
+  _mm_storeu_si128((__m128i *)sum,
+                   _mm_add_epi64(_mm256_castsi256_si128(v),
+                                 _mm256_extracti128_si256(v, 1)));
+  return sum[0] + sum[1];
+}
+
+int64_t vpx_sse_avx2(const uint8_t *a, int a_stride, const uint8_t *b,
+                     int b_stride, int width, int height) {
+  const __m256i zero = _mm256_setzero_si256();
+  __m256i sse64 = _mm256_setzero_si256();
+  int64_t sse = 0;
+  int i, j;
+
+  for (i = 0; i < height; i++) {
+    // A row adds at most width / 16 pairs of squares of 8 bit differences to
+    // each 32 bit lane.
+    __m256i sse32 = _mm256_setzero_si256();
+    for (j = 0; j + 32 <= width; j += 32) {
+      const __m256i va = _mm256_loadu_si256((const __m256i *)(a + j));
+      const __m256i vb = _mm256_loadu_si256((const __m256i *)(b + j));
+      const __m256i d0 = _mm256_sub_epi16(_mm256_unpacklo_epi8(va, zero),
+                                          _mm256_unpacklo_epi8(vb, zero));
+      const __m256i d1 = _mm256_sub_epi16(_mm256_unpackhi_epi8(va, zero),
+                                          _mm256_unpackhi_epi8(vb, zero));
+      sse32 = _mm256_add_epi32(sse32, _mm256_madd_epi16(d0, d0));
+      sse32 = _mm256_add_epi32(sse32, _mm256_madd_epi16(d1, d1));
+    }
+    if (j + 16 <= width) {
+      const __m256i d = _mm256_sub_epi16(
+          _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)(a + j))),
+          _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)(b + j))));
+      sse32 = _mm256_add_epi32(sse32, _mm256_madd_epi16(d, d));
+      j += 16;
+    }
+    for (; j < width; j++) {
+      const int diff = a[j] - b[j];
+      sse += diff * diff;
+    }
+    sse64 = add_32_to_64_avx2(sse64, sse32);
+    a += a_stride;
+    b += b_stride;
+  }
+  return sse + sum_64_avx2(sse64);
+}
+
+#if CONFIG_VP9_HIGHBITDEPTH
+int64_t vpx_highbd_sse_avx2(const uint8_t *a8, int a_stride,
+                            const uint8_t *b8, int b_stride,
+                            int width, int height) {
+  const uint16_t *a = CONVERT_TO_SHORTPTR(a8);
+  const uint16_t *b = CONVERT_TO_SHORTPTR(b8);
+  __m256i sse64 = _mm256_setzero_si256();
+  int64_t sse = 0;
+  int i, j;
+
+  for (i = 0; i < height; i++) {
+    j = 0;
+    while (j + 16 <= width) {
+      // Up to 32 pairs of squares of 12 bit differences fit a 32 bit lane.
+      const int end = j + ((width - j < 512 ? width - j : 512) & ~15);
+      __m256i sse32 = _mm256_setzero_si256();
+      for (; j < end; j += 16) {
+        const __m256i d = _mm256_sub_epi16(
+            _mm256_loadu_si256((const __m256i *)(a + j)),
+            _mm256_loadu_si256((const __m256i *)(b + j)));
+        sse32 = _mm256_add_epi32(sse32, _mm256_madd_epi16(d, d));
+      }
+      sse64 = add_32_to_64_avx2(sse64, sse32);
+    }
+    for (; j < width; j++) {
+      const int diff = a[j] - b[j];
+      sse += (int64_t)diff * diff;
+    }
+    a += a_stride;
+    b += b_stride;
+  }
+  return sse + sum_64_avx2(sse64);
+}
+#endif  // CONFIG_VP9_HIGHBITDEPTH
@@ -12,12 +12,13 @@
 
 #include "./vpx_dsp_rtcd.h"
 
-void vpx_get16x16var_avx2(const unsigned char *src_ptr,
-                          int source_stride,
-                          const unsigned char *ref_ptr,
-                          int recon_stride,
-                          unsigned int *SSE,
-                          int *Sum) {
+static void get16xhvar_avx2(const unsigned char *src_ptr,
+                            int source_stride,
+                            const unsigned char *ref_ptr,
+                            int recon_stride,
+                            int height,
+                            unsigned int *SSE,
+                            int *Sum) {
     __m256i src, src_expand_low, src_expand_high, ref, ref_expand_low;
     __m256i ref_expand_high, madd_low, madd_high;
     unsigned int i, src_2strides, ref_2strides;
@@ -29,7 +30,7 @@ void vpx_get16x16var_avx2(const unsigned char *src_ptr,
     // of loop stride by half (comparing to the sse2 code)
     src_2strides = source_stride << 1;
     ref_2strides = recon_stride << 1;
-    for (i = 0; i < 8; i++) {
+    for (i = 0; i < (unsigned int)height >> 1; i++) {
         src = _mm256_castsi128_si256(
               _mm_loadu_si128((__m128i const *) (src_ptr)));
         src = _mm256_inserti128_si256(src,
@@ -123,6 +124,26 @@ void vpx_get16x16var_avx2(const unsigned char *src_ptr,
     }
 }
 
+void vpx_get16x16var_avx2(const unsigned char *src_ptr,
+                          int source_stride,
+                          const unsigned char *ref_ptr,
+                          int recon_stride,
+                          unsigned int *SSE,
+                          int *Sum) {
+    get16xhvar_avx2(src_ptr, source_stride, ref_ptr, recon_stride, 16,
+                    SSE, Sum);
+}
+
+void vpx_get16x8var_avx2(const unsigned char *src_ptr,
+                         int source_stride,
+                         const unsigned char *ref_ptr,
+                         int recon_stride,
+                         unsigned int *SSE,
+                         int *Sum) {
+    get16xhvar_avx2(src_ptr, source_stride, ref_ptr, recon_stride, 8,
+                    SSE, Sum);
+}
+
 void vpx_get32x32var_avx2(const unsigned char *src_ptr,
                           int source_stride,
                           const unsigned char *ref_ptr,
@@ -307,3 +307,79 @@ unsigned int vpx_mse16x16_sse2(const uint8_t *src, int src_stride,
   vpx_variance16x16_sse2(src, src_stride, ref, ref_stride, sse);
   return *sse;
 }
+
+static INLINE int64_t sum_64_sse2(__m128i v) {
+  int64_t sum;
+  _mm_storel_epi64((__m128i *)&sum, _mm_add_epi64(v, _mm_srli_si128(v, 8)));
+  return sum;
+}
+
+int64_t vpx_sse_sse2(const uint8_t *a, int a_stride, const uint8_t *b,
+                     int b_stride, int width, int height) {
+  const __m128i zero = _mm_setzero_si128();
+  __m128i sse64 = _mm_setzero_si128();
+  int64_t sse = 0;
+  int i, j;
+
+  for (i = 0; i < height; i++) {
+    // A row adds at most width / 8 pairs of squares of 8 bit differences to
+    // each 32 bit lane.
+    __m128i sse32 = _mm_setzero_si128();
+    for (j = 0; j + 16 <= width; j += 16) {
+      const __m128i va = _mm_loadu_si128((const __m128i *)(a + j));
+      const __m128i vb = _mm_loadu_si128((const __m128i *)(b + j));
+      const __m128i d0 = _mm_sub_epi16(_mm_unpacklo_epi8(va, zero),
+                                       _mm_unpacklo_epi8(vb, zero));
+      const __m128i d1 = _mm_sub_epi16(_mm_unpackhi_epi8(va, zero),
+                                       _mm_unpackhi_epi8(vb, zero));
+      sse32 = _mm_add_epi32(sse32, _mm_madd_epi16(d0, d0));
+      sse32 = _mm_add_epi32(sse32, _mm_madd_epi16(d1, d1));
+    }
+    for (; j < width; j++) {
+      const int diff = a[j] - b[j];
+      sse += diff * diff;
+    }
+    sse64 = _mm_add_epi64(sse64, _mm_unpacklo_epi32(sse32, zero));
+    sse64 = _mm_add_epi64(sse64, _mm_unpackhi_epi32(sse32, zero));
+    a += a_stride;
+    b += b_stride;
+  }
+  return sse + sum_64_sse2(sse64);
+}
+
+#if CONFIG_VP9_HIGHBITDEPTH
+int64_t vpx_highbd_sse_sse2(const uint8_t *a8, int a_stride,
+                            const uint8_t *b8, int b_stride,
+                            int width, int height) {
+  const uint16_t *a = CONVERT_TO_SHORTPTR(a8);
+  const uint16_t *b = CONVERT_TO_SHORTPTR(b8);
+  const __m128i zero = _mm_setzero_si128();
+  __m128i sse64 = _mm_setzero_si128();
+  int64_t sse = 0;
+  int i, j;
+
+  for (i = 0; i < height; i++) {
+    j = 0;
+    while (j + 8 <= width) {
+      // Up to 32 pairs of squares of 12 bit differences fit a 32 bit lane.
+      const int end = j + ((width - j < 256 ? width - j : 256) & ~7);
+      __m128i sse32 = _mm_setzero_si128();
+      for (; j < end; j += 8) {
+        const __m128i d = _mm_sub_epi16(
+            _mm_loadu_si128((const __m128i *)(a + j)),
+            _mm_loadu_si128((const __m128i *)(b + j)));
+        sse32 = _mm_add_epi32(sse32, _mm_madd_epi16(d, d));
+      }
+      sse64 = _mm_add_epi64(sse64, _mm_unpacklo_epi32(sse32, zero));
+      sse64 = _mm_add_epi64(sse64, _mm_unpackhi_epi32(sse32, zero));
+    }
+    for (; j < width; j++) {
+      const int diff = a[j] - b[j];
+      sse += (int64_t)diff * diff;
+    }
+    a += a_stride;
+    b += b_stride;
+  }
+  return sse + sum_64_sse2(sse64);
+}
+#endif  // CONFIG_VP9_HIGHBITDEPTH
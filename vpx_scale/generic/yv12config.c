@@ -300,4 +300,38 @@ int vp9_alloc_frame_buffer(YV12_BUFFER_CONFIG *ybf,
   }
   return -2;
 }
+
+size_t vp9_get_frame_buffer_size(int width, int height, int ss_x, int ss_y,
+#if CONFIG_VP9_HIGHBITDEPTH
+                                 int use_highbitdepth,
+#endif
+                                 int border, int byte_alignment) {
+  // Must match the layout of vp9_realloc_frame_buffer().
+  const int align_addr_extra_size = 31;
+  const int aligned_width = (width + 7) & ~7;
+  const int aligned_height = (height + 7) & ~7;
+  const int y_stride = ((aligned_width + 2 * border) + 31) & ~31;
+  const uint64_t yplane_size = (aligned_height + 2 * border) *
+                               (uint64_t)y_stride + byte_alignment;
+  const int uv_height = aligned_height >> ss_y;
+  const int uv_stride = y_stride >> ss_x;
+  const int uv_border_h = border >> ss_y;
+  const uint64_t uvplane_size = (uv_height + 2 * uv_border_h) *
+                                (uint64_t)uv_stride + byte_alignment;
+#if CONFIG_ALPHA
+  const uint64_t alpha_plane_size = (aligned_height + 2 * border) *
+                                    (uint64_t)y_stride + byte_alignment;
+  uint64_t frame_size = yplane_size + 2 * uvplane_size + alpha_plane_size;
+#else
+  uint64_t frame_size = yplane_size + 2 * uvplane_size;
+#endif  // CONFIG_ALPHA
+
+#if CONFIG_VP9_HIGHBITDEPTH
+  frame_size *= 1 + use_highbitdepth;
+#endif
+  frame_size += align_addr_extra_size;
+  if (frame_size != (size_t)frame_size)
+    return 0;
+  return (size_t)frame_size;
+}
 #endif
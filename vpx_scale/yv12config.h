@@ -95,6 +95,15 @@ int vp9_realloc_frame_buffer(YV12_BUFFER_CONFIG *ybf,
                              void *cb_priv);
 int vp9_free_frame_buffer(YV12_BUFFER_CONFIG *ybf);
 
+// Returns the size in bytes vp9_realloc_frame_buffer() asks the get frame
+// buffer callback for to hold a frame of the given format, or 0 if it does
+// not fit in a size_t.
+size_t vp9_get_frame_buffer_size(int width, int height, int ss_x, int ss_y,
+#if CONFIG_VP9_HIGHBITDEPTH
+                                 int use_highbitdepth,
+#endif
+                                 int border, int byte_alignment);
+
 #ifdef __cplusplus
 }
 #endif
@@ -77,6 +77,11 @@ static const arg_def_t threadsarg = ARG_DEF(
     "t", "threads", 1, "Max threads to use");
 static const arg_def_t frameparallelarg = ARG_DEF(
     NULL, "frame-parallel", 0, "Frame parallel decode");
+static const arg_def_t pipelinedlpfarg = ARG_DEF(
+    NULL, "pipelined-lpf", 0, "Loopfilter rows while tiles are decoded");
+static const arg_def_t framesizehintarg = ARG_DEF(
+    NULL, "frame-size-hint", 1,
+    "Largest frame size expected, as WxH, to allocate buffers for");
 static const arg_def_t verbosearg = ARG_DEF(
     "v", "verbose", 0, "Show version string");
 static const arg_def_t error_concealment = ARG_DEF(
@@ -97,8 +102,8 @@ static const arg_def_t outbitdeptharg = ARG_DEF(
 static const arg_def_t *all_args[] = {
   &codecarg, &use_yv12, &use_i420, &flipuvarg, &rawvideo, &noblitarg,
   &progressarg, &limitarg, &skiparg, &postprocarg, &summaryarg, &outputfile,
-  &threadsarg, &frameparallelarg, &verbosearg, &scalearg, &fb_arg,
-  &md5arg, &error_concealment, &continuearg,
+  &threadsarg, &frameparallelarg, &pipelinedlpfarg, &framesizehintarg,
+  &verbosearg, &scalearg, &fb_arg, &md5arg, &error_concealment, &continuearg,
 #if CONFIG_VP9 && CONFIG_VP9_HIGHBITDEPTH
   &outbitdeptharg,
 #endif
@@ -545,6 +550,8 @@ static int main_loop(int argc, const char **argv_) {
   FILE                  *infile;
   int                    frame_in = 0, frame_out = 0, flipuv = 0, noblit = 0;
   int                    do_md5 = 0, progress = 0, frame_parallel = 0;
+  int                    pipelined_lpf = 0;
+  int                    frame_size_hint[2] = { 0, 0 };
   int                    stop_after = 0, postproc = 0, summary = 0, quiet = 1;
   int                    arg_skip = 0;
   int                    ec_enabled = 0;
@@ -647,6 +654,13 @@ static int main_loop(int argc, const char **argv_) {
 #if CONFIG_VP9_DECODER
     else if (arg_match(&arg, &frameparallelarg, argi))
       frame_parallel = 1;
+    else if (arg_match(&arg, &pipelinedlpfarg, argi))
+      pipelined_lpf = 1;
+    else if (arg_match(&arg, &framesizehintarg, argi)) {
+      if (sscanf(arg.val, "%dx%d", &frame_size_hint[0],
+                 &frame_size_hint[1]) != 2)
+        die("Invalid frame size hint: %s\n", arg.val);
+    }
 #endif
     else if (arg_match(&arg, &verbosearg, argi))
       quiet = 0;
@@ -812,6 +826,22 @@ static int main_loop(int argc, const char **argv_) {
   if (!quiet)
     fprintf(stderr, "%s\n", decoder.name);
 
+#if CONFIG_VP9_DECODER
+  if (pipelined_lpf &&
+      vpx_codec_control(&decoder, VP9D_SET_PIPELINED_LOOP_FILTER, 1)) {
+    fprintf(stderr, "Failed to enable pipelined loopfilter: %s\n",
+            vpx_codec_error(&decoder));
+    return EXIT_FAILURE;
+  }
+  if ((frame_size_hint[0] || frame_size_hint[1]) &&
+      vpx_codec_control(&decoder, VP9D_SET_FRAME_SIZE_HINT,
+                        frame_size_hint)) {
+    fprintf(stderr, "Failed to set frame size hint: %s\n",
+            vpx_codec_error(&decoder));
+    return EXIT_FAILURE;
+  }
+#endif
+
 #if CONFIG_VP8_DECODER
 
   if (vp8_pp_cfg.post_proc_flag
@@ -388,6 +388,13 @@ static const arg_def_t tile_rows = ARG_DEF(
     NULL, "tile-rows", 1, "Number of tile rows to use, log2");
 static const arg_def_t lossless = ARG_DEF(
     NULL, "lossless", 1, "Lossless mode");
+static const arg_def_t row_mt = ARG_DEF(
+    NULL, "row-mt", 1,
+    "Enable row based multi-threading (0: off (default), 1: on)");
+static const arg_def_t parallel_chunks = ARG_DEF(
+    NULL, "parallel-chunks", 1,
+    "Number of key frame delimited chunks coded in parallel in the last "
+    "pass (0: off (default))");
 static const arg_def_t frame_parallel_decoding = ARG_DEF(
     NULL, "frame-parallel", 1, "Enable frame parallel decodability features");
 static const arg_def_t aq_mode = ARG_DEF(
@@ -445,7 +452,7 @@ static const arg_def_t *vp9_args[] = {
   &tune_ssim, &cq_level, &max_intra_rate_pct, &max_inter_rate_pct,
   &gf_cbr_boost_pct, &lossless,
   &frame_parallel_decoding, &aq_mode, &frame_periodic_boost,
-  &noise_sens, &tune_content, &input_color_space,
+  &noise_sens, &tune_content, &input_color_space, &row_mt, &parallel_chunks,
 #if CONFIG_VP9 && CONFIG_VP9_HIGHBITDEPTH
   &bitdeptharg, &inbitdeptharg,
 #endif
@@ -460,7 +467,8 @@ static const int vp9_arg_ctrl_map[] = {
   VP9E_SET_MAX_INTER_BITRATE_PCT, VP9E_SET_GF_CBR_BOOST_PCT,
   VP9E_SET_LOSSLESS, VP9E_SET_FRAME_PARALLEL_DECODING, VP9E_SET_AQ_MODE,
   VP9E_SET_FRAME_PERIODIC_BOOST, VP9E_SET_NOISE_SENSITIVITY,
-  VP9E_SET_TUNE_CONTENT, VP9E_SET_COLOR_SPACE,
+  VP9E_SET_TUNE_CONTENT, VP9E_SET_COLOR_SPACE, VP9E_SET_ROW_MT,
+  VP9E_SET_PARALLEL_CHUNKS,
   0
 };
 #endif